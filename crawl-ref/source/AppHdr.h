@@ -342,6 +342,14 @@ static inline double pow(int x, double y) { return std::pow((double)x, y); }
     #define DEBUG_STATISTICS
 #endif
 
+// Allocation accounting attributes allocations to profiler zones, so it
+// needs the zone stack compiled in.
+#ifdef DEBUG_ALLOC
+    #ifndef DEBUG_PROF
+    #define DEBUG_PROF
+    #endif
+#endif
+
 // =========================================================================
 //  Lua user scripts (NOTE: this may also be enabled in your makefile!)
 // =========================================================================
@@ -75,6 +75,33 @@ static void abyss_area_shift();
 static void _push_items();
 static void _push_displaced_monster(monster* mon);
 
+// Cells currently flagged MMT_TURNED_TO_FLOOR, so the per-turn morph
+// pass visits just the dug-out cells instead of sweeping the whole map
+// for the flag. Rebuilt from the mask after a level load.
+static vector<coord_def> _turned_to_floor;
+static bool _turned_to_floor_valid = false;
+
+void abyss_note_turned_to_floor(const coord_def &p)
+{
+    if (_turned_to_floor_valid && !map_masked(p, MMT_TURNED_TO_FLOOR))
+        _turned_to_floor.push_back(p);
+}
+
+void abyss_invalidate_turned_to_floor()
+{
+    _turned_to_floor.clear();
+    _turned_to_floor_valid = false;
+}
+
+static void _rebuild_turned_to_floor()
+{
+    _turned_to_floor.clear();
+    for (rectangle_iterator ri(MAPGEN_BORDER); ri; ++ri)
+        if (map_masked(*ri, MMT_TURNED_TO_FLOOR))
+            _turned_to_floor.push_back(*ri);
+    _turned_to_floor_valid = true;
+}
+
 // If not_seen is true, don't place the feature where it can be seen from
 // the centre. Returns the chosen location, or INVALID_COORD if it
 // could not be placed.
@@ -988,15 +1015,44 @@ static void _abyss_shift_level_contents_around_player(
     dgn_erase_unused_vault_placements();
 }
 
+// Monster placement is the other big contributor to the spike on
+// area-shift turns: the shift asks for dozens of full placements at
+// once. Place a vanguard immediately so the fresh area isn't empty,
+// and bank the remainder as a spawn budget that abyss_morph() drains
+// a few placements per turn.
+static int _abyss_spawn_budget = 0;
+
 static void _abyss_generate_monsters(int nmonsters)
 {
     if (crawl_state.disables[DIS_SPAWNS])
         return;
 
+    const int immediate = min(nmonsters, 5 + nmonsters / 3);
+    _abyss_spawn_budget += nmonsters - immediate;
+
     mgen_data mg;
     mg.proximity = PROX_ANYWHERE;
 
-    for (int mcount = 0; mcount < nmonsters; mcount++)
+    for (int mcount = 0; mcount < immediate; mcount++)
+    {
+        mg.cls = pick_random_monster(level_id::current());
+        if (!invalid_monster_type(mg.cls))
+            mons_place(mg);
+    }
+}
+
+static void _abyss_drain_spawn_budget()
+{
+    if (_abyss_spawn_budget <= 0 || crawl_state.disables[DIS_SPAWNS])
+        return;
+
+    mgen_data mg;
+    mg.proximity = PROX_ANYWHERE;
+
+    const int batch = min(_abyss_spawn_budget, 3);
+    _abyss_spawn_budget -= batch;
+
+    for (int mcount = 0; mcount < batch; mcount++)
     {
         mg.cls = pick_random_monster(level_id::current());
         if (!invalid_monster_type(mg.cls))
@@ -1258,6 +1314,7 @@ static void _destroy_all_terrain(bool vaults)
     {
         if (vaults && env.level_map_mask(*ri) & MMT_VAULT)
             continue;
+        abyss_note_turned_to_floor(*ri);
         env.level_map_mask(*ri) = MMT_TURNED_TO_FLOOR;
     }
 }
@@ -1280,6 +1337,9 @@ static void _ensure_player_habitable(bool dig_instead)
 static void _abyss_apply_terrain(const map_bitmask &abyss_genlevel_mask,
                                  bool morph = false, bool now = false)
 {
+    // Morphing rewrites terrain across the whole level each turn.
+    const terrain_change_batch batch;
+
     // The chance is reciprocal to these numbers.
     const int exit_chance = you.runes[RUNE_ABYSSAL] ? 1250
                             : 7500 - 1250 * (you.depth - 1);
@@ -1308,16 +1368,38 @@ static void _abyss_apply_terrain(const map_bitmask &abyss_genlevel_mask,
 
     int ii = 0;
     int delta = you.time_taken * (you.abyss_speed + 40) / 200;
+    if (used_queue)
+    {
+        // Only dug-out cells are of interest; visit the recorded list
+        // instead of sweeping the whole map for the mask flag.
+        if (!_turned_to_floor_valid)
+            _rebuild_turned_to_floor();
+        unsigned int kept = 0;
+        for (unsigned int i = 0; i < _turned_to_floor.size(); ++i)
+        {
+            const coord_def p = _turned_to_floor[i];
+            if (!map_masked(p, MMT_TURNED_TO_FLOOR))
+                continue;
+            if (now || x_chance_in_y(delta, 50))
+            {
+                ++ii;
+                _update_abyss_terrain(p + abyssal_state.major_coord,
+                                      abyss_genlevel_mask, morph);
+                env.level_map_mask(p) &= ~MMT_TURNED_TO_FLOOR;
+            }
+            else
+                _turned_to_floor[kept++] = p;
+        }
+        _turned_to_floor.resize(kept);
+    }
+    else
     for (rectangle_iterator ri(MAPGEN_BORDER); ri; ++ri)
     {
         const coord_def p(*ri);
         const coord_def abyss_coord = p + abyssal_state.major_coord;
         bool turned_to_floor = map_masked(p, MMT_TURNED_TO_FLOOR);
-        if (used_queue && !turned_to_floor)
-            continue;
 
-        if (turned_to_floor && (now || x_chance_in_y(delta, 50))
-            || !turned_to_floor && !used_queue)
+        if (!turned_to_floor || now || x_chance_in_y(delta, 50))
         {
             ++ii;
             _update_abyss_terrain(abyss_coord, abyss_genlevel_mask, morph);
@@ -1582,6 +1664,7 @@ void generate_abyss()
     env.level_build_method += " abyss";
     env.level_layout_types.insert("abyss");
     destroy_abyss();
+    _abyss_spawn_budget = 0;
 
 retry:
     _initialize_abyss_state();
@@ -1659,6 +1742,7 @@ void abyss_morph()
     dgn_erase_unused_vault_placements();
     _abyss_apply_terrain(abyss_genlevel_mask, true);
     _place_displaced_monsters();
+    _abyss_drain_spawn_budget();
     _push_items();
     los_changed();
 }
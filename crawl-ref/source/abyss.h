@@ -33,6 +33,12 @@ extern abyss_state abyssal_state;
 
 void abyss_morph();
 
+// Track cells flagged MMT_TURNED_TO_FLOOR so morphing can visit just
+// those instead of sweeping the map. Call note before setting the
+// flag; invalidate when the mask is replaced wholesale.
+void abyss_note_turned_to_floor(const coord_def &p);
+void abyss_invalidate_turned_to_floor();
+
 void banished(const string &who = "", const int power = 0);
 void push_features_to_abyss();
 
@@ -603,12 +603,7 @@ static int _acquirement_staff_subtype(bool /*divine*/, int & /*quantity*/)
     skill_type best_spell_skill = best_skill(SK_FIRST_MAGIC_SCHOOL,
                                              SK_LAST_MAGIC);
     bool found_enhancer = false;
-    int result = 0;
-    do
-    {
-        result = random2(NUM_STAVES);
-    }
-    while (item_type_removed(OBJ_STAVES, result));
+    int result = random_live_subtype(OBJ_STAVES, 0, NUM_STAVES - 1);
 
     switch (best_spell_skill)
     {
@@ -4,16 +4,44 @@
 
 #include "env.h"
 #include "losglobal.h"
+#include "mon-util.h"
+
+// The near-iterators only ever yield actors within LOS_RADIUS of their
+// center, so instead of scanning menv they walk the cells of the
+// surrounding box through env.mgrd. i indexes this box row by row.
+// LOS_NONE places no bound on the distance, so that case falls back to
+// scanning menv slots.
+#define NEAR_BOX_DIM   (2 * LOS_RADIUS + 1)
+#define NEAR_BOX_CELLS (NEAR_BOX_DIM * NEAR_BOX_DIM)
+
+// The cell of the box around center that i refers to.
+static coord_def _box_cell(const coord_def &center, int i)
+{
+    return coord_def(center.x + i % NEAR_BOX_DIM - LOS_RADIUS,
+                     center.y + i / NEAR_BOX_DIM - LOS_RADIUS);
+}
+
+static monster* _box_monster(const coord_def &center, int i)
+{
+    if (i >= NEAR_BOX_CELLS)
+        return nullptr;
+    const coord_def p = _box_cell(center, i);
+    if (!in_bounds(p))
+        return nullptr;
+    return monster_at(p);
+}
 
 actor_near_iterator::actor_near_iterator(coord_def c, los_type los)
-    : center(c), _los(los), viewer(nullptr), i(-1)
+    : center(c), _los(los), viewer(nullptr), i(-1),
+      spatial(los != LOS_NONE)
 {
     if (!valid(&you))
         advance();
 }
 
 actor_near_iterator::actor_near_iterator(const actor* a, los_type los)
-    : center(a->pos()), _los(los), viewer(a), i(-1)
+    : center(a->pos()), _los(los), viewer(a), i(-1),
+      spatial(los != LOS_NONE)
 {
     if (!valid(&you))
         advance();
@@ -28,6 +56,8 @@ actor* actor_near_iterator::operator*() const
 {
     if (i == -1)
         return &you;
+    else if (spatial)
+        return _box_monster(center, i);
     else if (i < MAX_MONSTERS)
         return &menv[i];
     else
@@ -63,27 +93,32 @@ bool actor_near_iterator::valid(const actor* a) const
 
 void actor_near_iterator::advance()
 {
+    const int limit = spatial ? NEAR_BOX_CELLS : env.mons_slot_watermark;
     do
-         if (++i >= MAX_MONSTERS)
+         if (++i >= limit)
+         {
+             if (!spatial)
+                 i = MAX_MONSTERS;
              return;
-    while (!valid(**this));
+         }
+    while ((!spatial && !env.mons_occupied[i]) || !valid(**this));
 }
 
 //////////////////////////////////////////////////////////////////////////
 
 monster_near_iterator::monster_near_iterator(coord_def c, los_type los)
-    : center(c), _los(los), viewer(nullptr), i(0)
+    : center(c), _los(los), viewer(nullptr), i(-1),
+      spatial(los != LOS_NONE)
 {
-    if (!valid(&menv[0]))
-        advance();
+    advance();
     begin_point = i;
 }
 
 monster_near_iterator::monster_near_iterator(const actor *a, los_type los)
-    : center(a->pos()), _los(los), viewer(a), i(0)
+    : center(a->pos()), _los(los), viewer(a), i(-1),
+      spatial(los != LOS_NONE)
 {
-    if (!valid(&menv[0]))
-        advance();
+    advance();
     begin_point = i;
 }
 
@@ -94,7 +129,9 @@ monster_near_iterator::operator bool() const
 
 monster* monster_near_iterator::operator*() const
 {
-    if (i < MAX_MONSTERS)
+    if (spatial)
+        return _box_monster(center, i);
+    else if (i < MAX_MONSTERS)
         return &menv[i];
     else
         return nullptr;
@@ -138,7 +175,7 @@ monster_near_iterator monster_near_iterator::begin()
 monster_near_iterator monster_near_iterator::end()
 {
     monster_near_iterator copy = *this;
-    copy.i = MAX_MONSTERS;
+    copy.i = spatial ? NEAR_BOX_CELLS : MAX_MONSTERS;
     return copy;
 }
 
@@ -153,10 +190,15 @@ bool monster_near_iterator::valid(const monster* a) const
 
 void monster_near_iterator::advance()
 {
+    const int limit = spatial ? NEAR_BOX_CELLS : env.mons_slot_watermark;
     do
-         if (++i >= MAX_MONSTERS)
+         if (++i >= limit)
+         {
+             if (!spatial)
+                 i = MAX_MONSTERS;
              return;
-    while (!valid(**this));
+         }
+    while ((!spatial && !env.mons_occupied[i]) || !valid(**this));
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -164,8 +206,13 @@ void monster_near_iterator::advance()
 monster_iterator::monster_iterator()
     : i(0)
 {
-    while (i < MAX_MONSTERS && !menv[i].alive())
+    while (i < env.mons_slot_watermark
+           && (!env.mons_occupied[i] || !menv[i].alive()))
+    {
         i++;
+    }
+    if (i >= env.mons_slot_watermark)
+        i = MAX_MONSTERS;
 }
 
 monster_iterator::operator bool() const
@@ -188,9 +235,12 @@ monster* monster_iterator::operator->() const
 
 monster_iterator& monster_iterator::operator++()
 {
-    while (++i < MAX_MONSTERS)
-        if (menv[i].alive())
-            break;
+    // The occupancy bitmap finds candidate slots without dragging each
+    // monster object into cache; alive() still has the final say.
+    while (++i < env.mons_slot_watermark)
+        if (env.mons_occupied[i] && menv[i].alive())
+            return *this;
+    i = MAX_MONSTERS;
     return *this;
 }
 
@@ -200,11 +250,3 @@ monster_iterator monster_iterator::operator++(int)
     ++(*this);
     return copy;
 }
-
-void monster_iterator::advance()
-{
-    do
-         if (++i >= MAX_MONSTERS)
-             return;
-    while (!(*this)->alive());
-}
@@ -23,7 +23,10 @@ protected:
     const coord_def center;
     los_type _los;
     const actor* viewer;
+    // -1 is the player; otherwise a cell of the box around center
+    // (spatial mode) or a menv slot (LOS_NONE, which is unbounded).
     int i;
+    bool spatial;
 
     bool valid(const actor* a) const;
     void advance();
@@ -49,8 +52,11 @@ protected:
     const coord_def center;
     los_type _los;
     const actor* viewer;
+    // A cell of the box around center (spatial mode) or a menv slot
+    // (LOS_NONE, which is unbounded).
     int i;
     int begin_point;
+    bool spatial;
 
     bool valid(const monster* a) const;
     void advance();
@@ -69,5 +75,4 @@ public:
 
 protected:
     int i;
-    void advance();
 };
@@ -19,6 +19,7 @@
 #include "mon-behv.h"
 #include "mon-death.h"
 #include "religion.h"
+#include "show.h"
 #include "stepdown.h"
 #include "stringutil.h"
 #include "terrain.h"
@@ -138,6 +139,12 @@ void actor::set_position(const coord_def &c)
     position = c;
     los_actor_moved(this, oldpos);
     areas_actor_moved(this, oldpos);
+    show_mark_dirty(oldpos);
+    show_mark_dirty(c);
+    // Movement changes the set of visible monsters tension is computed
+    // over; this covers placement too, since new actors get their
+    // position through here.
+    invalidate_tension_cache();
 }
 
 bool actor::can_hibernate(bool holi_only, bool intrinsic_only) const
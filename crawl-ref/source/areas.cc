@@ -48,8 +48,13 @@ struct area_centre
     area_centre_type type;
     coord_def centre;
     int radius;
+    // The actor whose aura this is, for incremental removal when it
+    // moves; MID_NOBODY for non-actor areas (orb, sunlight, ...).
+    mid_t source;
 
-    explicit area_centre (area_centre_type t, coord_def c, int r) : type(t), centre(c), radius(r) { }
+    explicit area_centre (area_centre_type t, coord_def c, int r,
+                          mid_t s = MID_NOBODY)
+        : type(t), centre(c), radius(r), source(s) { }
 };
 
 typedef FixedArray<areaprops, GXM, GYM> propgrid_t;
@@ -60,9 +65,34 @@ static propgrid_t _agrid;
 static bool _agrid_valid = false;
 static bool no_areas = false;
 
+// Matches the number of areaprop bits above.
+const int NUM_AREA_PROPS = 11;
+
+// One count plane per areaprop, so one source's circle can be
+// subtracted again when it moves without disturbing the flags that
+// overlapping sources keep alive.
+static FixedArray<uint16_t, GXM, GYM> _acount[NUM_AREA_PROPS];
+
+// The cells each actor-bound source currently contributes, for
+// incremental removal; filled while _area_source is set.
+typedef pair<coord_def, areaprop> area_cell;
+static map<mid_t, vector<area_cell>> _area_contrib;
+static mid_t _area_source = MID_NOBODY;
+
+static int _prop_index(areaprop f)
+{
+    int i = 0;
+    for (unsigned int v = (unsigned int)f; v > 1; v >>= 1)
+        ++i;
+    return i;
+}
+
 static void _set_agrid_flag(const coord_def& p, areaprop f)
 {
-    _agrid(p) |= f;
+    if (!_acount[_prop_index(f)](p)++)
+        _agrid(p) |= f;
+    if (_area_source != MID_NOBODY)
+        _area_contrib[_area_source].emplace_back(p, f);
 }
 
 static bool _check_agrid_flag(const coord_def& p, areaprop f)
@@ -70,6 +100,26 @@ static bool _check_agrid_flag(const coord_def& p, areaprop f)
     return bool(_agrid(p) & f);
 }
 
+// Take one source's circles back out of the area grid.
+static void _remove_source(mid_t source)
+{
+    auto it = _area_contrib.find(source);
+    if (it != _area_contrib.end())
+    {
+        for (const area_cell &c : it->second)
+        {
+            uint16_t &count = _acount[_prop_index(c.second)](c.first);
+            ASSERT(count > 0);
+            if (!--count)
+                _agrid(c.first) &= ~c.second;
+        }
+        _area_contrib.erase(it);
+    }
+
+    erase_if(_agrid_centres, [source](const area_centre &a)
+                             { return a.source == source; });
+}
+
 void invalidate_agrid(bool recheck_new)
 {
     _agrid_valid = false;
@@ -77,25 +127,53 @@ void invalidate_agrid(bool recheck_new)
         no_areas = false;
 }
 
+static void _actor_areas(actor *a);
+
 void areas_actor_moved(const actor* act, const coord_def& oldpos)
 {
-    if (act->alive() &&
-        (you.entering_level
-         || act->halo_radius() > -1 || act->silence_radius() > -1
-         || act->liquefying_radius() > -1 || act->umbra_radius() > -1))
+    UNUSED(oldpos);
+
+    if (!act->alive())
+        return;
+
+    if (you.entering_level)
     {
         // Not necessarily new, but certainly potentially interesting.
         invalidate_agrid(true);
+        return;
+    }
+
+    if (act->halo_radius() == -1 && act->silence_radius() == -1
+        && act->liquefying_radius() == -1 && act->umbra_radius() == -1)
+    {
+        return;
+    }
+
+    if (!_agrid_valid)
+    {
+        invalidate_agrid(true);
+        return;
     }
+
+    // Only this source's position changed, so move its circles instead
+    // of rebuilding every area on the level. (Anything else that can
+    // change an area's shape — LOS changes, enchantments running out,
+    // deaths — still goes through invalidate_agrid().)
+    _remove_source(act->mid);
+    _actor_areas(const_cast<actor *>(act));
 }
 
 static void _actor_areas(actor *a)
 {
+    // Record which cells this actor contributes, so a later move can
+    // subtract them again in _remove_source().
+    _area_source = a->mid;
+
     int r;
 
     if ((r = a->silence_radius()) >= 0)
     {
-        _agrid_centres.emplace_back(AREA_SILENCE, a->pos(), r);
+        _agrid_centres.emplace_back(AREA_SILENCE, a->pos(), r, a->mid);
 
         for (radius_iterator ri(a->pos(), r, C_SQUARE); ri; ++ri)
             _set_agrid_flag(*ri, areaprop::silence);
@@ -104,7 +182,7 @@ static void _actor_areas(actor *a)
 
     if ((r = a->halo_radius()) >= 0)
     {
-        _agrid_centres.emplace_back(AREA_HALO, a->pos(), r);
+        _agrid_centres.emplace_back(AREA_HALO, a->pos(), r, a->mid);
 
         for (radius_iterator ri(a->pos(), r, C_SQUARE, LOS_DEFAULT); ri; ++ri)
             _set_agrid_flag(*ri, areaprop::halo);
@@ -113,7 +191,7 @@ static void _actor_areas(actor *a)
 
     if ((r = a->liquefying_radius()) >= 0)
     {
-        _agrid_centres.emplace_back(AREA_LIQUID, a->pos(), r);
+        _agrid_centres.emplace_back(AREA_LIQUID, a->pos(), r, a->mid);
 
         for (radius_iterator ri(a->pos(), r, C_SQUARE, LOS_SOLID); ri; ++ri)
         {
@@ -129,12 +207,14 @@ static void _actor_areas(actor *a)
 
     if ((r = a->umbra_radius()) >= 0)
     {
-        _agrid_centres.emplace_back(AREA_UMBRA, a->pos(), r);
+        _agrid_centres.emplace_back(AREA_UMBRA, a->pos(), r, a->mid);
 
         for (radius_iterator ri(a->pos(), r, C_SQUARE, LOS_DEFAULT); ri; ++ri)
             _set_agrid_flag(*ri, areaprop::umbra);
         no_areas = false;
     }
+
+    _area_source = MID_NOBODY;
 }
 
 /**
@@ -152,6 +232,9 @@ static void _update_agrid()
     }
 
     _agrid.init(areaprops());
+    for (int i = 0; i < NUM_AREA_PROPS; ++i)
+        _acount[i].init(0);
+    _area_contrib.clear();
     _agrid_centres.clear();
 
     no_areas = true;
@@ -29,6 +29,7 @@
 #include "mon-pick.h"
 #include "mon-tentacle.h"
 #include "ng-init.h"
+#include "random.h"
 #include "spl-miscast.h"
 #include "state.h"
 #include "stringutil.h"
@@ -104,6 +105,15 @@ namespace arena
 
     static int turns       = 0;
 
+    // Headless batch mode (tag "headless"): skip per-turn redraws and
+    // delays, and append one CSV row per trial to arena.csv. With a
+    // "seed:n" tag each trial i is run under seed n+i, so a batch is
+    // reproducible trial by trial.
+    static bool headless    = false;
+    static bool seeded_batch = false;
+    static uint32_t batch_seed = 0;
+    static FILE *csv_file   = nullptr;
+
     static bool allow_summons       = true;
     static bool allow_animate       = true;
     static bool allow_chain_summons = true;
@@ -340,8 +350,20 @@ namespace arena
         name_monsters  = strip_tag(spec, "names");
         random_uniques = strip_tag(spec, "random_uniques");
 
+        headless = strip_tag(spec, "headless");
+
+        const int spec_seed = strip_number_tag(spec, "seed:");
+        if (spec_seed != TAG_UNFOUND)
+        {
+            seeded_batch = true;
+            batch_seed = (uint32_t)spec_seed;
+        }
+
+        // Headless batches exist to collect statistically meaningful
+        // samples, so they get a much higher trial cap.
         const int ntrials = strip_number_tag(spec, "t:");
-        if (ntrials != TAG_UNFOUND && ntrials >= 1 && ntrials <= 99
+        if (ntrials != TAG_UNFOUND && ntrials >= 1
+            && ntrials <= (headless ? 99999 : 99)
             && !total_trials)
         {
             total_trials = ntrials;
@@ -507,6 +529,8 @@ namespace arena
     static void setup_fight()
     {
         //no_messages mx;
+        if (seeded_batch)
+            seed_rng(batch_seed + trials_done);
         parse_monster_spec();
         setup_level();
 
@@ -784,7 +808,8 @@ namespace arena
 
     static void do_fight()
     {
-        viewwindow();
+        if (!headless)
+            viewwindow();
         clear_messages(true);
         {
             cursor_control coff(false);
@@ -808,7 +833,8 @@ namespace arena
                 if ((turns++ % 100) == 0)
                     count_foes();
 
-                viewwindow();
+                if (!headless)
+                    viewwindow();
                 you.time_taken = 10;
                 // Make sure we don't starve.
                 you.hunger = HUNGER_MAXIMUM;
@@ -818,12 +844,14 @@ namespace arena
                 do_respawn(faction_a);
                 do_respawn(faction_b);
                 balance_spawners();
-                delay(Options.view_delay);
+                if (!headless)
+                    delay(Options.view_delay);
                 clear_messages();
                 dump_messages();
                 ASSERT(you.pet_target == MHITNOT);
             }
-            viewwindow();
+            if (!headless)
+                viewwindow();
         }
 
         clear_messages();
@@ -880,6 +908,13 @@ namespace arena
         else if (faction_a.won)
             team_a_wins++;
 
+        if (csv_file != nullptr)
+        {
+            fprintf(csv_file, "%d,%s,%d\n", trials_done,
+                    was_tied ? "tie" : faction_a.won ? "a" : "b", turns);
+            fflush(csv_file);
+        }
+
         show_fight_banner(true);
 
         string msg;
@@ -931,6 +966,13 @@ namespace arena
             end(0, false, "Results file already open");
         file = fopen("arena.result", "w");
 
+        if (headless)
+        {
+            csv_file = fopen("arena.csv", "w");
+            if (csv_file != nullptr)
+                fprintf(csv_file, "trial,winner,turns\n");
+        }
+
         if (file != nullptr)
         {
             string spec = find_monster_spec();
@@ -956,8 +998,11 @@ namespace arena
     {
         if (file != nullptr)
             fclose(file);
+        if (csv_file != nullptr)
+            fclose(csv_file);
 
         file = nullptr;
+        csv_file = nullptr;
     }
 
     static void write_results()
@@ -1000,7 +1045,7 @@ namespace arena
             }
             do_fight();
 
-            if (trials_done < total_trials)
+            if (!headless && trials_done < total_trials)
                 delay(Options.view_delay * 5);
         }
         while (!contest_cancelled && trials_done < total_trials);
@@ -1012,7 +1057,8 @@ namespace arena
                  faction_b.desc.c_str(), trials_done - team_a_wins - ties,
                  ties);
         }
-        delay(Options.view_delay * 5);
+        if (!headless)
+            delay(Options.view_delay * 5);
 
         write_results();
     }
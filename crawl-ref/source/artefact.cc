@@ -14,6 +14,7 @@
 #include <cstdlib>
 #include <cstring>
 #include <functional>
+#include <map>
 
 #include "areas.h"
 #include "branch.h"
@@ -1052,24 +1053,50 @@ int artefact_property(const item_def &item, artefact_prop_type prop,
 
 int artefact_property(const item_def &item, artefact_prop_type prop)
 {
-    bool known;
+    ASSERT(is_artefact(item));
+
+    // Single-property queries run in every equipment scan, several per
+    // player turn; read the one entry instead of materialising all
+    // ART_PROPERTIES through artefact_properties(). The KNOWN_PROPS_KEY
+    // guard matches artefact_properties(), which reports all zeroes for
+    // an artefact whose props haven't been set up yet.
+    if (!item.props.exists(KNOWN_PROPS_KEY))
+        return 0;
+
+    if (item.props.exists(ARTEFACT_PROPS_KEY))
+    {
+        const CrawlVector &rap_vec =
+            item.props[ARTEFACT_PROPS_KEY].get_vector();
+        return rap_vec[prop].get_short();
+    }
 
-    return artefact_property(item, prop, known);
+    if (is_unrandom_artefact(item))
+    {
+        const unrandart_entry *unrand = _seekunrandart(item);
+        return static_cast<short>(unrand->prpty[prop]);
+    }
+
+    artefact_properties_t proprt;
+    proprt.init(0);
+    _get_randart_properties(item, proprt);
+    return proprt[prop];
 }
 
 int artefact_known_property(const item_def &item, artefact_prop_type prop)
 {
-    artefact_properties_t  proprt;
-    artefact_known_props_t known;
-    proprt.init(0);
-    known.init(0);
+    ASSERT(is_artefact(item));
+    if (!item.props.exists(KNOWN_PROPS_KEY))
+        return 0;
 
-    artefact_properties(item, proprt, known);
+    if (!item_ident(item, ISFLAG_KNOW_PROPERTIES))
+    {
+        const CrawlVector &known_vec =
+            item.props[KNOWN_PROPS_KEY].get_vector();
+        if (!known_vec[prop].get_bool())
+            return 0;
+    }
 
-    if (known[prop])
-        return proprt[prop];
-    else
-        return 0;
+    return artefact_property(item, prop);
 }
 
 static int _artefact_num_props(const artefact_properties_t &proprt)
@@ -1327,21 +1354,31 @@ const unrandart_entry* get_unrand_entry(int unrand_index)
         return &unranddata[unrand_index];
 }
 
+// Indices into unranddata of every non-dummy entry, grouped by
+// base_type. Built once on first use, so generation-time scans only
+// walk entries of the class they could actually pick.
+static const vector<int>& _unrands_of_class(uint8_t aclass)
+{
+    static map<uint8_t, vector<int>> buckets;
+    if (buckets.empty())
+        for (int i = 0; i < NUM_UNRANDARTS; i++)
+            if (unranddata[i].base_type != OBJ_UNASSIGNED)
+                buckets[unranddata[i].base_type].push_back(i);
+    return buckets[aclass];
+}
+
 int find_okay_unrandart(uint8_t aclass, uint8_t atype, bool in_abyss)
 {
     int ret = -1;
+    int count = 0;
 
     // Pick randomly among not-yet-existing unrandarts with the proper
     // base_type and sub_type.
-    for (int i = 0, count = 0; i < NUM_UNRANDARTS; i++)
+    for (int i : _unrands_of_class(aclass))
     {
         const int              index = i + UNRAND_START;
         const unrandart_entry* entry = &unranddata[i];
 
-        // Skip dummy entries.
-        if (entry->base_type == OBJ_UNASSIGNED)
-            continue;
-
         const unique_item_status_type status =
             get_unique_item_status(index);
 
@@ -1358,8 +1395,7 @@ int find_okay_unrandart(uint8_t aclass, uint8_t atype, bool in_abyss)
             continue;
         }
 
-        if (entry->base_type != aclass
-            || atype != OBJ_RANDOM && entry->sub_type != atype
+        if (atype != OBJ_RANDOM && entry->sub_type != atype
                // Acquirement.
                && (aclass != OBJ_WEAPONS
                    || item_attack_skill(entry->base_type, atype) !=
@@ -1381,26 +1417,43 @@ int find_okay_unrandart(uint8_t aclass, uint8_t atype, bool in_abyss)
     return ret;
 }
 
-int get_unrandart_num(const char *name)
+static string _normalise_unrand_name(const string &name)
 {
-    string uname = name;
-    uname = replace_all(uname, " ", "_");
-    uname = replace_all(uname, "'", "");
-    lowercase(uname);
-    string quoted = "\"";
-    quoted += uname;
-    quoted += "\"";
+    string art = replace_all(name, " ", "_");
+    art = replace_all(art, "'", "");
+    lowercase(art);
+    return art;
+}
 
-    for (unsigned int i = 0; i < ARRAYSZ(unranddata); ++i)
+int get_unrandart_num(const char *name)
+{
+    // Normalised name -> unrand index, built once from unranddata.
+    // Quoted nicknames within a name are indexed too, so "bloodbane"
+    // still finds the axe. insert() keeps the first entry on a key
+    // clash, matching the old first-match scan.
+    static map<string, int> name_index;
+    if (name_index.empty())
     {
-        string art = unranddata[i].name;
-        art = replace_all(art, " ", "_");
-        art = replace_all(art, "'", "");
-        lowercase(art);
-        if (art == uname || art.find(quoted) != string::npos)
-            return UNRAND_START + i;
+        for (unsigned int i = 0; i < ARRAYSZ(unranddata); ++i)
+        {
+            const string art = _normalise_unrand_name(unranddata[i].name);
+            name_index.insert(make_pair(art, UNRAND_START + i));
+
+            size_t q1 = art.find('"');
+            while (q1 != string::npos)
+            {
+                const size_t q2 = art.find('"', q1 + 1);
+                if (q2 == string::npos)
+                    break;
+                name_index.insert(make_pair(art.substr(q1 + 1, q2 - q1 - 1),
+                                            UNRAND_START + i));
+                q1 = art.find('"', q2 + 1);
+            }
+        }
     }
-    return SPWPN_NORMAL;
+
+    const int *idx = map_find(name_index, _normalise_unrand_name(name));
+    return idx ? *idx : SPWPN_NORMAL;
 }
 
 static bool _randart_is_redundant(const item_def &item,
@@ -1823,6 +1876,10 @@ void artefact_set_property(item_def          &item,
     ASSERT(rap_vec.get_max_size() == ART_PROPERTIES);
 
     rap_vec[prop].get_short() = val;
+
+    // The item may be equipped (save-upgrade fixups run on loaded
+    // inventories), so the aggregated equipment sums may be stale now.
+    invalidate_equip_property_cache();
 }
 
 template<typename Z>
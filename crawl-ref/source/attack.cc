@@ -1280,7 +1280,11 @@ int attack::calc_damage()
 
         damage = apply_damage_modifiers(damage, damage_max);
 
-        set_attack_verb(damage);
+        // The flavour verb is only ever read when a hit message is
+        // printed; skip the string building (and its random rolls)
+        // for attacks nobody can see.
+        if (needs_message)
+            set_attack_verb(damage);
         return apply_defender_ac(damage, damage_max);
     }
     else
@@ -1311,7 +1315,8 @@ int attack::calc_damage()
         damage = apply_defender_ac(damage);
 
         damage = max(0, damage);
-        set_attack_verb(damage);
+        if (needs_message)
+            set_attack_verb(damage);
 
         return damage;
     }
@@ -23,6 +23,7 @@
 #include "mon-death.h"
 #include "mon-tentacle.h"
 #include "religion.h"
+#include "show.h"
 #include "state.h"
 #include "travel.h"
 
@@ -30,6 +31,11 @@
 // temporarily.
 void mons_att_changed(monster* mon)
 {
+    // Friendliness determines whether a monster counts for tension,
+    // and attitude recolours the monster's glyph.
+    invalidate_tension_cache();
+    show_mark_dirty(mon->pos());
+
     const mon_attitude_type att = mon->temp_attitude();
     const monster_type mc = mons_base_type(*mon);
 
@@ -41,6 +41,7 @@
 #include "libutil.h"
 #include "losglobal.h"
 #include "los.h"
+#include "macro.h"
 #include "message.h"
 #include "misc.h"
 #include "mon-behv.h"
@@ -153,6 +154,15 @@ kill_category bolt::whose_kill() const
     return KC_OTHER;
 }
 
+// True if the player has already queued further input, in which case
+// per-cell animation delays would only hold up the command they have
+// already decided on. The glyphs and tile overlays are still placed, so
+// a collapsed animation shows the full path in a single frame.
+static bool _input_queued()
+{
+    return kbhit() || has_pending_input();
+}
+
 // A simple animated flash from Rupert Smith (expanded to be more
 // generic).
 static void _zap_animation(int colour, const monster* mon = nullptr,
@@ -184,9 +194,11 @@ static void _zap_animation(int colour, const monster* mon = nullptr,
         put_colour_ch(colour, dchar_glyph(DCHAR_FIRED_ZAP));
 #endif
 
-        update_screen();
-
-        scaled_delay(50);
+        if (!_input_queued())
+        {
+            update_screen();
+            scaled_delay(50);
+        }
     }
 }
 
@@ -702,8 +714,22 @@ void bolt::apply_beam_conducts()
 
 void bolt::choose_ray()
 {
-    if ((!chose_ray || reflections > 0)
-        && !find_ray(source, target, ray, opc_solid_see)
+    if (chose_ray && reflections <= 0)
+        return;
+
+    // A real firing normally repeats the exact shot its tracer just
+    // traced; reuse the ray the tracer picked instead of searching
+    // again, as long as the aim hasn't changed in between. Nothing can
+    // alter the terrain between the two firings.
+    if (!is_tracer && tracer_ray_valid && reflections <= 0 && bounces <= 0
+        && source == tracer_ray_source && target == tracer_ray_target)
+    {
+        ray = tracer_ray;
+        tracer_ray_valid = false;
+        return;
+    }
+
+    if (!find_ray(source, target, ray, opc_solid_see)
         // If fire is blocked, at least try a visible path so the
         // error message is better.
         && !find_ray(source, target, ray, opc_default))
@@ -743,7 +769,12 @@ void bolt::draw(const coord_def& p)
     put_colour_ch(colour == BLACK ? random_colour(true)
                                   : element_colour(colour),
                   glyph);
+#endif
+
+    if (_input_queued())
+        return;
 
+#ifndef USE_TILE_LOCAL
     // Get curses to update the screen so we can see the beam.
     update_screen();
 #endif
@@ -1102,6 +1133,15 @@ void bolt::do_fire()
     if (!aimed_at_feet)
     {
         choose_ray();
+        if (is_tracer)
+        {
+            // Save the chosen ray for the real firing that usually
+            // follows; these members deliberately survive _undo_tracer.
+            tracer_ray        = ray;
+            tracer_ray_source = source;
+            tracer_ray_target = target;
+            tracer_ray_valid  = true;
+        }
         // Take *one* step, so as not to hurt the source.
         ray.advance();
     }
@@ -5811,6 +5851,56 @@ int explosion_noise(int rad)
 }
 
 #define MAX_EXPLOSION_RADIUS 9
+
+// The cost-propagation rules of determine_affected_cells(), minus all
+// the terrain checks, for precomputing open-ground footprints.
+static void _fill_open_explosion_map(explosion_map &m, const coord_def &delta,
+                                     int count, int r)
+{
+    const coord_def centre(9,9);
+
+    if (delta.rdist() > centre.rdist() || delta.rdist() > r || count > 10*r)
+        return;
+
+    m(delta + centre) = min(count, m(delta + centre));
+
+    for (int i = 0; i < 8; ++i)
+    {
+        const coord_def new_delta = delta + Compass[i];
+
+        if (new_delta.rdist() > centre.rdist())
+            continue;
+
+        if (m(new_delta + centre) <= count)
+            continue;
+
+        int cadd = 5;
+        if (delta.rdist() == 1 && new_delta.rdist() == 1)
+            cadd = 0;
+        else if (delta.x * Compass[i].x < 0 || delta.y * Compass[i].y < 0)
+            cadd = 17;
+
+        _fill_open_explosion_map(m, new_delta, count + cadd, r);
+    }
+}
+
+// On open ground the footprint of an explosion only depends on its
+// radius, so compute each radius once and reuse it; a fire storm turn
+// runs many overlapping explosions over mostly clear floor.
+static const explosion_map &_open_explosion_map(int r)
+{
+    ASSERT_RANGE(r, 0, MAX_EXPLOSION_RADIUS + 1);
+    static explosion_map cache[MAX_EXPLOSION_RADIUS + 1];
+    static bool cached[MAX_EXPLOSION_RADIUS + 1];
+    if (!cached[r])
+    {
+        cache[r].init(INT_MAX);
+        _fill_open_explosion_map(cache[r], coord_def(), 0, r);
+        cached[r] = true;
+    }
+    return cache[r];
+}
+
 // Returns true if we saw something happening.
 bool bolt::explode(bool show_more, bool hole_in_the_middle)
 {
@@ -5877,10 +5967,31 @@ bool bolt::explode(bool show_more, bool hole_in_the_middle)
             mprf(MSGCH_SOUND, "%s", explode_noise_msg.c_str());
     }
 
-    // Run DFS to determine which cells are influenced
+    // If nothing within range could block or contain the explosion, the
+    // footprint is the precomputed open-ground one; otherwise run the
+    // DFS to determine which cells are influenced.
+    bool open_ground = true;
+    for (int x = -r; x <= r && open_ground; ++x)
+        for (int y = -r; y <= r; ++y)
+        {
+            const coord_def loc = pos() + coord_def(x, y);
+            if (!map_bounds(loc)
+                || feat_is_solid(grd(loc))
+                || is_sanctuary(loc) && flavour != BEAM_VISUAL)
+            {
+                open_ground = false;
+                break;
+            }
+        }
+
     explosion_map exp_map;
-    exp_map.init(INT_MAX);
-    determine_affected_cells(exp_map, coord_def(), 0, r, true, true);
+    if (open_ground)
+        exp_map = _open_explosion_map(r);
+    else
+    {
+        exp_map.init(INT_MAX);
+        determine_affected_cells(exp_map, coord_def(), 0, r, true, true);
+    }
 
     // We get a bit fancy, drawing all radius 0 effects, then radius
     // 1, radius 2, etc. It looks a bit better that way.
@@ -5901,7 +6012,7 @@ bool bolt::explode(bool show_more, bool hole_in_the_middle)
                 if (exp_map(delta + centre) < INT_MAX)
                     pass_visible |= explosion_draw_cell(delta + pos());
             }
-            if (pass_visible)
+            if (pass_visible && !_input_queued())
             {
                 update_screen();
                 scaled_delay(explode_delay);
@@ -5909,30 +6020,35 @@ bool bolt::explode(bool show_more, bool hole_in_the_middle)
         }
     }
 
-    // Affect pass.
+    // Affect pass. Explosions can wipe out a whole pack at once, so
+    // resolve the deaths as one batch (a single forced redraw at the
+    // end rather than one per corpse).
     int cells_seen = 0;
-    for (const auto &line : sweep)
     {
-        for (const coord_def delta : line)
+        const death_batch batch;
+        for (const auto &line : sweep)
         {
-            if (delta.origin() && hole_in_the_middle)
-                continue;
-
-            if (exp_map(delta + centre) < INT_MAX)
+            for (const coord_def delta : line)
             {
-                if (you.see_cell(delta + pos()))
-                    ++cells_seen;
+                if (delta.origin() && hole_in_the_middle)
+                    continue;
 
-                explosion_affect_cell(delta + pos());
+                if (exp_map(delta + centre) < INT_MAX)
+                {
+                    if (you.see_cell(delta + pos()))
+                        ++cells_seen;
+
+                    explosion_affect_cell(delta + pos());
 
-                if (beam_cancelled) // don't spam prompts
-                    return false;
+                    if (beam_cancelled) // don't spam prompts
+                        return false;
+                }
             }
         }
     }
 
     // Delay after entire explosion has been drawn.
-    if (!is_tracer && cells_seen > 0 && show_more)
+    if (!is_tracer && cells_seen > 0 && show_more && !_input_queued())
         scaled_delay(explode_delay * 3);
 
     return cells_seen > 0;
@@ -6039,12 +6155,13 @@ void bolt::determine_affected_cells(explosion_map& m, const coord_def& delta,
             continue;
 
         // If we were at a wall, only move to visible squares.
-        coord_def caster_pos = actor_by_mid(source_id) ?
-                                   actor_by_mid(source_id)->pos() :
-                                   you.pos();
-
-        if (at_wall && !cell_see_cell(caster_pos, loc + Compass[i], LOS_NO_TRANS))
-            continue;
+        if (at_wall)
+        {
+            const actor *caster = actor_by_mid(source_id);
+            const coord_def caster_pos = caster ? caster->pos() : you.pos();
+            if (!cell_see_cell(caster_pos, loc + Compass[i], LOS_NO_TRANS))
+                continue;
+        }
 
         int cadd = 5;
         // Circling around the center is always free.
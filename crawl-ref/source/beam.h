@@ -151,6 +151,13 @@ struct bolt
 
     ray_def     ray;             // shoot on this specific ray
 
+    // Ray chosen by the most recent tracer firing, for reuse by the
+    // real firing that usually follows (see bolt::choose_ray()).
+    ray_def     tracer_ray;
+    coord_def   tracer_ray_source = {0,0}; // aim tracer_ray was chosen for
+    coord_def   tracer_ray_target = {0,0};
+    bool        tracer_ray_valid = false;
+
     int         tile_beam; // only used if USE_TILE is defined
 
 private:
@@ -69,6 +69,14 @@ bit_vector& bit_vector::operator &= (const bit_vector& other)
     return *this;
 }
 
+void bit_vector::ior_and(const bit_vector& a, const bit_vector& b)
+{
+    ASSERT(size == a.size);
+    ASSERT(size == b.size);
+    for (int w = 0; w < nwords; ++w)
+        data[w] |= a.data[w] & b.data[w];
+}
+
 bit_vector bit_vector::operator & (const bit_vector& other) const
 {
     ASSERT(size == other.size);
@@ -9,6 +9,7 @@
 #pragma once
 
 #include <bitset>
+#include <cstring>
 
 #include "defines.h"
 
@@ -28,6 +29,17 @@ public:
     bit_vector& operator &= (const bit_vector& other);
     bit_vector  operator & (const bit_vector& other) const;
 
+    // Fused *this |= (a & b), without allocating a temporary.
+    void ior_and(const bit_vector& a, const bit_vector& b);
+
+    // Word-level access for batch scans.
+    int words() const { return nwords; }
+    unsigned long word(int w) const
+    {
+        ASSERT(w >= 0 && w < nwords);
+        return data[w];
+    }
+
 protected:
     unsigned long size;
     int nwords;
@@ -107,21 +119,29 @@ public:
     }
 };
 
+// Grid-sized bit masks, stored as a flat word array rather than a
+// bitset so that mask algebra (AND/OR/ANDNOT) and scans for set bits
+// can run a machine word — and, with a vectorising compiler, several
+// words — at a time.
 template <unsigned int SIZEX, unsigned int SIZEY> class FixedBitArray
 {
 protected:
-    std::bitset<SIZEX*SIZEY> data;
+    static const unsigned int NBITS = SIZEX * SIZEY;
+    static const unsigned int NWORDS = (NBITS + LONGSIZE - 1) / LONGSIZE;
+    unsigned long data[NWORDS];
 public:
     void reset()
     {
-        data.reset();
+        memset(data, 0, sizeof(data));
     }
 
     void init(bool def)
     {
-        data.reset();
-        if (def)
-            data.flip();
+        memset(data, def ? 0xFF : 0, sizeof(data));
+        // Keep the unused bits of the last word clear, so word-level
+        // scans never see phantom cells past the end of the grid.
+        if (def && NBITS % LONGSIZE)
+            data[NWORDS - 1] &= (1UL << (NBITS % LONGSIZE)) - 1;
     }
 
     FixedBitArray()
@@ -142,7 +162,7 @@ public:
             die("bit array range error: %d,%d / %u,%u", x, y, SIZEX, SIZEY);
 #endif
         unsigned int i = y * SIZEX + x;
-        return data[i];
+        return data[i / LONGSIZE] & (1UL << (i % LONGSIZE));
     }
 
     template<class Indexer> inline bool get(const Indexer &i) const
@@ -167,7 +187,10 @@ public:
             die("bit array range error: %d,%d / %u,%u", x, y, SIZEX, SIZEY);
 #endif
         unsigned int i = y * SIZEX + x;
-        data[i] = value;
+        if (value)
+            data[i / LONGSIZE] |= 1UL << (i % LONGSIZE);
+        else
+            data[i / LONGSIZE] &= ~(1UL << (i % LONGSIZE));
     }
 
     template<class Indexer> inline void set(const Indexer &i, bool value = true)
@@ -177,13 +200,89 @@ public:
 
     inline FixedBitArray<SIZEX, SIZEY>& operator|=(const FixedBitArray<SIZEX, SIZEY>&x)
     {
-        data |= x.data;
+        for (unsigned int w = 0; w < NWORDS; w++)
+            data[w] |= x.data[w];
         return *this;
     }
 
     inline FixedBitArray<SIZEX, SIZEY>& operator&=(const FixedBitArray<SIZEX, SIZEY>&x)
     {
-        data &= x.data;
+        for (unsigned int w = 0; w < NWORDS; w++)
+            data[w] &= x.data[w];
         return *this;
     }
+
+    // *this &= ~x, without a temporary for the complement.
+    inline FixedBitArray<SIZEX, SIZEY>& andnot(const FixedBitArray<SIZEX, SIZEY>&x)
+    {
+        for (unsigned int w = 0; w < NWORDS; w++)
+            data[w] &= ~x.data[w];
+        return *this;
+    }
+
+    inline FixedBitArray<SIZEX, SIZEY> operator&(const FixedBitArray<SIZEX, SIZEY>&x) const
+    {
+        FixedBitArray<SIZEX, SIZEY> result;
+        for (unsigned int w = 0; w < NWORDS; w++)
+            result.data[w] = data[w] & x.data[w];
+        return result;
+    }
+
+    inline FixedBitArray<SIZEX, SIZEY> operator|(const FixedBitArray<SIZEX, SIZEY>&x) const
+    {
+        FixedBitArray<SIZEX, SIZEY> result;
+        for (unsigned int w = 0; w < NWORDS; w++)
+            result.data[w] = data[w] | x.data[w];
+        return result;
+    }
+
+    inline bool any() const
+    {
+        for (unsigned int w = 0; w < NWORDS; w++)
+            if (data[w])
+                return true;
+        return false;
+    }
+
+    // Index of the first set bit at or after position i, or -1 if there
+    // is none. Indices are y * SIZEX + x, matching set(x, y), so scans
+    // over the set bits of a mask skip empty words instead of testing
+    // every cell:
+    //
+    //     for (int i = mask.next_set(); i >= 0; i = mask.next_set(i + 1))
+    //         coord_def c(i % SIZEX, i / SIZEX);
+    inline int next_set(unsigned int i = 0) const
+    {
+        if (i >= NBITS)
+            return -1;
+
+        unsigned int w = i / LONGSIZE;
+        unsigned long bits = data[w] & (ULONG_MAX << (i % LONGSIZE));
+        while (!bits)
+        {
+            if (++w >= NWORDS)
+                return -1;
+            bits = data[w];
+        }
+
+#ifdef __GNUC__
+        return w * LONGSIZE + __builtin_ctzl(bits);
+#else
+        int b = 0;
+        while (!(bits & 1UL))
+        {
+            bits >>= 1;
+            b++;
+        }
+        return w * LONGSIZE + b;
+#endif
+    }
+
+    // Word-level access for batch scans, as in bit_vector.
+    int words() const { return NWORDS; }
+    unsigned long word(int w) const
+    {
+        ASSERT(w >= 0 && w < (int)NWORDS);
+        return data[w];
+    }
 };
@@ -193,22 +193,37 @@ bool is_connected_branch(level_id place)
     return is_connected_branch(place.branch);
 }
 
+// Name lookups used to walk the branch table comparing strings per
+// call; the speech prefix classifier does such a lookup for every
+// prefix it probes, and level specs are parsed all over the level
+// compiler. The branch table is immutable, so build each reverse map
+// once.
 branch_type branch_by_abbrevname(const string &branch, branch_type err)
 {
-    for (branch_iterator it; it; ++it)
-        if (it->abbrevname && it->abbrevname == branch)
-            return it->id;
+    static map<string, branch_type> abbrev_map;
+    if (abbrev_map.empty())
+    {
+        for (branch_iterator it; it; ++it)
+            if (it->abbrevname)
+                abbrev_map[it->abbrevname] = it->id;
+    }
 
-    return err;
+    auto found = abbrev_map.find(branch);
+    return found == abbrev_map.end() ? err : found->second;
 }
 
 branch_type branch_by_shortname(const string &branch)
 {
-    for (branch_iterator it; it; ++it)
-        if (it->shortname && it->shortname == branch)
-            return it->id;
+    static map<string, branch_type> shortname_map;
+    if (shortname_map.empty())
+    {
+        for (branch_iterator it; it; ++it)
+            if (it->shortname)
+                shortname_map[it->shortname] = it->id;
+    }
 
-    return NUM_BRANCHES;
+    auto found = shortname_map.find(branch);
+    return found == shortname_map.end() ? NUM_BRANCHES : found->second;
 }
 
 int ambient_noise(branch_type branch)
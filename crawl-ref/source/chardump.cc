@@ -88,7 +88,7 @@ static void _sdump_separator(dump_params &);
 #ifdef CLUA_BINDINGS
 static void _sdump_lua(dump_params &);
 #endif
-static bool _write_dump(const string &fname, const dump_params &,
+static bool _write_dump(const string &fname, dump_params &,
                         bool print_dump_path = false);
 
 struct dump_section_handler
@@ -185,7 +185,8 @@ static dump_params _get_dump(bool full_id = false,
 bool dump_char(const string &fname, bool quiet, bool full_id,
                const scorefile_entry *se)
 {
-    return _write_dump(fname, _get_dump(full_id, se), quiet);
+    dump_params par("", full_id, se);
+    return _write_dump(fname, par, quiet);
 }
 
 static void _sdump_header(dump_params &par)
@@ -1626,7 +1627,11 @@ void dump_map(const char* fname, bool debug, bool dist)
     fclose(fp);
 }
 
-static bool _write_dump(const string &fname, const dump_params &par, bool quiet)
+// Generates the dump a section at a time into par's (reused) buffer and
+// streams each section to the morgue file as it completes, so peak memory
+// stays one section rather than the whole dump. Sections that need the
+// full text in memory should go through _get_dump() instead.
+static bool _write_dump(const string &fname, dump_params &par, bool quiet)
 {
     bool succeeded = false;
 
@@ -1651,7 +1656,13 @@ static bool _write_dump(const string &fname, const dump_params &par, bool quiet)
 
     if (handle != nullptr)
     {
-        fputs(OUTS(par.text), handle);
+        for (const string &section : Options.dump_order)
+        {
+            par.section = section;
+            par.text.clear();
+            dump_section(par);
+            fputs(OUTS(par.text), handle);
+        }
         fclose(handle);
         succeeded = true;
         if (!quiet)
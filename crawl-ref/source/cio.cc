@@ -89,17 +89,25 @@ int unmangle_direction_keys(int keyin, KeymapContext keymap,
         /* can we say yuck? -- haranp */
         if (keyin == '*')
         {
-            unwind_cursor saved(1, crawl_view.msgsz.y, GOTO_MSG);
-            cprintf("CTRL");
-            keyin = getchm(keymap);
+            {
+                unwind_cursor saved(1, crawl_view.msgsz.y, GOTO_MSG);
+                cprintf("CTRL");
+                keyin = getchm(keymap);
+            }
+            // Wipe the modifier hint off the last message row.
+            display_message_window();
             // return control-key
             keyin = CONTROL(toupper(_numpad2vi(keyin)));
         }
         else if (keyin == '/')
         {
-            unwind_cursor saved(1, crawl_view.msgsz.y, GOTO_MSG);
-            cprintf("SHIFT");
-            keyin = getchm(keymap);
+            {
+                unwind_cursor saved(1, crawl_view.msgsz.y, GOTO_MSG);
+                cprintf("SHIFT");
+                keyin = getchm(keymap);
+            }
+            // Wipe the modifier hint off the last message row.
+            display_message_window();
             // return shift-key
             keyin = toupper(_numpad2vi(keyin));
         }
@@ -32,6 +32,7 @@
 #include "nearby-danger.h" // Compass (for random_walk, CloudGenerator)
 #include "religion.h"
 #include "shout.h"
+#include "show.h"
 #include "spl-util.h"
 #include "state.h"
 #include "stringutil.h"
@@ -41,7 +42,35 @@
 
 cloud_struct* cloud_at(coord_def pos)
 {
-    return map_find(env.cloud, pos);
+    if (!in_bounds(pos))
+        return nullptr;
+    return env.cloud_grid(pos);
+}
+
+// Access the cloud at pos, inserting an entry if there is none, and
+// keep the lookup grid pointing at the map entry. Map nodes don't move,
+// so the pointer stays good until the entry is erased. All writes to
+// env.cloud must go through this, _erase_cloud() or reload_cloud_grid().
+static cloud_struct& _cloud_ref(const coord_def& pos)
+{
+    cloud_struct& c = env.cloud[pos];
+    env.cloud_grid(pos) = &c;
+    return c;
+}
+
+static void _erase_cloud(const coord_def& pos)
+{
+    env.cloud_grid(pos) = nullptr;
+    env.cloud.erase(pos);
+}
+
+// Repopulate the lookup grid after env.cloud has been edited wholesale
+// (level load, level build).
+void reload_cloud_grid()
+{
+    env.cloud_grid.init(nullptr);
+    for (auto& entry : env.cloud)
+        env.cloud_grid(entry.first) = &entry.second;
 }
 
 /// damage = base + random2avg(random, random/15 + 1)
@@ -360,6 +389,7 @@ static bool _killer_whose_match(kill_category whose, killer_type killer)
  */
 static void _los_cloud_changed(const coord_def& p, const cloud_type t, const cloud_type old)
 {
+    show_mark_dirty(p);
     if (is_opaque_cloud(t) || is_opaque_cloud(old))
         los_terrain_changed(p);
 }
@@ -402,10 +432,11 @@ static int _spread_cloud(const cloud_struct &cloud)
         if (newdecay >= cloud.decay)
             newdecay = cloud.decay - 1;
 
-        env.cloud[*ai] = cloud;
-        env.cloud[*ai].pos = *ai;
-        env.cloud[*ai].decay = newdecay;
-        _los_cloud_changed(env.cloud[*ai].pos, env.cloud[*ai].type, CLOUD_NONE);
+        cloud_struct &newc = _cloud_ref(*ai);
+        newc = cloud;
+        newc.pos = *ai;
+        newc.decay = newdecay;
+        _los_cloud_changed(newc.pos, newc.type, CLOUD_NONE);
 
         extra_decay += 8;
     }
@@ -429,10 +460,11 @@ static void _spread_fire(const cloud_struct &cloud)
         // burning trees produce flames all around
         if (!cell_is_solid(*ai) && make_flames)
         {
-            env.cloud[*ai] = cloud;
-            env.cloud[*ai].type = CLOUD_FIRE;
-            env.cloud[*ai].pos = *ai;
-            env.cloud[*ai].decay = cloud.decay / 2 + 1;
+            cloud_struct &newc = _cloud_ref(*ai);
+            newc = cloud;
+            newc.type = CLOUD_FIRE;
+            newc.pos = *ai;
+            newc.decay = cloud.decay / 2 + 1;
         }
 
         // forest fire doesn't spread in all directions at once,
@@ -446,9 +478,10 @@ static void _spread_fire(const cloud_struct &cloud)
         if (you.see_cell(*ai))
             mpr("The forest fire spreads!");
         destroy_wall(*ai);
-        env.cloud[*ai] = cloud;
-        env.cloud[*ai].pos = *ai;
-        env.cloud[*ai].decay = random2(30) + 25;
+        cloud_struct &firec = _cloud_ref(*ai);
+        firec = cloud;
+        firec.pos = *ai;
+        firec.decay = random2(30) + 25;
         if (cloud.whose == KC_YOU)
             did_god_conduct(DID_KILL_PLANT, 1);
         else if (cloud.whose == KC_FRIENDLY && !crawl_state.game_is_arena())
@@ -472,9 +505,9 @@ static void _cloud_interacts_with_terrain(const cloud_struct &cloud)
             && one_chance_in(14))
         {
             const cloud_type old = cloud_type_at(p);
-            env.cloud[p] = cloud_struct(p, CLOUD_STEAM, 2 + random2(5),
-                                        11, cloud.whose, cloud.killer,
-                                        cloud.source, -1);
+            _cloud_ref(p) = cloud_struct(p, CLOUD_STEAM, 2 + random2(5),
+                                         11, cloud.whose, cloud.killer,
+                                         cloud.source, -1);
             _los_cloud_changed(p, env.cloud[p].type, old);
         }
     }
@@ -510,6 +543,8 @@ static void _dissipate_cloud(cloud_struct& cloud)
 {
     // Apply calculated rate to the actual cloud.
     cloud.decay -= _cloud_dissipation_rate(cloud);
+    // Decay drives the displayed cloud density.
+    show_mark_dirty(cloud.pos);
 
     if (cloud.type == CLOUD_FOREST_FIRE)
         _spread_fire(cloud);
@@ -641,7 +676,7 @@ void delete_cloud(coord_def p)
     if (!cloud_at(p))
         return;
     const cloud_type type = cloud_at(p)->type;
-    env.cloud.erase(p);
+    _erase_cloud(p);
     if (type == CLOUD_RAIN)
         _maybe_leave_water(p);
     _los_cloud_changed(p, CLOUD_NONE, type);
@@ -669,11 +704,12 @@ void move_cloud(coord_def src, coord_def newpos)
 
     const cloud_type old = cloud_type_at(newpos);
 
-    env.cloud[newpos] = env.cloud[src];
-    env.cloud.erase(src);
-    env.cloud[newpos].pos = newpos;
-    _los_cloud_changed(src, CLOUD_NONE, env.cloud[newpos].type);
-    _los_cloud_changed(newpos, env.cloud[newpos].type, old);
+    cloud_struct &newc = _cloud_ref(newpos);
+    newc = env.cloud[src];
+    _erase_cloud(src);
+    newc.pos = newpos;
+    _los_cloud_changed(src, CLOUD_NONE, newc.type);
+    _los_cloud_changed(newpos, newc.type, old);
 }
 
 void swap_clouds(coord_def p1, coord_def p2)
@@ -763,9 +799,9 @@ void place_cloud(cloud_type cl_type, const coord_def& ctarget, int cl_range,
 
     const int spread_rate = _actual_spread_rate(cl_type, _spread_rate);
 
-    env.cloud[ctarget] = cloud_struct(ctarget, cl_type, cl_range * 10,
-                                      spread_rate, whose, killer, source,
-                                      excl_rad);
+    _cloud_ref(ctarget) = cloud_struct(ctarget, cl_type, cl_range * 10,
+                                       spread_rate, whose, killer, source,
+                                       excl_rad);
     _los_cloud_changed(ctarget, env.cloud[ctarget].type, old);
 }
 
@@ -19,6 +19,7 @@ struct cloud_tile_info
 };
 
 cloud_struct* cloud_at(coord_def pos);
+void reload_cloud_grid();
 
 cloud_type cloud_type_at(const coord_def &pos);
 bool cloud_is_yours_at(const coord_def &pos);
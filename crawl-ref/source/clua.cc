@@ -57,7 +57,8 @@ CLua::CLua(bool managed)
       throttle_sleep_end(800), n_throttle_sleeps(0), mixed_call_depth(0),
       lua_call_depth(0), max_mixed_call_depth(8),
       max_lua_call_depth(100), memory_used(0),
-      _state(nullptr), sourced_files(), uniqindex(0)
+      _state(nullptr), sourced_files(), uniqindex(0),
+      chunk_gen(0), hook_cache_gen(-1)
 {
 }
 
@@ -84,6 +85,7 @@ lua_State *CLua::state()
 void CLua::setglobal(const char *name)
 {
     lua_setglobal(state(), name);
+    chunk_gen++;
 }
 
 void CLua::getglobal(const char *name)
@@ -277,6 +279,7 @@ int CLua::execstring(const char *s, const char *context, int nresults)
     lua_call_throttle strangler(this);
     err = lua_pcall(ls, 0, nresults, 0);
     set_error(err, ls);
+    chunk_gen++;
     return err;
 }
 
@@ -288,6 +291,26 @@ bool CLua::is_path_safe(string s, bool trusted)
            && (trusted || s.find("dlua") != 0);
 }
 
+// Chunks already compiled this process, keyed by resolved path. One
+// session compiles the same bundled libraries into several Lua states
+// (clua and dlua, plus re-sourcing after an rc re-read), and replaying
+// the dumped bytecode skips both the disk read and the parse. The
+// modtime guards against an included user file being edited mid-session.
+struct compiled_chunk
+{
+    string bytecode;
+    time_t mtime;
+};
+static map<string, compiled_chunk> _compiled_chunks;
+
+static int _chunk_writer(lua_State *, const void *chunk, size_t size,
+                         void *bytecode)
+{
+    static_cast<string *>(bytecode)->append(static_cast<const char *>(chunk),
+                                            size);
+    return 0;
+}
+
 int CLua::loadfile(lua_State *ls, const char *filename, bool trusted,
                    bool die_on_fail)
 {
@@ -310,14 +333,34 @@ int CLua::loadfile(lua_State *ls, const char *filename, bool trusted,
         return -1;
     }
 
+    const time_t mtime = file_modtime(file);
+    auto cached = _compiled_chunks.find(file);
+    if (cached != _compiled_chunks.end() && cached->second.mtime == mtime)
+    {
+        // Binary chunks carry the original "@file" name in their debug
+        // info, so error messages are unchanged.
+        return luaL_loadbuffer(ls, cached->second.bytecode.c_str(),
+                               cached->second.bytecode.length(),
+                               ("@" + file).c_str());
+    }
+
     FileLineInput f(file.c_str());
     string script;
     while (!f.eof())
         script += f.get_line() + "\n";
 
     // prefixing with @ stops lua from adding [string "%s"]
-    return luaL_loadbuffer(ls, &script[0], script.length(),
-                           ("@" + file).c_str());
+    const int err = luaL_loadbuffer(ls, &script[0], script.length(),
+                                    ("@" + file).c_str());
+    if (!err)
+    {
+        compiled_chunk &chunk = _compiled_chunks[file];
+        chunk.bytecode.clear();
+        chunk.mtime = mtime;
+        if (lua_dump(ls, _chunk_writer, &chunk.bytecode))
+            _compiled_chunks.erase(file);
+    }
+    return err;
 }
 
 int CLua::execfile(const char *filename, bool trusted, bool die_on_fail,
@@ -334,6 +377,7 @@ int CLua::execfile(const char *filename, bool trusted, bool die_on_fail,
     if (!err)
         err = lua_pcall(ls, 0, 0, 0);
     set_error(err);
+    chunk_gen++;
     if (die_on_fail && !error.empty())
     {
         end(1, false, "Lua execfile error (%s): %s",
@@ -547,9 +591,38 @@ bool CLua::calltopfn(lua_State *ls, const char *params, va_list args,
     lua_call_throttle strangler(this);
     int err = lua_pcall(ls, argc, retc, 0);
     set_error(err, ls);
+    chunk_gen++;
     return !err;
 }
 
+// Cheap existence test for a global hook function: no string
+// splitting, allocation or argument marshalling, so callers invoking a
+// hook once per cell can skip callmbooleanfn() when it isn't defined.
+// Verdicts hold until the VM next runs a chunk (or a global is set
+// from C++), so the hookless common case never re-enters the VM.
+bool CLua::is_function_defined(const char *name)
+{
+    lua_State *ls = state();
+    if (!ls)
+        return false;
+
+    if (hook_cache_gen != chunk_gen)
+    {
+        hook_cache.clear();
+        hook_cache_gen = chunk_gen;
+    }
+
+    auto cached = hook_cache.find(name);
+    if (cached != hook_cache.end())
+        return cached->second;
+
+    lua_getglobal(ls, name);
+    const bool defined = lua_isfunction(ls, -1);
+    lua_pop(ls, 1);
+    hook_cache[name] = defined;
+    return defined;
+}
+
 maybe_bool CLua::callmbooleanfn(const char *fn, const char *params,
                                 va_list args)
 {
@@ -558,6 +631,11 @@ maybe_bool CLua::callmbooleanfn(const char *fn, const char *params,
     if (!ls)
         return MB_MAYBE;
 
+    // Undefined simple-name hooks are the common case; answer them
+    // from the memo before doing any stack or argument work.
+    if (!strchr(fn, '.') && !is_function_defined(fn))
+        return MB_MAYBE;
+
     int stacktop = lua_gettop(ls);
 
     pushglobal(fn);
@@ -591,6 +669,9 @@ maybe_bool CLua::callmaybefn(const char *fn, const char *params, va_list args)
     if (!ls)
         return MB_MAYBE;
 
+    if (!strchr(fn, '.') && !is_function_defined(fn))
+        return MB_MAYBE;
+
     int stacktop = lua_gettop(ls);
 
     pushglobal(fn);
@@ -679,6 +760,9 @@ bool CLua::callfn(const char *fn, const char *params, ...)
     if (!ls)
         return false;
 
+    if (!strchr(fn, '.') && !is_function_defined(fn))
+        return false;
+
     pushglobal(fn);
     if (!lua_isfunction(ls, -1))
     {
@@ -711,6 +795,12 @@ bool CLua::callfn(const char *fn, int nargs, int nret)
     // If a function is not provided on the stack, get the named function.
     if (fn)
     {
+        if (!strchr(fn, '.') && !is_function_defined(fn))
+        {
+            lua_pop(ls, nargs);
+            return false;
+        }
+
         pushglobal(fn);
         if (!lua_isfunction(ls, -1))
         {
@@ -726,6 +816,7 @@ bool CLua::callfn(const char *fn, int nargs, int nret)
     lua_call_throttle strangler(this);
     int err = lua_pcall(ls, nargs, nret, 0);
     set_error(err, ls);
+    chunk_gen++;
     return !err;
 }
 
@@ -734,6 +825,8 @@ void CLua::init_lua()
     if (_state)
         return;
 
+    chunk_gen++;
+
 #ifdef NO_CUSTOM_ALLOCATOR
     // If this is likely to be used as a server, warn the builder.
     // NOTE: #warning doesn't work on MSVC, so this will be fatal there
@@ -123,6 +123,7 @@ public:
                  bool force = false);
 
     void pushglobal(const string &name);
+    bool is_function_defined(const char *name);
 
     maybe_bool callmbooleanfn(const char *fn, const char *params, ...);
     maybe_bool callmaybefn(const char *fn, const char *params, ...);
@@ -170,6 +171,14 @@ private:
     sfset sourced_files;
     unsigned int uniqindex;
 
+    // Bumped every time the VM runs a chunk, any of which may define
+    // or redefine globals; hook existence verdicts are memoized
+    // against it, so a hookless rc answers per-turn and per-message
+    // hook dispatch without touching the VM.
+    int chunk_gen;
+    int hook_cache_gen;
+    map<string, bool> hook_cache;
+
     vector<lua_shutdown_listener*> shutdown_listeners;
 
 private:
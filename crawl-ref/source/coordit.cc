@@ -167,6 +167,59 @@ void random_rectangle_iterator::operator++(int)
 /*
  *  radius iterator
  */
+
+// Precomputed offset tables for radius iteration. A shape's membership
+// is fully determined by (is_square, credit), so the credit walk below
+// only ever runs once per distinct shape and radius; after that,
+// iteration is a pointer walk over the cached offsets, clipped to map
+// bounds (and the LOS mask, where requested) per cell. The offsets are
+// generated in exactly the order the incremental walk emits them, so
+// callers see an unchanged iteration order. Wizard-sized radii (magic
+// mapping the whole level) would make enormous tables and keep the
+// incremental walk instead.
+static map<pair<bool, int>, vector<coord_def> > _ri_offset_cache;
+
+static const vector<coord_def> *_ri_offsets(bool is_square, int credit)
+{
+    if (credit > (is_square ? 16 : 200))
+        return nullptr;
+
+    const pair<bool, int> key(is_square, credit);
+    auto it = _ri_offset_cache.find(key);
+    if (it != _ri_offset_cache.end())
+        return &it->second;
+
+    vector<coord_def> &offs = _ri_offset_cache[key];
+    const int base_cost = is_square ? 1 : -1;
+    const int inc_cost = is_square ? 0 : 2;
+    int y = 0;
+    int cost_y = base_cost;
+    int credit_y = credit;
+    do
+    {
+        int x = 0;
+        int cost_x = base_cost;
+        int credit_x = is_square ? credit : credit_y;
+        do
+        {
+            // Same emission order as the walk in operator++: SE, NE,
+            // SW, NW, with the axes emitted once.
+            offs.emplace_back(x, y);
+            if (y)
+                offs.emplace_back(x, -y);
+            if (x)
+                offs.emplace_back(-x, y);
+            if (x && y)
+                offs.emplace_back(-x, -y);
+            x++;
+            credit_x -= (cost_x += inc_cost);
+        } while (credit_x >= 0);
+        y++;
+        credit_y -= (cost_y += inc_cost);
+    } while (credit_y >= 0);
+    return &offs;
+}
+
 radius_iterator::radius_iterator(const coord_def _center, int r,
                                  circle_type ctype,
                                  bool _exclude_center)
@@ -183,6 +236,8 @@ radius_iterator::radius_iterator(const coord_def _center, int r,
     case C_SQUARE: credit = r; break;
     }
     is_square = (ctype == C_SQUARE);
+    offsets = _ri_offsets(is_square, credit);
+    offset_idx = 0;
     ++(*this);
     if (_exclude_center)
         ++(*this);
@@ -198,6 +253,8 @@ radius_iterator::radius_iterator(const coord_def _center,
     ASSERT(map_bounds(_center));
     credit = get_los_radius();
     is_square = true;
+    offsets = _ri_offsets(is_square, credit);
+    offset_idx = 0;
     ++(*this);
     if (_exclude_center)
         ++(*this);
@@ -221,6 +278,8 @@ radius_iterator::radius_iterator(const coord_def _center,
     case C_SQUARE: credit = r; break;
     }
     is_square = (ctype == C_SQUARE);
+    offsets = _ri_offsets(is_square, credit);
+    offset_idx = 0;
     ++(*this);
     if (_exclude_center)
         ++(*this);
@@ -254,6 +313,21 @@ const coord_def* radius_iterator::operator->() const
 
 void radius_iterator::operator++()
 {
+    if (offsets)
+    {
+        while (offset_idx < offsets->size())
+        {
+            current = center + (*offsets)[offset_idx++];
+            if (!map_bounds(current))
+                continue;
+            if (los && !cell_see_cell(center, current, los))
+                continue;
+            return;
+        }
+        state = RI_DONE;
+        return;
+    }
+
     cobegin(RI_START);
 
     base_cost = is_square ? 1 : -1;
@@ -83,6 +83,10 @@ private:
     coord_def center;
     los_type los;
     coord_def current;    // storage for operator->
+    // Precomputed offset table for this shape and radius, or null for
+    // radii too large to cache; see _ri_offsets() in coordit.cc.
+    const vector<coord_def> *offsets;
+    size_t offset_idx;
 };
 
 class adjacent_iterator : public iterator<forward_iterator_tag, coord_def>
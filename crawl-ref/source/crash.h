@@ -13,5 +13,6 @@ void write_stack_trace(FILE* file, int ignore_count);
 void call_gdb(FILE *file);
 void disable_other_crashes();
 void do_crash_dump();
+void do_slow_turn_dump(int elapsed_ms);
 
 void watchdog();
@@ -173,12 +173,12 @@ local function will_tab(ax, ay, bx, by)
   return will_tab(ax+move[1], ay+move[2], bx, by)
 end
 
-local function get_monster_info(dx,dy,no_move)
-  m = monster.get_monster_at(dx,dy)
-  name = m:name()
+local function get_monster_info(dx,dy,no_move,mon)
+  m = mon or monster.get_monster_at(dx,dy)
   if not m then
     return nil
   end
+  name = m:name()
   info = {}
   info.distance = (abs(dx) > abs(dy)) and -abs(dx) or -abs(dy)
   if have_ranged() then
@@ -227,8 +227,8 @@ local function compare_monster_info(m1, m2)
   return false
 end
 
-local function is_candidate_for_attack(x,y)
-  m = monster.get_monster_at(x, y)
+local function is_candidate_for_attack(x,y,mon)
+  m = mon or monster.get_monster_at(x, y)
   --if m then crawl.mpr("Checking: (" .. x .. "," .. y .. ") " .. m:name()) end
   if not m or m:attitude() ~= ATT_HOSTILE then
     return false
@@ -248,20 +248,21 @@ local function is_candidate_for_attack(x,y)
 end
 
 local function get_target(no_move)
-  local los_radius = you.los()
   local x, y, bestx, besty, best_info, new_info
   bestx = 0
   besty = 0
   best_info = nil
-  for x = -los_radius,los_radius do
-    for y = -los_radius,los_radius do
-      if is_candidate_for_attack(x, y) then
-        new_info = get_monster_info(x, y, no_move)
-        if (not best_info) or compare_monster_info(new_info, best_info) then
-          bestx = x
-          besty = y
-          best_info = new_info
-        end
+  -- One call for the visible hostiles beats probing every cell in
+  -- sight range with get_monster_at().
+  for _, mon in ipairs(monster.get_visible_hostiles()) do
+    x = mon:x_pos()
+    y = mon:y_pos()
+    if is_candidate_for_attack(x, y, mon) then
+      new_info = get_monster_info(x, y, no_move, mon)
+      if (not best_info) or compare_monster_info(new_info, best_info) then
+        bestx = x
+        besty = y
+        best_info = new_info
       end
     end
   end
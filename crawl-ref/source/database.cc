@@ -21,6 +21,7 @@
 #include "libutil.h"
 #include "options.h"
 #include "random.h"
+#include "state.h"
 #include "stringutil.h"
 #include "syscalls.h"
 #include "threads.h"
@@ -37,6 +38,9 @@ public:
     TextDB(TextDB *parent);
     ~TextDB() { shutdown(true); delete translation; }
     void init();
+    // Lazy-init gate: the DB is opened (and rebuilt if stale) on first
+    // lookup rather than at process start.
+    void ensure_init() { if (!_initialised) init(); }
     void shutdown(bool recursive = false);
     DBM* get() { return _db; }
 
@@ -54,6 +58,7 @@ public:
     string _directory;
     vector<string> _input_files;
     DBM* _db;
+    bool _initialised = false;
     string timestamp;
     TextDB *_parent;
     const char* lang() { return _parent ? Options.lang_name : 0; }
@@ -67,6 +72,8 @@ static void _store_text_db(const string &in, DBM *db);
 
 static string _query_database(TextDB &db, string key, bool canonicalise_key,
                               bool run_lua, bool untranslated = false);
+static void _clear_fetch_cache();
+static void _clear_speak_keys();
 static void _add_entry(DBM *db, const string &k, string &v);
 
 static TextDB AllDBs[] =
@@ -194,6 +201,10 @@ bool TextDB::open_db()
 
 void TextDB::init()
 {
+    // Set before doing any work: opening the DB runs a timestamp query
+    // through _query_database, which would otherwise re-enter init().
+    _initialised = true;
+
     if (Options.lang_name && !_parent)
     {
         translation = new TextDB(this);
@@ -217,6 +228,8 @@ void TextDB::shutdown(bool recursive)
 {
     if (_db)
     {
+        _clear_fetch_cache();
+        _clear_speak_keys();
         dbm_close(_db);
         _db = nullptr;
     }
@@ -319,6 +332,14 @@ void TextDB::_regenerate_db()
 
 void databaseSystemInit()
 {
+    // -builddb wants everything regenerated now; otherwise each DB
+    // opens on its first lookup, so an idle startup menu doesn't pay
+    // for speech, quotes and the rest. Partial -builddb-des workers
+    // only compile their .des slice, so don't have each of them
+    // rebuild the text databases too.
+    if (!crawl_state.build_db || !crawl_state.build_db_only.empty())
+        return;
+
     for (unsigned int i = 0; i < NUM_DB; i++)
         AllDBs[i].init();
 }
@@ -332,20 +353,59 @@ void databaseSystemShutdown()
 ////////////////////////////////////////////////////////////////////////////
 // Main DB functions
 
+// Fetch results, including misses, cached per DB handle. Monster speech
+// runs several mostly-missing lookups per speaking monster, and a DB
+// round trip per miss dwarfs a map probe. The text DBs are read-only
+// once opened, so entries can't go stale; the cache is dropped when a
+// DB handle is closed (and could be reused by a later open).
+struct db_cache_entry
+{
+    bool found;
+    string value;
+};
+static map<pair<const DBM *, string>, db_cache_entry> _fetch_cache;
+static const unsigned int MAX_FETCH_CACHE_ENTRIES = 2000;
+
+static void _clear_fetch_cache()
+{
+    _fetch_cache.clear();
+}
+
 static datum _database_fetch(DBM *database, const string &key)
 {
     datum result;
     result.dptr = nullptr;
     result.dsize = 0;
-    datum dbKey;
-
-    dbKey.dptr = (DPTR_COERCE) key.c_str();
-    dbKey.dsize = key.length();
 
     // Don't use the database if called from "monster".
-    if (database)
-        result = dbm_fetch(database, dbKey);
+    if (!database)
+        return result;
 
+    auto cached = _fetch_cache.find(make_pair(database, key));
+    if (cached == _fetch_cache.end())
+    {
+        datum dbKey;
+        dbKey.dptr = (DPTR_COERCE) key.c_str();
+        dbKey.dsize = key.length();
+        const datum fetched = dbm_fetch(database, dbKey);
+
+        // Cache full: pass the result through uncached rather than
+        // evict, since callers hold the returned pointer briefly.
+        if (_fetch_cache.size() >= MAX_FETCH_CACHE_ENTRIES)
+            return fetched;
+
+        db_cache_entry &entry = _fetch_cache[make_pair(database, key)];
+        entry.found = fetched.dptr && fetched.dsize > 0;
+        if (entry.found)
+            entry.value.assign((const char *)fetched.dptr, fetched.dsize);
+        cached = _fetch_cache.find(make_pair(database, key));
+    }
+
+    if (cached->second.found)
+    {
+        result.dptr = (DPTR_COERCE) cached->second.value.c_str();
+        result.dsize = cached->second.value.length();
+    }
     return result;
 }
 
@@ -578,6 +638,8 @@ static string _chooseStrByWeight(string entry, int fixed_weight = -1)
 static string _getWeightedString(TextDB &db, const string &key,
                                  const string &suffix, int fixed_weight = -1)
 {
+    db.ensure_init();
+
     // We have to canonicalise the key (in case the user typed it
     // in and got the case wrong.)
     string canonical_key = key + suffix;
@@ -690,6 +752,8 @@ static void _call_recursive_replacement(string &str, TextDB &db,
 static string _query_database(TextDB &db, string key, bool canonicalise_key,
                               bool run_lua, bool untranslated)
 {
+    db.ensure_init();
+
     if (canonicalise_key)
     {
         // We have to canonicalise the key (in case the user typed it
@@ -744,6 +808,7 @@ string getLongDescription(const string &key)
 vector<string> getLongDescKeysByRegex(const string &regex,
                                       db_find_filter filter)
 {
+    DescriptionDB.ensure_init();
     if (!DescriptionDB.get())
     {
         vector<string> empty;
@@ -758,6 +823,7 @@ vector<string> getLongDescKeysByRegex(const string &regex,
 vector<string> getLongDescBodiesByRegex(const string &regex,
                                         db_find_filter filter)
 {
+    DescriptionDB.ensure_init();
     if (!DescriptionDB.get())
     {
         vector<string> empty;
@@ -791,6 +857,58 @@ string getShoutString(const string &monst, const string &suffix)
 
 /////////////////////////////////////////////////////////////////////////////
 // Speak DB specific functions.
+
+// The speech database is read-only once built, so its key list only
+// needs to be pulled out of the DBM once.
+static vector<string> _speak_keys;
+static bool _speak_keys_loaded = false;
+
+static void _clear_speak_keys()
+{
+    _speak_keys.clear();
+    _speak_keys_loaded = false;
+}
+
+static void _load_speak_keys(DBM *database)
+{
+    if (!database)
+        return;
+
+    datum dbKey = dbm_firstkey(database);
+    while (dbKey.dptr != nullptr)
+    {
+        _speak_keys.emplace_back((const char *)dbKey.dptr, dbKey.dsize);
+        dbKey = dbm_nextkey(database);
+    }
+}
+
+// Whether any speech database key contains the given fragment. Every
+// key probed by mons_speaks() ends with a name derived from the
+// speaking monster, so a negative answer for all of a monster type's
+// names proves the entire prefix cascade must miss for that type.
+bool speakKeyExists(const string &fragment)
+{
+    SpeakDB.ensure_init();
+    if (!SpeakDB.get())
+        return true;
+
+    if (!_speak_keys_loaded)
+    {
+        _load_speak_keys(SpeakDB.get());
+        if (SpeakDB.translation)
+            _load_speak_keys(SpeakDB.translation->get());
+        _speak_keys_loaded = true;
+    }
+
+    string needle = fragment;
+    lowercase(needle);
+    for (const string &key : _speak_keys)
+        if (key.find(needle) != string::npos)
+            return true;
+
+    return false;
+}
+
 string getSpeakString(const string &key)
 {
     int num_replacements = 0;
@@ -828,6 +946,7 @@ string getHelpString(const string &topic)
 // FAQ DB specific functions.
 vector<string> getAllFAQKeys()
 {
+    FAQDB.ensure_init();
     if (!FAQDB.get())
     {
         vector<string> empty;
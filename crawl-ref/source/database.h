@@ -41,6 +41,7 @@ string getGameStartDescription(const string &key);
 
 string getShoutString(const string &monst, const string &suffix = "");
 string getSpeakString(const string &key);
+bool speakKeyExists(const string &fragment);
 string getRandNameString(const string &itemtype, const string &suffix = "");
 string getHelpString(const string &topic);
 string getMiscString(const string &misc, const string &suffix = "");
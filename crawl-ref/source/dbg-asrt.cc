@@ -9,9 +9,12 @@
 #include <csignal>
 
 #include "abyss.h"
+#include "act-iter.h"
 #include "chardump.h"
+#include "cloud.h"
 #include "coordit.h"
 #include "crash.h"
+#include "dbg-prof.h"
 #include "dbg-scan.h"
 #include "dbg-util.h"
 #include "delay.h"
@@ -22,6 +25,7 @@
 #include "hiscores.h"
 #include "initfile.h"
 #include "item-name.h"
+#include "macro.h"
 #include "jobs.h"
 #include "mapmark.h"
 #include "message.h"
@@ -32,6 +36,7 @@
 #include "spl-util.h"
 #include "state.h"
 #include "stringutil.h"
+#include "syscalls.h"
 #include "tiles-build-specific.h"
 #include "travel.h"
 #include "version.h"
@@ -683,6 +688,12 @@ void do_crash_dump()
     // generation info if the crash happened during level generation.
     _dump_level_info(file);
 
+    // Profiler counters and recent turn timings only touch static
+    // data, so dumping them is safe even if the game state is mangled;
+    // counter deltas are what distinguish a livelocked hot loop from a
+    // genuine hang.
+    prof_dump_crash_report(file);
+
     // Dumping information on marker inconsistancy is unlikely to crash,
     // as is dumping the descriptions of non-Lua markers.
     fprintf(file, "Markers:\n");
@@ -760,6 +771,79 @@ void do_crash_dump()
         fclose(file);
 }
 
+/*
+ * Writes a diagnostic snapshot after a turn that ran over the
+ * slow_turn_capture_ms threshold: level info, a monster census, active
+ * clouds and markers, and the recent message history. The state is
+ * captured just after the slow turn rather than during it, but rare
+ * multi-second turns are usually still explicable from what's left on
+ * the level afterwards.
+ */
+void do_slow_turn_dump(int elapsed_ms)
+{
+    const time_t t = time(nullptr);
+
+    string dir = (!Options.morgue_dir.empty() ? Options.morgue_dir :
+                  !SysEnv.crawl_dir.empty()   ? SysEnv.crawl_dir
+                                              : "");
+
+    if (!dir.empty() && dir[dir.length() - 1] != FILE_SEPARATOR)
+        dir += FILE_SEPARATOR;
+
+    char name[180] = {};
+    snprintf(name, sizeof(name), "%sslowturn-%s-%s.txt", dir.c_str(),
+             you.your_name.c_str(), make_file_time(t).c_str());
+
+    FILE *file = fopen_u(name, "w");
+    if (!file)
+        return;
+
+    fprintf(file, "Slow turn: %d ms on turn %d (threshold %d ms).\n\n",
+            elapsed_ms, you.num_turns, Options.slow_turn_capture_ms);
+
+    _dump_ver_stuff(file);
+    _dump_level_info(file);
+    prof_dump_crash_report(file);
+
+    int mon_count = 0;
+    map<string, int> census;
+    for (monster_iterator mi; mi; ++mi)
+    {
+        census[mi->name(DESC_PLAIN, true)]++;
+        mon_count++;
+    }
+    fprintf(file, "Monsters: %d\n", mon_count);
+    for (const auto &entry : census)
+        fprintf(file, "    %3d %s\n", entry.second, entry.first.c_str());
+
+    map<string, int> cloud_census;
+    for (const auto &entry : env.cloud)
+        cloud_census[cloud_type_name(entry.second.type)]++;
+    fprintf(file, "\nClouds: %d\n", (int)env.cloud.size());
+    for (const auto &entry : cloud_census)
+        fprintf(file, "    %3d %s\n", entry.second, entry.first.c_str());
+
+    set_msg_dump_file(file);
+    fprintf(file, "\nMarkers:\n");
+    fprintf(file, "<<<<<<<<<<<<<<<<<<<<<<\n");
+    _debug_dump_markers();
+    fprintf(file, ">>>>>>>>>>>>>>>>>>>>>>\n");
+    set_msg_dump_file(nullptr);
+
+    fprintf(file, "\nprev_cmd = %s\n",
+            command_to_name(crawl_state.prev_cmd).c_str());
+
+    fprintf(file, "\nMessages:\n");
+    fprintf(file, "<<<<<<<<<<<<<<<<<<<<<<\n");
+    fprintf(file, "%s", get_last_messages(NUM_STORED_MESSAGES, true).c_str());
+    fprintf(file, ">>>>>>>>>>>>>>>>>>>>>>\n");
+
+    fclose(file);
+
+    mprf(MSGCH_DIAGNOSTICS, "Slow turn (%d ms); diagnostics written to %s.",
+         elapsed_ms, name);
+}
+
 ///////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////
 
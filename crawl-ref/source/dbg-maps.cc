@@ -7,6 +7,8 @@
 
 #include "dbg-maps.h"
 
+#include <chrono>
+
 #include "branch.h"
 #include "chardump.h"
 #include "crash.h"
@@ -19,6 +21,7 @@
 #include "message.h"
 #include "ng-init.h"
 #include "player.h"
+#include "random.h"
 #include "shopping.h"
 #include "state.h"
 #include "stringutil.h"
@@ -43,6 +46,11 @@ static string last_error;
 
 static int levels_tried = 0, levels_failed = 0;
 static int build_attempts = 0, level_vetoes = 0;
+
+// Per-branch builder() wall-clock times for -genbench, plus the current
+// iteration, which keys the fixed (branch, depth, iteration) seed corpus.
+static map<branch_type, vector<unsigned int> > genbench_usec;
+static int genbench_iter = 0;
 // Map from message to counts.
 static map<string, int> veto_messages;
 
@@ -92,7 +100,24 @@ static bool _do_build_level()
     }
 
     ++levels_tried;
-    if (!builder())
+    bool built;
+    if (crawl_state.gen_bench)
+    {
+        const level_id lid = level_id::current();
+        // Re-seed per tuple so every run builds the same corpus and
+        // timings stay comparable across builds.
+        seed_rng(0x9e3779b9U * (lid.branch * 127 + lid.depth)
+                 + genbench_iter);
+        const auto start = chrono::steady_clock::now();
+        built = builder();
+        const auto stop = chrono::steady_clock::now();
+        genbench_usec[lid.branch].push_back(static_cast<unsigned int>(
+            chrono::duration_cast<chrono::microseconds>(stop - start)
+                .count()));
+    }
+    else
+        built = builder();
+    if (!built)
     {
         ++levels_failed;
         // Abort level build failure in objstat since the statistics will be
@@ -254,6 +279,7 @@ bool mapstat_build_levels()
              build_attempts ? level_vetoes * 100.0 / build_attempts : 0.0);
         printf("%d..", i + 1);
         fflush(stdout);
+        genbench_iter = i;
         dlua.callfn("dgn_clear_data", "");
         you.uniq_map_tags.clear();
         you.uniq_map_names.clear();
@@ -531,4 +557,88 @@ void mapstat_generate_stats()
     printf("Map stats complete.\n");
 }
 
+/**
+ * Benchmark level generation over a fixed seed corpus (-genbench).
+ *
+ * Builds the usual mapstat level list for the configured iterations,
+ * but with a deterministic seed per (branch, depth, iteration) tuple,
+ * and reports per-branch build-time percentiles and veto rates. If the
+ * command line supplied gates, any branch exceeding them fails the run.
+ *
+ * @returns True if no gate was exceeded, for use as the process exit
+ * status by CI; sharding branches across processes via -mapstat
+ * <depths> is how to parallelise.
+ */
+bool mapstat_run_genbench()
+{
+    you.wizard = true;
+    you.species = SP_HUMAN;
+
+    initialise_item_descriptions();
+    initialise_branch_depths();
+
+    run_map_global_preludes();
+    run_map_local_preludes();
+
+    _dungeon_places();
+
+    clear_messages();
+    printf("Benchmarking %d iteration(s) of %d level(s) over %d "
+           "branch(es).\n", SysEnv.map_gen_iters,
+           (int) generated_levels.size(), branch_count);
+    fflush(stdout);
+
+    mapstat_build_levels();
+
+    // Aggregate the per-level veto counts up to branches.
+    map<branch_type, pair<int, int> > branch_builds;
+    for (const auto &entry : map_builds)
+    {
+        branch_builds[entry.first.branch].first  += entry.second.first;
+        branch_builds[entry.first.branch].second += entry.second.second;
+    }
+
+    bool ok = true;
+    printf("\n%-10s %7s %8s %8s %8s %6s\n",
+           "branch", "builds", "p50ms", "p95ms", "maxms", "veto%");
+    for (auto &entry : genbench_usec)
+    {
+        vector<unsigned int> &times = entry.second;
+        sort(times.begin(), times.end());
+
+        const double p50 = times[times.size() / 2] / 1000.0;
+        const double p95 = times[times.size() * 95 / 100] / 1000.0;
+        const double mx  = times.back() / 1000.0;
+
+        const pair<int, int> &builds = branch_builds[entry.first];
+        const double veto_pct = builds.first
+            ? builds.second * 100.0 / builds.first : 0.0;
+
+        printf("%-10s %7d %8.1f %8.1f %8.1f %5.1f%%\n",
+               branches[entry.first].abbrevname, (int) times.size(),
+               p50, p95, mx, veto_pct);
+
+        if (crawl_state.genbench_p95_ms
+            && p95 > crawl_state.genbench_p95_ms)
+        {
+            printf("FAIL: %s p95 %.1f ms exceeds gate of %d ms.\n",
+                   branches[entry.first].abbrevname, p95,
+                   crawl_state.genbench_p95_ms);
+            ok = false;
+        }
+        if (crawl_state.genbench_veto_percent
+            && veto_pct > crawl_state.genbench_veto_percent)
+        {
+            printf("FAIL: %s veto rate %.1f%% exceeds gate of %d%%.\n",
+                   branches[entry.first].abbrevname, veto_pct,
+                   crawl_state.genbench_veto_percent);
+            ok = false;
+        }
+    }
+    printf(ok ? "Generation benchmark passed.\n"
+              : "Generation benchmark FAILED.\n");
+    fflush(stdout);
+    return ok;
+}
+
 #endif // DEBUG_STATISTICS
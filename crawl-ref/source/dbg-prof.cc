@@ -0,0 +1,327 @@
+/**
+ * @file
+ * @brief Scoped timer zones exported as a chrome://tracing JSON trace.
+**/
+
+#include "AppHdr.h"
+
+#ifdef DEBUG_PROF
+
+#include "dbg-prof.h"
+
+#include <chrono>
+#include <cstdio>
+#include <new>
+
+#include "message.h"
+#include "stringutil.h"
+#include "syscalls.h"
+
+#ifdef DEBUG_ALLOC
+#ifndef TARGET_OS_WINDOWS
+#include <sys/resource.h>
+#endif
+#endif
+
+static FILE *_trace = nullptr;
+static chrono::steady_clock::time_point _trace_start;
+
+// Innermost-first stack of the currently open zones.
+static vector<const char *> _zone_stack;
+
+// Cumulative (microseconds, calls) per zone since the last reset, for
+// benchmarks that want subsystem totals without parsing the trace.
+static map<const char *, pair<unsigned long long, unsigned long long> >
+    _zone_totals;
+
+// Same tallies over the whole process lifetime, never reset, so the
+// crash report's counters survive benchmark prof_reset_totals() calls.
+static map<const char *, pair<unsigned long long, unsigned long long> >
+    _zone_lifetime;
+
+// Per-turn zone timing lines for the last few finished turns, rolled
+// over at each prof_mark_turn(). Kept as preformatted strings so the
+// crash path only has to fputs them.
+static const int PROF_TURN_RING_SIZE = 8;
+static string _turn_ring[PROF_TURN_RING_SIZE];
+static int _turn_ring_next = 0;
+static map<const char *, pair<unsigned long long, unsigned long long> >
+    _last_turn_snapshot;
+
+#ifdef DEBUG_ALLOC
+struct alloc_stats
+{
+    unsigned long long count;
+    unsigned long long bytes;
+};
+
+// Allocation tallies for the turn in progress and the last finished
+// turn, keyed by the zone name literal's address so that bookkeeping
+// inside operator new never has to build strings.
+static map<const char *, alloc_stats> _turn_allocs;
+static map<const char *, alloc_stats> _last_turn_allocs;
+static bool _in_alloc_hook = false;
+static long _level_load_rss_kb = 0;
+
+static void _count_alloc(size_t size)
+{
+    // The tally maps allocate their own nodes; don't count those.
+    if (_in_alloc_hook)
+        return;
+
+    _in_alloc_hook = true;
+    const char *zone = _zone_stack.empty() ? "(no zone)"
+                                           : _zone_stack.back();
+    alloc_stats &stats = _turn_allocs[zone];
+    stats.count++;
+    stats.bytes += size;
+    _in_alloc_hook = false;
+}
+
+void *operator new(size_t size)
+{
+    void *ptr = malloc(size ? size : 1);
+    if (!ptr)
+        throw std::bad_alloc();
+    _count_alloc(size);
+    return ptr;
+}
+
+void *operator new[](size_t size)
+{
+    void *ptr = malloc(size ? size : 1);
+    if (!ptr)
+        throw std::bad_alloc();
+    _count_alloc(size);
+    return ptr;
+}
+
+void operator delete(void *ptr) noexcept
+{
+    free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+    free(ptr);
+}
+
+static long _peak_rss_kb()
+{
+#ifdef TARGET_OS_WINDOWS
+    return 0;
+#else
+    struct rusage ru;
+    if (getrusage(RUSAGE_SELF, &ru))
+        return 0;
+    return ru.ru_maxrss;
+#endif
+}
+#endif // DEBUG_ALLOC
+
+static unsigned long long _trace_now_us()
+{
+    return chrono::duration_cast<chrono::microseconds>(
+        chrono::steady_clock::now() - _trace_start).count();
+}
+
+prof_zone::prof_zone(const char *name)
+    : zone_name(name), entered(chrono::steady_clock::now())
+{
+    _zone_stack.push_back(zone_name);
+    if (_trace)
+    {
+        fprintf(_trace, "{\"ph\":\"B\",\"name\":\"%s\",\"pid\":1,\"tid\":1,"
+                        "\"ts\":%llu},\n", zone_name, _trace_now_us());
+    }
+}
+
+prof_zone::~prof_zone()
+{
+    _zone_stack.pop_back();
+
+    const unsigned long long us = chrono::duration_cast<chrono::microseconds>(
+        chrono::steady_clock::now() - entered).count();
+
+    pair<unsigned long long, unsigned long long> &total =
+        _zone_totals[zone_name];
+    total.first += us;
+    total.second++;
+
+    pair<unsigned long long, unsigned long long> &lifetime =
+        _zone_lifetime[zone_name];
+    lifetime.first += us;
+    lifetime.second++;
+    if (_trace)
+    {
+        fprintf(_trace, "{\"ph\":\"E\",\"name\":\"%s\",\"pid\":1,\"tid\":1,"
+                        "\"ts\":%llu},\n", zone_name, _trace_now_us());
+    }
+}
+
+/*
+ * Starts streaming trace events to the given file in the chrome-trace
+ * JSON array format; load the result via chrome://tracing or Perfetto.
+ * The viewers accept an unterminated array, so a crash mid-game still
+ * leaves a loadable trace.
+ */
+void prof_start_trace(const string &filename)
+{
+    if (_trace)
+        return;
+
+    _trace = fopen_u(filename.c_str(), "w");
+    if (!_trace)
+        return;
+
+    _trace_start = chrono::steady_clock::now();
+    fputs("[\n", _trace);
+}
+
+void prof_stop_trace()
+{
+    if (!_trace)
+        return;
+
+    fputs("{}]\n", _trace);
+    fclose(_trace);
+    _trace = nullptr;
+}
+
+void prof_reset_totals()
+{
+    _zone_totals.clear();
+}
+
+/*
+ * One "zone: N.NNN ms over N calls" line per zone accumulated since the
+ * last prof_reset_totals(), for in-game benchmark reports.
+ */
+string prof_report_totals()
+{
+    string report;
+    for (const auto &entry : _zone_totals)
+    {
+        report += make_stringf("%s: %llu.%03llu ms over %llu calls\n",
+                               entry.first, entry.second.first / 1000,
+                               entry.second.first % 1000,
+                               entry.second.second);
+    }
+    return report;
+}
+
+/*
+ * Drops an instant event at a turn boundary, so per-turn attribution of
+ * the zones between two markers is direct rather than guesswork.
+ */
+void prof_mark_turn(int turn)
+{
+    // Roll the finished turn's zone deltas into the ring buffer for
+    // the crash report.
+    string line = make_stringf("turn %d:", turn);
+    for (const auto &entry : _zone_lifetime)
+    {
+        const pair<unsigned long long, unsigned long long> &prev =
+            _last_turn_snapshot[entry.first];
+        const unsigned long long us = entry.second.first - prev.first;
+        const unsigned long long calls = entry.second.second - prev.second;
+        if (calls)
+        {
+            line += make_stringf(" %s=%llu.%03llums/%lluc", entry.first,
+                                 us / 1000, us % 1000, calls);
+        }
+    }
+    _last_turn_snapshot = _zone_lifetime;
+    _turn_ring[_turn_ring_next] = line;
+    _turn_ring_next = (_turn_ring_next + 1) % PROF_TURN_RING_SIZE;
+
+#ifdef DEBUG_ALLOC
+    // Roll the allocation tallies over at the turn boundary, so the
+    // wizard report always describes a whole, finished turn.
+    _in_alloc_hook = true;
+    _last_turn_allocs.swap(_turn_allocs);
+    _turn_allocs.clear();
+    _in_alloc_hook = false;
+#endif
+
+    if (_trace)
+    {
+        fprintf(_trace, "{\"ph\":\"i\",\"name\":\"turn\",\"pid\":1,\"tid\":1,"
+                        "\"s\":\"g\",\"ts\":%llu,\"args\":{\"turn\":%d}},\n",
+                _trace_now_us(), turn);
+    }
+}
+
+/*
+ * Writes the profiler's view of the process into a crash report: the
+ * lifetime per-zone totals (whose call counts double as cumulative
+ * counters — losight calls are LOS updates, travel_pathfind calls are
+ * pathfind invocations, tag_write calls are saves) and the per-turn
+ * zone timings of the last few finished turns. A livelocked hot loop
+ * shows up as one zone's counter delta dwarfing the rest.
+ */
+void prof_dump_crash_report(FILE *file)
+{
+    fprintf(file, "Performance counters (whole process):\n");
+    for (const auto &entry : _zone_lifetime)
+    {
+        fprintf(file, "  %s: %llu.%03llu ms over %llu calls\n",
+                entry.first, entry.second.first / 1000,
+                entry.second.first % 1000, entry.second.second);
+    }
+
+    fprintf(file, "Recent turn timings (oldest first):\n");
+    for (int i = 0; i < PROF_TURN_RING_SIZE; i++)
+    {
+        const string &line =
+            _turn_ring[(_turn_ring_next + i) % PROF_TURN_RING_SIZE];
+        if (!line.empty())
+            fprintf(file, "  %s\n", line.c_str());
+    }
+    fprintf(file, "\n");
+}
+
+#ifdef DEBUG_ALLOC
+/*
+ * Wizard report of the allocations made during the last finished turn,
+ * attributed to the innermost profiler zone open at allocation time.
+ */
+void debug_dump_alloc_stats()
+{
+    mprf(MSGCH_DIAGNOSTICS, "Allocations during the last turn:");
+    for (const auto &entry : _last_turn_allocs)
+    {
+        mprf(MSGCH_DIAGNOSTICS, "  %s: %llu allocs, %llu bytes",
+             entry.first, entry.second.count, entry.second.bytes);
+    }
+    mprf(MSGCH_DIAGNOSTICS, "Peak RSS: %ld kB (%ld kB at last level load)",
+         _peak_rss_kb(), _level_load_rss_kb);
+}
+
+/*
+ * Notes the process peak RSS after a level load, both for the wizard
+ * report and as an instant event in the trace, so level-sized memory
+ * spikes can be pinned to the level that caused them.
+ */
+void prof_note_level_load()
+{
+    const long rss = _peak_rss_kb();
+
+    if (_trace)
+    {
+        fprintf(_trace, "{\"ph\":\"i\",\"name\":\"level_load\","
+                        "\"pid\":1,\"tid\":1,\"s\":\"g\",\"ts\":%llu,"
+                        "\"args\":{\"peak_rss_kb\":%ld}},\n",
+                _trace_now_us(), rss);
+    }
+
+    if (rss > _level_load_rss_kb)
+    {
+        mprf(MSGCH_DIAGNOSTICS, "Peak RSS grew to %ld kB over this level load.",
+             rss);
+    }
+    _level_load_rss_kb = rss;
+}
+#endif // DEBUG_ALLOC
+
+#endif // DEBUG_PROF
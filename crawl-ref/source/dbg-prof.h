@@ -0,0 +1,57 @@
+/**
+ * @file
+ * @brief Scoped timer zones exported as a chrome://tracing JSON trace.
+**/
+
+#pragma once
+
+#include <cstdio>
+
+#ifdef DEBUG_PROF
+
+#include <chrono>
+
+// Times the enclosing scope and records it as a nested zone in the
+// trace. Nesting falls out of scope order, so zones inside zones show
+// up as a flame graph in the trace viewer.
+class prof_zone
+{
+public:
+    prof_zone(const char *name);
+    ~prof_zone();
+
+private:
+    const char *zone_name;
+    chrono::steady_clock::time_point entered;
+};
+
+void prof_start_trace(const string &filename);
+void prof_stop_trace();
+void prof_mark_turn(int turn);
+void prof_reset_totals();
+string prof_report_totals();
+void prof_dump_crash_report(FILE *file);
+
+#define PROF_ZONE_NAME2(line) _prof_zone_##line
+#define PROF_ZONE_NAME(line) PROF_ZONE_NAME2(line)
+#define PROF_ZONE(name) prof_zone PROF_ZONE_NAME(__LINE__)(name)
+
+#else
+
+static inline void prof_start_trace(const string &) {}
+static inline void prof_stop_trace() {}
+static inline void prof_mark_turn(int) {}
+static inline void prof_reset_totals() {}
+static inline string prof_report_totals() { return ""; }
+static inline void prof_dump_crash_report(FILE *) {}
+
+#define PROF_ZONE(name) ((void)0)
+
+#endif
+
+#ifdef DEBUG_ALLOC
+void debug_dump_alloc_stats();
+void prof_note_level_load();
+#else
+static inline void prof_note_level_load() {}
+#endif
@@ -693,3 +693,33 @@ void check_map_validity()
     debug_mons_scan();
 #endif
 }
+
+#ifdef DEBUG_GRID_HEAT
+// Dump (and reset) the coord-indexed access counts of the main level
+// grids, to show which ones the current workload actually hammers —
+// build with -DDEBUG_GRID_HEAT and call this from a debugger or a
+// temporary hook around the loop under study.
+void debug_dump_grid_heat()
+{
+    struct named_heat
+    {
+        const char *name;
+        unsigned long long *heat;
+    };
+    const named_heat grids[] =
+    {
+        { "grid (terrain)",  &env.grid.heat },
+        { "pgrid (fprops)",  &env.pgrid.heat },
+        { "mgrid",           &env.mgrid.heat },
+        { "igrid",           &env.igrid.heat },
+        { "cloud_grid",      &env.cloud_grid.heat },
+        { "grid_colours",    &env.grid_colours.heat },
+        { "map_knowledge",   &env.map_knowledge.heat },
+    };
+    for (const named_heat &g : grids)
+    {
+        mprf(MSGCH_DIAGNOSTICS, "%-16s %12llu accesses", g.name, *g.heat);
+        *g.heat = 0;
+    }
+}
+#endif
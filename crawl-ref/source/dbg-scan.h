@@ -8,3 +8,6 @@
 void debug_item_scan();
 void debug_mons_scan();
 void check_map_validity();
+#ifdef DEBUG_GRID_HEAT
+void debug_dump_grid_heat();
+#endif
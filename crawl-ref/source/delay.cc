@@ -109,7 +109,7 @@ void push_delay(shared_ptr<Delay> delay)
 static void _pop_delay()
 {
     if (!you.delay_queue.empty())
-        you.delay_queue.erase(you.delay_queue.begin());
+        you.delay_queue.pop_front();
 
     you.redraw_evasion = true;
 }
@@ -991,11 +991,37 @@ static maybe_bool _userdef_interrupt_activity(Delay* delay,
     return MB_MAYBE;
 }
 
+const FixedBitVector<NUM_AINTERRUPTS>& Delay::relevant_interrupts()
+{
+    if (!interrupt_mask_built)
+    {
+        interrupt_mask = Options.activity_interrupts[name()];
+        interrupt_mask.set(AI_FORCE_INTERRUPT);
+        interrupt_mask_built = true;
+    }
+    return interrupt_mask;
+}
+
 // Returns true if the activity should be interrupted, false otherwise.
 static bool _should_stop_activity(Delay* delay,
                                   activity_interrupt_type ai,
                                   const activity_interrupt_data &at)
 {
+    // Nearly every poll during a long travel or macro delay ends in
+    // "this interrupt can't stop this delay"; answer that from the
+    // delay's compiled mask before the lua hook and special-case
+    // evaluation below. Macro delays are exempt because
+    // c_interrupt_macro interrupts by default when undefined.
+    if (!delay->relevant_interrupts()[ai]
+        && !delay->is_macro()
+#ifdef CLUA_BINDINGS
+        && !clua.is_function_defined("c_interrupt_activity")
+#endif
+        )
+    {
+        return false;
+    }
+
     switch (_userdef_interrupt_activity(delay, ai, at))
     {
     case MB_TRUE:
@@ -1039,8 +1065,7 @@ static bool _should_stop_activity(Delay* delay,
         return false;
     }
 
-    return ai == AI_FORCE_INTERRUPT
-           || Options.activity_interrupts[delay->name()][ai];
+    return delay->relevant_interrupts()[ai];
 }
 
 static string _abyss_monster_creation_message(const monster* mon)
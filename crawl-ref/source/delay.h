@@ -6,6 +6,7 @@
 #pragma once
 
 #include "activity-interrupt-type.h"
+#include "bitary.h"
 #include "command-type.h"
 #include "enum.h"
 #include "item-prop-enum.h"
@@ -107,6 +108,13 @@ class Delay
     }
 protected:
     bool started = false;
+private:
+    // Which interrupt types can possibly stop this delay, compiled
+    // from Options.activity_interrupts[name()] on first check so that
+    // per-tick interrupt polling skips the per-name map lookup. Rc
+    // lua hooks can interrupt regardless; callers handle those.
+    FixedBitVector<NUM_AINTERRUPTS> interrupt_mask;
+    bool interrupt_mask_built = false;
 public:
     int duration;
 
@@ -210,6 +218,12 @@ public:
      * @return the delay's name; used in debugging and for the interrupt_ option family.
      */
     virtual const char* name() const = 0;
+
+    /**
+     * @return the set of interrupt types that can stop this delay,
+     * including AI_FORCE_INTERRUPT (see interrupt_mask above).
+     */
+    const FixedBitVector<NUM_AINTERRUPTS>& relevant_interrupts();
 };
 
 class ArmourOnDelay : public Delay
@@ -17,7 +17,8 @@ dgn_event_dispatcher dungeon_events;
 void dgn_event_dispatcher::clear()
 {
     global_event_mask = 0;
-    listeners.clear();
+    for (int i = 0; i < NUM_DGN_EVENT_BITS; ++i)
+        listeners[i].clear();
     for (int y = 0; y < GYM; ++y)
         for (int x = 0; x < GXM; ++x)
             grid_triggers[x][y].reset(nullptr);
@@ -82,12 +83,15 @@ void dgn_event_dispatcher::fire_position_event(
 
 void dgn_event_dispatcher::fire_event(const dgn_event &e)
 {
-    if (global_event_mask & e.type)
+    unsigned bits = e.type & global_event_mask;
+    for (int i = 0; bits; ++i, bits >>= 1)
     {
-        auto copy = listeners;
-        for (const auto &ldef : copy)
-            if (ldef.eventmask & e.type)
-                ldef.listener->notify_dgn_event(e);
+        if (!(bits & 1))
+            continue;
+        // Copy the bucket: listeners may unregister while notified.
+        auto copy = listeners[i];
+        for (auto listener : copy)
+            listener->notify_dgn_event(e);
     }
 }
 
@@ -105,15 +109,14 @@ void dgn_event_dispatcher::register_listener(unsigned mask,
     else
     {
         global_event_mask |= mask;
-        for (auto &ldef : listeners)
+        for (int i = 0; i < NUM_DGN_EVENT_BITS; ++i)
         {
-            if (ldef.listener == listener)
-            {
-                ldef.eventmask |= mask;
-                return;
-            }
+            if (!(mask & 1u << i))
+                continue;
+            list<dgn_event_listener *> &bucket = listeners[i];
+            if (find(bucket.begin(), bucket.end(), listener) == bucket.end())
+                bucket.push_back(listener);
         }
-        listeners.emplace_back(mask, listener);
     }
 }
 
@@ -140,13 +143,12 @@ void dgn_event_dispatcher::remove_listener(dgn_event_listener *listener,
         remove_listener_at(pos, listener);
     else
     {
-        for (auto i = listeners.begin(); i != listeners.end(); ++i)
+        global_event_mask = 0;
+        for (int i = 0; i < NUM_DGN_EVENT_BITS; ++i)
         {
-            if (i->listener == listener)
-            {
-                listeners.erase(i);
-                return;
-            }
+            erase_val(listeners[i], listener);
+            if (!listeners[i].empty())
+                global_event_mask |= 1u << i;
         }
     }
 }
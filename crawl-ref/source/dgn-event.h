@@ -79,16 +79,8 @@ struct dgn_square_alarm
     list<dgn_event_listener*> listeners;
 };
 
-struct dgn_listener_def
-{
-    dgn_listener_def(unsigned mask, dgn_event_listener *l)
-        : eventmask(mask), listener(l)
-    {
-    }
-
-    unsigned eventmask;
-    dgn_event_listener *listener;
-};
+// One listener bucket per possible event-mask bit.
+const int NUM_DGN_EVENT_BITS = 32;
 
 // Listeners are not saved here. Map markers have their own
 // persistence and activation mechanisms. Other listeners must make
@@ -127,9 +119,13 @@ private:
     void remove_listener_at(const coord_def &pos, dgn_event_listener *l);
 
 private:
+    // Union of the bits with a non-empty bucket below; dispatching an
+    // event nobody listens for costs this one mask test.
     unsigned global_event_mask;
     unique_ptr<dgn_square_alarm> grid_triggers[GXM][GYM];
-    list<dgn_listener_def> listeners;
+    // Global listeners bucketed by event type, so dispatch walks only
+    // the subscribers of the fired event.
+    list<dgn_event_listener *> listeners[NUM_DGN_EVENT_BITS];
 };
 
 extern dgn_event_dispatcher dungeon_events;
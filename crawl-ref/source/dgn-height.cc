@@ -66,13 +66,18 @@ void dgn_smooth_height_at(coord_def c, int radius, int max_height)
     const int max_delta = radius * radius * 2 + 2;
     int divisor = 0;
     int total = 0;
-    for (int y = c.y - radius; y <= c.y + radius; ++y)
+    // Clamp the window to the map up front instead of bounds-checking
+    // every neighbour; this kernel runs for every cell of the level,
+    // several passes per Shoals or Swamp build.
+    const int y0 = max(c.y - radius, Y_BOUND_1 + 1);
+    const int y1 = min(c.y + radius, Y_BOUND_2 - 1);
+    const int x0 = max(c.x - radius, X_BOUND_1 + 1);
+    const int x1 = min(c.x + radius, X_BOUND_2 - 1);
+    for (int y = y0; y <= y1; ++y)
     {
-        for (int x = c.x - radius; x <= c.x + radius; ++x)
+        for (int x = x0; x <= x1; ++x)
         {
             const coord_def p(x, y);
-            if (!in_bounds(p))
-                continue;
             const int nheight = dgn_height_at(p);
             if (max_height != DGN_UNDEFINED_HEIGHT && nheight > max_height)
                 continue;
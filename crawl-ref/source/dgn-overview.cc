@@ -64,8 +64,25 @@ static string _print_altars_for_gods(const vector<god_type>& gods,
                                      bool print_unseen, bool display);
 static const string _get_coloured_level_annotation(level_id li);
 
+// The overview text scans every branch, altar, shop, portal and
+// annotation table and reformats the lot; on late-game characters
+// that's a noticeable stall each time Ctrl-O opens (or the dump code
+// asks). The tables only change through the functions in this file,
+// so the rendered string is kept and reused until one of them fires
+// or a turn passes — the deepest-explored depths consulted while
+// rendering change by travelling, not through any hook here.
+static string _overview_text[2];
+static bool _overview_valid[2] = { false, false };
+static int _overview_turn = -1;
+
+static void _invalidate_overview()
+{
+    _overview_valid[0] = _overview_valid[1] = false;
+}
+
 void overview_clear()
 {
+    _invalidate_overview();
     stair_level.clear();
     shops_present.clear();
     altars_present.clear();
@@ -83,6 +100,8 @@ void seen_notable_thing(dungeon_feature_type which_thing, const coord_def& pos)
     if (!player_in_connected_branch())
         return;
 
+    _invalidate_overview();
+
     const god_type god = feat_altar_god(which_thing);
     if (god != GOD_NO_GOD)
         _seen_altar(god, pos);
@@ -104,6 +123,8 @@ bool move_notable_thing(const coord_def& orig, const coord_def& dest)
     if (!is_notable_terrain(grd(orig)))
         return false;
 
+    _invalidate_overview();
+
     level_pos pos1(level_id::current(), orig);
     level_pos pos2(level_id::current(), dest);
 
@@ -212,6 +233,15 @@ static string _portals_description_string()
 // display: format for in-game display; !display: format for dump
 string overview_description_string(bool display)
 {
+    if (you.num_turns != _overview_turn)
+    {
+        _invalidate_overview();
+        _overview_turn = you.num_turns;
+    }
+
+    if (_overview_valid[display])
+        return _overview_text[display];
+
     string disp;
 
     disp += "                    <white>Dungeon Overview and Level Annotations</white>\n" ;
@@ -221,7 +251,9 @@ string overview_description_string(bool display)
     disp += _get_portals();
     disp += _get_notes();
 
-    return disp.substr(0, disp.find_last_not_of('\n')+1);
+    _overview_text[display] = disp.substr(0, disp.find_last_not_of('\n')+1);
+    _overview_valid[display] = true;
+    return _overview_text[display];
 }
 
 // iterate through every dungeon branch, listing the ones which have been found
@@ -599,6 +631,7 @@ static bool _unnotice_stair(const level_pos &pos)
 
 bool unnotice_feature(const level_pos &pos)
 {
+    _invalidate_overview();
     StashTrack.remove_shop(pos);
     shopping_list.forget_pos(pos);
     return _unnotice_portal(pos)
@@ -692,6 +725,8 @@ static const char *_get_tracked_feature_key(dungeon_feature_type feat)
 static void _update_tracked_feature_annot(dungeon_feature_type feat,
                                           int old_num)
 {
+    _invalidate_overview();
+
     const level_id li = level_id::current();
     const char *feat_key = _get_tracked_feature_key(feat);
     const int new_num = env.properties[feat_key];
@@ -764,12 +799,14 @@ void enter_branch(branch_type branch, level_id from)
     {
         stair_level[branch].clear();
         stair_level[branch].insert(from);
+        _invalidate_overview();
     }
 }
 
 // Add an annotation on a level if we corrupt with Lugonu's ability
 void mark_corrupted_level(level_id li)
 {
+    _invalidate_overview();
     if (!level_annotations[li].empty())
         level_annotations[li] += ", ";
     level_annotations[li] += "corrupted";
@@ -779,6 +816,8 @@ void mark_corrupted_level(level_id li)
 
 static void _update_unique_annotation(level_id level)
 {
+    _invalidate_overview();
+
     string note = "";
     string sep = ", ";
 
@@ -873,11 +912,13 @@ void set_level_exclusion_annotation(string str, level_id li)
     }
 
     level_exclusions[li] = str;
+    _invalidate_overview();
 }
 
 void clear_level_exclusion_annotation(level_id li)
 {
     level_exclusions.erase(li);
+    _invalidate_overview();
 }
 
 string get_level_annotation(level_id li, bool skip_excl, bool skip_uniq,
@@ -961,16 +1002,21 @@ void do_annotate(level_id& li)
     else if (old == buf)
         canned_msg(MSG_OK);
     else if (*buf)
+    {
         level_annotations[li] = buf;
+        _invalidate_overview();
+    }
     else
     {
         mpr("Cleared annotation.");
         level_annotations.erase(li);
+        _invalidate_overview();
     }
 }
 
 void clear_level_annotations(level_id li)
 {
+    _invalidate_overview();
     level_annotations.erase(li);
 
     // Abyss persists its denizens.
@@ -1000,6 +1046,7 @@ void marshallUniqueAnnotations(writer& outf)
 
 void unmarshallUniqueAnnotations(reader& inf)
 {
+    _invalidate_overview();
     auto_unique_annotations.clear();
     int num_notes = unmarshallShort(inf);
     for (int i = 0; i < num_notes; ++i)
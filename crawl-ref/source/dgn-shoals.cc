@@ -23,6 +23,7 @@
 #include "mon-place.h"
 #include "state.h"
 #include "stringutil.h"
+#include "terrain.h"
 #include "traps.h"
 #include "view.h"
 
@@ -909,7 +910,12 @@ static vector<coord_def> _shoals_extra_tide_seeds()
 
 static void _shoals_apply_tide(int tide, bool incremental_tide)
 {
-    vector<coord_def> pages[2];
+    // The tide reruns every few turns on Shoals levels; reuse the
+    // flood-fill scratch so each update allocates nothing once the
+    // pages have warmed up.
+    static vector<coord_def> pages[2];
+    pages[0].clear();
+    pages[1].clear();
     int current_page = 0;
 
     // Start from corners of the map.
@@ -923,7 +929,8 @@ static void _shoals_apply_tide(int tide, bool incremental_tide)
     pages[current_page].insert(pages[current_page].end(),
                                extra_seeds.begin(), extra_seeds.end());
 
-    FixedArray<bool, GXM, GYM> seen_points(false);
+    static FixedArray<bool, GXM, GYM> seen_points;
+    seen_points.init(false);
 
     while (!pages[current_page].empty())
     {
@@ -1016,6 +1023,9 @@ void shoals_apply_tides(int turns_elapsed, bool force, bool incremental_tide)
     CrawlHashTable &props(you.props);
     _shoals_init_tide();
 
+    // The tide can move a whole shoreline of cells in one update.
+    const terrain_change_batch batch;
+
     // Make sure we don't do too much catch-up if another Shoals level
     // has been updating the tide.
     if (turns_elapsed > 1)
@@ -2276,6 +2276,10 @@ static bool _find_monster(const coord_def& where, targ_mode_type mode,
                           bool need_path, int range, targeter *hitfunc)
 {
 #ifdef CLUA_BINDINGS
+    // The existence check keeps the spiral scan from paying for a full
+    // Lua call setup on every cell when no hook is defined (the usual
+    // case); target cycling runs this for each square it passes over.
+    if (clua.is_function_defined("ch_target_monster"))
     {
         coord_def dp = grid2player(where);
         // We could pass more info here.
@@ -2318,6 +2322,10 @@ static bool _find_shadow_step_mons(const coord_def& where, targ_mode_type mode,
                                    targeter *hitfunc)
 {
 #ifdef CLUA_BINDINGS
+    // The existence check keeps the spiral scan from paying for a full
+    // Lua call setup on every cell when no hook is defined (the usual
+    // case); target cycling runs this for each square it passes over.
+    if (clua.is_function_defined("ch_target_shadow_step"))
     {
         coord_def dp = grid2player(where);
         // We could pass more info here.
@@ -2345,6 +2353,10 @@ static bool _find_monster_expl(const coord_def& where, targ_mode_type mode,
     ASSERT(hitfunc);
 
 #ifdef CLUA_BINDINGS
+    // The existence check keeps the spiral scan from paying for a full
+    // Lua call setup on every cell when no hook is defined (the usual
+    // case); target cycling runs this for each square it passes over.
+    if (clua.is_function_defined("ch_target_monster_expl"))
     {
         coord_def dp = grid2player(where);
         // We could pass more info here.
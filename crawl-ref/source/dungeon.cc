@@ -17,6 +17,10 @@
 #include <set>
 #include <sstream>
 
+#if defined(DEBUG_DIAGNOSTICS) && !defined(TARGET_OS_WINDOWS)
+#include <sys/time.h>
+#endif
+
 #include "abyss.h"
 #include "acquire.h"
 #include "act-iter.h"
@@ -29,6 +33,7 @@
 #include "coordit.h"
 #include "directn.h"
 #include "dbg-maps.h"
+#include "dbg-prof.h"
 #include "dbg-scan.h"
 #include "dgn-delve.h"
 #include "dgn-height.h"
@@ -48,6 +53,7 @@
 #include "items.h"
 #include "lev-pand.h"
 #include "libutil.h"
+#include "losparam.h"
 #include "mapmark.h"
 #include "maps.h"
 #include "mon-death.h"
@@ -282,6 +288,8 @@ static void _count_gold()
  *********************************************************************/
 bool builder(bool enable_random_maps, dungeon_feature_type dest_stairs_type)
 {
+    PROF_ZONE("builder");
+
     // Re-check whether we're in a valid place, it leads to obscure errors
     // otherwise.
     ASSERT_RANGE(you.where_are_you, 0, NUM_BRANCHES);
@@ -297,6 +305,11 @@ bool builder(bool enable_random_maps, dungeon_feature_type dest_stairs_type)
 
     unwind_bool levelgen(crawl_state.generating_level, true);
 
+    // All the builder's rolls come from the levelgen substream, so
+    // gameplay randomness drawn before or between level builds can't
+    // perturb the layouts a given seed produces.
+    rng_stream levelgen_rng(RNG_LEVELGEN);
+
     // N tries to build the level, after which we bail with a capital B.
     int tries = 50;
     while (tries-- > 0)
@@ -347,6 +360,61 @@ bool builder(bool enable_random_maps, dungeon_feature_type dest_stairs_type)
     return false;
 }
 
+#ifdef DEBUG_DIAGNOSTICS
+// Wall-clock phase timing for the level builder: _dgn_phase(name)
+// closes the running phase and opens the named one, and the per-level
+// totals are emitted as a single greppable "dgn-phase-times:" line so
+// slow generation can be pinned on layout, vaults, connectivity or
+// population.
+static uint64_t _dgn_millis()
+{
+#ifdef TARGET_OS_WINDOWS
+    // MSVC has no gettimeofday().
+    FILETIME ft;
+    GetSystemTimeAsFileTime(&ft);
+    uint64_t tt = ft.dwHighDateTime;
+    tt <<= 32;
+    tt |= ft.dwLowDateTime;
+    return tt / 10000;
+#else
+    struct timeval tv;
+    gettimeofday(&tv, nullptr);
+    return uint64_t(tv.tv_sec) * 1000 + tv.tv_usec / 1000;
+#endif
+}
+
+static const char *_dgn_cur_phase = nullptr;
+static uint64_t _dgn_phase_start = 0;
+static string _dgn_phase_report;
+
+static void _dgn_phase(const char *name)
+{
+    const uint64_t now = _dgn_millis();
+    if (_dgn_cur_phase)
+    {
+        _dgn_phase_report += make_stringf(" %s=%d", _dgn_cur_phase,
+                                          int(now - _dgn_phase_start));
+    }
+    _dgn_cur_phase = name;
+    _dgn_phase_start = now;
+}
+
+static void _dgn_report_phase_times()
+{
+    _dgn_phase(nullptr);
+    if (!_dgn_phase_report.empty())
+    {
+        dprf(DIAG_DNGN, "dgn-phase-times: %s%s",
+             level_id::current().describe().c_str(),
+             _dgn_phase_report.c_str());
+    }
+    _dgn_phase_report.clear();
+}
+#else
+static inline void _dgn_phase(const char *) { }
+static inline void _dgn_report_phase_times() { }
+#endif
+
 static bool _build_level_vetoable(bool enable_random_maps,
                                   dungeon_feature_type dest_stairs_type)
 {
@@ -362,9 +430,11 @@ static bool _build_level_vetoable(bool enable_random_maps,
     try
     {
         _build_dungeon_level(dest_stairs_type);
+        _dgn_report_phase_times();
     }
     catch (dgn_veto_exception& e)
     {
+        _dgn_report_phase_times();
         dprf(DIAG_DNGN, "<white>VETO</white>: %s: %s",
              level_id::current().describe().c_str(), e.what());
 #ifdef DEBUG_STATISTICS
@@ -631,6 +701,7 @@ void level_clear_vault_memory()
     Temp_Vaults.clear();
     env.level_map_mask.init(0);
     env.level_map_ids.init(INVALID_MAP_INDEX);
+    abyss_invalidate_turned_to_floor();
 }
 
 void dgn_flush_map_memory()
@@ -760,7 +831,10 @@ static bool _dgn_fill_zone(
     bool (*iswanted)(const coord_def &) = nullptr)
 {
     bool ret = false;
-    list<coord_def> points[2];
+    // Flood fills run repeatedly per build for zone counts and
+    // connectivity checks; vectors avoid a node allocation per visited
+    // cell.
+    vector<coord_def> points[2];
     int cur = 0;
 
     // No bounds checks, assuming the level has at least one layer of
@@ -921,9 +995,21 @@ static int _process_disconnected_zones(int x1, int y1, int x2, int y2,
                 continue;
             }
 
+            // Record the zone's squares as the flood fill visits them,
+            // so filling a disconnected zone doesn't have to rescan the
+            // whole rectangle to find them again.
+            vector<coord_def> zone_points;
+            auto record_point = [&zone_points, fill](const coord_def &c)
+            {
+                if (fill)
+                    zone_points.push_back(c);
+            };
+            if (fill)
+                zone_points.emplace_back(x, y);
+
             const bool found_exit_stair =
                 _dgn_fill_zone(coord_def(x, y), ++nzones,
-                               _dgn_point_record_stub,
+                               record_point,
                                _dgn_square_is_passable,
                                choose_stairless ? (at_branch_bottom() ?
                                                    _is_upwards_exit_stair :
@@ -940,28 +1026,17 @@ static int _process_disconnected_zones(int x1, int y1, int x2, int y2,
                 // from the rest of the level, this will cause the level to be
                 // vetoed later on.
                 bool veto = false;
-                vector<coord_def> coords;
-                for (int fy = y1; fy <= y2 ; ++fy)
+                for (const coord_def &fc : zone_points)
                 {
-                    for (int fx = x1; fx <= x2; ++fx)
+                    if (map_masked(fc, MMT_VAULT))
                     {
-                        if (travel_point_distance[fx][fy] == nzones)
-                        {
-                            if (map_masked(coord_def(fx, fy), MMT_VAULT))
-                            {
-                                veto = true;
-                                break;
-                            }
-                            else
-                                coords.emplace_back(fx, fy);
-                        }
-                    }
-                    if (veto)
+                        veto = true;
                         break;
+                    }
                 }
                 if (!veto)
                 {
-                    for (auto c : coords)
+                    for (auto c : zone_points)
                         _set_grd(c, fill);
                 }
             }
@@ -1208,6 +1283,10 @@ void dgn_reset_level(bool enable_random_maps)
     env.level_uniq_map_tags.clear();
     clear_subvault_stack();
 
+    // The builder writes terrain without notifications; don't let
+    // stale opacity bits survive into the new level.
+    opacity_grid_reset();
+
     you.unique_creatures = temp_unique_creatures;
     you.unique_items = temp_unique_items;
 
@@ -1260,6 +1339,7 @@ void dgn_reset_level(bool enable_random_maps)
     setup_vault_mon_list();
 
     env.cloud.clear();
+    reload_cloud_grid();
 
     mgrd.init(NON_MONSTER);
     igrd.init(NON_ITEM);
@@ -2365,6 +2445,7 @@ static void _post_vault_build()
 
 static void _build_dungeon_level(dungeon_feature_type dest_stairs_type)
 {
+    _dgn_phase("layout");
     bool place_vaults = _builder_by_type();
 
     if (player_in_branch(BRANCH_LABYRINTH))
@@ -2377,6 +2458,7 @@ static void _build_dungeon_level(dungeon_feature_type dest_stairs_type)
     // Stairs must exist by this point (except in Shoals where they are
     // yet to be placed). Some items and monsters already exist.
 
+    _dgn_phase("doors");
     _check_doors();
 
     const unsigned nvaults = env.level_vaults.size();
@@ -2384,6 +2466,7 @@ static void _build_dungeon_level(dungeon_feature_type dest_stairs_type)
     // Any further vaults must make sure not to disrupt level layout.
     dgn_check_connectivity = true;
 
+    _dgn_phase("overflow-temples");
     if (player_in_branch(BRANCH_DUNGEON)
         && !crawl_state.game_is_tutorial())
     {
@@ -2394,6 +2477,7 @@ static void _build_dungeon_level(dungeon_feature_type dest_stairs_type)
     // no guarantees, seeing this is a minivault.
     if (crawl_state.game_standard_levelgen())
     {
+        _dgn_phase("vaults");
         if (place_vaults)
         {
             // Moved branch entries to place first so there's a good
@@ -2415,6 +2499,7 @@ static void _build_dungeon_level(dungeon_feature_type dest_stairs_type)
         // Ruination and plant clumps.
         _post_vault_build();
 
+        _dgn_phase("uniques-mimics-traps");
         // XXX: Moved this here from builder_monsters so that
         //      connectivity can be ensured
         _place_uniques();
@@ -2425,11 +2510,14 @@ static void _build_dungeon_level(dungeon_feature_type dest_stairs_type)
         _place_traps();
 
         // Any vault-placement activity must happen before this check.
+        _dgn_phase("connectivity");
         _dgn_verify_connectivity(nvaults);
 
+        _dgn_phase("monsters");
         _builder_monsters();
 
         // Place items.
+        _dgn_phase("items");
         _builder_items();
 
         _fixup_walls();
@@ -2441,6 +2529,7 @@ static void _build_dungeon_level(dungeon_feature_type dest_stairs_type)
         _post_vault_build();
     }
 
+    _dgn_phase("fixup");
     // Translate stairs for pandemonium levels.
     if (player_in_branch(BRANCH_PANDEMONIUM))
         _fixup_pandemonium_stairs();
@@ -4880,9 +4969,9 @@ monster* dgn_place_monster(mons_spec &mspec, coord_def where,
         item_def *wpn = mons->mslot_item(MSLOT_WEAPON);
         ASSERT(wpn);
         if (mons->type == MONS_DANCING_WEAPON)
-            mons->ghost->init_dancing_weapon(*wpn, 100);
+            mons->writable_ghost().init_dancing_weapon(*wpn, 100);
         else if (mons->type == MONS_SPECTRAL_WEAPON)
-            mons->ghost->init_spectral_weapon(*wpn, 100);
+            mons->writable_ghost().init_spectral_weapon(*wpn, 100);
         mons->ghost_demon_init();
     }
 
@@ -14,8 +14,10 @@
 #include "colour.h"
 #include "crash.h"
 #include "database.h"
+#include "dbg-prof.h"
 #include "describe.h"
 #include "dungeon.h"
+#include "files.h"
 #include "god-passive.h"
 #include "hints.h"
 #include "invent.h"
@@ -171,6 +173,7 @@ NORETURN void end(int exit_code, bool print_error, const char *format, ...)
         tiles.shutdown();
 #endif
 
+        prof_stop_trace();
         cio_cleanup();
         msg::deinitialise_mpr_streams();
         _clear_globals_on_exit();
@@ -224,6 +227,7 @@ static void _delete_files()
     you.save->unlink();
     delete you.save;
     you.save = 0;
+    reset_level_cache();
 }
 
 NORETURN void screen_end_game(string text)
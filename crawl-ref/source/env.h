@@ -3,6 +3,7 @@
 #include <set>
 #include <memory> // unique_ptr
 
+#include "bitary.h"
 #include "coord.h"
 #include "fprop.h"
 #include "map-cell.h"
@@ -27,10 +28,30 @@ struct crawl_environment
     FixedVector< item_def, MAX_ITEMS >       item;  // item list
     FixedVector< monster, MAX_MONSTERS+2 >   mons;  // monster list, plus anon
 
+    // One past the highest mons slot handed out since the level's
+    // monsters were last reset. Slots are reused lowest-first, so live
+    // monsters always sit below this and iteration can stop here
+    // instead of scanning all MAX_MONSTERS slots.
+    int mons_slot_watermark;
+
+    // Compact mirror of which mons slots are occupied, maintained by
+    // get_free_monster(), monster::reset() and the level loader. Whole-
+    // list scans consult this bitmap to find candidate slots instead of
+    // pulling each monster object into cache just to reject it; a set
+    // bit is only a hint, so users must still check alive() themselves.
+    FixedBitVector<MAX_MONSTERS>             mons_occupied;
+
+    // The grids the LOS, travel and cloud loops read together; keep
+    // them adjacent so those cross-grid access patterns stay within as
+    // few cache-resident regions as possible.
     feature_grid                             grid;  // terrain grid
     FixedArray<terrain_property_t, GXM, GYM> pgrid; // terrain properties
     FixedArray< unsigned short, GXM, GYM >   mgrid; // monster grid
     FixedArray< int, GXM, GYM >              igrid; // item grid
+    // Per-cell pointers to the entries of cloud below, maintained by
+    // cloud.cc so cloud_at() is a grid load instead of a map search.
+    // Rebuild with reload_cloud_grid() after editing cloud wholesale.
+    FixedArray<cloud_struct*, GXM, GYM>      cloud_grid;
     FixedArray< unsigned short, GXM, GYM >   grid_colours; // colour overrides
 
     map_mask                                 level_map_mask;
@@ -224,10 +224,10 @@ void exclude_set::add_exclude_points(travel_exclude& ex)
         return;
     }
 
+    // Reuse the cached LOS circle if it is still valid; it only has to
+    // be recomputed when a cell in its bounds has changed.
     if (!ex.uptodate)
         ex.set_los();
-    else
-        ex.los.update();
 
     for (radius_iterator ri(ex.pos, ex.radius, C_SQUARE); ri; ++ri)
         if (ex.affects(*ri))
@@ -236,15 +236,28 @@ void exclude_set::add_exclude_points(travel_exclude& ex)
 
 void exclude_set::update_excluded_points(bool recompute_los)
 {
+    // Recompute only the circles that were actually invalidated; the
+    // other exclusions keep their cached LOS results.
+    bool dirty = false;
     for (iterator it = exclude_roots.begin(); it != exclude_roots.end(); ++it)
     {
         travel_exclude &ex = it->second;
         if (!ex.uptodate)
         {
-            recompute_excluded_points(recompute_los);
-            return;
+            if (recompute_los)
+                ex.set_los();
+            dirty = true;
         }
     }
+
+    if (!dirty)
+        return;
+
+    // The overall point set still has to be rebuilt, since circles may
+    // overlap, but with the LOS results cached that is only set inserts.
+    exclude_points.clear();
+    for (iterator it = exclude_roots.begin(); it != exclude_roots.end(); ++it)
+        add_exclude_points(it->second);
 }
 
 void exclude_set::recompute_excluded_points(bool recompute_los)
@@ -334,6 +347,13 @@ void update_exclusion_los(vector<coord_def> changed)
     for (coord_def c : changed)
         _mark_excludes_non_updated(c);
 
+    // An exclusion whose LOS gets recomputed may change its footprint
+    // well away from the terrain change itself, so reclassify the travel
+    // safety of each affected circle.
+    for (const auto &entry : curr_excludes)
+        if (!entry.second.uptodate)
+            travel_safety_exclude_changed(entry.second.pos);
+
     curr_excludes.update_excluded_points(true);
 }
 
@@ -379,10 +399,19 @@ static void _tile_exclude_gmap_update(const coord_def &p)
 }
 #endif
 
-static void _exclude_update()
+static void _exclude_update_common()
 {
     set_level_exclusion_annotation(curr_excludes.get_exclusion_desc());
     travel_cache.update_excludes();
+    // Exclusion halo colouring reaches out-of-LOS cells.
+    view_invalidate_scroll();
+}
+
+static void _exclude_update()
+{
+    _exclude_update_common();
+    // No single centre to repair around, so drop the whole safety cache.
+    travel_safety_reset();
 }
 
 static void _exclude_update(const coord_def &p)
@@ -390,7 +419,9 @@ static void _exclude_update(const coord_def &p)
 #ifdef USE_TILE
     _tile_exclude_gmap_update(p);
 #endif
-    _exclude_update();
+    _exclude_update_common();
+    // Only the circle this exclusion can cover needs reclassifying.
+    travel_safety_exclude_changed(p);
 }
 
 // Catch up exclude updates from set_exclude with defer_updates=true.
@@ -599,7 +599,7 @@ public:
     item_def() : base_type(OBJ_UNASSIGNED), sub_type(0), plus(0), plus2(0),
                  special(0), rnd(0), quantity(0), flags(0),
                  pos(), link(NON_ITEM), slot(0), orig_place(),
-                 orig_monnum(0), inscription()
+                 orig_monnum(0), inscription(), cached_name_key(0)
     {
     }
 
@@ -663,6 +663,11 @@ public:
     bool is_mundane() const;
 
 private:
+    /// Memoized result of the last name_aux() call, keyed on everything
+    /// the result depends on; see item_def::name() in item-name.cc.
+    mutable string   cached_name;
+    mutable uint64_t cached_name_key;
+
     string name_aux(description_level_type desc, bool terse, bool ident,
                     bool with_inscription, iflags_t ignore_flags) const;
 
@@ -848,6 +853,9 @@ private:
 
 private:
     dgn_marker_map markers;
+    // One bit per cell with at least one marker, so the common
+    // no-marker-here queries skip the multimap entirely.
+    FixedBitArray<GXM, GYM> occupied;
     bool have_inactive_markers;
 };
 
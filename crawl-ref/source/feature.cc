@@ -6,6 +6,7 @@
 #include "libutil.h"
 #include "options.h"
 #include "player.h"
+#include "terrain.h"
 #include "viewchar.h"
 
 #include "feature-data.h"
@@ -153,6 +154,9 @@ void init_show_table()
 {
     _init_feature_index();
 
+    // The packed feature category bits are derived from this table.
+    reset_feat_category_cache();
+
     for (int i = 0; i < NUM_SHOW_ITEMS; i++)
     {
         show_item_type si = static_cast<show_item_type>(i);
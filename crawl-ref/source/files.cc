@@ -14,6 +14,7 @@
 #include <cstdlib>
 #include <cstring>
 #include <functional>
+#include <list>
 #include <string>
 #include <fcntl.h>
 #include <sys/stat.h>
@@ -34,6 +35,7 @@
 #include "cloud.h"
 #include "coordit.h"
 #include "dactions.h"
+#include "dbg-prof.h"
 #include "dgn-overview.h"
 #include "directn.h"
 #include "dungeon.h"
@@ -750,15 +752,169 @@ static void _write_ghost_version(writer &outf)
         marshallInt(outf, 0);
 }
 
-static void _write_tagged_chunk(const string &chunkname, tag_type tag)
+// Writes a serialised chunk to the save, unless the save already holds
+// a chunk of that name with identical content from earlier this session.
+// Periodic saves rewrite every chunk wholesale; skipping the unchanged
+// ones (stashes, kills, notes, untouched levels...) saves both the
+// compression work and the block churn that fragments the save file.
+static void _write_chunk_if_changed(const string &chunkname,
+                                    const vector<unsigned char> &buf)
 {
+    if (you.save->chunk_up_to_date(chunkname, buf.empty() ? nullptr : &buf[0],
+                                   buf.size()))
+    {
+        return;
+    }
+
     writer outf(you.save, chunkname);
+    if (!buf.empty())
+        outf.write(&buf[0], buf.size());
+}
+
+// In-memory cache of recently visited levels' serialized state. A level
+// transition has to serialize the level it leaves in any case, but
+// parking the bytes here lets stair-dancing's return trips skip the
+// package's compression and disk round trip in both directions. The
+// package sees level chunks only when the game saves (so a committed
+// save is exactly as consistent as before), or when an entry is evicted
+// over the level_cache_size budget. Entries are dropped when their
+// level is deleted, and the whole cache when the save file is closed.
+struct level_cache_entry
+{
+    string name;
+    vector<unsigned char> buf;
+    bool dirty;                 // not yet written to the package
+};
+
+// Most recently used first. Stair-dancing touches two or three levels,
+// so a linear scan is fine.
+static list<level_cache_entry> _level_cache;
+static size_t _level_cache_bytes = 0;
+
+static size_t _level_cache_budget()
+{
+    return (size_t)max(0, Options.level_cache_size) * 1024 * 1024;
+}
+
+static level_cache_entry *_level_cache_find(const string &name)
+{
+    for (auto it = _level_cache.begin(); it != _level_cache.end(); ++it)
+        if (it->name == name)
+        {
+            _level_cache.splice(_level_cache.begin(), _level_cache, it);
+            return &_level_cache.front();
+        }
+    return nullptr;
+}
+
+static bool _level_cache_has(const string &name)
+{
+    for (const level_cache_entry &entry : _level_cache)
+        if (entry.name == name)
+            return true;
+    return false;
+}
+
+static void _level_cache_trim(size_t budget)
+{
+    while (_level_cache_bytes > budget)
+    {
+        level_cache_entry &entry = _level_cache.back();
+        if (entry.dirty && you.save)
+            _write_chunk_if_changed(entry.name, entry.buf);
+        _level_cache_bytes -= entry.buf.size();
+        _level_cache.pop_back();
+    }
+}
+
+static void _level_cache_store(const string &name, vector<unsigned char> &&buf)
+{
+    if (!you.save || !_level_cache_budget())
+    {
+        _write_chunk_if_changed(name, buf);
+        return;
+    }
+
+    level_cache_entry *entry = _level_cache_find(name);
+    if (entry)
+        _level_cache_bytes -= entry->buf.size();
+    else
+    {
+        _level_cache.emplace_front();
+        entry = &_level_cache.front();
+        entry->name = name;
+    }
+    entry->buf = move(buf);
+    entry->dirty = true;
+    _level_cache_bytes += entry->buf.size();
+
+    _level_cache_trim(_level_cache_budget());
+}
+
+static void _level_cache_erase(const string &name)
+{
+    for (auto it = _level_cache.begin(); it != _level_cache.end(); ++it)
+        if (it->name == name)
+        {
+            _level_cache_bytes -= it->buf.size();
+            _level_cache.erase(it);
+            return;
+        }
+}
+
+// Write every dirty cached level through to the package; repeated
+// flushes of unchanged levels stop at the chunk_up_to_date check above.
+static void _level_cache_flush()
+{
+    if (!you.save)
+        return;
+
+    for (level_cache_entry &entry : _level_cache)
+        if (entry.dirty)
+        {
+            _write_chunk_if_changed(entry.name, entry.buf);
+            entry.dirty = false;
+        }
+}
+
+// Called when a save file is opened or closed: whatever is cached
+// belongs to some other game.
+void reset_level_cache()
+{
+    _level_cache.clear();
+    _level_cache_bytes = 0;
+}
+
+// Reconstruct a level from the in-memory cache, if it is there.
+static bool _level_cache_restore(const string &name)
+{
+    level_cache_entry *entry = _level_cache_find(name);
+    if (!entry)
+        return false;
+
+    reader inf(entry->buf);
+    // The buffer was serialized by this session, so the version header
+    // is known good.
+    unmarshallUByte(inf);
+    const int minor = unmarshallUByte(inf);
+    inf.setMinorVersion(minor);
+    crawl_state.minor_version = minor;
+    tag_read(inf, TAG_LEVEL);
+    inf.fail_if_not_eof(name);
+    return true;
+}
+
+static void _write_tagged_chunk(const string &chunkname, tag_type tag)
+{
+    vector<unsigned char> buf;
+    writer outf(&buf);
 
     // write version
     marshallUByte(outf, TAG_MAJOR_VERSION);
     marshallUByte(outf, TAG_MINOR_VERSION);
 
     tag_write(tag, outf);
+    _write_chunk_if_changed(chunkname, buf);
 }
 
 static int _get_dest_stair_type(branch_type old_branch,
@@ -1342,8 +1498,9 @@ bool load_level(dungeon_feature_type stair_taken, load_mode_type load_mode,
 
     bool just_created_level = false;
 
-    // GENERATE new level when the file can't be opened:
-    if (!you.save->has_chunk(level_name))
+    // GENERATE new level when the level is neither cached in memory nor
+    // in the save file:
+    if (!_level_cache_has(level_name) && !you.save->has_chunk(level_name))
     {
         ASSERT(load_mode != LOAD_VISITOR);
         dprf("Generating new level for '%s'.", level_name.c_str());
@@ -1353,7 +1510,17 @@ bool load_level(dungeon_feature_type stair_taken, load_mode_type load_mode,
     else
     {
         dprf("Loading old level '%s'.", level_name.c_str());
-        _restore_tagged_chunk(you.save, level_name, TAG_LEVEL, "Level file is invalid.");
+        if (!_level_cache_restore(level_name))
+        {
+            _restore_tagged_chunk(you.save, level_name, TAG_LEVEL,
+                                  "Level file is invalid.");
+        }
+
+        // Merge stacks that have become identical since they were
+        // dropped (typically through identification); keeps the piles
+        // short for everything that walks them later.
+        for (rectangle_iterator ri(0); ri; ++ri)
+            normalise_item_pile(*ri);
 
         _redraw_all();
     }
@@ -1558,6 +1725,8 @@ bool load_level(dungeon_feature_type stair_taken, load_mode_type load_mode,
     }
 #endif
 
+    prof_note_level_load();
+
     return just_created_level;
 }
 
@@ -1568,7 +1737,15 @@ static void _save_level(const level_id& lid)
     // Nail all items to the ground.
     fix_item_coordinates();
 
-    _write_tagged_chunk(lid.describe(), TAG_LEVEL);
+    vector<unsigned char> buf;
+    writer outf(&buf);
+    marshallUByte(outf, TAG_MAJOR_VERSION);
+    marshallUByte(outf, TAG_MINOR_VERSION);
+    tag_write(TAG_LEVEL, outf);
+
+    // Park the serialized level in the in-memory cache; it reaches the
+    // package when the game saves, or on eviction.
+    _level_cache_store(lid.describe(), move(buf));
 }
 
 #if TAG_MAJOR_VERSION == 34
@@ -1577,11 +1754,13 @@ static void _save_level(const level_id& lid)
 # define CHUNK(short, long) long
 #endif
 
-#define SAVEFILE(short, long, savefn)           \
-    do                                          \
-    {                                           \
-        writer w(you.save, CHUNK(short, long)); \
-        savefn(w);                              \
+#define SAVEFILE(short, long, savefn)                 \
+    do                                                \
+    {                                                 \
+        vector<unsigned char> buf;                    \
+        writer w(&buf);                               \
+        savefn(w);                                    \
+        _write_chunk_if_changed(CHUNK(short, long), buf); \
     } while (false)
 
 // Stack allocated string's go in separate function, so Valgrind doesn't
@@ -1612,6 +1791,9 @@ static void _save_game_base()
     /* messages */
     SAVEFILE("msg", "messages", save_messages);
 
+    /* older message history; only ever read lazily on Ctrl-P */
+    SAVEFILE("msh", "message_hist", save_message_history);
+
     /* tile dolls (empty for ASCII)*/
 #ifdef USE_TILE
     // Save the current equipment into a file.
@@ -1639,6 +1821,8 @@ static void _save_game_exit()
     // Must be exiting -- save level & goodbye!
     if (!you.entering_level)
         _save_level(level_id::current());
+    _level_cache_flush();
+    reset_level_cache();
 
     clrscr();
 
@@ -1680,7 +1864,15 @@ void save_game(bool leave_game, const char *farewellmsg)
     if (!leave_game)
     {
         if (!crawl_state.disables[DIS_SAVE_CHECKPOINTS])
+        {
+            // Include the current level, so the checkpoint is a
+            // consistent snapshot rather than pairing a fresh player
+            // with the level as it looked on entry.
+            if (!you.entering_level)
+                _save_level(level_id::current());
+            _level_cache_flush();
             you.save->commit();
+        }
         return;
     }
 
@@ -1708,6 +1900,34 @@ static string _make_ghost_filename()
 
 #define BONES_DIAGNOSTICS (defined(WIZARD) || defined(DEBUG_BONES) | defined(DEBUG_DIAGNOSTICS))
 
+// A busy server's bones pool can hold thousands of files, and listing
+// the directory on every level generation and ghost save dominates the
+// bones cost. Cache the listing, keyed on the directory's mtime so
+// bones written or consumed by other processes are noticed. mtime has
+// one-second granularity, so a listing can briefly go stale; at worst
+// that offers up a bones file another game already consumed, which the
+// loader tolerates (the open fails and no ghost is placed).
+static string _bones_dir_cached;
+static time_t _bones_dir_mtime;
+static vector<string> _bones_dir_files;
+
+static void _invalidate_bones_dir_cache()
+{
+    _bones_dir_cached.clear();
+}
+
+static const vector<string> &_get_bones_dir_files(const string &dir)
+{
+    const time_t mtime = file_modtime(dir);
+    if (!mtime || dir != _bones_dir_cached || mtime != _bones_dir_mtime)
+    {
+        _bones_dir_cached = dir;
+        _bones_dir_mtime = mtime;
+        _bones_dir_files = get_dir_files(dir);
+    }
+    return _bones_dir_files;
+}
+
 /**
  * Lists all bonefiles for the current level.
  *
@@ -1719,7 +1939,7 @@ static vector<string> _list_bones()
     string base_filename = _make_ghost_filename();
     string underscored_filename = base_filename + "_";
 
-    vector<string> filenames = get_dir_files(bonefile_dir);
+    const vector<string> &filenames = _get_bones_dir_files(bonefile_dir);
     vector<string> bonefiles;
     for (const auto &filename : filenames)
         if (starts_with(filename, underscored_filename))
@@ -1790,6 +2010,7 @@ static vector<ghost_demon> _load_ghost_vec(bool creating_level, bool wiz_cmd)
         mprf(MSGCH_ERROR, "Failed to unlink bones file: %s",
                 ghost_filename.c_str());
     }
+    _invalidate_bones_dir_cache();
 
     if (!debug_check_ghosts(result))
     {
@@ -1923,6 +2144,7 @@ static bool _restore_game(const string& filename)
 
     clear_message_store();
 
+    reset_level_cache();
     you.save = new package((_get_savefile_directory() + filename).c_str(), true);
 
     if (!_read_char_chunk(you.save))
@@ -2021,6 +2243,10 @@ static bool _restore_game(const string& filename)
         load_messages(inf);
     }
 
+    /* older message history stays on disk until someone scrolls back */
+    if (you.save->has_chunk(CHUNK("msh", "message_hist")))
+        defer_message_history_load(minorVersion);
+
     return true;
 }
 
@@ -2061,7 +2287,8 @@ static void _load_level(const level_id &level)
 // in this game.
 bool is_existing_level(const level_id &level)
 {
-    return you.save && you.save->has_chunk(level.describe());
+    return you.save && (_level_cache_has(level.describe())
+                        || you.save->has_chunk(level.describe()));
 }
 
 void delete_level(const level_id &level)
@@ -2073,6 +2300,7 @@ void delete_level(const level_id &level)
     clear_level_exclusion_annotation(level);
     clear_level_annotations(level);
 
+    _level_cache_erase(level.describe());
     if (you.save)
         you.save->delete_chunk(level.describe());
     if (level.branch == BRANCH_ABYSS)
@@ -2452,6 +2680,7 @@ void save_ghosts(const vector<ghost_demon> &ghosts, bool force)
     tag_write_ghosts(outw, ghosts);
 
     lk_close(ghost_file, g_file_name);
+    _invalidate_bones_dir_cache();
 
 #ifdef BONES_DIAGNOSTICS
     if (do_diagnostics)
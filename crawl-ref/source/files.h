@@ -95,6 +95,8 @@ bool restore_game(const string& filename);
 
 bool is_existing_level(const level_id &level);
 
+void reset_level_cache();
+
 class level_excursion
 {
 protected:
@@ -35,6 +35,14 @@ public:
         init(def);
     }
 
+#ifdef DEBUG_GRID_HEAT
+    // Per-array access counter for auditing which grids the current
+    // workload actually hammers; see debug_dump_grid_heat(). Counting
+    // happens only in the coord-indexed accessors, which is where the
+    // per-cell grid reads of interest go through.
+    mutable unsigned long long heat = 0;
+#endif
+
 public:
     // ----- Size -----
     bool empty() const { return WIDTH == 0 || HEIGHT == 0; }
@@ -52,6 +60,9 @@ public:
     template<class Indexer>
     TYPE& operator () (const Indexer &i)
     {
+#ifdef DEBUG_GRID_HEAT
+        heat++;
+#endif
         return mData[i.x][i.y];
     }
 
@@ -64,6 +75,9 @@ public:
     template<class Indexer>
     const TYPE& operator () (const Indexer &i) const
     {
+#ifdef DEBUG_GRID_HEAT
+        heat++;
+#endif
         return mData[i.x][i.y];
     }
 
@@ -13,6 +13,7 @@
 #include "files.h"
 #include "format.h"
 #include "glwrapper.h"
+#include "hash.h"
 #include "options.h"
 #include "syscalls.h"
 #include "tilebuf.h"
@@ -71,19 +72,26 @@ FTFontWrapper::FTFontWrapper() :
     pixels(nullptr),
     fsize(0)
 {
-    m_buf = GLShapeBuffer::create(true, true);
+    m_atlas_version = 0;
 }
 
 FTFontWrapper::~FTFontWrapper()
 {
+    clear_textblock_cache();
     delete[] m_atlas;
     delete[] pixels;
-    delete m_buf;
     if (face)
         FT_Done_Face(face);
     delete[] ttf;
 }
 
+void FTFontWrapper::clear_textblock_cache()
+{
+    for (auto &entry : m_textblock_cache)
+        delete entry.second.buf;
+    m_textblock_cache.clear();
+}
+
 /**
  * Configure the font based on metrics, and initialize caches. This may be
  * called multiple times when cached information needs to be reset, e.g. upon
@@ -142,6 +150,8 @@ bool FTFontWrapper::configure_font()
     m_tex.load_texture(nullptr, m_ft_width, m_ft_height, MIPMAP_NONE);
 
     m_glyphs.clear();
+    clear_textblock_cache();
+    m_atlas_version++;
 
     for (int i = 0; i < MAX_GLYPHS; i++)
         m_atlas[i] = FontAtlasEntry();
@@ -330,6 +340,8 @@ unsigned int FTFontWrapper::map_unicode(char32_t uchar)
         m_atlas[c].uchar = uchar;
         load_glyph(c, uchar);
         n_subst++;
+        // Cached text blocks may reference the reassigned slot.
+        m_atlas_version++;
     }
 
     auto it = find(m_atlas_lru.begin(), m_atlas_lru.end(), (uint8_t)c);
@@ -349,11 +361,37 @@ void FTFontWrapper::render_textblock(unsigned int x_pos, unsigned int y_pos,
     if (!chars || !colours || !width || !height || !m_atlas)
         return;
 
+    // The text regions render from long-lived arrays whose contents
+    // rarely change between frames, so memoize the packed vertex data
+    // per array and replay it when the block is unchanged.
+    uint64_t block_hash =
+        (uint64_t)hash32(chars, width * height * sizeof(char32_t)) << 32
+        | hash32(colours, width * height * sizeof(uint8_t));
+    block_hash ^= (uint64_t)width ^ (uint64_t)height << 20
+                  ^ (drop_shadow ? (uint64_t)1 << 40 : 0);
+
+    // Transient callers (stack buffers) can grow the cache; toss it
+    // rather than track lifetimes.
+    if (m_textblock_cache.size() > 16)
+        clear_textblock_cache();
+
+    TextBlockEntry &entry = m_textblock_cache[chars];
+    if (entry.buf && entry.cacheable && entry.hash == block_hash
+        && entry.atlas_version == m_atlas_version)
+    {
+        draw_text_buf(*entry.buf, x_pos, y_pos, drop_shadow);
+        return;
+    }
+
+    if (!entry.buf)
+        entry.buf = GLShapeBuffer::create(true, true);
+    GLShapeBuffer *const buf = entry.buf;
+
     coord_def adv(max(-m_min_offset, 0), 0);
     unsigned int i = 0;
 
-    ASSERT(m_buf);
-    m_buf->clear();
+    buf->clear();
+    entry.cacheable = true;
     n_subst = 0;
 
     float texcoord_dy = (float)m_max_height / (float)m_tex.height();
@@ -374,7 +412,7 @@ void FTFontWrapper::render_textblock(unsigned int x_pos, unsigned int y_pos,
                             term_colours[col_bg].g,
                             term_colours[col_bg].b);
                 rect.set_col(col);
-                m_buf->add(rect);
+                buf->add(rect);
             }
 
             adv.x += glyph.offset;
@@ -398,7 +436,7 @@ void FTFontWrapper::render_textblock(unsigned int x_pos, unsigned int y_pos,
                 rect.set_col(col);
                 rect.set_tex(tex_x, tex_y, tex_x2, tex_y2);
 
-                m_buf->add(rect);
+                buf->add(rect);
             }
 
             i++;
@@ -407,8 +445,11 @@ void FTFontWrapper::render_textblock(unsigned int x_pos, unsigned int y_pos,
             // See if we need to flush prematurely.
             if (n_subst == MAX_GLYPHS - 1)
             {
-                draw_m_buf(x_pos, y_pos, drop_shadow);
-                m_buf->clear();
+                // The block cycled through the whole atlas; the partial
+                // vertex data drawn here can't be replayed later.
+                entry.cacheable = false;
+                draw_text_buf(*buf, x_pos, y_pos, drop_shadow);
+                buf->clear();
                 n_subst = 0;
             }
         }
@@ -417,13 +458,17 @@ void FTFontWrapper::render_textblock(unsigned int x_pos, unsigned int y_pos,
         adv.y += m_max_advance.y;
     }
 
-    draw_m_buf(x_pos, y_pos, drop_shadow);
+    draw_text_buf(*buf, x_pos, y_pos, drop_shadow);
+    // Only validate the entry now: packing may itself have loaded glyphs
+    // and bumped the atlas version.
+    entry.hash = block_hash;
+    entry.atlas_version = m_atlas_version;
 }
 
-void FTFontWrapper::draw_m_buf(unsigned int x_pos, unsigned int y_pos,
-                               bool drop_shadow)
+void FTFontWrapper::draw_text_buf(GLShapeBuffer &buf, unsigned int x_pos,
+                                  unsigned int y_pos, bool drop_shadow)
 {
-    if (!m_buf->size())
+    if (!buf.size())
         return;
 
     GLState state;
@@ -448,11 +493,11 @@ void FTFontWrapper::draw_m_buf(unsigned int x_pos, unsigned int y_pos,
         GLW_3VF trans_shadow(trans.x + 1, trans.y + 1, 0.0f);
         glmanager->set_transform(trans_shadow, scale);
 
-        m_buf->draw(state_shadow);
+        buf.draw(state_shadow);
     }
 
     glmanager->set_transform(trans, scale);
-    m_buf->draw(state);
+    buf.draw(state);
 
     glmanager->reset_transform();
 }
@@ -88,7 +88,9 @@ protected:
     unsigned int map_unicode(char32_t uchar, bool update);
     unsigned int map_unicode(char32_t uchar);
     void load_glyph(unsigned int c, char32_t uchar);
-    void draw_m_buf(unsigned int x_pos, unsigned int y_pos, bool drop_shadow);
+    void draw_text_buf(GLShapeBuffer &buf, unsigned int x_pos,
+                       unsigned int y_pos, bool drop_shadow);
+    void clear_textblock_cache();
 
     struct GlyphInfo
     {
@@ -141,7 +143,22 @@ protected:
     int m_max_height;
 
     GenericTexture m_tex;
-    GLShapeBuffer *m_buf;
+
+    // Packed vertex data of recently rendered text blocks, keyed on the
+    // caller's character array: the message pane and sidebar re-render
+    // a mostly unchanged block every frame. Content changes are caught
+    // by the hash; atlas slot reuse invalidates via m_atlas_version.
+    struct TextBlockEntry
+    {
+        TextBlockEntry() : hash(0), atlas_version(0), cacheable(false),
+                           buf(nullptr) {}
+        uint64_t hash;
+        unsigned int atlas_version;
+        bool cacheable;
+        GLShapeBuffer *buf;
+    };
+    map<const char32_t *, TextBlockEntry> m_textblock_cache;
+    unsigned int m_atlas_version;
 
     FT_Byte *ttf;
     FT_Face face;
@@ -74,6 +74,20 @@ void display_tagged_block(const string &s)
 formatted_string formatted_string::parse_string(const string &s,
                                                 int main_colour)
 {
+    // Menus, the sidebar and describe screens re-parse the same tagged
+    // strings on every redraw, so memoize parses of strings that
+    // actually contain tags. Tag-free strings parse in a single cheap
+    // pass and aren't worth the storage.
+    static map<pair<string, int>, formatted_string> parse_cache;
+
+    const bool cacheable = s.find('<') != string::npos;
+    if (cacheable)
+    {
+        auto it = parse_cache.find(make_pair(s, main_colour));
+        if (it != parse_cache.end())
+            return it->second;
+    }
+
     // main_colour will usually be LIGHTGREY (default).
     vector<int> colour_stack(1, main_colour);
 
@@ -82,6 +96,14 @@ formatted_string formatted_string::parse_string(const string &s,
     parse_string1(s, fs, colour_stack);
     if (colour_stack.back() != colour_stack.front())
         fs.textcolour(colour_stack.front()); // XXX: this does nothing
+
+    if (cacheable)
+    {
+        // Crude bound; a menu's worth of strings fits comfortably.
+        if (parse_cache.size() >= 1000)
+            parse_cache.clear();
+        parse_cache[make_pair(s, main_colour)] = fs;
+    }
     return fs;
 }
 
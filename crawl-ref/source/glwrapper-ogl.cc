@@ -76,9 +76,7 @@ OGLStateManager::OGLStateManager()
     glClearColor(0.0, 0.0, 0.0, 1.0f);
     glDepthFunc(GL_LEQUAL);
 
-#ifdef __ANDROID__
     m_last_tex = 0;
-#endif
     m_window_height = 0;
 }
 
@@ -275,6 +273,11 @@ void OGLStateManager::pixelstore_unpack_alignment(unsigned int bpp)
 
 void OGLStateManager::delete_textures(size_t count, unsigned int *textures)
 {
+    // The driver may hand a deleted name back out from generate_textures,
+    // so don't let it satisfy the redundant-bind check.
+    for (size_t i = 0; i < count; ++i)
+        if (textures[i] == m_last_tex)
+            m_last_tex = 0;
     glDeleteTextures(count, (GLuint*)textures);
     glDebug("glDeleteTextures");
 }
@@ -287,11 +290,14 @@ void OGLStateManager::generate_textures(size_t count, unsigned int *textures)
 
 void OGLStateManager::bind_texture(unsigned int texture)
 {
+    // Consecutive buffer draws very often share a texture (fonts, GUI
+    // panes, the doll and main sheets), so drop redundant binds here
+    // rather than making every caller track what is bound.
+    if (texture == m_last_tex)
+        return;
     glBindTexture(GL_TEXTURE_2D, texture);
     glDebug("glBindTexture");
-#ifdef __ANDROID__
     m_last_tex = texture;
-#endif
 }
 
 void OGLStateManager::load_texture(unsigned char *pixels, unsigned int width,
@@ -566,6 +572,16 @@ void OGLShapeBuffer::add_rect(const GLWPrim &rect)
     }
 }
 
+void OGLShapeBuffer::set_rect_colour(unsigned int rect, const VColour &col)
+{
+    ASSERT(m_prim_type == GLW_RECTANGLE);
+    ASSERT(m_colour_verts);
+    const size_t first = (size_t)rect * 4;
+    ASSERT(first + 4 <= m_colour_buffer.size());
+    for (size_t i = first; i < first + 4; ++i)
+        m_colour_buffer[i].set(col);
+}
+
 void OGLShapeBuffer::add_line(const GLWPrim &rect)
 {
     // Copy vert positions
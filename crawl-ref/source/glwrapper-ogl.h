@@ -38,9 +38,7 @@ public:
     int device_to_logical(int n, bool round=true) const override;
 protected:
     GLState m_current_state;
-#ifdef __ANDROID__
-    GLint m_last_tex;
-#endif
+    unsigned int m_last_tex;
     int m_window_height;
 
 private:
@@ -57,6 +55,7 @@ public:
     virtual unsigned int size() const override;
 
     virtual void add(const GLWPrim &rect) override;
+    virtual void set_rect_colour(unsigned int rect, const VColour &col) override;
     virtual void draw(const GLState &state) override;
     virtual void clear() override;
 
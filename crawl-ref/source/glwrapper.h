@@ -185,6 +185,9 @@ public:
     // Add a primitive to be drawn.
     virtual void add(const GLWPrim &prim) = 0;
 
+    // Recolour an already-added rectangle in place.
+    virtual void set_rect_colour(unsigned int rect, const VColour &col) = 0;
+
     // Draw all the primitives in the buffer.
     virtual void draw(const GLState &state) = 0;
 
@@ -998,12 +998,40 @@ static bool _god_likes_killing(const monster& victim)
     return !god_hates_attacking_friend(you.religion, victim);
 }
 
+// The response tables never change after static initialisation, so
+// the overwhelmingly common case — a conduct the player's god has no
+// registered response to at all — can be answered with one bitmask
+// test instead of two map lookups; kill-heavy turns fire dozens of
+// conduct events, nearly all of them no-ops.
+static uint64_t _relevant_conduct_mask(god_type god)
+{
+    COMPILE_CHECK(NUM_CONDUCTS <= 64);
+
+    static uint64_t masks[NUM_GODS];
+    static bool built = false;
+    if (!built)
+    {
+        for (int g = 0; g < NUM_GODS; ++g)
+        {
+            for (const auto& entry : divine_peeves[g])
+                masks[g] |= UINT64_C(1) << entry.first;
+            for (const auto& entry : divine_likes[g])
+                masks[g] |= UINT64_C(1) << entry.first;
+        }
+        built = true;
+    }
+    return masks[god];
+}
+
 static void _handle_your_gods_response(conduct_type thing_done, int level,
                                        bool known, const monster* victim)
 {
     COMPILE_CHECK(ARRAYSZ(divine_peeves) == NUM_GODS);
     COMPILE_CHECK(ARRAYSZ(divine_likes) == NUM_GODS);
 
+    if (!(_relevant_conduct_mask(you.religion) & UINT64_C(1) << thing_done))
+        return;
+
     // Lucy gives no piety in Abyss. :(
     // XXX: make this not a hack...? (or remove it?)
     if (you_worship(GOD_LUGONU) && player_in_branch(BRANCH_ABYSS))
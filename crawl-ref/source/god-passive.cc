@@ -428,16 +428,45 @@ static const vector<god_passive> god_passives[] =
 };
 COMPILE_CHECK(ARRAYSZ(god_passives) == NUM_GODS);
 
+// Cache of the currently active passive set. have_passive() is called
+// from nearly every hot path (item identification, regen, combat), and
+// the underlying inputs -- god, piety, penance -- change far less often
+// than it is queried, so recompute only when they do.
+static bool _active_passives[256];
+static god_type _passive_cache_god = NUM_GODS;
+static int _passive_cache_piety = -1;
+static int _passive_cache_penance = -1;
+
+static void _refresh_passive_cache()
+{
+    if (_passive_cache_god == you.religion
+        && _passive_cache_piety == you.piety
+        && _passive_cache_penance == you.penance[you.religion])
+    {
+        return;
+    }
+
+    memset(_active_passives, 0, sizeof(_active_passives));
+    for (const god_passive &p : god_passives[you.religion])
+    {
+        if (piety_rank() >= p.rank
+            && (!player_under_penance() || p.rank < 0))
+        {
+            _active_passives[static_cast<int>(p.pasv)] = true;
+        }
+    }
+
+    _passive_cache_god = you.religion;
+    _passive_cache_piety = you.piety;
+    _passive_cache_penance = you.penance[you.religion];
+}
+
 bool have_passive(passive_t passive)
 {
-    const auto &pasvec = god_passives[you.religion];
-    return any_of(begin(pasvec), end(pasvec),
-                  [passive] (const god_passive &p) -> bool
-                  {
-                      return p.pasv == passive
-                          && piety_rank() >= p.rank
-                          && (!player_under_penance() || p.rank < 0);
-                  });
+    COMPILE_CHECK(static_cast<int>(passive_t::wu_jian_wall_jump)
+                  < (int) ARRAYSZ(_active_passives));
+    _refresh_passive_cache();
+    return _active_passives[static_cast<int>(passive)];
 }
 
 bool will_have_passive(passive_t passive)
@@ -783,6 +812,11 @@ static bool _is_slot_cursed(equipment_type eq)
 
 bool god_id_item(item_def& item, bool silent)
 {
+    // Item movement re-runs this for every item the player can see;
+    // anything already fully identified has nothing left to learn.
+    if ((item.flags & ISFLAG_IDENT_MASK) == ISFLAG_IDENT_MASK)
+        return false;
+
     iflags_t old_ided = item.flags & ISFLAG_IDENT_MASK;
     iflags_t ided = 0;
 
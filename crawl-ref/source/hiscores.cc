@@ -91,13 +91,24 @@ static string _log_file_name()
     return Options.shared_dir + "logfile" + crawl_state.game_type_qualifier();
 }
 
+// Returns the value of the "sc" field of a raw scoreline, or -1 if the
+// line has none. The scorefile is kept sorted by score, so the insertion
+// scan in hiscores_new_entry only needs this one field; fully parsing
+// (and later reformatting) every entry is what made each game end
+// rewrite the whole scoreboard at full cost.
+static int _score_from_scoreline(const string &line)
+{
+    for (const string &field : _xlog_split_fields(line))
+        if (field.compare(0, 3, "sc=") == 0)
+            return atoi(field.c_str() + 3);
+    return -1;
+}
+
 int hiscores_new_entry(const scorefile_entry &ne)
 {
     unwind_bool score_update(crawl_state.updating_scores, true);
 
     FILE *scores;
-    int i, total_entries;
-    bool inserted = false;
     int newest_entry = -1;
 
     // open highscore file (reading) -- nullptr is fatal!
@@ -111,49 +122,39 @@ int hiscores_new_entry(const scorefile_entry &ne)
     // we're at the end of the file, seek back to beginning.
     fseek(scores, 0, SEEK_SET);
 
-    // read highscore file, inserting new entry at appropriate point,
-    for (i = 0; i < SCORE_FILE_ENTRIES; i++)
+    // Read raw scorelines, locating the insertion point by score alone.
+    // Lines that merely shift down are copied back out verbatim, and a
+    // score below a full scoreboard's cutoff leaves the file untouched.
+    vector<string> lines;
+    char inbuf[1300];
+    while ((int)lines.size() < SCORE_FILE_ENTRIES
+           && fgets(inbuf, sizeof inbuf, scores))
     {
-        hs_list[i].reset(new scorefile_entry);
-        if (_hs_read(scores, *hs_list[i]) == false)
-            break;
-
-        // compare points..
-        if (!inserted && ne.get_score() >= hs_list[i]->get_score())
+        if (newest_entry == -1)
         {
-            newest_entry = i;           // for later printing
-            inserted = true;
-            // copy read entry to i+1th position
-            // Fixed a nasty overflow bug here -- Sharp
-            if (i+1 < SCORE_FILE_ENTRIES)
-            {
-                hs_list[i + 1] = move(hs_list[i]);
-                hs_list[i].reset(new scorefile_entry(ne));
-                i++;
-            }
-            else
-                *hs_list[i] = ne; // copy new entry to current position
+            const int sc = _score_from_scoreline(inbuf);
+            if (sc < 0)
+                break;      // unparseable tail, drop it as before
+            if (ne.get_score() >= sc)
+                newest_entry = lines.size();
         }
+        lines.push_back(inbuf);
     }
 
-    // special case: lowest score, with room
-    if (!inserted && i < SCORE_FILE_ENTRIES)
-    {
-        newest_entry = i;
-        inserted = true;
-        // copy new entry
-        hs_list[i].reset(new scorefile_entry(ne));
-        i++;
-    }
+    // Lowest score, with room?
+    if (newest_entry == -1 && (int)lines.size() < SCORE_FILE_ENTRIES)
+        newest_entry = lines.size();
 
-    // If we've still not inserted it, it's not a highscore.
-    if (!inserted)
+    // If we've still not found a slot, it's not a highscore.
+    if (newest_entry == -1)
     {
         _hs_close(scores, _score_file_name());
         return -1;
     }
 
-    total_entries = i;
+    lines.insert(lines.begin() + newest_entry, string());
+    if ((int)lines.size() > SCORE_FILE_ENTRIES)
+        lines.resize(SCORE_FILE_ENTRIES);
 
     // The old code closed and reopened the score file, leading to a
     // race condition where one Crawl process could overwrite the
@@ -165,10 +166,13 @@ int hiscores_new_entry(const scorefile_entry &ne)
     rewind(scores);
 
     // write scorefile entries.
-    for (i = 0; i < total_entries; i++)
+    scorefile_entry ne_copy = ne;
+    for (int i = 0; i < (int)lines.size(); i++)
     {
-        _hs_write(scores, *hs_list[i]);
-        hs_list[i].reset(nullptr);
+        if (i == newest_entry)
+            _hs_write(scores, ne_copy);
+        else
+            fputs(lines[i].c_str(), scores);
     }
 
     // close scorefile.
@@ -244,6 +244,7 @@ const vector<GameOption*> game_options::build_options_list()
         new IntGameOption(SIMPLE_NAME(hp_warning), 30, 0, 100),
         new IntGameOption(magic_point_warning, {"mp_warning"}, 0, 0, 100),
         new IntGameOption(SIMPLE_NAME(autofight_warning), 0, 0, 1000),
+        new IntGameOption(SIMPLE_NAME(slow_turn_capture_ms), 0, 0, 60000),
         // These need to be odd, hence allow +1.
         new IntGameOption(SIMPLE_NAME(view_max_width),
                       max(VIEW_BASE_WIDTH, VIEW_MIN_WIDTH),
@@ -267,6 +268,7 @@ const vector<GameOption*> game_options::build_options_list()
         new IntGameOption(SIMPLE_NAME(explore_delay), -1, -1, 2000),
         new IntGameOption(SIMPLE_NAME(explore_item_greed), 10, -1000, 1000),
         new IntGameOption(SIMPLE_NAME(explore_wall_bias), 0, 0, 1000),
+        new IntGameOption(SIMPLE_NAME(level_cache_size), 32, 0, 1024),
         new IntGameOption(SIMPLE_NAME(scroll_margin_x), 2, 0),
         new IntGameOption(SIMPLE_NAME(scroll_margin_y), 2, 0),
         new IntGameOption(SIMPLE_NAME(item_stack_summary_minimum), 4),
@@ -371,6 +373,8 @@ const vector<GameOption*> game_options::build_options_list()
         new BoolGameOption(SIMPLE_NAME(tile_level_map_hide_messages), true),
         new BoolGameOption(SIMPLE_NAME(tile_level_map_hide_sidebar), false),
         new BoolGameOption(SIMPLE_NAME(tile_web_mouse_control), true),
+        new IntGameOption(SIMPLE_NAME(tile_web_idle_trim_delay), 300, 0,
+                          INT_MAX),
         new StringGameOption(SIMPLE_NAME(tile_font_crt_family), "monospace"),
         new StringGameOption(SIMPLE_NAME(tile_font_msg_family), "monospace"),
         new StringGameOption(SIMPLE_NAME(tile_font_stat_family), "monospace"),
@@ -2521,32 +2525,27 @@ void game_options::read_option_line(const string &str, bool runscript)
     // Keep unlowercased field around
     const string orig_field = field;
 
-    if (key != "name" && key != "crawl_dir" && key != "macro_dir"
-        && key != "combo"
-        && key != "species" && key != "background" && key != "job"
-        && key != "race" && key != "class" && key != "ban_pickup"
-        && key != "autopickup_exceptions"
-        && key != "explore_stop_pickup_ignore"
-        && key != "stop_travel"
-        && key != "force_more_message"
-        && key != "flash_screen_message"
-        && key != "confirm_action"
-        && key != "drop_filter" && key != "lua_file" && key != "terp_file"
-        && key != "note_items" && key != "autoinscribe"
-        && key != "note_monsters" && key != "note_messages"
-        && key != "display_char" && !starts_with(key, "cset") // compatibility
-        && key != "dungeon" && key != "feature"
-        && key != "mon_glyph" && key != "item_glyph"
-        && key != "fire_items_start"
-        && key != "opt" && key != "option"
-        && key != "menu_colour" && key != "menu_color"
-        && key != "message_colour" && key != "message_color"
-        && key != "levels" && key != "level" && key != "entries"
-        && key != "include" && key != "bindkey"
-        && key != "spell_slot"
-        && key != "item_slot"
-        && key != "ability_slot"
-        && key != "sound" && key != "hold_sound" && key != "sound_file_path"
+    // Keys whose field must keep its case. This runs for every rc line,
+    // so membership is checked against a set rather than a chain of
+    // string comparisons.
+    static const set<string> preserve_case_keys =
+    {
+        "name", "crawl_dir", "macro_dir", "combo",
+        "species", "background", "job", "race", "class", "ban_pickup",
+        "autopickup_exceptions", "explore_stop_pickup_ignore",
+        "stop_travel", "force_more_message", "flash_screen_message",
+        "confirm_action", "drop_filter", "lua_file", "terp_file",
+        "note_items", "autoinscribe", "note_monsters", "note_messages",
+        "display_char",
+        "dungeon", "feature", "mon_glyph", "item_glyph",
+        "fire_items_start", "opt", "option",
+        "menu_colour", "menu_color", "message_colour", "message_color",
+        "levels", "level", "entries", "include", "bindkey",
+        "spell_slot", "item_slot", "ability_slot",
+        "sound", "hold_sound", "sound_file_path",
+    };
+    if (!preserve_case_keys.count(key)
+        && !starts_with(key, "cset") // compatibility
         && key.find("font") == string::npos)
     {
         lowercase(field);
@@ -3775,6 +3774,7 @@ enum commandline_option_type
     CLO_MAPSTAT,
     CLO_MAPSTAT_DUMP_DISCONNECT,
     CLO_OBJSTAT,
+    CLO_GENBENCH,
     CLO_ITERATIONS,
     CLO_FORCE_MAP,
     CLO_ARENA,
@@ -3782,6 +3782,7 @@ enum commandline_option_type
     CLO_TEST,
     CLO_SCRIPT,
     CLO_BUILDDB,
+    CLO_BUILDDB_DES,
     CLO_HELP,
     CLO_VERSION,
     CLO_SEED,
@@ -3801,6 +3802,8 @@ enum commandline_option_type
     CLO_THROTTLE,
     CLO_NO_THROTTLE,
     CLO_PLAYABLE_JSON, // JSON metadata for species, jobs, combos.
+    CLO_RECORD_KEYS,
+    CLO_REPLAY_KEYS,
 #ifdef USE_TILE_WEB
     CLO_WEBTILES_SOCKET,
     CLO_AWAIT_CONNECTION,
@@ -3814,11 +3817,14 @@ static const char *cmd_ops[] =
 {
     "scores", "name", "species", "background", "dir", "rc", "rcdir", "tscores",
     "vscores", "scorefile", "morgue", "macro", "mapstat", "dump-disconnect",
-    "objstat", "iters", "force-map", "arena", "dump-maps", "test", "script",
-    "builddb", "help", "version", "seed", "save-version", "sprint",
+    "objstat", "genbench", "iters", "force-map", "arena", "dump-maps", "test",
+    "script",
+    "builddb", "builddb-des", "help", "version", "seed", "save-version",
+    "sprint",
     "extra-opt-first", "extra-opt-last", "sprint-map", "edit-save",
     "print-charset", "tutorial", "wizard", "explore", "no-save", "gdb",
     "no-gdb", "nogdb", "throttle", "no-throttle", "playable-json",
+    "record-keys", "replay-keys",
 #ifdef USE_TILE_WEB
     "webtiles-socket", "await-connection", "print-webtiles-options",
 #endif
@@ -3910,7 +3916,7 @@ static struct es_command
     { ES_GET,     "get",     false, 1, 2, },
     { ES_PUT,     "put",     true,  1, 2, },
     { ES_RM,      "rm",      true,  1, 1, },
-    { ES_REPACK,  "repack",  false, 0, 0, },
+    { ES_REPACK,  "repack",  false, 0, 1, },
     { ES_INFO,    "info",    false, 0, 0, },
 };
 
@@ -3925,7 +3931,9 @@ static void _edit_save(int argc, char **argv)
                "  put <chunk> [<chunkfile>]   import a chunk from <chunkfile>\n"
                "     <chunkfile> defaults to \"chunk\"; use \"-\" for stdout/stdin\n"
                "  rm <chunk>                  delete a chunk\n"
-               "  repack                      defrag and reclaim unused space\n"
+               "  repack [<percent>]          defrag and reclaim unused space;\n"
+               "     with <percent>, only if at least that much of the file is garbage,\n"
+               "     so a server can sweep idle saves without rewriting packed ones\n"
              );
         return;
     }
@@ -4028,6 +4036,19 @@ static void _edit_save(int argc, char **argv)
         }
         else if (cmd == ES_REPACK)
         {
+            if (argc == 3)
+            {
+                // Garbage threshold: checking costs only a directory
+                // read, so sweeping every save on a server is cheap and
+                // well-packed ones aren't rewritten.
+                const int minpct = atoi(argv[2]);
+                if (minpct < 0 || minpct > 100)
+                    FAIL("Invalid percentage \"%s\".\n", argv[2]);
+                const plen_t flen = save.get_size();
+                const plen_t slack = save.get_slack();
+                if ((int)(100 - 100 * (flen - slack) / flen) < minpct)
+                    return;
+            }
             package save2((filename + ".tmp").c_str(), true, true);
             for (const string &chunk : save.list_chunks())
             {
@@ -4414,6 +4435,33 @@ bool parse_args(int argc, char **argv, bool rc_only)
             fprintf(stderr, "%s", dbg_stat_err);
             end(1);
 #endif
+        case CLO_GENBENCH:
+#ifdef DEBUG_STATISTICS
+            // Implies mapstat's build machinery; combine with -mapstat
+            // <depths> to restrict the corpus to particular branches.
+            crawl_state.map_stat_gen = true;
+            crawl_state.gen_bench    = true;
+#ifdef USE_TILE_LOCAL
+            crawl_state.tiles_disabled = true;
+#endif
+            if (!SysEnv.map_gen_iters)
+                SysEnv.map_gen_iters = 10;
+            if (next_is_param && isadigit(*next_arg))
+            {
+                // Regression gates: p95 build time in ms, optionally
+                // followed by a veto percentage: -genbench 500,30
+                if (sscanf(next_arg, "%d,%d", &crawl_state.genbench_p95_ms,
+                           &crawl_state.genbench_veto_percent) >= 1)
+                {
+                    nextUsed = true;
+                }
+            }
+            break;
+#else
+            fprintf(stderr, "%s", dbg_stat_err);
+            end(1);
+#endif
+
         case CLO_MAPSTAT_DUMP_DISCONNECT:
 #ifdef DEBUG_STATISTICS
             crawl_state.map_stat_dump_disconnect = true;
@@ -4517,6 +4565,20 @@ bool parse_args(int argc, char **argv, bool rc_only)
 #endif
             break;
 
+        case CLO_BUILDDB_DES:
+            // Like -builddb, but compiles only the named .des file's
+            // cache; repeatable. Lets packaging fan the corpus out to
+            // parallel worker processes.
+            if (!next_is_param)
+                return false;
+            nextUsed = true;
+            crawl_state.build_db = true;
+            crawl_state.build_db_only.push_back(next_arg);
+#ifdef USE_TILE_LOCAL
+            crawl_state.tiles_disabled = true;
+#endif
+            break;
+
         case CLO_GDB:
             crawl_state.no_gdb = 0;
             break;
@@ -4630,6 +4692,22 @@ bool parse_args(int argc, char **argv, bool rc_only)
             nextUsed = true;
             break;
 
+        case CLO_RECORD_KEYS:
+            if (!next_is_param)
+                return false;
+
+            nextUsed = true;
+            crawl_state.keylog_record_file = next_arg;
+            break;
+
+        case CLO_REPLAY_KEYS:
+            if (!next_is_param)
+                return false;
+
+            nextUsed = true;
+            crawl_state.keylog_replay_file = next_arg;
+            break;
+
         case CLO_SPRINT:
             if (!rc_only)
                 Options.game.type = GAME_TYPE_SPRINT;
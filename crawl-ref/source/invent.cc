@@ -72,21 +72,11 @@ InvEntry::InvEntry(const item_def &i)
 {
     data = const_cast<item_def *>(item);
 
-    if (in_inventory(i) && i.base_type != OBJ_GOLD)
-    {
-        // We need to do this in order to get the 'wielded' annotation.
-        // We then toss out the first four characters, which look
-        // like this: "a - ". Ow. FIXME.
-        text = i.name(DESC_INVENTORY_EQUIP, false).substr(4);
-    }
-    else
-        text = i.name(DESC_A, false);
-
-    if (item_is_stationary_net(i))
-    {
-        text += make_stringf(" (holding %s)",
-                             net_holdee(i)->name(DESC_A).c_str());
-    }
+    // The full item name is built lazily in get_fullname(): bulk menus
+    // such as the item knowledge list create thousands of entries, most
+    // of them never shown (or shown through a subclass that formats its
+    // own name), and item naming is by far the most expensive part of
+    // constructing one.
 
     if (i.base_type != OBJ_GOLD && in_inventory(i))
         add_hotkey(index_to_letter(i.link));
@@ -114,6 +104,30 @@ const string &InvEntry::get_qualname() const
 
 const string &InvEntry::get_fullname() const
 {
+    // Only build the name on first use; callers that replace text
+    // wholesale (e.g. the rune menu) simply never trigger this. The
+    // const_cast mirrors the one for the data pointer in the ctor.
+    if (text.empty())
+    {
+        string &name = const_cast<InvEntry*>(this)->text;
+        const item_def &i = *item;
+
+        if (in_inventory(i) && i.base_type != OBJ_GOLD)
+        {
+            // We need to do this in order to get the 'wielded' annotation.
+            // We then toss out the first four characters, which look
+            // like this: "a - ". Ow. FIXME.
+            name = i.name(DESC_INVENTORY_EQUIP, false).substr(4);
+        }
+        else
+            name = i.name(DESC_A, false);
+
+        if (item_is_stationary_net(i))
+        {
+            name += make_stringf(" (holding %s)",
+                                 net_holdee(i)->name(DESC_A).c_str());
+        }
+    }
     return text;
 }
 
@@ -213,7 +227,7 @@ string InvEntry::get_text(bool need_cursor) const
     if (InvEntry::show_glyph)
         tstr << "(" << glyph_to_tagstr(get_item_glyph(*item)) << ")" << " ";
 
-    tstr << text;
+    tstr << get_fullname();
     const string str = tstr.str();
 
     if (printed_width(str) > get_number_of_cols())
@@ -52,6 +52,8 @@
 #include "skills.h"
 #include "spl-book.h"
 #include "spl-summoning.h"
+#include "spl-util.h"
+#include "stash.h"
 #include "state.h"
 #include "stringutil.h"
 #include "throw.h"
@@ -133,6 +135,15 @@ static string _item_inscription(const item_def &item)
                                              ", ").c_str());
 }
 
+// Bumped whenever dungeon-wide item knowledge changes; all memoized
+// item names computed before the bump become stale.
+static uint64_t _name_generation = 1;
+
+void invalidate_item_name_cache()
+{
+    _name_generation++;
+}
+
 string item_def::name(description_level_type descrip, bool terse, bool ident,
                       bool with_inscription, bool quantity_in_words,
                       iflags_t ignore_flags) const
@@ -148,8 +159,36 @@ string item_def::name(description_level_type descrip, bool terse, bool ident,
 
     ostringstream buff;
 
-    const string auxname = name_aux(descrip, terse, ident, with_inscription,
-                                    ignore_flags);
+    // name_aux() is pure for a given identify-state, and the UI asks
+    // for names far more often than that state changes, so memoize its
+    // result on the item. The key mixes a global counter bumped when
+    // item knowledge changes (set_ident_type), the naming parameters,
+    // and every item field name_aux reads; a 64-bit hash collision
+    // merely risks showing a stale name.
+    // Decks and other miscellany are excluded: their names can depend
+    // on mutable state outside the item fields hashed below (the known
+    // top card, ziggurat completions).
+    const bool cacheable = base_type != OBJ_MISCELLANY;
+
+    uint64_t key = _name_generation;
+    const uint64_t key_parts[] =
+    {
+        (uint64_t)descrip, (uint64_t)terse, (uint64_t)ident,
+        (uint64_t)with_inscription, (uint64_t)ignore_flags,
+        (uint64_t)base_type, (uint64_t)sub_type, (uint64_t)(uint16_t)plus,
+        (uint64_t)(uint16_t)plus2, (uint64_t)(uint32_t)special,
+        (uint64_t)rnd, (uint64_t)(uint16_t)quantity, (uint64_t)flags,
+    };
+    for (uint64_t part : key_parts)
+        key = key * 0x9E3779B97F4A7C15ULL + part + 1;
+
+    if (!cacheable || key != cached_name_key)
+    {
+        cached_name = name_aux(descrip, terse, ident, with_inscription,
+                               ignore_flags);
+        cached_name_key = cacheable ? key : 0;
+    }
+    const string &auxname = cached_name;
 
     const bool startvowel     = is_vowel(auxname[0]);
 
@@ -2195,6 +2234,45 @@ bool set_ident_type(item_def &item, bool identify)
     return true;
 }
 
+// you.type_ids mirrored as one packed 64-bit word per class, maintained
+// by set_ident_type below. Code that writes type_ids directly (saving
+// code, new-game setup, the player constructor) calls
+// reset_ident_bitsets() instead, and the mirror is rebuilt on the next
+// summary query. Range summaries then cost a popcount rather than a
+// walk over the subtype array.
+static uint64_t _ident_bits[NUM_OBJECT_CLASSES];
+static bool _ident_bits_valid = false;
+
+void reset_ident_bitsets()
+{
+    _ident_bits_valid = false;
+}
+
+static void _rebuild_ident_bits()
+{
+    COMPILE_CHECK(MAX_SUBTYPES <= 64);
+    for (int i = 0; i < NUM_OBJECT_CLASSES; i++)
+    {
+        _ident_bits[i] = 0;
+        for (int j = 0; j < MAX_SUBTYPES; j++)
+            if (you.type_ids[i][j])
+                _ident_bits[i] |= uint64_t(1) << j;
+    }
+    _ident_bits_valid = true;
+}
+
+int count_identified_range(object_class_type basetype, int first, int last)
+{
+    if (!_ident_bits_valid)
+        _rebuild_ident_bits();
+
+    uint64_t bits = _ident_bits[basetype];
+    bits &= ~uint64_t(0) << first;
+    if (last + 1 < 64)
+        bits &= (uint64_t(1) << (last + 1)) - 1;
+    return count_bits(bits);
+}
+
 bool set_ident_type(object_class_type basetype, int subtype, bool identify)
 {
     preserve_quiver_slots p;
@@ -2206,8 +2284,20 @@ bool set_ident_type(object_class_type basetype, int subtype, bool identify)
         return false;
 
     you.type_ids[basetype][subtype] = identify;
+    if (_ident_bits_valid)
+    {
+        if (identify)
+            _ident_bits[basetype] |= uint64_t(1) << subtype;
+        else
+            _ident_bits[basetype] &= ~(uint64_t(1) << subtype);
+    }
+    invalidate_item_name_cache();
+    invalidate_shop_price_cache();
     request_autoinscribe();
 
+    // Item names may have changed dungeon-wide.
+    invalidate_stash_search_index();
+
     // Our item knowledge changed in a way that could possibly affect shop
     // prices.
     shopping_list.item_type_identified(basetype, subtype);
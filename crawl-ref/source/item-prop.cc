@@ -804,6 +804,24 @@ bool item_type_removed(object_class_type base, int subtype)
     return removed_items.count({ base, subtype }) != 0;
 }
 
+int random_live_subtype(object_class_type base, int first, int last)
+{
+    // removed_items is fixed at compile time, so each (class, range)
+    // candidate list only has to be built once; afterwards callers get a
+    // single uniform pick instead of rejection-looping over removed types.
+    static map<int, vector<int> > cache;
+    const int key = base << 16 | first << 8 | last;
+    vector<int> &live = cache[key];
+    if (live.empty())
+    {
+        for (int subtype = first; subtype <= last; subtype++)
+            if (!item_type_removed(base, subtype))
+                live.push_back(subtype);
+        ASSERT(!live.empty());
+    }
+    return live[random2(live.size())];
+}
+
 // Some convenient functions to hide the bit operations and create
 // an interface layer between the code and the data in case this
 // gets changed again. - bwr
@@ -1089,6 +1107,11 @@ void set_ident_flags(item_def &item, iflags_t flags)
     {
         item.flags |= flags;
         request_autoinscribe();
+        // Newly known properties change the known-only equipment sums,
+        // and identifying mundane jewellery or staves changes the
+        // known-only resistance block.
+        if (in_inventory(item))
+            invalidate_equip_property_cache();
 
         if (in_inventory(item))
         {
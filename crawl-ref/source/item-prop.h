@@ -48,6 +48,8 @@ enum armour_flag
 extern const set<pair<object_class_type, int> > removed_items;
 /// Check for membership in removed_items.
 bool item_type_removed(object_class_type base, int subtype);
+/// A uniformly random subtype in [first, last] that is not removed.
+int random_live_subtype(object_class_type base, int first, int last);
 
 // cursed:
 bool item_known_cursed(const item_def &item) PURE;
@@ -69,6 +69,7 @@
 #include "religion.h"
 #include "rot.h"
 #include "shopping.h"
+#include "show.h"
 #include "showsymb.h"
 #include "slot-select-mode.h"
 #include "sound.h"
@@ -158,6 +159,28 @@ void fix_item_coordinates()
         }
 }
 
+// Per-cell generation stamps for floor piles, bumped whenever the pile
+// at a cell is linked, resized or destroyed. The stash tracker compares
+// stamps to skip unchanged cells; the clock is global and never reset,
+// so stamps recorded on one level can't be confused with those of
+// another.
+static FixedArray<uint32_t, GXM, GYM> _igrd_generation;
+static uint32_t _igrd_generation_clock = 0;
+
+void note_item_grid_change(const coord_def &pos)
+{
+    if (in_bounds(pos))
+    {
+        _igrd_generation(pos) = ++_igrd_generation_clock;
+        show_mark_dirty(pos);
+    }
+}
+
+uint32_t item_grid_generation(const coord_def &pos)
+{
+    return in_bounds(pos) ? _igrd_generation(pos) : 0;
+}
+
 // This function uses the items coordinates to relink all the igrd lists.
 void link_items()
 {
@@ -194,6 +217,8 @@ void link_items()
                     movable_ind = si->index();
             }
         }
+        note_item_grid_change(mitm[i].pos);
+
         // Link to top
         if (!move_below || movable_ind == -1)
         {
@@ -458,6 +483,7 @@ bool dec_inv_item_quantity(int obj, int amount)
 bool dec_mitm_item_quantity(int obj, int amount)
 {
     item_def &item = mitm[obj];
+    note_item_grid_change(item.pos);
     if (amount > item.quantity)
         amount = item.quantity; // can't use min due to type mismatch
 
@@ -488,6 +514,7 @@ void inc_inv_item_quantity(int obj, int amount)
 void inc_mitm_item_quantity(int obj, int amount)
 {
     mitm[obj].quantity += amount;
+    note_item_grid_change(mitm[obj].pos);
 }
 
 void init_item(int item)
@@ -498,6 +525,14 @@ void init_item(int item)
     mitm[item].clear();
 }
 
+// Indices of mitm slots believed to be free, used LIFO so freshly
+// freed slots are reused first. Entries can go stale (whole levels are
+// swapped in under mitm, and items can be cleared without going through
+// destroy_item), so every entry is revalidated before being handed out;
+// an empty list just means the next allocation pays for one full scan
+// to refill it.
+static vector<int> _free_mitm_slots;
+
 // Returns an unused mitm slot, or NON_ITEM if none available.
 // The reserve is the number of item slots to not check.
 // Items may be culled if a reserve <= 10 is specified.
@@ -510,11 +545,37 @@ int get_mitm_slot(int reserve)
 
     int item = NON_ITEM;
 
-    for (item = 0; item < (MAX_ITEMS - reserve); item++)
-        if (!mitm[item].defined())
+    while (!_free_mitm_slots.empty())
+    {
+        const int slot = _free_mitm_slots.back();
+        _free_mitm_slots.pop_back();
+        // Reserved slots are just dropped; the next refill scan finds
+        // them again.
+        if (slot < MAX_ITEMS - reserve && !mitm[slot].defined())
+        {
+            item = slot;
             break;
+        }
+    }
 
-    if (item >= MAX_ITEMS - reserve)
+    if (item == NON_ITEM)
+    {
+        // Refill with a single scan, lowest index on top of the stack
+        // so low slots are handed out first, as the old linear scan
+        // did.
+        for (int i = MAX_ITEMS - 1; i >= 0; i--)
+            if (!mitm[i].defined())
+                _free_mitm_slots.push_back(i);
+
+        if (!_free_mitm_slots.empty()
+            && _free_mitm_slots.back() < MAX_ITEMS - reserve)
+        {
+            item = _free_mitm_slots.back();
+            _free_mitm_slots.pop_back();
+        }
+    }
+
+    if (item == NON_ITEM)
     {
         if (crawl_state.game_is_arena())
         {
@@ -582,6 +643,8 @@ void unlink_item(int dest)
         // Use the items (x,y) to access the list (igrd[x][y]) where
         // the item should be linked.
 
+        note_item_grid_change(mitm[dest].pos);
+
 #if TAG_MAJOR_VERSION == 34
         if (mitm[dest].pos.x != 0 || mitm[dest].pos.y < 5)
 #endif
@@ -695,6 +758,9 @@ void destroy_item(int dest, bool never_created)
 
     unlink_item(dest);
     destroy_item(mitm[dest], never_created);
+    // O(1) reuse for the slot; get_mitm_slot revalidates entries, so
+    // items cleared behind its back merely cost a rescan later.
+    _free_mitm_slots.push_back(dest);
 }
 
 static void _handle_gone_item(const item_def &item)
@@ -730,6 +796,7 @@ void lose_item_stack(const coord_def& where)
         }
     }
     igrd(where) = NON_ITEM;
+    note_item_grid_change(where);
 }
 
 /**
@@ -2262,6 +2329,7 @@ static void _gozag_move_gold_to_top(const coord_def p)
 bool move_item_to_grid(int *const obj, const coord_def& p, bool silent)
 {
     ASSERT_IN_BOUNDS(p);
+    note_item_grid_change(p);
 
     int& ob(*obj);
 
@@ -2363,6 +2431,47 @@ bool move_item_to_grid(int *const obj, const coord_def& p, bool silent)
     return true;
 }
 
+// Re-stack a single cell's pile in one pass: gather the list once,
+// bucket stackable items by type, and merge every stack that
+// items_stack allows into the first of its kind. Piles only need this
+// when stacks were placed without the usual move_item_to_grid merging
+// (whole piles dumped onto other piles, or stacks that became
+// identical after the fact, e.g. through identification).
+void normalise_item_pile(const coord_def &p)
+{
+    if (igrd(p) == NON_ITEM || mitm[igrd(p)].link == NON_ITEM)
+        return; // zero or one item; nothing can merge
+
+    map<int, vector<int>> groups; // coarse key -> pile indices kept
+    vector<int> merged;
+    for (stack_iterator si(p); si; ++si)
+    {
+        if (!is_stackable_item(*si))
+            continue;
+
+        vector<int> &group = groups[si->base_type << 16 | si->sub_type];
+        bool absorbed = false;
+        for (int head : group)
+        {
+            if (items_stack(mitm[head], *si))
+            {
+                merge_item_stacks(*si, mitm[head]);
+                inc_mitm_item_quantity(head, si->quantity);
+                merged.push_back(si->index());
+                absorbed = true;
+                break;
+            }
+        }
+        if (!absorbed)
+            group.push_back(si->index());
+    }
+
+    // Unlinking invalidates stack iterators, so dispose of the
+    // absorbed stacks only now.
+    for (int slot : merged)
+        destroy_item(slot);
+}
+
 void move_item_stack_to_grid(const coord_def& from, const coord_def& to)
 {
     if (igrd(from) == NON_ITEM)
@@ -2383,6 +2492,11 @@ void move_item_stack_to_grid(const coord_def& from, const coord_def& to)
 
     igrd(to) = igrd(from);
     igrd(from) = NON_ITEM;
+    note_item_grid_change(from);
+    note_item_grid_change(to);
+
+    // The two piles were concatenated, not merged stack by stack.
+    normalise_item_pile(to);
 }
 
 // Returns false if no items could be dropped.
@@ -2394,6 +2508,8 @@ bool copy_item_to_grid(item_def &item, const coord_def& p,
     if (quant_drop == 0)
         return false;
 
+    note_item_grid_change(p);
+
     if (!silenced(p) && !silent)
         feat_splash_noise(grd(p));
 
@@ -5003,13 +5119,8 @@ bool maybe_identify_base_type(item_def &item)
     // What's the enum of the first item in the category?
     const int item_base = _get_item_base(item);
 
-    int ident_count = 0;
-
-    for (int i = item_base; i < item_count + item_base; i++)
-    {
-        const bool identified = you.type_ids[item.base_type][i];
-        ident_count += identified ? 1 : 0;
-    }
+    const int ident_count = count_identified_range(item.base_type, item_base,
+                                                   item_base + item_count - 1);
 
     if (ident_count < item_count - 1)
         return false;
@@ -56,6 +56,7 @@ void clear_item_pickup_flags(item_def &item);
 bool is_stackable_item(const item_def &item);
 bool items_similar(const item_def &item1, const item_def &item2);
 bool items_stack(const item_def &item1, const item_def &item2);
+void normalise_item_pile(const coord_def &p);
 void merge_item_stacks(const item_def &source, item_def &dest, int quant = -1);
 void get_gold(const item_def& item, int quant, bool quiet);
 
@@ -73,6 +74,8 @@ void fix_item_coordinates();
 int get_mitm_slot(int reserve = 50);
 
 void unlink_item(int dest);
+void note_item_grid_change(const coord_def &pos);
+uint32_t item_grid_generation(const coord_def &pos);
 void destroy_item(item_def &item, bool never_created = false);
 void destroy_item(int dest, bool never_created = false);
 void lose_item_stack(const coord_def& where);
@@ -275,11 +275,12 @@ void Kills::merge(const Kills &k)
     // Regular kills are messier to merge.
     for (const auto &entry : k.kills)
     {
-        const kill_monster_desc &kmd = entry.first;
-        kill_def &ki = kills[kmd];
+        const kill_monster_desc kmd = kill_monster_desc::unpack(entry.first);
+        kill_def &ki = kills[entry.first];
         const kill_def &ko = entry.second;
         bool uniq = mons_is_unique(kmd.monnum);
         ki.merge(ko, uniq);
+        kill_counts[entry.first] += ko.kills;
     }
 }
 
@@ -297,7 +298,9 @@ void Kills::record_kill(const monster* mon)
     // Create a descriptor
     kill_monster_desc descriptor = mon;
 
-    kill_def &k = kills[descriptor];
+    const int id = descriptor.packed();
+    kill_counts[id]++;
+    kill_def &k = kills[id];
     if (k.kills)
         k.add_kill(mon, level_id::current());
     else
@@ -309,7 +312,7 @@ int Kills::get_kills(vector<kill_exp> &all_kills) const
     int count = 0;
     for (const auto &entry : kills)
     {
-        const kill_monster_desc &md = entry.first;
+        const kill_monster_desc md = kill_monster_desc::unpack(entry.first);
         const kill_def &k = entry.second;
         all_kills.emplace_back(k, md);
         count += k.kills;
@@ -330,7 +333,7 @@ void Kills::save(writer& outf) const
 
     for (const auto &entry : kills)
     {
-        entry.first.save(outf);
+        kill_monster_desc::unpack(entry.first).save(outf);
         entry.second.save(outf);
     }
 
@@ -345,11 +348,14 @@ void Kills::load(reader& inf)
     // How many kill records?
     int kill_count = unmarshallInt(inf);
     kills.clear();
+    kill_counts.init(0);
     for (int i = 0; i < kill_count; ++i)
     {
         kill_monster_desc md;
         md.load(inf);
-        kills[md].load(inf);
+        kill_def &k = kills[md.packed()];
+        k.load(inf);
+        kill_counts[md.packed()] = k.kills;
     }
 
     short ghost_count = unmarshallShort(inf);
@@ -384,14 +390,12 @@ int Kills::num_kills(const monster_info& mon) const
 
 int Kills::num_kills(kill_monster_desc desc) const
 {
-    auto iter = kills.find(desc);
-    int total = (iter == kills.end() ? 0 : iter->second.kills);
+    int total = kill_counts[desc.packed()];
 
     if (desc.modifier == kill_monster_desc::M_SHAPESHIFTER)
     {
         desc.modifier = kill_monster_desc::M_NORMAL;
-        iter = kills.find(desc);
-        total += (iter == kills.end() ? 0 : iter->second.kills);
+        total += kill_counts[desc.packed()];
     }
 
     return total;
@@ -593,15 +597,17 @@ kill_ghost::kill_ghost(const monster* mon)
 {
     exp = exper_value(*mon);
     place = level_id::current();
-    ghost_name = mon->ghost->name;
 
     // Check whether this is really a ghost, since we also have to handle
-    // the Pandemonic demons.
+    // the Pandemonic demons; only real ghosts get the expensive full
+    // description built, the others just copy the stored name.
     if (mon->type == MONS_PLAYER_GHOST && !mon->is_summoned())
     {
         monster_info mi(mon);
         ghost_name = "The ghost of " + get_ghost_description(mi, true);
     }
+    else
+        ghost_name = mon->ghost->name;
 }
 
 string kill_ghost::info() const
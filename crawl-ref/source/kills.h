@@ -11,6 +11,8 @@
 #include <vector>
 
 #include "enum.h"
+#include "fixedvector.h"
+#include "monster-type.h"
 
 class monster;
 struct monster_info;
@@ -36,15 +38,20 @@ struct kill_monster_desc
     monster_type monnum;        // Number of the beast
     name_modifier modifier;     // Nature of the beast
 
-    struct less_than
+    // The modifier lives in the low bits of the packed id.
+    static const int MOD_BITS = 3;
+
+    // Packed (type, modifier) id, used to key kill records and to index
+    // the flat kill counters.
+    int packed() const { return (monnum << MOD_BITS) | modifier; }
+
+    static kill_monster_desc unpack(int id)
     {
-        bool operator () (const kill_monster_desc &m1,
-                          const kill_monster_desc &m2) const
-        {
-            return m1.monnum < m2.monnum
-                   || (m1.monnum == m2.monnum && m1.modifier < m2.modifier);
-        }
-    };
+        kill_monster_desc desc;
+        desc.monnum = static_cast<monster_type>(id >> MOD_BITS);
+        desc.modifier = static_cast<name_modifier>(id & ((1 << MOD_BITS) - 1));
+        return desc;
+    }
 };
 
 #define PLACE_LIMIT 5   // How many unique kill places we're prepared to track
@@ -131,6 +138,8 @@ struct kill_exp
 class Kills
 {
 public:
+    Kills() : kill_counts(0) { }
+
     void record_kill(const monster* mon);
     void merge(const Kills &k);
 
@@ -144,13 +153,19 @@ public:
 private:
     int num_kills(kill_monster_desc desc) const;
 
-    typedef map<kill_monster_desc, kill_def,
-                kill_monster_desc::less_than> kill_map;
+    // Kill records keyed by kill_monster_desc::packed(); the heavier
+    // per-type data (exp, places) lives here.
+    typedef map<int, kill_def> kill_map;
     typedef vector<kill_ghost> ghost_vec;
 
     kill_map    kills;
     ghost_vec   ghosts;
 
+    // Raw kill counts for every packed (type, modifier) id in the
+    // catalogue; rebuilt from the kill records on load, never saved.
+    FixedVector<unsigned short,
+                NUM_MONSTERS << kill_monster_desc::MOD_BITS> kill_counts;
+
     void record_ghost_kill(const monster* mon);
 };
 
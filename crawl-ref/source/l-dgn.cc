@@ -2,6 +2,7 @@
 
 #include "l-libs.h"
 
+#include <algorithm>
 #include <cmath>
 
 #include "branch.h"
@@ -659,6 +660,15 @@ static int dgn_original_map(lua_State *ls)
 static int dgn_load_des_file(lua_State *ls)
 {
     const string &file = luaL_checkstring(ls, 1);
+    // A -builddb-des run compiles only its assigned files; the rest of
+    // the list belongs to other worker processes.
+    if (!crawl_state.build_db_only.empty()
+        && find(crawl_state.build_db_only.begin(),
+                crawl_state.build_db_only.end(), file)
+           == crawl_state.build_db_only.end())
+    {
+        return 0;
+    }
     if (!file.empty())
         read_map(file);
     return 0;
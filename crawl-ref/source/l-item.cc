@@ -1380,9 +1380,18 @@ static int item_get(lua_State *ls)
     if (!attr)
         return 0;
 
-    for (const ItemAccessor &ia : item_attrs)
-        if (!strcmp(attr, ia.attribute))
-            return ia.accessor(ls, iw, attr);
+    // This __index runs for every item attribute access, and per-turn
+    // scripts (autofight, autopickup hooks) make a lot of them; resolve
+    // the accessor through a map built once rather than strcmp-scanning
+    // the whole table on each access.
+    static map<string, const ItemAccessor *> attr_map;
+    if (attr_map.empty())
+        for (const ItemAccessor &ia : item_attrs)
+            attr_map[ia.attribute] = &ia;
+
+    auto it = attr_map.find(attr);
+    if (it != attr_map.end())
+        return it->second->accessor(ls, iw, attr);
 
     return 0;
 }
@@ -15,6 +15,7 @@
 #include "l-defs.h"
 #include "libutil.h" // map_find
 #include "mon-book.h"
+#include "nearby-danger.h"
 #include "spl-util.h"
 #include "stringutil.h"
 #include "transform.h"
@@ -402,9 +403,26 @@ LUAFN(mi_get_monster_at)
     return 1;
 }
 
+// Every hostile monster the player can see, as an array of monster.info
+// userdata. One call here replaces a get_monster_at() probe of every
+// cell in sight range, which is what autofight used to do per keypress.
+LUAFN(mi_get_visible_hostiles)
+{
+    lua_newtable(ls);
+    int i = 0;
+    for (monster* mon : get_visible_hostiles())
+    {
+        monster_info mi(mon);
+        lua_push_moninf(ls, &mi);
+        lua_rawseti(ls, -2, ++i);
+    }
+    return 1;
+}
+
 static const struct luaL_reg mon_lib[] =
 {
     { "get_monster_at", mi_get_monster_at },
+    { "get_visible_hostiles", mi_get_visible_hostiles },
 
     { nullptr, nullptr }
 };
@@ -771,13 +771,44 @@ void puttext(int x1, int y1, const crawl_view_buffer &vbuf)
 {
     const screen_cell_t *cell = vbuf;
     const coord_def size = vbuf.size();
+    // Coalesce runs of identically coloured cells into one attribute
+    // change and one string write each, rather than one of both per
+    // cell; over a high-latency connection this turns the repaint into
+    // a handful of writes per line.
+    vector<wchar_t> run;
+    run.reserve(size.x);
+#ifdef USE_TILE_WEB
+    vector<char32_t> web_run;
+    web_run.reserve(size.x + 1);
+#endif
     for (int y = 0; y < size.y; ++y)
     {
         cgotoxy(x1, y1 + y);
-        for (int x = 0; x < size.x; ++x)
+        for (int x = 0; x < size.x; )
         {
-            put_colour_ch(cell->colour, cell->glyph);
-            cell++;
+            const unsigned short colour = cell->colour;
+            run.clear();
+#ifdef USE_TILE_WEB
+            web_run.clear();
+#endif
+            do
+            {
+                // As in putwch, write nulls as spaces: addnwstr would
+                // drop them without advancing the cursor.
+                run.push_back(cell->glyph ? cell->glyph : ' ');
+#ifdef USE_TILE_WEB
+                web_run.push_back(cell->glyph ? cell->glyph : ' ');
+#endif
+                cell++;
+                x++;
+            }
+            while (x < size.x && cell->colour == colour);
+            textcolour(colour);
+            addnwstr(&run[0], run.size());
+#ifdef USE_TILE_WEB
+            web_run.push_back(0);
+            tiles.put_ucs_string(&web_run[0]);
+#endif
         }
     }
     update_screen();
@@ -46,12 +46,19 @@
 
 #include <algorithm>
 #include <cmath>
+#include <map>
 
 #include "areas.h"
 #include "coord.h"
 #include "coordit.h"
+#include "dbg-prof.h"
 #include "env.h"
+#include "files.h"
 #include "losglobal.h"
+#include "show.h"
+#include "syscalls.h"
+#include "tags.h"
+#include "tag-version.h"
 
 // These determine what rays are cast in the precomputation,
 // and affect start-up time significantly.
@@ -83,6 +90,13 @@ static blockrays_t blockrays;
 struct cellray;
 static FixedArray<vector<cellray>, LOS_MAX_RANGE+1, LOS_MAX_RANGE+1> min_cellrays;
 
+// For each quadrant cell, the endpoints of all minimal cellrays passing
+// through it. This is the per-cell inverse of blockrays, used by the
+// global LOS cache to invalidate only those pairs an opacity change
+// can actually affect.
+static FixedArray<vector<coord_def>, LOS_MAX_RANGE+1, LOS_MAX_RANGE+1>
+    blocked_cellray_ends;
+
 // Temporary arrays used in losight() to track which rays
 // are blocked or have seen a smoke cloud.
 // Allocated when doing the precomputations.
@@ -116,8 +130,7 @@ void set_los_radius(int r)
 {
     ASSERT(r <= LOS_RADIUS);
     los_radius = r;
-    invalidate_los();
-    _handle_los_change();
+    los_changed();
 }
 
 int get_los_radius()
@@ -381,6 +394,29 @@ static void _register_ray(geom::ray r)
     fullrays.push_back(ray);
 }
 
+// Final setup shared by the computing and the cache-loading paths:
+// invert the compressed blockrays into per-cell endpoint lists for
+// incremental invalidation of the global LOS cache, and allocate the
+// scratch vectors used in losight().
+static void _finalise_blockrays()
+{
+    const int n_min_rays = cellray_ends.size();
+
+    for (quadrant_iterator qi; qi; ++qi)
+    {
+        vector<coord_def>& ends = blocked_cellray_ends(*qi);
+        ends.clear();
+        for (int i = 0; i < n_min_rays; ++i)
+            if (blockrays(*qi)->get(i))
+                ends.push_back(cellray_ends[i]);
+        sort(ends.begin(), ends.end());
+        ends.erase(unique(ends.begin(), ends.end()), ends.end());
+    }
+
+    dead_rays  = new bit_vector(n_min_rays);
+    smoke_rays = new bit_vector(n_min_rays);
+}
+
 static void _create_blockrays()
 {
     // First, we calculate blocking information for all cell rays.
@@ -427,8 +463,7 @@ static void _create_blockrays()
     for (quadrant_iterator qi; qi; ++qi)
         delete all_blockrays(*qi);
 
-    dead_rays  = new bit_vector(n_min_rays);
-    smoke_rays = new bit_vector(n_min_rays);
+    _finalise_blockrays();
 
     dprf("Cellrays: %d Fullrays: %u Minimal cellrays: %u",
           n_cellrays, (unsigned int)fullrays.size(), n_min_rays);
@@ -452,6 +487,239 @@ static bool _complexity_lt(const pair<int,int>& lhs, const pair<int,int>& rhs)
     return lhs.first * lhs.second < rhs.first * rhs.second;
 }
 
+/////////////////////////////////////////////////////////////////////
+// Precomputed table cache.
+//
+// The raycast tables depend only on LOS_MAX_RANGE, LOS_MAX_ANGLE and
+// LOS_INTERCEPT_MULT, so they are serialized to a versioned file in
+// the save directory after the first computation and reloaded on
+// subsequent startups. Any mismatch or read error just falls back to
+// recomputing from scratch.
+
+#ifndef BYTE_ORDER
+# error BYTE_ORDER is not defined
+#endif
+#if BYTE_ORDER == LITTLE_ENDIAN
+# define WORD_LEN (int8_t)sizeof(long)
+#else
+# define WORD_LEN -(int8_t)sizeof(long)
+#endif
+
+static const int RAY_CACHE_VERSION = 1;
+
+static string _ray_cache_path()
+{
+    return catpath(savedir_versioned_path(""), "rays.cache");
+}
+
+// Ray geometry must round-trip exactly, so doubles are stored by bit
+// pattern rather than through the float marshallers.
+static void _marshall_double(writer& outf, double v)
+{
+    COMPILE_CHECK(sizeof(double) == sizeof(int64_t));
+    int64_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    marshallSigned(outf, bits);
+}
+
+static double _unmarshall_double(reader& inf)
+{
+    const int64_t bits = unmarshallSigned(inf);
+    double v;
+    memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+
+static void _marshall_ray_header(writer& outf)
+{
+    marshallUByte(outf, TAG_MAJOR_VERSION);
+    marshallUByte(outf, TAG_MINOR_VERSION);
+    marshallByte(outf, WORD_LEN);
+    marshallInt(outf, RAY_CACHE_VERSION);
+    marshallInt(outf, LOS_MAX_RANGE);
+    marshallInt(outf, LOS_MAX_ANGLE);
+    marshallInt(outf, LOS_INTERCEPT_MULT);
+}
+
+static bool _unmarshall_ray_header(reader& inf)
+{
+    return unmarshallUByte(inf) == TAG_MAJOR_VERSION
+           && unmarshallUByte(inf) == TAG_MINOR_VERSION
+           && unmarshallByte(inf) == WORD_LEN
+           && unmarshallInt(inf) == RAY_CACHE_VERSION
+           && unmarshallInt(inf) == LOS_MAX_RANGE
+           && unmarshallInt(inf) == LOS_MAX_ANGLE
+           && unmarshallInt(inf) == LOS_INTERCEPT_MULT;
+}
+
+static void _save_ray_cache()
+{
+    const string path = _ray_cache_path();
+    FILE* fp = fopen_u(path.c_str(), "wb");
+    if (!fp)
+        return; // not fatal, we'll just recompute next time
+
+    writer outf(path, fp, true);
+    _marshall_ray_header(outf);
+
+    marshallInt(outf, ray_coords.size());
+    for (const coord_def& c : ray_coords)
+    {
+        marshallShort(outf, c.x);
+        marshallShort(outf, c.y);
+    }
+
+    // Map from footprint start to fullray index, for the cellrays.
+    map<unsigned int, int> ray_index;
+    marshallInt(outf, fullrays.size());
+    for (unsigned int i = 0; i < fullrays.size(); ++i)
+    {
+        const los_ray& ray = fullrays[i];
+        ray_index[ray.start] = i;
+        _marshall_double(outf, ray.r.start.x);
+        _marshall_double(outf, ray.r.start.y);
+        _marshall_double(outf, ray.r.dir.x);
+        _marshall_double(outf, ray.r.dir.y);
+        marshallInt(outf, ray.start);
+        marshallInt(outf, ray.length);
+    }
+
+    const int n_min_rays = cellray_ends.size();
+    marshallInt(outf, n_min_rays);
+    for (const coord_def& c : cellray_ends)
+    {
+        marshallShort(outf, c.x);
+        marshallShort(outf, c.y);
+    }
+
+    vector<uint8_t> packed((n_min_rays + 7) / 8);
+    for (quadrant_iterator qi; qi; ++qi)
+    {
+        fill(packed.begin(), packed.end(), 0);
+        for (int i = 0; i < n_min_rays; ++i)
+            if (blockrays(*qi)->get(i))
+                packed[i >> 3] |= 1 << (i & 7);
+        outf.write(packed.data(), packed.size());
+    }
+
+    for (quadrant_iterator qi; qi; ++qi)
+    {
+        const vector<cellray>& min = min_cellrays(*qi);
+        marshallInt(outf, min.size());
+        for (const cellray& c : min)
+        {
+            marshallInt(outf, ray_index[c.ray.start]);
+            marshallInt(outf, c.end);
+            marshallInt(outf, c.imbalance);
+            marshallByte(outf, c.first_diag);
+        }
+    }
+
+    fclose(fp);
+}
+
+static void _clear_ray_tables()
+{
+    fullrays.clear();
+    ray_coords.clear();
+    cellray_ends.clear();
+    for (quadrant_iterator qi; qi; ++qi)
+    {
+        delete blockrays(*qi);
+        blockrays(*qi) = nullptr;
+        min_cellrays(*qi).clear();
+    }
+}
+
+static bool _load_ray_cache()
+{
+    const string path = _ray_cache_path();
+    FILE* fp = fopen_u(path.c_str(), "rb");
+    if (!fp)
+        return false;
+
+    try
+    {
+        reader inf(fp, TAG_MINOR_VERSION);
+        if (!_unmarshall_ray_header(inf))
+        {
+            fclose(fp);
+            return false;
+        }
+
+        const int n_coords = unmarshallInt(inf);
+        ray_coords.reserve(n_coords);
+        for (int i = 0; i < n_coords; ++i)
+        {
+            const int x = unmarshallShort(inf);
+            const int y = unmarshallShort(inf);
+            ray_coords.emplace_back(x, y);
+        }
+
+        const int n_fullrays = unmarshallInt(inf);
+        fullrays.reserve(n_fullrays);
+        for (int i = 0; i < n_fullrays; ++i)
+        {
+            const double sx = _unmarshall_double(inf);
+            const double sy = _unmarshall_double(inf);
+            const double dx = _unmarshall_double(inf);
+            const double dy = _unmarshall_double(inf);
+            los_ray ray(geom::ray(sx, sy, dx, dy));
+            ray.start  = unmarshallInt(inf);
+            ray.length = unmarshallInt(inf);
+            fullrays.push_back(ray);
+        }
+
+        const int n_min_rays = unmarshallInt(inf);
+        cellray_ends.reserve(n_min_rays);
+        for (int i = 0; i < n_min_rays; ++i)
+        {
+            const int x = unmarshallShort(inf);
+            const int y = unmarshallShort(inf);
+            cellray_ends.emplace_back(x, y);
+        }
+
+        vector<uint8_t> packed((n_min_rays + 7) / 8);
+        for (quadrant_iterator qi; qi; ++qi)
+        {
+            inf.read(packed.data(), packed.size());
+            blockrays(*qi) = new bit_vector(n_min_rays);
+            for (int i = 0; i < n_min_rays; ++i)
+                if (packed[i >> 3] & (1 << (i & 7)))
+                    blockrays(*qi)->set(i);
+        }
+
+        for (quadrant_iterator qi; qi; ++qi)
+        {
+            const int count = unmarshallInt(inf);
+            vector<cellray>& min = min_cellrays(*qi);
+            min.reserve(count);
+            for (int i = 0; i < count; ++i)
+            {
+                const int rayidx = unmarshallInt(inf);
+                const int end    = unmarshallInt(inf);
+                if (rayidx < 0 || rayidx >= (int)fullrays.size())
+                    throw short_read_exception();
+                cellray c(fullrays[rayidx], end);
+                c.imbalance  = unmarshallInt(inf);
+                c.first_diag = unmarshallByte(inf);
+                min.push_back(c);
+            }
+        }
+
+        fclose(fp);
+    }
+    catch (short_read_exception&)
+    {
+        fclose(fp);
+        _clear_ray_tables();
+        return false;
+    }
+
+    _finalise_blockrays();
+    return true;
+}
+
 // Cast all rays
 static void raycast()
 {
@@ -463,6 +731,10 @@ static void raycast()
     // We have a considerable amount of overkill.
     done_raycast = true;
 
+    // Reuse the tables from a previous run if we can.
+    if (_load_ray_cache())
+        return;
+
     // register perpendiculars FIRST, to make them top choice
     // when selecting beams
     _register_ray(geom::ray(0.5, 0.5, 0.0, 1.0));
@@ -503,6 +775,20 @@ static void raycast()
 
     // Now create the appropriate blockrays array
     _create_blockrays();
+
+    // Cache the tables for future runs.
+    _save_ray_cache();
+}
+
+// The endpoints (in quadrant coordinates) of all minimal cellrays
+// passing through the given quadrant cell. A cell change at rel can
+// only affect LOS to these targets (and to rel itself).
+const vector<coord_def>& los_blocked_cellray_ends(const coord_def& rel)
+{
+    ASSERT(rel.x >= 0 && rel.x <= LOS_MAX_RANGE);
+    ASSERT(rel.y >= 0 && rel.y <= LOS_MAX_RANGE);
+    raycast();
+    return blocked_cellray_ends(rel);
 }
 
 static int _imbalance(ray_def ray, const coord_def& target)
@@ -613,20 +899,41 @@ struct opacity_trans : public opacity_func
     }
 };
 
-// Find a nonblocked ray from source to target. Return false if no
-// such ray could be found, otherwise return true and fill ray
-// appropriately.
-// if range is too great or all rays are blocked.
-// If cycle is false, find the first fitting ray. If it is true,
-// assume that ray is appropriately filled in, and look for the next
-// ray. We only ever use ray.cycle_idx.
-bool find_ray(const coord_def& source, const coord_def& target,
-              ray_def& ray, const opacity_func& opc, int range,
-              bool cycle)
+// Memo of find_ray results for the two global opacity functors beams
+// use. Monster spell tracers look up the same endpoints over and over
+// — once per candidate spell, and again for each pack member sharing
+// a corridor — and the chosen ray only depends on the opacity grid,
+// so entries stay valid until an opacity change flushes the memo (see
+// the LOS change notifications below).
+struct ray_memo_t
 {
-    if (target == source || !map_bounds(source) || !map_bounds(target))
-        return false;
+    bool found;
+    ray_def ray;
+};
+static map<uint64_t, ray_memo_t> _ray_memo;
+
+static void _clear_ray_memo()
+{
+    _ray_memo.clear();
+}
 
+static uint64_t _ray_memo_key(const coord_def& source,
+                              const coord_def& target,
+                              int opc_id, int range)
+{
+    uint64_t key = opc_id;
+    key = key << 16 | (uint16_t)range;
+    key = key << 8 | (uint8_t)source.x;
+    key = key << 8 | (uint8_t)source.y;
+    key = key << 8 | (uint8_t)target.x;
+    key = key << 8 | (uint8_t)target.y;
+    return key;
+}
+
+static bool _find_ray(const coord_def& source, const coord_def& target,
+                      ray_def& ray, const opacity_func& opc, int range,
+                      bool cycle)
+{
     const int signx = ((target.x - source.x >= 0) ? 1 : -1);
     const int signy = ((target.y - source.y >= 0) ? 1 : -1);
     const int absx  = signx * (target.x - source.x);
@@ -650,6 +957,46 @@ bool find_ray(const coord_def& source, const coord_def& target,
     return true;
 }
 
+// Find a nonblocked ray from source to target. Return false if no
+// such ray could be found, otherwise return true and fill ray
+// appropriately.
+// if range is too great or all rays are blocked.
+// If cycle is false, find the first fitting ray. If it is true,
+// assume that ray is appropriately filled in, and look for the next
+// ray. We only ever use ray.cycle_idx.
+bool find_ray(const coord_def& source, const coord_def& target,
+              ray_def& ray, const opacity_func& opc, int range,
+              bool cycle)
+{
+    if (target == source || !map_bounds(source) || !map_bounds(target))
+        return false;
+
+    // Only the stateless global functors can be memoized; cycling
+    // searches depend on the incoming ray, so they can't.
+    const int opc_id = &opc == static_cast<const opacity_func*>(&opc_solid_see)
+                       ? 0
+                     : &opc == static_cast<const opacity_func*>(&opc_default)
+                       ? 1 : -1;
+    if (cycle || opc_id < 0)
+        return _find_ray(source, target, ray, opc, range, cycle);
+
+    const uint64_t key = _ray_memo_key(source, target, opc_id, range);
+    auto it = _ray_memo.find(key);
+    if (it != _ray_memo.end())
+    {
+        if (it->second.found)
+            ray = it->second.ray;
+        return it->second.found;
+    }
+
+    ray_memo_t memo;
+    memo.found = _find_ray(source, target, ray, opc, range, false);
+    if (memo.found)
+        memo.ray = ray;
+    _ray_memo[key] = memo;
+    return memo.found;
+}
+
 bool exists_ray(const coord_def& source, const coord_def& target,
                 const opacity_func& opc, int range)
 {
@@ -811,7 +1158,7 @@ static void _losight_quadrant(los_grid& sh, const los_param& dat, int sx, int sy
             break;
         case OPC_HALF:
             // Block rays which have already seen a cloud.
-            *dead_rays  |= (*smoke_rays & *blockrays(*qi));
+            dead_rays->ior_and(*smoke_rays, *blockrays(*qi));
             *smoke_rays |= *blockrays(*qi);
             break;
         default:
@@ -820,12 +1167,18 @@ static void _losight_quadrant(los_grid& sh, const los_param& dat, int sx, int sy
     }
 
     // Ray calculation done. Now work out which cells in this
-    // quadrant are visible.
-    for (unsigned int rayidx = 0; rayidx < num_cellrays; ++rayidx)
+    // quadrant are visible. Walk dead_rays a word at a time so a
+    // fully blocked word skips LONGSIZE rays at once.
+    for (int w = 0; w < dead_rays->words(); ++w)
     {
-        // make the cells seen by this ray at this point visible
-        if (!dead_rays->get(rayidx))
+        unsigned long alive = ~dead_rays->word(w);
+        for (unsigned int b = 0; alive; ++b, alive >>= 1)
         {
+            if (!(alive & 1))
+                continue;
+            const unsigned int rayidx = w * LONGSIZE + b;
+            if (rayidx >= num_cellrays)
+                break;
             // This ray is alive, thus the end cell is visible.
             const coord_def p = coord_def(sx * cellray_ends[rayidx].x,
                                           sy * cellray_ends[rayidx].y);
@@ -861,6 +1214,8 @@ struct los_param_funcs : public los_param
 void losight(los_grid& sh, const coord_def& center,
              const opacity_func& opc, const circle_def& bounds)
 {
+    PROF_ZONE("losight");
+
     const los_param& dat = los_param_funcs(center, opc, bounds);
 
     sh.init(false);
@@ -893,6 +1248,34 @@ opacity_type mons_opacity(const monster* mon, los_type how)
 /////////////////////////////////////
 // A start at tracking LOS changes.
 
+// Cells whose opacity changed since the last global LOS cache flush.
+// Clouds are the most frequent source, creating and expiring many
+// cells per turn; deferring the cache invalidation and deduplicating
+// the dirty set means each cell is processed once per turn instead of
+// once per cloud event. The cache readers in losglobal.cc flush before
+// every lookup, so deferral is never observable.
+static vector<coord_def> _pending_los_changes;
+
+void los_flush_pending()
+{
+    if (_pending_los_changes.empty())
+        return;
+
+    sort(_pending_los_changes.begin(), _pending_los_changes.end());
+    _pending_los_changes.erase(unique(_pending_los_changes.begin(),
+                                      _pending_los_changes.end()),
+                               _pending_los_changes.end());
+    for (const coord_def& p : _pending_los_changes)
+        invalidate_los_around(p);
+    _pending_los_changes.clear();
+}
+
+static void _defer_los_change(const coord_def& p)
+{
+    _pending_los_changes.push_back(p);
+    _clear_ray_memo();
+}
+
 // Something that affects LOS (with default parameters)
 // has changed somewhere.
 static void _handle_los_change()
@@ -910,9 +1293,12 @@ void los_actor_moved(const actor* act, const coord_def& oldpos)
 {
     if (act->is_monster() && _mons_block_sight(act->as_monster()))
     {
-        invalidate_los_around(oldpos);
-        invalidate_los_around(act->pos());
+        opacity_grid_changed(oldpos);
+        opacity_grid_changed(act->pos());
+        _defer_los_change(oldpos);
+        _defer_los_change(act->pos());
         _handle_los_change();
+        show_mark_all_dirty();
     }
 }
 
@@ -920,20 +1306,28 @@ void los_monster_died(const monster* mon)
 {
     if (_mons_block_sight(mon))
     {
-        invalidate_los_around(mon->pos());
+        opacity_grid_changed(mon->pos());
+        _defer_los_change(mon->pos());
         _handle_los_change();
+        show_mark_all_dirty();
     }
 }
 
 // Might want to pass new/old terrain.
 void los_terrain_changed(const coord_def& p)
 {
-    invalidate_los_around(p);
+    opacity_grid_changed(p);
+    _defer_los_change(p);
     _handle_los_change();
+    show_mark_all_dirty();
 }
 
 void los_changed()
 {
+    opacity_grid_reset();
+    _pending_los_changes.clear();
+    _clear_ray_memo();
     invalidate_los();
     _handle_los_change();
+    show_mark_all_dirty();
 }
@@ -28,6 +28,7 @@ bool find_ray(const coord_def& source, const coord_def& target,
 bool exists_ray(const coord_def& source, const coord_def& target,
                 const opacity_func &opc, int range = LOS_MAX_RANGE);
 dungeon_feature_type ray_blocker(const coord_def& source, const coord_def& target);
+const vector<coord_def>& los_blocked_cellray_ends(const coord_def& rel);
 
 void fallback_ray(const coord_def& source, const coord_def& target,
                   ray_def& ray);
@@ -50,4 +51,5 @@ void los_actor_moved(const actor* act, const coord_def& oldpos);
 void los_monster_died(const monster* mon);
 void los_terrain_changed(const coord_def& p);
 void los_changed();
+void los_flush_pending();
 opacity_type mons_opacity(const monster* mon, los_type how);
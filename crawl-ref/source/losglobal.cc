@@ -2,78 +2,156 @@
 
 #include "losglobal.h"
 
+#include <bitset>
+#include <cstring>
+
 #include "coord.h"
 #include "coordit.h"
 #include "libutil.h"
 #include "los-def.h"
 
-#define LOS_KNOWN 4
+// Each cell stores a full (2*LOS_MAX_RANGE+1)^2 field of target bits
+// per los_type, split into two bit planes: whether the pair has been
+// computed (known) and whether it is visible (vis). The planes are
+// arrays of 64-bit words, so batch queries can combine a whole word of
+// targets with a few ANDs and popcounts. Visibility is symmetric, so
+// each pair is mirrored into both endpoints' fields as it is computed.
+
+#define LOS_FIELD_DIM   (2 * LOS_MAX_RANGE + 1)
+#define LOS_FIELD_CELLS (LOS_FIELD_DIM * LOS_FIELD_DIM)
+#define LOS_TYPES 4
+
+COMPILE_CHECK(LOS_FIELD_CELLS <= LOS_FIELD_WORDS * 64);
+
+struct losfield_t
+{
+    uint64_t known[LOS_TYPES][LOS_FIELD_WORDS];
+    uint64_t vis[LOS_TYPES][LOS_FIELD_WORDS];
+    // Bit l set: every in-bounds pair for los_type l is known, so
+    // queries against this field need no update check at all.
+    uint8_t complete;
+};
 
-typedef uint8_t losfield_t;
-typedef losfield_t halflos_t[LOS_MAX_RANGE+1][2*LOS_MAX_RANGE+1];
-static const int o_half_x = 0;
-static const int o_half_y = LOS_MAX_RANGE;
-typedef halflos_t globallos_t[GXM][GYM];
+typedef losfield_t globallos_t[GXM][GYM];
 
 static globallos_t globallos;
 
-static losfield_t* _lookup_globallos(const coord_def& p, const coord_def& q)
+static int _popcount64(uint64_t x)
 {
-    COMPILE_CHECK(LOS_KNOWN * 2 <= sizeof(losfield_t) * 8);
+    return bitset<64>(x).count();
+}
 
+static int _plane_index(los_type l)
+{
+    switch (l)
+    {
+    case LOS_DEFAULT:   return 0;
+    case LOS_NO_TRANS:  return 1;
+    case LOS_SOLID:     return 2;
+    case LOS_SOLID_SEE: return 3;
+    default:
+        die("invalid opacity");
+    }
+}
+
+// Bit position of target q in the field centered on p.
+// Valid only if (q - p).rdist() <= LOS_MAX_RANGE.
+static int _field_index(const coord_def& p, const coord_def& q)
+{
+    return (q.x - p.x + LOS_MAX_RANGE) * LOS_FIELD_DIM
+         + (q.y - p.y + LOS_MAX_RANGE);
+}
+
+static void _clear_pair(const coord_def& p, const coord_def& q)
+{
     if (!map_bounds(p) || !map_bounds(q))
-        return nullptr;
-    coord_def diff = q - p;
-    if (diff.rdist() > LOS_RADIUS)
-        return nullptr;
-    // p < q iff p.x < q.x || p.x == q.x && p.y < q.y
-    if (diff < coord_def(0, 0))
-        return &globallos[q.x][q.y][-diff.x + o_half_x][-diff.y + o_half_y];
-    else
-        return &globallos[p.x][p.y][ diff.x + o_half_x][ diff.y + o_half_y];
+        return;
+    if ((q - p).rdist() > LOS_MAX_RANGE)
+        return;
+
+    losfield_t& pf = globallos[p.x][p.y];
+    losfield_t& qf = globallos[q.x][q.y];
+    const int pi = _field_index(p, q);
+    const int qi = _field_index(q, p);
+    for (int t = 0; t < LOS_TYPES; ++t)
+    {
+        pf.known[t][pi >> 6] &= ~(uint64_t(1) << (pi & 63));
+        qf.known[t][qi >> 6] &= ~(uint64_t(1) << (qi & 63));
+    }
+    pf.complete = 0;
+    qf.complete = 0;
 }
 
 static void _save_los(los_def* los, los_type l)
 {
     const coord_def o = los->get_center();
-    int y1 = o.y - LOS_MAX_RANGE;
-    int y2 = o.y + LOS_MAX_RANGE;
-    int x1 = o.x - LOS_MAX_RANGE;
-    int x2 = o.x + LOS_MAX_RANGE;
-    for (int y = y1; y <= y2; y++)
-        for (int x = x1; x <= x2; x++)
+    const int t = _plane_index(l);
+    losfield_t& field = globallos[o.x][o.y];
+    for (int y = o.y - LOS_MAX_RANGE; y <= o.y + LOS_MAX_RANGE; y++)
+        for (int x = o.x - LOS_MAX_RANGE; x <= o.x + LOS_MAX_RANGE; x++)
         {
-            if (max(abs(o.x - x), abs(o.y - y)) > LOS_MAX_RANGE)
+            const coord_def ri(x, y);
+            if (!map_bounds(ri))
                 continue;
 
-            coord_def ri(x, y);
-            losfield_t* flags = _lookup_globallos(o, ri);
-            if (!flags)
-                continue;
-            *flags |= l << LOS_KNOWN;
-            if (los->see_cell(ri))
-                *flags |= l;
+            const bool vis = los->see_cell(ri);
+            const int i = _field_index(o, ri);
+            field.known[t][i >> 6] |= uint64_t(1) << (i & 63);
+            if (vis)
+                field.vis[t][i >> 6] |= uint64_t(1) << (i & 63);
             else
-                *flags &= ~l;
+                field.vis[t][i >> 6] &= ~(uint64_t(1) << (i & 63));
+
+            // Visibility is symmetric: mirror into the target's field.
+            losfield_t& other = globallos[x][y];
+            const int j = _field_index(ri, o);
+            other.known[t][j >> 6] |= uint64_t(1) << (j & 63);
+            if (vis)
+                other.vis[t][j >> 6] |= uint64_t(1) << (j & 63);
+            else
+                other.vis[t][j >> 6] &= ~(uint64_t(1) << (j & 63));
         }
+    field.complete |= l;
 }
 
-// Opacity at p has changed.
+// Opacity at p has changed. Rather than dropping every cached field
+// near p, clear only those pairs one of whose minimal cellrays passes
+// through p; the rest of the cache stays hot.
 void invalidate_los_around(const coord_def& p)
 {
-    int x1 = max(p.x - LOS_MAX_RANGE, 0);
-    int y1 = max(p.y - LOS_MAX_RANGE, 0);
-    int x2 = min(p.x, GXM - 1);
-    int y2 = min(p.y + LOS_MAX_RANGE, GYM - 1);
+    const int x1 = max(p.x - LOS_MAX_RANGE, 0);
+    const int y1 = max(p.y - LOS_MAX_RANGE, 0);
+    const int x2 = min(p.x + LOS_MAX_RANGE, GXM - 1);
+    const int y2 = min(p.y + LOS_MAX_RANGE, GYM - 1);
     for (int y = y1; y <= y2; y++)
         for (int x = x1; x <= x2; x++)
-            memset(globallos[x][y], 0, sizeof(halflos_t));
+        {
+            const coord_def s(x, y);
+
+            // Pairs with p itself as an endpoint are always stale.
+            _clear_pair(s, p);
+            if (s == p)
+                continue;
+
+            const coord_def diff = p - s;
+            // On the axes the quadrant mirroring is ambiguous, so
+            // consider both sign choices there.
+            for (int sx = -1; sx <= 1; sx += 2)
+                for (int sy = -1; sy <= 1; sy += 2)
+                {
+                    if (sx * diff.x < 0 || sy * diff.y < 0)
+                        continue;
+                    const coord_def rel(sx * diff.x, sy * diff.y);
+                    for (const coord_def& e : los_blocked_cellray_ends(rel))
+                        _clear_pair(s, coord_def(s.x + sx * e.x,
+                                                 s.y + sy * e.y));
+                }
+        }
 }
 
 void invalidate_los()
 {
-    for (rectangle_iterator ri(0); ri; ++ri)
-        memset(globallos[ri->x][ri->y], 0, sizeof(halflos_t));
+    memset(globallos, 0, sizeof(globallos));
 }
 
 static void _update_globallos_at(const coord_def& p, los_type l)
@@ -113,22 +191,135 @@ static void _update_globallos_at(const coord_def& p, los_type l)
     }
 }
 
+// The field at p with all pairs for type l known, updating it if
+// necessary.
+static const losfield_t& _complete_field(const coord_def& p, los_type l)
+{
+    los_flush_pending();
+    losfield_t& field = globallos[p.x][p.y];
+    if (!(field.complete & l))
+        _update_globallos_at(p, l);
+    ASSERT(globallos[p.x][p.y].complete & l);
+    return field;
+}
+
 bool cell_see_cell(const coord_def& p, const coord_def& q, los_type l)
 {
     if (l == LOS_NONE)
         return true;
 
-    losfield_t* flags = _lookup_globallos(p, q);
-
-    if (!flags)
+    if (!map_bounds(p) || !map_bounds(q))
+        return false;
+    if ((q - p).rdist() > LOS_RADIUS)
         return false; // outside range
 
-    if (!(*flags & (l << LOS_KNOWN)))
+    los_flush_pending();
+
+    const int t = _plane_index(l);
+    const int i = _field_index(p, q);
+    losfield_t& field = globallos[p.x][p.y];
+
+    if (!(field.known[t][i >> 6] & (uint64_t(1) << (i & 63))))
         _update_globallos_at(p, l);
 
-    //if (!(*flags & (l << LOS_KNOWN)))
-    //    die("cell_see_cell %d,%d %d,%d", p.x,p.y,q.x,q.y);
-    ASSERT(*flags & (l << LOS_KNOWN));
+    ASSERT(field.known[t][i >> 6] & (uint64_t(1) << (i & 63)));
+
+    return field.vis[t][i >> 6] & (uint64_t(1) << (i & 63));
+}
+
+los_cell_set::los_cell_set(const coord_def& c)
+    : center(c)
+{
+    memset(words, 0, sizeof(words));
+}
+
+void los_cell_set::add(const coord_def& q)
+{
+    if (!map_bounds(q) || (q - center).rdist() > LOS_MAX_RANGE)
+        return;
+    const int i = _field_index(center, q);
+    words[i >> 6] |= uint64_t(1) << (i & 63);
+}
+
+bool los_cell_set::contains(const coord_def& q) const
+{
+    if (!map_bounds(q) || (q - center).rdist() > LOS_MAX_RANGE)
+        return false;
+    const int i = _field_index(center, q);
+    return words[i >> 6] & (uint64_t(1) << (i & 63));
+}
+
+// How many of the given cells can p see? One field update at most,
+// then a handful of AND/popcount operations.
+int cell_see_count(const coord_def& p, const los_cell_set& targets,
+                   los_type l)
+{
+    ASSERT(targets.center == p);
+    if (!map_bounds(p))
+        return 0;
+
+    int count = 0;
+    if (l == LOS_NONE)
+    {
+        for (int w = 0; w < LOS_FIELD_WORDS; ++w)
+            count += _popcount64(targets.words[w]);
+        return count;
+    }
 
-    return *flags & l;
+    const losfield_t& field = _complete_field(p, l);
+    const int t = _plane_index(l);
+    for (int w = 0; w < LOS_FIELD_WORDS; ++w)
+        count += _popcount64(field.vis[t][w] & targets.words[w]);
+    return count;
+}
+
+// Can p see any of the given cells?
+bool cell_see_any(const coord_def& p, const los_cell_set& targets,
+                  los_type l)
+{
+    ASSERT(targets.center == p);
+    if (!map_bounds(p))
+        return false;
+
+    if (l == LOS_NONE)
+    {
+        for (int w = 0; w < LOS_FIELD_WORDS; ++w)
+            if (targets.words[w])
+                return true;
+        return false;
+    }
+
+    const losfield_t& field = _complete_field(p, l);
+    const int t = _plane_index(l);
+    for (int w = 0; w < LOS_FIELD_WORDS; ++w)
+        if (field.vis[t][w] & targets.words[w])
+            return true;
+    return false;
+}
+
+// Which of the given cells can p see? Computes the field at p at most
+// once; each query is then a single bit test.
+void cell_see_cells(const coord_def& p, const vector<coord_def>& qs,
+                    vector<bool>& seen, los_type l)
+{
+    seen.assign(qs.size(), false);
+    if (!map_bounds(p))
+        return;
+
+    if (l == LOS_NONE)
+    {
+        seen.assign(qs.size(), true);
+        return;
+    }
+
+    const losfield_t& field = _complete_field(p, l);
+    const int t = _plane_index(l);
+    for (unsigned int n = 0; n < qs.size(); ++n)
+    {
+        const coord_def& q = qs[n];
+        if (!map_bounds(q) || (q - p).rdist() > LOS_RADIUS)
+            continue;
+        const int i = _field_index(p, q);
+        seen[n] = field.vis[t][i >> 6] & (uint64_t(1) << (i & 63));
+    }
 }
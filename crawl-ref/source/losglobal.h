@@ -1,8 +1,34 @@
 #pragma once
 
+#include <vector>
+
 #include "los-type.h"
 
+// Words per bit plane of a cached LOS field; enough for
+// (2*LOS_MAX_RANGE+1)^2 target bits.
+#define LOS_FIELD_WORDS 5
+
 void invalidate_los_around(const coord_def& p);
 void invalidate_los();
 
 bool cell_see_cell(const coord_def& p, const coord_def& q, los_type l);
+
+// A set of target cells around a fixed center, packed to match the
+// word layout of the global LOS cache for batch queries.
+class los_cell_set
+{
+public:
+    explicit los_cell_set(const coord_def& c);
+    void add(const coord_def& q);
+    bool contains(const coord_def& q) const;
+
+    coord_def center;
+    uint64_t words[LOS_FIELD_WORDS];
+};
+
+bool cell_see_any(const coord_def& p, const los_cell_set& targets,
+                  los_type l);
+int cell_see_count(const coord_def& p, const los_cell_set& targets,
+                   los_type l);
+void cell_see_cells(const coord_def& p, const vector<coord_def>& qs,
+                    vector<bool>& seen, los_type l);
@@ -7,12 +7,62 @@
 
 #include "losparam.h"
 
+#include "bitary.h"
 #include "cloud.h"
+#include "coordit.h"
 #include "env.h"
 #include "los.h"
 #include "state.h"
 #include "terrain.h"
 
+// Packed per-level opacity planes, kept in sync with env.grid through
+// the los_*_changed() notifications. They turn the per-cell blocking
+// tests in ray walking into single bit reads instead of feature,
+// cloud and monster lookups. The half plane covers both opaque clouds
+// and sight-blocking monsters (bushes), which block identically for
+// all the cached los_types that consider them.
+static FixedBitArray<GXM, GYM> _opc_opaque;
+static FixedBitArray<GXM, GYM> _opc_wall;
+static FixedBitArray<GXM, GYM> _opc_solid;
+static FixedBitArray<GXM, GYM> _opc_half;
+static bool _opc_valid = false;
+
+static void _compute_opacity_at(const coord_def& p)
+{
+    const dungeon_feature_type f = grd(p);
+    _opc_opaque.set(p, feat_is_opaque(f));
+    _opc_wall.set(p, feat_is_opaque(f) || feat_is_wall(f));
+    _opc_solid.set(p, feat_is_solid(f));
+    bool half = is_opaque_cloud(cloud_type_at(p));
+    if (!half)
+        if (const monster *mon = monster_at(p))
+            half = mons_opacity(mon, LOS_DEFAULT) != OPC_CLEAR;
+    _opc_half.set(p, half);
+}
+
+static void _ensure_opacity_grid()
+{
+    if (_opc_valid)
+        return;
+    for (rectangle_iterator ri(0); ri; ++ri)
+        _compute_opacity_at(*ri);
+    _opc_valid = true;
+}
+
+// Opacity at p may have changed; refresh its bits.
+void opacity_grid_changed(const coord_def& p)
+{
+    if (_opc_valid && map_bounds(p))
+        _compute_opacity_at(p);
+}
+
+// Everything may have changed (level load, arena reset, ...);
+// rebuild lazily on the next query.
+void opacity_grid_reset()
+{
+    _opc_valid = false;
+}
+
 const opacity_default opc_default = opacity_default();
 const opacity_fullyopaque opc_fullyopaque = opacity_fullyopaque();
 const opacity_no_trans opc_no_trans = opacity_no_trans();
@@ -24,34 +74,24 @@ const opacity_excl opc_excl = opacity_excl();
 
 opacity_type opacity_default::operator()(const coord_def& p) const
 {
-    dungeon_feature_type f = grd(p);
-    if (feat_is_opaque(f))
+    _ensure_opacity_grid();
+    if (_opc_opaque(p))
         return OPC_OPAQUE;
-    else if (is_opaque_cloud(cloud_type_at(p)))
-        return OPC_HALF;
-    else if (const monster *mon = monster_at(p))
-        return mons_opacity(mon, LOS_DEFAULT);
-    return OPC_CLEAR;
+    return _opc_half(p) ? OPC_HALF : OPC_CLEAR;
 }
 
 opacity_type opacity_fullyopaque::operator()(const coord_def& p) const
 {
-    if (feat_is_opaque(env.grid(p)))
-        return OPC_OPAQUE;
-    else
-        return OPC_CLEAR;
+    _ensure_opacity_grid();
+    return _opc_opaque(p) ? OPC_OPAQUE : OPC_CLEAR;
 }
 
 opacity_type opacity_no_trans::operator()(const coord_def& p) const
 {
-    dungeon_feature_type f = grd(p);
-    if (feat_is_opaque(f) || feat_is_wall(f))
+    _ensure_opacity_grid();
+    if (_opc_wall(p))
         return OPC_OPAQUE;
-    else if (is_opaque_cloud(cloud_type_at(p)))
-        return OPC_HALF;
-    else if (const monster *mon = monster_at(p))
-        return mons_opacity(mon, LOS_NO_TRANS);
-    return OPC_CLEAR;
+    return _opc_half(p) ? OPC_HALF : OPC_CLEAR;
 }
 
 opacity_type opacity_immob::operator()(const coord_def& p) const
@@ -71,26 +111,18 @@ opacity_type opacity_mons_immob::operator()(const coord_def& p) const
 
 opacity_type opacity_solid::operator()(const coord_def& p) const
 {
-    dungeon_feature_type f = env.grid(p);
-    if (feat_is_solid(f))
-        return OPC_OPAQUE;
-
-    return OPC_CLEAR;
+    _ensure_opacity_grid();
+    return _opc_solid(p) ? OPC_OPAQUE : OPC_CLEAR;
 }
 
 // Make anything solid block in addition to normal LOS.
 // That includes statues and grates in addition to opacity_no_trans.
 opacity_type opacity_solid_see::operator()(const coord_def& p) const
 {
-    dungeon_feature_type f = env.grid(p);
-    if (feat_is_solid(f))
+    _ensure_opacity_grid();
+    if (_opc_solid(p))
         return OPC_OPAQUE;
-    else if (is_opaque_cloud(cloud_type_at(p)))
-        return OPC_HALF;
-    else if (const monster *mon = monster_at(p))
-        return mons_opacity(mon, LOS_SOLID_SEE);
-
-    return OPC_CLEAR;
+    return _opc_half(p) ? OPC_HALF : OPC_CLEAR;
 }
 
 opacity_type opacity_monmove::operator()(const coord_def& p) const
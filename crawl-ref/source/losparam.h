@@ -16,6 +16,11 @@ enum opacity_type
     NUM_OPACITIES
 };
 
+// Maintenance of the packed opacity planes backing the cached
+// opacity functors; called from the los_*_changed() notifications.
+void opacity_grid_changed(const coord_def& p);
+void opacity_grid_reset();
+
 class opacity_func
 {
 public:
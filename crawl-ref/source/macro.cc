@@ -32,6 +32,7 @@
 #include <vector>
 
 #include "cio.h"
+#include "end.h"
 #include "files.h"
 #include "initfile.h"
 #include "libutil.h"
@@ -65,6 +66,11 @@ static macromap *all_maps[] =
 static keybuf Buffer;
 static keybuf SendKeysBuffer;
 
+// Keystroke log being written (-record-keys), if any, and whether keys
+// loaded from one (-replay-keys) are still being consumed.
+static FILE *_keylog_out = nullptr;
+static bool _keylog_replaying = false;
+
 #define USERFUNCBASE -10000
 static vector<string> userfunctions;
 
@@ -635,6 +641,9 @@ int macro_buf_get()
         if (macro_keys_left == 0)
             macro_keys_left = -1;
 
+        // Both buffers drained: a keylog replay, if any, is over.
+        _keylog_replaying = false;
+
         return -1;
     }
 
@@ -649,6 +658,12 @@ int macro_buf_get()
     for (key_recorder *recorder : recorders)
         recorder->add_key(key);
 
+    if (_keylog_out)
+    {
+        fprintf(_keylog_out, "%d\n", key);
+        fflush(_keylog_out);
+    }
+
     return key;
 }
 
@@ -701,6 +716,78 @@ void macro_save()
     fclose(f);
 }
 
+/*
+ * Opens the keystroke log for -record-keys. Every key fetched from the
+ * keyboard buffer (i.e. post macro expansion) is appended to it, so the
+ * log together with the seed in its header reproduces the session.
+ */
+void keylog_start_record(const string &filename)
+{
+    _keylog_out = fopen_u(filename.c_str(), "w");
+    if (!_keylog_out)
+        end(1, true, "Couldn't open %s for key recording", filename.c_str());
+
+    // The seed goes into the header so a recording can be replayed
+    // without a separate -seed argument.
+    fprintf(_keylog_out, "# %s %s keylog\n# seed %x\n",
+            OUTS(CRAWL), OUTS(Version::Long), Options.seed);
+}
+
+void keylog_stop_record()
+{
+    if (_keylog_out)
+    {
+        fclose(_keylog_out);
+        _keylog_out = nullptr;
+    }
+}
+
+/*
+ * Loads a keystroke log written by -record-keys and queues its keys for
+ * replay. Returns false if the file can't be read or contains no keys.
+ */
+bool keylog_start_replay(const string &filename)
+{
+    FILE *f = fopen_u(filename.c_str(), "r");
+    if (!f)
+        return false;
+
+    char line[80];
+    keyseq keys;
+    while (fgets(line, sizeof line, f))
+    {
+        unsigned int seed = 0;
+        if (sscanf(line, "# seed %x", &seed) == 1)
+        {
+            // A seed given on the command line beats the recorded one.
+            if (!Options.seed)
+                Options.seed = seed;
+        }
+        else if (line[0] != '#')
+            keys.push_back(atoi(line));
+    }
+    fclose(f);
+
+    if (keys.empty())
+        return false;
+
+    // The log holds post-expansion keystrokes, so they re-enter the game
+    // as expanded keys through the sendkeys buffer, which feeds the main
+    // buffer whenever it runs dry.
+    for (int key : keys)
+        macro_sendkeys_end_add_expanded(key);
+
+    _keylog_replaying = true;
+    return true;
+}
+
+// True while keys loaded by keylog_start_replay() are still driving the
+// game; goes false once the buffers drain back to interactive input.
+bool keylog_replay_active()
+{
+    return _keylog_replaying;
+}
+
 /*
  * Reads as many keypresses as are available (waiting for at least one),
  * and returns them as a single keyseq.
@@ -50,6 +50,11 @@ void macro_add_query();
 void macro_init();
 void macro_save();
 
+void keylog_start_record(const string &filename);
+void keylog_stop_record();
+bool keylog_start_replay(const string &filename);
+bool keylog_replay_active();
+
 void macro_clear_buffers();
 
 void macro_userfn(const char *keys, const char *registryname);
@@ -7,6 +7,7 @@
 
 #include <algorithm>
 #include <cerrno>
+#include <chrono>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
@@ -52,6 +53,7 @@
 #include "crash.h"
 #include "dactions.h"
 #include "database.h"
+#include "dbg-prof.h"
 #include "dbg-scan.h"
 #include "dbg-util.h"
 #include "delay.h"
@@ -92,6 +94,7 @@
 #include "jobs.h"
 #include "level-state-type.h"
 #include "libutil.h"
+#include "los.h"
 #include "luaterp.h"
 #include "lookup-help.h"
 #include "macro.h"
@@ -186,6 +189,41 @@ void world_reacts();
 
 static key_recorder repeat_again_rec;
 
+// Wall-clock time spent per turn while replaying a keylog, so that two
+// builds can be compared on the same recorded session. The phases carve
+// world_reacts() into actor behaviour, world upkeep, the viewwindow()
+// redraw, and end-of-turn bookkeeping.
+static vector<unsigned int> _replay_turn_usec;
+static unsigned long long _replay_phase_usec[4];
+static const char *_replay_phase_names[4] =
+    { "acting", "upkeep", "redraw", "bookkeeping" };
+
+static void _report_replay_timings()
+{
+    vector<unsigned int> sorted(_replay_turn_usec);
+    sort(sorted.begin(), sorted.end());
+
+    unsigned long long total = 0;
+    for (unsigned int usec : sorted)
+        total += usec;
+
+    // Written to stderr rather than the message window so that replay
+    // runs can be scripted and their output diffed.
+    fprintf(stderr, "replay: %u turns in %llu.%03llu ms\n",
+            (unsigned int)sorted.size(), total / 1000, total % 1000);
+    fprintf(stderr, "replay: per turn min %u us, median %u us, "
+                    "90th %u us, max %u us\n",
+            sorted.front(), sorted[sorted.size() / 2],
+            sorted[sorted.size() * 9 / 10], sorted.back());
+    for (int i = 0; i < 4; ++i)
+    {
+        fprintf(stderr, "replay: %s %llu.%03llu ms\n",
+                _replay_phase_names[i],
+                _replay_phase_usec[i] / 1000, _replay_phase_usec[i] % 1000);
+    }
+}
+
+
 // Clockwise, around the compass from north (same order as run_dir_type)
 const struct coord_def Compass[9] =
 {
@@ -329,6 +367,10 @@ int main(int argc, char *argv[])
         return -1;
 #endif
 
+    // In DEBUG_PROF builds, stream timer zones for the whole session;
+    // prof_stop_trace() in end() finalises the file.
+    prof_start_trace("crawl-trace.json");
+
     _launch_game_loop();
     if (crawl_state.last_game_exit.message.size())
         end(0, false, "%s\n", crawl_state.last_game_exit.message.c_str());
@@ -474,7 +516,17 @@ NORETURN static void _launch_game()
 
     cursor_control ccon(!Options.use_fake_player_cursor);
     while (true)
+    {
         _input();
+
+        // Once a keylog replay runs out of keys, report the timings it
+        // collected (exactly once) before going back to interactive play.
+        if (!_replay_turn_usec.empty() && !keylog_replay_active())
+        {
+            _report_replay_timings();
+            _replay_turn_usec.clear();
+        }
+    }
 }
 
 static void _show_commandline_options_help()
@@ -499,6 +551,8 @@ static void _show_commandline_options_help()
     puts("  -sprint               select Sprint");
     puts("  -sprint-map <name>    preselect a Sprint map");
     puts("  -tutorial             select the Tutorial");
+    puts("  -record-keys <file>   log the seed and all keystrokes to a file");
+    puts("  -replay-keys <file>   replay a recorded session, reporting timings");
 #ifdef WIZARD
     puts("  -wizard               allow access to wizard mode");
     puts("  -explore              allow access to explore mode");
@@ -971,12 +1025,91 @@ static void _update_place_info()
     curr_LevelXPInfo.assert_validity();
 }
 
+// Burn through rest turns back to back instead of taking one per trip
+// through the input loop. Every iteration still runs the complete
+// per-turn machinery -- monster actions, clouds, timed effects,
+// activity interrupts -- so the outcome is identical to pressing '5'
+// and waiting; what it skips is the stat draw, message window and
+// input bookkeeping between turns, which dominate rest time when
+// nothing is happening. Anything interesting (damage, a monster
+// coming into view, full HP/MP) interrupts the rest through the usual
+// channels and ends the loop. Only used when rest_delay is -1 (the
+// dgl default), i.e. the player has asked not to watch rest tick by.
+static void _rest_fast_forward()
+{
+    if (Options.rest_delay != -1 || crawl_state.game_is_hints())
+        return;
+
+    while (you.running.is_rest())
+    {
+        if (crawl_state.seen_hups || you.pending_revival || you.cannot_act())
+            break;
+
+        if (kbhit())
+        {
+            if (Options.travel_key_stop)
+                stop_running();
+            break;
+        }
+
+#ifdef WATCHDOG
+        watchdog();
+#endif
+
+        religion_turn_start();
+        god_conduct_turn_start();
+        reset_damage_counters();
+
+        you.turn_is_over = false;
+        you.time_taken = player_speed();
+        you.shield_blocks = 0;
+
+        update_monsters_in_view();
+
+        // Monster update can cause a weapon swap.
+        if (you.turn_is_over)
+        {
+            world_reacts();
+            continue;
+        }
+
+        // Scripts use the per-turn hook to watch resting; keep calling it.
+        if (++crawl_state.lua_calls_no_turn > 1000)
+            mprf(MSGCH_ERROR, "Infinite lua loop detected, aborting.");
+        else if (!clua.callfn("ready", 0, 0) && !clua.error.empty())
+            mprf(MSGCH_ERROR, "Lua error: %s", clua.error.c_str());
+
+        if (!you.running.is_rest())
+            break;
+
+        you.running.rest();
+
+        if (!is_resting() && you.running.hp == you.hp
+            && you.running.mp == you.magic_points)
+        {
+            mpr("Done waiting.");
+        }
+
+        update_acrobat_status();
+        you.turn_is_over = true;
+
+        if (you.apply_berserk_penalty)
+            _do_berserk_no_combat_penalty();
+
+        _do_searing_ray();
+
+        world_reacts();
+    }
+}
+
 //
 //  This function handles the player's input. It's called from main(),
 //  from inside an endless loop.
 //
 static void _input()
 {
+    PROF_ZONE("input");
+
     if (crawl_state.seen_hups)
         save_game(true, "Game saved, see you later!");
 
@@ -1187,6 +1320,8 @@ static void _input()
         _do_searing_ray();
 
         world_reacts();
+
+        _rest_fast_forward();
     }
     else
     {
@@ -2202,88 +2337,118 @@ static void _update_still_winds()
 
 void world_reacts()
 {
-    // All markers should be activated at this point.
-    ASSERT(!env.markers.need_activate());
+    PROF_ZONE("world_reacts");
 
-    fire_final_effects();
+    const bool replay_timing = keylog_replay_active();
+    const auto turn_start = chrono::steady_clock::now();
+    auto phase_start = turn_start;
+    auto end_phase = [&phase_start, replay_timing](int phase)
+    {
+        if (!replay_timing)
+            return;
+        const auto now = chrono::steady_clock::now();
+        _replay_phase_usec[phase] += chrono::duration_cast
+            <chrono::microseconds>(now - phase_start).count();
+        phase_start = now;
+    };
 
-    if (crawl_state.viewport_monster_hp || crawl_state.viewport_weapons)
     {
-        crawl_state.viewport_monster_hp = false;
-        crawl_state.viewport_weapons = false;
-        viewwindow();
-    }
+        // Coalesce the map redraws requested while this turn's actions
+        // and upkeep cascade into the single frame drawn below;
+        // animation frames still draw immediately.
+        const redraw_batch batch;
 
-    update_monsters_in_view();
+        // All markers should be activated at this point.
+        ASSERT(!env.markers.need_activate());
 
-    reset_show_terrain();
+        fire_final_effects();
 
-    crawl_state.clear_mon_acting();
+        if (crawl_state.viewport_monster_hp || crawl_state.viewport_weapons)
+        {
+            crawl_state.viewport_monster_hp = false;
+            crawl_state.viewport_weapons = false;
+            viewwindow();
+        }
 
-    if (!crawl_state.game_is_arena())
-    {
-        you.turn_is_over = true;
-        religion_turn_end();
-        crawl_state.clear_god_acting();
-    }
+        update_monsters_in_view();
 
-#ifdef USE_TILE
-    if (crawl_state.game_is_hints())
-    {
-        tiles.clear_text_tags(TAG_TUTORIAL);
-        tiles.place_cursor(CURSOR_TUTORIAL, NO_CURSOR);
-    }
-#endif
+        reset_show_terrain();
 
-    _check_banished();
-    _check_sanctuary();
-
-    run_environment_effects();
-
-    if (!crawl_state.game_is_arena())
-        player_reacts();
-
-    abyss_morph();
-    apply_noises();
-    handle_monsters(true);
-
-    _check_banished();
-
-    ASSERT(you.time_taken >= 0);
-    you.elapsed_time += you.time_taken;
-    if (you.elapsed_time >= 2*1000*1000*1000)
-    {
-        // 2B of 1/10 turns. A 32-bit signed int can hold 2.1B.
-        // The worst case of mummy scumming had 92M turns, the second worst
-        // merely 8M. This limit is ~200M turns, with an efficient bot that
-        // keeps resting on a fast machine, it takes ~24 hours to hit it
-        // on a level with no monsters, at 100% CPU utilization, producing
-        // a gigabyte of bzipped ttyrec.
-        // We could extend the counters to 64 bits, but in the light of the
-        // above, it's an useless exercise.
-        mpr("Outside, the world ends.");
-        mpr("Sorry, but your quest for the Orb is now rather pointless. "
-            "You quit...");
-        // Please do not give it a custom ktyp or make it cool in any way
-        // whatsoever, because players are insane. Usually, not being dragged
-        // down by sanity is good, but this is not the case here.
-        ouch(INSTANT_DEATH, KILLED_BY_QUITTING);
-    }
-
-    handle_time();
-    manage_clouds();
-    if (env.level_state & LSTATE_GLOW_MOLD)
-        _update_mold();
-    if (env.level_state & LSTATE_GOLUBRIA)
-        _update_golubria_traps();
-    if (env.level_state & LSTATE_STILL_WINDS)
-        _update_still_winds();
-    if (!crawl_state.game_is_arena())
-        player_reacts_to_monsters();
-
-    wu_jian_end_of_turn_effects();
+        crawl_state.clear_mon_acting();
 
-    viewwindow();
+        if (!crawl_state.game_is_arena())
+        {
+            you.turn_is_over = true;
+            religion_turn_end();
+            crawl_state.clear_god_acting();
+        }
+
+    #ifdef USE_TILE
+        if (crawl_state.game_is_hints())
+        {
+            tiles.clear_text_tags(TAG_TUTORIAL);
+            tiles.place_cursor(CURSOR_TUTORIAL, NO_CURSOR);
+        }
+    #endif
+
+        _check_banished();
+        _check_sanctuary();
+
+        run_environment_effects();
+
+        if (!crawl_state.game_is_arena())
+            player_reacts();
+
+        abyss_morph();
+        apply_noises();
+        handle_monsters(true);
+
+        _check_banished();
+        end_phase(0); // acting
+
+        ASSERT(you.time_taken >= 0);
+        you.elapsed_time += you.time_taken;
+        if (you.elapsed_time >= 2*1000*1000*1000)
+        {
+            // 2B of 1/10 turns. A 32-bit signed int can hold 2.1B.
+            // The worst case of mummy scumming had 92M turns, the second worst
+            // merely 8M. This limit is ~200M turns, with an efficient bot that
+            // keeps resting on a fast machine, it takes ~24 hours to hit it
+            // on a level with no monsters, at 100% CPU utilization, producing
+            // a gigabyte of bzipped ttyrec.
+            // We could extend the counters to 64 bits, but in the light of the
+            // above, it's an useless exercise.
+            mpr("Outside, the world ends.");
+            mpr("Sorry, but your quest for the Orb is now rather pointless. "
+                "You quit...");
+            // Please do not give it a custom ktyp or make it cool in any way
+            // whatsoever, because players are insane. Usually, not being dragged
+            // down by sanity is good, but this is not the case here.
+            ouch(INSTANT_DEATH, KILLED_BY_QUITTING);
+        }
+
+        handle_time();
+        manage_clouds();
+        if (env.level_state & LSTATE_GLOW_MOLD)
+            _update_mold();
+        if (env.level_state & LSTATE_GOLUBRIA)
+            _update_golubria_traps();
+        if (env.level_state & LSTATE_STILL_WINDS)
+            _update_still_winds();
+        if (!crawl_state.game_is_arena())
+            player_reacts_to_monsters();
+
+        wu_jian_end_of_turn_effects();
+
+        // Apply the turn's accumulated opacity changes (mostly cloud
+        // creation and expiry) to the global LOS cache in one pass.
+        los_flush_pending();
+        end_phase(1); // upkeep
+
+        // The turn's one real draw: closing the batch below flushes it.
+        viewwindow();
+    }
+    end_phase(2); // redraw
 
     if (you.cannot_act() && any_messages()
         && crawl_state.repeat_cmd != CMD_WIZARD)
@@ -2307,10 +2472,14 @@ void world_reacts()
             env.turns_on_level++;
         record_turn_timestamp();
         update_turn_count();
+        prof_mark_turn(you.num_turns);
         msgwin_new_turn();
         crawl_state.lua_calls_no_turn = 0;
-        if (crawl_state.game_is_sprint()
-            && !(you.num_turns % 256)
+        // Periodic checkpoints used to be sprint-only; now that saves
+        // skip unchanged chunks they're cheap enough for every game,
+        // and they bound what a crash or OOM kill loses to a couple
+        // hundred turns rather than everything since the last staircase.
+        if (!(you.num_turns % 256)
             && !you_are_delayed()
             && !crawl_state.disables[DIS_SAVE_CHECKPOINTS])
         {
@@ -2325,6 +2494,23 @@ void world_reacts()
     // the loudest noise tracking for the next world_reacts cycle.
     you.los_noise_last_turn = you.los_noise_level;
     you.los_noise_level = 0;
+
+    end_phase(3); // bookkeeping
+    if (replay_timing)
+    {
+        _replay_turn_usec.push_back(static_cast<unsigned int>(
+            chrono::duration_cast<chrono::microseconds>(
+                phase_start - turn_start).count()));
+    }
+
+    if (Options.slow_turn_capture_ms > 0)
+    {
+        const int elapsed_ms = static_cast<int>(
+            chrono::duration_cast<chrono::milliseconds>(
+                chrono::steady_clock::now() - turn_start).count());
+        if (elapsed_ms >= Options.slow_turn_capture_ms)
+            do_slow_turn_dump(elapsed_ms);
+    }
 }
 
 static command_type _get_next_cmd()
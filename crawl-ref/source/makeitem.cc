@@ -1461,9 +1461,9 @@ static void _generate_scroll_item(item_def& item, int force_type,
 /// Choose a random spellbook type for the given level.
 static book_type _choose_book_type(int item_level)
 {
-    const book_type book = static_cast<book_type>(random2(NUM_FIXED_BOOKS));
-    if (item_type_removed(OBJ_BOOKS, book))
-        return _choose_book_type(item_level); // choose something else
+    const book_type book =
+        static_cast<book_type>(random_live_subtype(OBJ_BOOKS, 0,
+                                                   NUM_FIXED_BOOKS - 1));
 
     // If this book is really rare for this depth, continue trying.
     const int rarity = book_rarity(book);
@@ -1558,11 +1558,7 @@ static void _generate_staff_item(item_def& item, bool allow_uniques,
 
     if (force_type == OBJ_RANDOM)
     {
-        do
-        {
-            item.sub_type = random2(NUM_STAVES);
-        }
-        while (item_type_removed(OBJ_STAVES, item.sub_type));
+        item.sub_type = random_live_subtype(OBJ_STAVES, 0, NUM_STAVES - 1);
 
         // staves of energy are 25% less common, wizardry/power
         // are more common
@@ -1818,6 +1814,11 @@ int items(bool allow_uniques,
            || force_class == OBJ_MISSILES
            || force_class == OBJ_MISCELLANY && is_deck_type(force_type));
 
+    // Item generation rolls on its own substream for the same reason
+    // the builder does: a given generation sequence stays reproducible
+    // no matter what gameplay randomness ran in between.
+    rng_stream itemgen_rng(RNG_ITEMGEN);
+
     // Find an empty slot for the item (with culling if required).
     int p = get_mitm_slot(10);
     if (p == NON_ITEM)
@@ -2086,15 +2087,9 @@ static bool _armour_is_visibly_special(const item_def &item)
 
 jewellery_type get_random_amulet_type()
 {
-    int res;
-    do
-    {
-        res = random_range(AMU_FIRST_AMULET, NUM_JEWELLERY - 1);
-    }
-    // Do not generate removed item types.
-    while (item_type_removed(OBJ_JEWELLERY, res));
-
-    return jewellery_type(res);
+    return jewellery_type(random_live_subtype(OBJ_JEWELLERY,
+                                              AMU_FIRST_AMULET,
+                                              NUM_JEWELLERY - 1));
 }
 
 static jewellery_type _get_raw_random_ring_type()
@@ -2102,10 +2097,11 @@ static jewellery_type _get_raw_random_ring_type()
     jewellery_type ring;
     do
     {
-        ring = (jewellery_type)(random_range(RING_FIRST_RING, NUM_RINGS - 1));
+        ring = (jewellery_type)random_live_subtype(OBJ_JEWELLERY,
+                                                   RING_FIRST_RING,
+                                                   NUM_RINGS - 1);
     }
-    while (ring == RING_TELEPORTATION && crawl_state.game_is_sprint()
-           || item_type_removed(OBJ_JEWELLERY, ring));
+    while (ring == RING_TELEPORTATION && crawl_state.game_is_sprint());
     return ring;
 }
 
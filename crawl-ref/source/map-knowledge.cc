@@ -19,16 +19,66 @@
 #include "travel.h"
 #include "view.h"
 
+// Staging buffer for minimap updates: while a map_update_batch is
+// live, touched cells are recorded here (deduplicated through the
+// flag grid) and flushed once when the outermost batch ends. A magic
+// mapping scroll or a large LOS reveal touches each cell's whole
+// neighbourhood, so the same minimap square is otherwise updated many
+// times over -- and each update recomputes the explore horizon.
+static int _batch_depth = 0;
+#ifdef USE_TILE
+static FixedArray<bool, GXM, GYM> _batch_staged;
+static vector<coord_def> _batch_cells;
+#endif
+
+map_update_batch::map_update_batch()
+{
+    _batch_depth++;
+}
+
+map_update_batch::~map_update_batch()
+{
+    if (--_batch_depth > 0)
+        return;
+#ifdef USE_TILE
+    for (const coord_def &gc : _batch_cells)
+    {
+        _batch_staged(gc) = false;
+        tiles.update_minimap(gc);
+    }
+    _batch_cells.clear();
+#endif
+}
+
+void batched_minimap_update(const coord_def &gc)
+{
+#ifdef USE_TILE
+    if (!_batch_depth)
+    {
+        tiles.update_minimap(gc);
+        return;
+    }
+    if (!map_bounds(gc) || _batch_staged(gc))
+        return;
+    _batch_staged(gc) = true;
+    _batch_cells.push_back(gc);
+#else
+    UNUSED(gc);
+#endif
+}
+
 void set_terrain_mapped(const coord_def gc)
 {
     map_cell* cell = &env.map_knowledge(gc);
     cell->flags &= (~MAP_CHANGED_FLAG);
     cell->flags |= MAP_MAGIC_MAPPED_FLAG;
+    travel_safety_changed(gc);
+    view_invalidate_scroll();
 #ifdef USE_TILE
     // This may have changed the explore horizon, so update adjacent minimap
     // squares as well.
     for (adjacent_iterator ai(gc, false); ai; ++ai)
-        tiles.update_minimap(*ai);
+        batched_minimap_update(*ai);
 #endif
 }
 
@@ -53,6 +103,8 @@ int count_detected_mons()
 
 void clear_map(bool clear_items, bool clear_mons)
 {
+    travel_safety_reset();
+    view_invalidate_scroll();
     for (rectangle_iterator ri(BOUNDARY_BORDER - 1); ri; ++ri)
     {
         const coord_def p = *ri;
@@ -113,6 +165,9 @@ static int _map_quality()
 
 void reautomap_level()
 {
+    // One minimap flush for the whole level rather than one per
+    // automapped neighbourhood.
+    map_update_batch batch;
     int passive = _map_quality();
 
     for (int x = X_BOUND_1; x <= X_BOUND_2; ++x)
@@ -140,12 +195,13 @@ void set_terrain_seen(const coord_def pos)
 
     cell->flags &= (~MAP_CHANGED_FLAG);
     cell->flags |= MAP_SEEN_FLAG;
+    travel_safety_changed(pos);
 
 #ifdef USE_TILE
     // This may have changed the explore horizon, so update adjacent minimap
     // squares as well.
     for (adjacent_iterator ai(pos, false); ai; ++ai)
-        tiles.update_minimap(*ai);
+        batched_minimap_update(*ai);
 #endif
 }
 
@@ -291,6 +347,7 @@ void update_cloud_knowledge()
         {
             if (env.map_knowledge[x][y].update_cloud_state())
             {
+                view_invalidate_scroll();
 #ifdef USE_TILE
                 tile_draw_map_cell({x, y}, true);
 #endif
@@ -7,6 +7,29 @@
 void set_terrain_mapped(const coord_def c);
 void set_terrain_seen(const coord_def c);
 
+/**
+ * @brief Coalesce minimap/webtiles updates over a batch of knowledge changes.
+ *
+ * While a map_update_batch is live, minimap touches from knowledge
+ * updates are staged instead of being propagated per cell, and each
+ * distinct cell is flushed once to the render/webtiles consumers when
+ * the outermost batch ends. Magic mapping and the per-turn LOS update
+ * touch overlapping neighbourhoods cell by cell; batching turns those
+ * into one update per distinct cell. Nesting is allowed and flushes at
+ * the outermost scope.
+ */
+class map_update_batch
+{
+public:
+    map_update_batch();
+    ~map_update_batch();
+};
+
+/**
+ * @brief Update the minimap at @p gc, staging it if a batch is live.
+ */
+void batched_minimap_update(const coord_def &gc);
+
 void set_terrain_visible(const coord_def c);
 void clear_terrain_visibility();
 
@@ -1550,14 +1550,16 @@ void map_lines::rotate(bool clockwise)
               ye = clockwise? -1 : (int) lines.size(),
               yi = clockwise? -1 : 1;
 
+    newlines.reserve(map_width);
     for (int i = xs; i != xe; i += xi)
     {
         string line;
+        line.reserve(lines.size());
 
         for (int j = ys; j != ye; j += yi)
             line += lines[j][i];
 
-        newlines.push_back(line);
+        newlines.push_back(move(line));
     }
 
     if (overlay.get())
@@ -1570,7 +1572,7 @@ void map_lines::rotate(bool clockwise)
     }
 
     map_width = lines.size();
-    lines     = newlines;
+    lines     = move(newlines);
     rotate_markers(clockwise);
     solid_checked = false;
 }
@@ -1623,11 +1625,7 @@ void map_lines::vmirror()
     const int midpoint = vsize / 2;
 
     for (int i = 0; i < midpoint; ++i)
-    {
-        string temp = lines[i];
-        lines[i] = lines[vsize - 1 - i];
-        lines[vsize - 1 - i] = temp;
-    }
+        swap(lines[i], lines[vsize - 1 - i]);
 
     if (overlay.get())
     {
@@ -3247,15 +3245,35 @@ void map_def::fixup()
     }
 }
 
+// Matches " <tag> " in tags without building the padded temporary;
+// these predicates run for every map definition on every vault
+// selection, so they should not allocate.
+static bool _tag_present(const string &tags, const string &tag)
+{
+    for (size_t pos = tags.find(tag, 1); pos != string::npos;
+         pos = tags.find(tag, pos + 1))
+    {
+        if (tags[pos - 1] == ' '
+            && pos + tag.length() < tags.length()
+            && tags[pos + tag.length()] == ' ')
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 bool map_def::has_tag(const string &tagwanted) const
 {
     if (tags.empty() || tagwanted.empty())
         return false;
 
-    vector<string> wanted_tags = split_string(" ", tagwanted);
+    // The common case is asking for a single tag.
+    if (tagwanted.find(' ') == string::npos)
+        return _tag_present(tags, tagwanted);
 
-    for (const string &tag : wanted_tags)
-        if (tags.find(" " + tag + " ") == string::npos)
+    for (const string &tag : split_string(" ", tagwanted))
+        if (!_tag_present(tags, tag))
             return false;
 
     return true;
@@ -3263,14 +3281,33 @@ bool map_def::has_tag(const string &tagwanted) const
 
 bool map_def::has_tag_prefix(const string &prefix) const
 {
-    return !tags.empty() && !prefix.empty()
-        && tags.find(" " + prefix) != string::npos;
+    if (tags.empty() || prefix.empty())
+        return false;
+
+    for (size_t pos = tags.find(prefix, 1); pos != string::npos;
+         pos = tags.find(prefix, pos + 1))
+    {
+        if (tags[pos - 1] == ' ')
+            return true;
+    }
+    return false;
 }
 
 bool map_def::has_tag_suffix(const string &suffix) const
 {
-    return !tags.empty() && !suffix.empty()
-        && tags.find(suffix + " ") != string::npos;
+    if (tags.empty() || suffix.empty())
+        return false;
+
+    for (size_t pos = tags.find(suffix); pos != string::npos;
+         pos = tags.find(suffix, pos + 1))
+    {
+        if (pos + suffix.length() < tags.length()
+            && tags[pos + suffix.length()] == ' ')
+        {
+            return true;
+        }
+    }
+    return false;
 }
 
 vector<string> map_def::get_tags() const
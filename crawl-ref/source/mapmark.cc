@@ -1024,6 +1024,8 @@ void map_markers::activate_markers_at(coord_def p)
 void map_markers::add(map_marker *marker)
 {
     markers.insert(dgn_pos_marker(marker->pos, marker));
+    if (map_bounds(marker->pos))
+        occupied.set(marker->pos);
     have_inactive_markers = true;
 }
 
@@ -1038,6 +1040,8 @@ void map_markers::unlink_marker(const map_marker *marker)
             break;
         }
     }
+    if (map_bounds(marker->pos) && !markers.count(marker->pos))
+        occupied.set(marker->pos, false);
 }
 
 void map_markers::check_empty()
@@ -1056,6 +1060,9 @@ void map_markers::remove(map_marker *marker)
 void map_markers::remove_markers_at(const coord_def &c,
                                     map_marker_type type)
 {
+    if (map_bounds(c) && !occupied(c))
+        return;
+
     auto els = markers.equal_range(c);
     for (auto i = els.first; i != els.second;)
     {
@@ -1066,11 +1073,16 @@ void map_markers::remove_markers_at(const coord_def &c,
             markers.erase(todel);
         }
     }
+    if (map_bounds(c) && !markers.count(c))
+        occupied.set(c, false);
     check_empty();
 }
 
 map_marker *map_markers::find(const coord_def &c, map_marker_type type)
 {
+    if (map_bounds(c) && !occupied(c))
+        return nullptr;
+
     auto els = markers.equal_range(c);
     for (auto i = els.first; i != els.second; ++i)
         if (type == MAT_ANY || i->second->get_type() == type)
@@ -1090,6 +1102,8 @@ map_marker *map_markers::find(map_marker_type type)
 void map_markers::move(const coord_def &from, const coord_def &to)
 {
     unwind_bool inactive(have_inactive_markers);
+    if (map_bounds(from))
+        occupied.set(from, false);
     auto els = markers.equal_range(from);
 
     list<map_marker*> tmarkers;
@@ -1144,8 +1158,11 @@ vector<map_marker*> map_markers::get_all(const string &key, const string &val)
 
 vector<map_marker*> map_markers::get_markers_at(const coord_def &c)
 {
-    auto els = markers.equal_range(c);
     vector<map_marker*> rmarkers;
+    if (map_bounds(c) && !occupied(c))
+        return rmarkers;
+
+    auto els = markers.equal_range(c);
     for (auto i = els.first; i != els.second; ++i)
         rmarkers.push_back(i->second);
     return rmarkers;
@@ -1154,6 +1171,9 @@ vector<map_marker*> map_markers::get_markers_at(const coord_def &c)
 string map_markers::property_at(const coord_def &c, map_marker_type type,
                                 const string &key)
 {
+    if (map_bounds(c) && !occupied(c))
+        return "";
+
     auto els = markers.equal_range(c);
     for (auto i = els.first; i != els.second; ++i)
     {
@@ -1169,6 +1189,7 @@ void map_markers::clear()
     for (auto &entry : markers)
         delete entry.second;
     markers.clear();
+    occupied.reset();
     check_empty();
 }
 
@@ -690,6 +690,7 @@ static bool _map_matches_species(const map_def &map)
 
 const map_def *find_map_by_name(const string &name)
 {
+    ensure_maps_loaded();
     for (const map_def &mapdef : vdefs)
         if (mapdef.name == name)
             return &mapdef;
@@ -707,6 +708,7 @@ void strip_all_maps()
 
 vector<string> find_map_matches(const string &name)
 {
+    ensure_maps_loaded();
     vector<string> matches;
 
     for (const map_def &mapdef : vdefs)
@@ -719,6 +721,7 @@ mapref_vector find_maps_for_tag(const string &tag,
                                 bool check_depth,
                                 bool check_used)
 {
+    ensure_maps_loaded();
     mapref_vector maps;
     level_id place = level_id::current();
 
@@ -1119,6 +1122,7 @@ _random_map_in_list(const map_selector &sel,
 
 static const map_def *_random_map_by_selector(const map_selector &sel)
 {
+    ensure_maps_loaded();
     const vault_indices filtered = _eligible_maps_for_selector(sel);
     return _random_map_in_list(sel, filtered);
 }
@@ -1141,6 +1145,7 @@ const map_def *random_map_in_depth(const level_id &place, bool want_minivault,
 mapref_vector random_chance_maps_in_depth(const level_id &place,
                                           maybe_bool extra)
 {
+    ensure_maps_loaded();
     map_selector sel = map_selector::by_depth_chance(place, extra);
     const vault_indices eligible = _eligible_maps_for_selector(sel);
     return _random_chance_maps_in_list(sel, eligible);
@@ -1335,6 +1340,35 @@ static bool _load_map_cache(const string &filename, const string &cachename)
     return _load_map_index(cachename, descache_base, mtime);
 }
 
+// Compile a chunk's Lua source to bytecode so that the des cache
+// stores the precompiled form (dlua_chunk::write marshals bytecode
+// when it's available). Maps loaded from the cache then skip the Lua
+// parser entirely, which matters for validate and veto chunks that run
+// inside vault selection loops. The cache header's version and word
+// size stamps already guard against loading bytecode produced by an
+// incompatible build. Compile errors are ignored here: the source form
+// is cached instead, and the error surfaces at placement time exactly
+// as it would without the cache.
+static void _precompile_chunk(dlua_chunk &chunk)
+{
+    if (chunk.empty() || !chunk.compiled_chunk().empty())
+        return;
+
+    // load() leaves the compiled function on the stack; discard it.
+    lua_stack_cleaner clean(dlua);
+    chunk.load(dlua);
+}
+
+static void _precompile_map_lua(map_def &map)
+{
+    _precompile_chunk(map.prelude);
+    _precompile_chunk(map.mapchunk);
+    _precompile_chunk(map.main);
+    _precompile_chunk(map.validate);
+    _precompile_chunk(map.veto);
+    _precompile_chunk(map.epilogue);
+}
+
 static void _write_map_prelude(const string &filebase, time_t mtime)
 {
     const string luafile = filebase + ".lux";
@@ -1350,6 +1384,7 @@ static void _write_map_prelude(const string &filebase, time_t mtime)
     marshallUByte(outf, TAG_MINOR_VERSION);
     marshallByte(outf, WORD_LEN);
     marshallSigned(outf, mtime);
+    _precompile_chunk(lc_global_prelude);
     lc_global_prelude.write(outf);
     fclose(fp);
 }
@@ -1368,7 +1403,10 @@ static void _write_map_full(const string &filebase, size_t vs, size_t ve,
     marshallByte(outf, WORD_LEN);
     marshallSigned(outf, mtime);
     for (size_t i = vs; i < ve; ++i)
+    {
+        _precompile_map_lua(vdefs[i]);
         vdefs[i].write_full(outf);
+    }
     fclose(fp);
 }
 
@@ -1454,13 +1492,36 @@ void read_map(const string &file)
     dlua.gc();
 }
 
+static bool _maps_loaded = false;
+
+// Lazy-init gate: the .des cache is parsed on the first map lookup
+// rather than at process start, so an idle startup menu doesn't pay
+// for it. -builddb and the debug harnesses still call read_maps()
+// directly to force a full (re)load.
+void ensure_maps_loaded()
+{
+    if (_maps_loaded)
+        return;
+    read_maps();
+    run_map_global_preludes();
+}
+
 void read_maps()
 {
+    // Set before doing any work: the sanity checks place maps through
+    // the public selectors, which would otherwise re-enter read_maps().
+    _maps_loaded = true;
+
     if (dlua.execfile("dlua/loadmaps.lua", true, true, true))
         end(1, false, "Lua error: %s", dlua.error.c_str());
 
     lc_loaded_maps.clear();
 
+    // A partial -builddb-des build loads only a slice of the corpus,
+    // which the cross-map sanity checks would falsely flag.
+    if (!crawl_state.build_db_only.empty())
+        return;
+
     {
         unwind_var<FixedVector<int, NUM_BRANCHES> > depths(brdepth);
         // let the sanity check place maps
@@ -1517,6 +1578,7 @@ void run_map_global_preludes()
 
 void run_map_local_preludes()
 {
+    ensure_maps_loaded();
     for (map_def &vdef : vdefs)
     {
         if (!vdef.prelude.empty())
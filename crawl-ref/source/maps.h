@@ -53,6 +53,7 @@ mapref_vector find_maps_for_tag(const string &tag,
                                 bool check_depth = false,
                                 bool check_used = true);
 
+void ensure_maps_loaded();
 void read_maps();
 void reread_maps();
 void read_map(const string &file);
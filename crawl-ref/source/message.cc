@@ -24,10 +24,12 @@
 #include "mon-util.h"
 #include "notes.h"
 #include "output.h"
+#include "package.h"
 #include "religion.h"
 #include "sound.h"
 #include "state.h"
 #include "stringutil.h"
+#include "tags.h"
 #include "tiles-build-specific.h"
 #include "unwind.h"
 #include "view.h"
@@ -68,9 +70,16 @@ struct message_particle
     string text;        /// text of message (tagged string...)
     int repeats;        /// Number of times the message is in succession (x2)
 
+    /// Cache of pure_text(): the merge heuristics and the message window
+    /// ask for it several times per message, and parsing the colour tags
+    /// out is the expensive part of storing a message.
+    mutable string pure;
+
     string pure_text() const
     {
-        return formatted_string::parse_string(text).tostring();
+        if (pure.empty())
+            pure = formatted_string::parse_string(text).tostring();
+        return pure;
     }
 
     string with_repeats() const
@@ -390,6 +399,13 @@ class message_window
     vector<formatted_string> lines;
     prefix_type prompt; // current prefix prompt
 
+    // What each screen row currently displays, as colour-tagged text,
+    // so show() can skip rows that haven't changed: a one-line message
+    // in an unfilled window touches one row, not the whole pane.
+    // Cleared whenever something else has written into the region.
+    vector<string> painted;
+    int painted_width = 0;
+
     int height() const
     {
         return crawl_view.msgsz.y;
@@ -601,14 +617,39 @@ public:
         //  lines if this has happened.
         const int diff = max(int(lines.size()) - height(), 0);
 
+        bool force = false;
+        if ((int) painted.size() != height() || painted_width != width())
+        {
+            painted.assign(height(), string());
+            painted_width = width();
+            force = true;
+        }
+
         for (size_t i = diff; i < lines.size(); ++i)
-            out_line(lines[i], i - diff);
+        {
+            string &prev = painted[i - diff];
+            string cur = lines[i].to_colour_string();
+            if (force || cur != prev)
+            {
+                out_line(lines[i], i - diff);
+                prev = move(cur);
+            }
+        }
         place_cursor();
 #ifdef USE_TILE
         tiles.set_need_redraw();
 #endif
     }
 
+    // Forget what's on screen and write out every row: for use after
+    // the region has been clobbered by someone else (full-screen menus,
+    // prompts drawn in place).
+    void repaint()
+    {
+        painted.clear();
+        show();
+    }
+
     // temporary: to be overwritten with next item, e.g. new turn
     //            leading dash or prompt without response
     void add_item(string text, prefix_type first_col = prefix_type::none,
@@ -709,6 +750,9 @@ public:
 
             readkey_more(user);
         }
+
+        // The prompt was written straight onto the last row.
+        painted.clear();
     }
 };
 
@@ -716,7 +760,9 @@ message_window msgwin;
 
 void display_message_window()
 {
-    msgwin.show();
+    // Callers use this after full-screen interfaces have clobbered the
+    // region, so don't trust the damage tracking.
+    msgwin.repaint();
 }
 
 void clear_message_window()
@@ -759,7 +805,9 @@ public:
 
     void add(const message_line& msg)
     {
+#ifdef USE_SOUND
         string orig_full_text = msg.full_text();
+#endif
 
         if (!(msg.channel != MSGCH_PROMPT && prev_msg.merge(msg)))
         {
@@ -1333,6 +1381,21 @@ void msgwin_clear_temporary()
 
 static int _last_msg_turn = -1; // Turn of last message.
 
+// Pre-format repeat collapse: AOE turns emit long runs of identical
+// messages ("The orc dies!" xN), and everything from the force_more
+// regexes to colour parsing costs the same for every copy. When a
+// message repeats the previous one byte for byte within the same turn,
+// the formatted line computed for the first copy is replayed instead
+// and the buffer's usual merge bumps its repeat count. Messages that
+// prompted, flashed or interrupted are never replayed.
+static string _repeat_text;
+static msg_channel_type _repeat_channel = MSGCH_PLAIN;
+static int _repeat_param = 0;
+static bool _repeat_cap = false;
+static int _repeat_turn = -1;
+static bool _repeat_ok = false;
+static message_line _repeat_line;
+
 static void _mpr(string text, msg_channel_type channel, int param, bool nojoin,
                  bool cap)
 {
@@ -1373,6 +1436,20 @@ static void _mpr(string text, msg_channel_type channel, int param, bool nojoin,
     if (channel == MSGCH_DIAGNOSTICS || channel == MSGCH_ERROR)
         cap = false;
 
+    if (_repeat_ok
+        && _repeat_turn == you.num_turns
+        && channel == _repeat_channel
+        && param == _repeat_param
+        && cap == _repeat_cap
+        && !nojoin
+        && text == _repeat_text)
+    {
+        buffer.add(_repeat_line);
+        _last_msg_turn = _repeat_line.turn;
+        return;
+    }
+    const string raw_text = text;
+
     msg_colour_type colour = prepare_message(text, channel, param);
 
     if (colour == MSGCOL_MUTED)
@@ -1404,6 +1481,15 @@ static void _mpr(string text, msg_channel_type channel, int param, bool nojoin,
     buffer.add(msg);
     _last_msg_turn = msg.turn;
 
+    _repeat_text = raw_text;
+    _repeat_channel = channel;
+    _repeat_param = param;
+    _repeat_cap = cap;
+    _repeat_turn = msg.turn;
+    _repeat_line = msg;
+    _repeat_ok = !domore && !do_flash_screen && !nojoin
+                 && channel != MSGCH_PROMPT && channel != MSGCH_ERROR;
+
     if (channel == MSGCH_ERROR)
         interrupt_activity(AI_FORCE_INTERRUPT);
 
@@ -1437,6 +1523,8 @@ void msgwin_reply(string reply)
 {
     msgwin_clear_temporary();
     msgwin_set_temporary(false);
+    // The line reader wrote the player's input straight into the region.
+    msgwin.repaint();
     reply = replace_all(reply, "<", "<<");
     mprf(MSGCH_PROMPT, "%s<lightgrey>%s</lightgrey>", _prompt.c_str(), reply.c_str());
     msgwin.got_input();
@@ -1884,9 +1972,30 @@ static bool is_channel_dumpworthy(msg_channel_type channel)
            && channel != MSGCH_TUTORIAL;
 }
 
+// How many of the newest messages go into the eagerly loaded "msg"
+// chunk; plenty to refill the message window and cover morgue dumps.
+// Everything older is banished to the history chunk, which is only
+// read if the player actually scrolls back through it.
+static const int NUM_SAVED_TAIL_MESSAGES = 200;
+
+#if TAG_MAJOR_VERSION == 34
+# define MESSAGE_HIST_CHUNK "msh"
+#else
+# define MESSAGE_HIST_CHUNK "message_hist"
+#endif
+
+// Messages older than the saved tail, populated from the history chunk
+// the first time they're needed. While _old_history_pending is set the
+// chunk exists in the save but hasn't been read yet.
+static vector<message_line> _old_history;
+static bool _old_history_pending = false;
+static int _old_history_minor_version = 0;
+
 void clear_message_store()
 {
     buffer.clear();
+    _old_history.clear();
+    _old_history_pending = false;
 }
 
 string get_last_messages(int mcount, bool full)
@@ -1931,21 +2040,98 @@ void get_recent_messages(vector<string> &mess,
     }
 }
 
-// We just write out the whole message store including empty/unused
-// messages. They'll be ignored when restoring.
-void save_messages(writer& outf)
+static void _marshall_message(writer& outf, const message_line &msg)
 {
-    store_t msgs = buffer.get_store();
-    marshallInt(outf, msgs.size());
+    marshallString4(outf, msg.full_text());
+    marshallInt(outf, msg.channel);
+    marshallInt(outf, msg.param);
+    marshallInt(outf, msg.turn);
+}
+
+static message_line _unmarshall_message(reader& inf)
+{
+    string text;
+    unmarshallString4(inf, text);
+
+    msg_channel_type channel = (msg_channel_type) unmarshallInt(inf);
+    int           param      = unmarshallInt(inf);
+#if TAG_MAJOR_VERSION == 34
+    if (inf.getMinorVersion() < TAG_MINOR_MESSAGE_REPEATS)
+                               unmarshallInt(inf); // was 'repeats'
+#endif
+    int           turn       = unmarshallInt(inf);
+
+    return message_line(text, channel, param, turn);
+}
+
+// The non-empty stored messages, oldest first.
+static vector<message_line> _get_stored_messages()
+{
+    vector<message_line> out;
+    const store_t msgs = buffer.get_store();
     for (int i = 0; i < msgs.size(); ++i)
+        if (msgs[i])
+            out.push_back(msgs[i]);
+    return out;
+}
+
+void defer_message_history_load(int minorVersion)
+{
+    _old_history_pending = true;
+    _old_history_minor_version = minorVersion;
+}
+
+static void _load_old_history()
+{
+    if (!_old_history_pending)
+        return;
+    _old_history_pending = false;
+
+    if (!you.save || !you.save->has_chunk(MESSAGE_HIST_CHUNK))
+        return;
+
+    reader inf(you.save, MESSAGE_HIST_CHUNK, _old_history_minor_version);
+    const int num = unmarshallInt(inf);
+    for (int i = 0; i < num; ++i)
     {
-        marshallString4(outf, msgs[i].full_text());
-        marshallInt(outf, msgs[i].channel);
-        marshallInt(outf, msgs[i].param);
-        marshallInt(outf, msgs[i].turn);
+        message_line msg = _unmarshall_message(inf);
+        if (msg)
+            _old_history.push_back(msg);
     }
 }
 
+// Write out only the newest messages; the rest of the ring goes into
+// the lazily loaded history chunk in save_message_history below.
+void save_messages(writer& outf)
+{
+    const vector<message_line> msgs = _get_stored_messages();
+    const int tail = min<int>(msgs.size(), NUM_SAVED_TAIL_MESSAGES);
+    marshallInt(outf, tail);
+    for (int i = msgs.size() - tail; i < (int) msgs.size(); ++i)
+        _marshall_message(outf, msgs[i]);
+}
+
+// Everything older than the saved tail: history carried over from the
+// save we loaded, then the older part of the current ring, capped so
+// tail plus history never exceed the in-game store.
+void save_message_history(writer& outf)
+{
+    // If the old chunk was never read this session, pull it in now
+    // rather than dropping it from the save.
+    _load_old_history();
+
+    vector<message_line> old = _old_history;
+    const vector<message_line> msgs = _get_stored_messages();
+    const int tail = min<int>(msgs.size(), NUM_SAVED_TAIL_MESSAGES);
+    old.insert(old.end(), msgs.begin(), msgs.end() - tail);
+
+    const int cap = NUM_STORED_MESSAGES - NUM_SAVED_TAIL_MESSAGES;
+    const int num = min<int>(old.size(), cap);
+    marshallInt(outf, num);
+    for (int i = old.size() - num; i < (int) old.size(); ++i)
+        _marshall_message(outf, old[i]);
+}
+
 void load_messages(reader& inf)
 {
     unwind_bool save_more(crawl_state.show_more_prompt, false);
@@ -1958,18 +2144,7 @@ void load_messages(reader& inf)
     int num = unmarshallInt(inf);
     for (int i = 0; i < num; ++i)
     {
-        string text;
-        unmarshallString4(inf, text);
-
-        msg_channel_type channel = (msg_channel_type) unmarshallInt(inf);
-        int           param      = unmarshallInt(inf);
-#if TAG_MAJOR_VERSION == 34
-        if (inf.getMinorVersion() < TAG_MINOR_MESSAGE_REPEATS)
-                                   unmarshallInt(inf); // was 'repeats'
-#endif
-        int           turn       = unmarshallInt(inf);
-
-        message_line msg(message_line(text, channel, param, turn));
+        message_line msg = _unmarshall_message(inf);
         if (msg)
             buffer.store_msg(msg);
     }
@@ -1978,32 +2153,50 @@ void load_messages(reader& inf)
     clear_messages(); // check for Options.message_clear
 }
 
+static void _add_replay_message(formatted_scroller &hist,
+                                const message_line &msg, bool turn_ended)
+{
+    string text = msg.full_text();
+    linebreak_string(text, cgetsize(GOTO_CRT).x - 1);
+    vector<formatted_string> parts;
+    formatted_string::parse_string_to_multiple(text, parts);
+    for (unsigned int j = 0; j < parts.size(); ++j)
+    {
+        formatted_string line;
+        prefix_type p = prefix_type::none;
+        if (j == parts.size() - 1 && turn_ended)
+            p = prefix_type::turn_end;
+        line.add_glyph(_prefix_glyph(p));
+        line += parts[j];
+        hist.add_item_formatted_string(line);
+    }
+}
+
 void replay_messages()
 {
     formatted_scroller hist(MF_START_AT_END | MF_ALWAYS_SHOW_MORE, "");
     hist.set_more();
 
+    // This is the only place history beyond the saved tail is ever
+    // shown, so the history chunk is read here, once.
+    _load_old_history();
+
+    for (size_t i = 0; i < _old_history.size(); ++i)
+        if (channel_message_history(_old_history[i].channel))
+        {
+            const bool turn_ended = i + 1 < _old_history.size()
+                                    && _old_history[i+1].turn
+                                       > _old_history[i].turn;
+            _add_replay_message(hist, _old_history[i], turn_ended);
+        }
+
     const store_t msgs = buffer.get_store();
     for (int i = 0; i < msgs.size(); ++i)
         if (channel_message_history(msgs[i].channel))
         {
-            string text = msgs[i].full_text();
-            linebreak_string(text, cgetsize(GOTO_CRT).x - 1);
-            vector<formatted_string> parts;
-            formatted_string::parse_string_to_multiple(text, parts);
-            for (unsigned int j = 0; j < parts.size(); ++j)
-            {
-                formatted_string line;
-                prefix_type p = prefix_type::none;
-                if (j == parts.size() - 1 && i + 1 < msgs.size()
-                    && msgs[i+1].turn > msgs[i].turn)
-                {
-                    p = prefix_type::turn_end;
-                }
-                line.add_glyph(_prefix_glyph(p));
-                line += parts[j];
-                hist.add_item_formatted_string(line);
-            }
+            const bool turn_ended = i + 1 < msgs.size()
+                                    && msgs[i+1].turn > msgs[i].turn;
+            _add_replay_message(hist, msgs[i], turn_ended);
         }
 
     hist.show();
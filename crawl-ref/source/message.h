@@ -105,7 +105,11 @@ void webtiles_send_messages(); // does nothing unless USE_TILE_WEB is defined
 void webtiles_send_last_messages(int n = 20); // does nothing unless USE_TILE_WEB is defined
 
 void save_messages(writer& outf);
+void save_message_history(writer& outf);
 void load_messages(reader& inf);
+// Note that a lazily loadable history chunk exists in the save; it
+// won't be read unless the player scrolls back past the message tail.
+void defer_message_history_load(int minorVersion);
 void clear_message_store();
 
 // Have any messages been printed since the last clear?
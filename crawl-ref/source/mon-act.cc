@@ -16,6 +16,7 @@
 #include "cloud.h"
 #include "colour.h"
 #include "coordit.h"
+#include "dbg-prof.h"
 #include "dbg-scan.h"
 #include "delay.h"
 #include "directn.h" // feature_description_at
@@ -1622,6 +1623,41 @@ void handle_monster_move(monster* mons)
 
     mons->shield_blocks = 0;
 
+    // A monster sleeping through an uneventful turn -- no cloud on it,
+    // no slime walls, nothing gnawing at it, no per-turn type or
+    // enchantment quirks -- only regenerates and burns its action
+    // energy; everything below would no-op on it. Anything that can
+    // rouse a sleeper (noise, damage, stealth checks) goes through
+    // behaviour_event before its next action, so it leaves this path
+    // the moment something happens. This keeps full levels cheap:
+    // most monsters are asleep on the far side of the map.
+    if (mons->asleep()
+        && mons->foe == MHITNOT
+        && !mons->friendly()
+        && mons->type != MONS_SIXFIRHY
+        && mons->type != MONS_JIANGSHI
+        && mons->type != MONS_TIAMAT
+        && mons->type != MONS_SLIME_CREATURE
+        && mons->type != MONS_SPECTRAL_WEAPON
+        && !mons_is_tentacle_or_tentacle_segment(mons->type)
+        && !mons->caught()
+        && !mons->is_constricted()
+        && !mons->has_ench(ENCH_CONFUSION)
+        && !mons->has_ench(ENCH_HAUNTING)
+        && !mons->has_ench(ENCH_DAZED)
+        && !mons->has_ench(ENCH_GOLD_LUST)
+        && !mons->has_ench(ENCH_BRILLIANCE_AURA)
+        && !mons->has_ench(ENCH_SUBMERGED)
+        && !cloud_at(mons->pos())
+        && !(env.level_state & LSTATE_SLIMY_WALL))
+    {
+        _monster_regenerate(mons);
+        // All handle_behaviour() does for such a sleeper.
+        mons->target = mons->pos();
+        mons->speed_increment -= non_move_energy;
+        return;
+    }
+
     _mons_in_cloud(*mons);
     if (!mons->alive())
         return;
@@ -2363,6 +2399,8 @@ static void _display_just_seen()
  */
 void handle_monsters(bool with_noise)
 {
+    PROF_ZONE("handle_monsters");
+
     for (monster_iterator mi; mi; ++mi)
     {
         _pre_monster_move(**mi);
@@ -29,6 +29,7 @@
 #include "ouch.h"
 #include "religion.h"
 #include "shout.h"
+#include "show.h"
 #include "spl-summoning.h"
 #include "state.h"
 #include "stringutil.h"
@@ -255,6 +256,23 @@ void handle_behaviour(monster* mon)
         }
     }
 
+    // A sleeping monster without a foe has nothing to recompute: every
+    // state change below is gated on being awake, on already having a
+    // foe, or on one of the special cases excluded here, and the
+    // BEH_SLEEP case only re-pins the target to the monster's own
+    // position. Waking up happens through behaviour_event(), not here,
+    // so skip the LOS checks and foe scans outright.
+    if (mon->behaviour == BEH_SLEEP
+        && mon->foe == MHITNOT
+        && !mon->friendly()
+        && mon->type != MONS_SPECTRAL_WEAPON
+        && !mon->has_ench(ENCH_CONFUSION)
+        && !mon->has_ench(ENCH_HAUNTING))
+    {
+        mon->target = mon->pos();
+        return;
+    }
+
     bool changed = true;
     bool isFriendly = mon->friendly();
     bool isNeutral  = mon->neutral();
@@ -1023,6 +1041,9 @@ void behaviour_event(monster* mon, mon_event_type event, const actor *src,
     if (mons_is_projectile(mon->type))
         return; // projectiles have no AI
 
+    // Behaviour (asleep, fleeing, ...) is part of the monster's display.
+    show_mark_dirty(mon->pos());
+
     const beh_type old_behaviour = mon->behaviour;
 
     bool isSmart          = (mons_intel(*mon) >= I_HUMAN);
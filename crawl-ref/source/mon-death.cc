@@ -58,6 +58,7 @@
 #include "output.h"
 #include "religion.h"
 #include "rot.h"
+#include "show.h"
 #include "spl-damage.h"
 #include "spl-goditem.h"
 #include "spl-miscast.h"
@@ -83,6 +84,39 @@
  *                    are checked.
  * @returns whether a corpse could be created.
  */
+// Monsters whose death cascade is currently being resolved. AOE kills
+// and death effects (spore chains, pain bond, reaping) can wind up
+// calling monster_die again for a monster that is already partway
+// through its own death; running the cascade twice double-drops items
+// and double-counts experience at best.
+static set<mid_t> _dying_monsters;
+
+// Unwinder marking a monster as dying for the duration of its
+// monster_die call, whatever the exit path.
+struct _dying_guard
+{
+    explicit _dying_guard(mid_t m) : mid(m) { _dying_monsters.insert(mid); }
+    ~_dying_guard() { _dying_monsters.erase(mid); }
+    mid_t mid;
+};
+
+static int _death_batch_depth = 0;
+static bool _death_batch_redraw = false;
+
+death_batch::death_batch()
+{
+    _death_batch_depth++;
+}
+
+death_batch::~death_batch()
+{
+    if (--_death_batch_depth == 0 && _death_batch_redraw)
+    {
+        _death_batch_redraw = false;
+        update_screen();
+    }
+}
+
 static bool _fill_out_corpse(const monster& mons, item_def& corpse)
 {
     corpse.clear();
@@ -1906,6 +1940,17 @@ item_def* monster_die(monster& mons, killer_type killer,
 {
     ASSERT(!invalid_monster(&mons));
 
+    // Deaths that don't route through monster::hurt (banishment,
+    // wizmode deletion) still change the tension picture.
+    invalidate_tension_cache();
+    show_mark_dirty(mons.pos());
+
+    // Refuse to re-enter the death cascade for a monster that is
+    // already partway through its own death.
+    if (_dying_monsters.count(mons.mid))
+        return nullptr;
+    const _dying_guard dying_guard(mons.mid);
+
     const bool was_visible = you.can_see(mons);
 
     // If a monster was banished to the Abyss and then killed there,
@@ -2830,11 +2875,16 @@ item_def* monster_die(monster& mons, killer_type killer,
     crawl_state.dec_mon_acting(&mons);
     monster_cleanup(&mons);
 
-    // Force redraw for monsters that die.
+    // Force redraw for monsters that die. When a batch of deaths is
+    // being resolved (an explosion sweeping over a pack, say), flush
+    // the screen once at the end of the batch instead of per corpse.
     if (in_bounds(mwhere) && you.see_cell(mwhere))
     {
         view_update_at(mwhere);
-        update_screen();
+        if (_death_batch_depth)
+            _death_batch_redraw = true;
+        else
+            update_screen();
     }
 
     if (!mons_reset)
@@ -29,6 +29,17 @@
 
 struct bolt;
 
+// Scope marker for effects that can kill several monsters at once
+// (explosions, storms). While any death_batch is live, monster_die
+// defers its per-death forced screen update; the last batch to unwind
+// flushes the screen once for all of them. Nests safely.
+class death_batch
+{
+public:
+    death_batch();
+    ~death_batch();
+};
+
 item_def* monster_die(monster& mons, const actor *killer, bool silent = false,
                       bool wizard = false, bool fake = false);
 
@@ -38,6 +38,7 @@
 #include "mon-tentacle.h"
 #include "religion.h"
 #include "rot.h"
+#include "show.h"
 #include "spl-clouds.h"
 #include "spl-damage.h"
 #include "spl-summoning.h"
@@ -137,6 +138,12 @@ void monster::update_ench(const mon_enchant &ench)
 
 bool monster::add_ench(const mon_enchant &ench)
 {
+    // Enchantments (haste, might, berserk, ...) feed the tension
+    // formula, and some (invisibility, submersion) change how the
+    // monster is displayed.
+    invalidate_tension_cache();
+    show_mark_dirty(pos());
+
     // silliness
     if (ench.ench == ENCH_NONE)
         return false;
@@ -421,6 +428,9 @@ bool monster::del_ench(enchant_type ench, bool quiet, bool effect)
     if (i == enchantments.end())
         return false;
 
+    invalidate_tension_cache();
+    show_mark_dirty(pos());
+
     const mon_enchant me = i->second;
     const enchant_type et = i->first;
 
@@ -2060,13 +2070,19 @@ void monster::apply_enchantments()
     // We process an enchantment only if it existed both at the start of this
     // function and when getting to it in order; any enchantment can add, modify
     // or remove others -- or even itself.
-    FixedBitVector<NUM_ENCHANTMENTS> ec = ench_cache;
-
-    // The ordering in enchant_type makes sure that "super-enchantments"
-    // like berserk time out before their parts.
-    for (int i = 0; i < NUM_ENCHANTMENTS; ++i)
-        if (ec[i] && has_ench(static_cast<enchant_type>(i)))
-            apply_enchantment(enchantments.find(static_cast<enchant_type>(i))->second);
+    //
+    // The map is keyed by enchant_type, so snapshotting its keys visits the
+    // few enchantments actually present instead of testing every bit of
+    // NUM_ENCHANTMENTS, while keeping the enchant_type ordering that makes
+    // sure "super-enchantments" like berserk time out before their parts.
+    enchant_type ec[NUM_ENCHANTMENTS];
+    int ec_size = 0;
+    for (const auto &entry : enchantments)
+        ec[ec_size++] = entry.first;
+
+    for (int i = 0; i < ec_size; ++i)
+        if (has_ench(ec[i]))
+            apply_enchantment(enchantments.find(ec[i])->second);
 }
 
 // Used to adjust time durations in calc_duration() for monster speed.
@@ -1809,26 +1809,55 @@ bool monster_info::debuffable() const
                   { return this->has_trivial_ench(ench); });
 }
 
+// The monster pane, the status-line list and describe all rebuild the
+// monster_info list, and tiles can redraw several times per player
+// action. Constructing an entry walks a lot of monster state and
+// formats names, so the sorted list is cached and reused until a
+// monster event (the tension epoch ticks on movement, damage,
+// enchantment, attitude and death) or the player's position, turn or
+// level changes. Copying the cached entries is far cheaper than
+// rebuilding them.
+static vector<monster_info> _monster_info_cache;
+static int _minfo_epoch = -1;
+static int _minfo_turn = -1;
+static int _minfo_xl = -1;
+static coord_def _minfo_pos;
+
 void get_monster_info(vector<monster_info>& mons)
 {
-    vector<monster* > visible;
     if (crawl_state.game_is_arena())
     {
         for (monster_iterator mi; mi; ++mi)
-            visible.push_back(*mi);
+        {
+            if (mons_is_threatening(**mi) || mi->is_child_tentacle())
+                mons.emplace_back(*mi);
+        }
+        sort(mons.begin(), mons.end(), monster_info::less_than_wrapper);
+        return;
     }
-    else
-        visible = get_nearby_monsters();
 
-    for (monster *mon : visible)
+    if (_minfo_epoch != tension_epoch() || _minfo_turn != you.num_turns
+        || _minfo_xl != you.experience_level || _minfo_pos != you.pos())
     {
-        if (mons_is_threatening(*mon)
-            || mon->is_child_tentacle())
+        _monster_info_cache.clear();
+        for (monster *mon : get_nearby_monsters())
         {
-            mons.emplace_back(mon);
+            if (mons_is_threatening(*mon)
+                || mon->is_child_tentacle())
+            {
+                _monster_info_cache.emplace_back(mon);
+            }
         }
+        sort(_monster_info_cache.begin(), _monster_info_cache.end(),
+             monster_info::less_than_wrapper);
+        _minfo_epoch = tension_epoch();
+        _minfo_turn = you.num_turns;
+        _minfo_xl = you.experience_level;
+        _minfo_pos = you.pos();
     }
-    sort(mons.begin(), mons.end(), monster_info::less_than_wrapper);
+
+    mons.insert(mons.end(), _monster_info_cache.begin(),
+                _monster_info_cache.end());
 }
 
 monster_type monster_info::draco_or_demonspawn_subspecies() const
@@ -175,8 +175,36 @@ bool try_pathfind(monster* mon)
         const coord_def targ = mon->travel_path[len - 1];
 
         // Current target still valid?
-        if (can_go_straight(mon, targ, targpos))
+        bool path_valid = can_go_straight(mon, targ, targpos);
+
+        // If not, the foe may just have stepped around a corner: the
+        // goal the path was computed for saw both the path's end and
+        // (if it only moved a step or two) the foe's new position, so
+        // splicing it in as an extra waypoint keeps the path usable
+        // without re-running the full search. Steady-state corridor
+        // chases reuse their path this way every time the foe turns a
+        // corner.
+        if (!path_valid && mon->props.exists("pathfind_goal"))
         {
+            const coord_def old_goal =
+                mon->props["pathfind_goal"].get_coord();
+
+            if (old_goal != targ
+                && grid_distance(old_goal, targpos) <= 2
+                && can_go_straight(mon, targ, old_goal)
+                && can_go_straight(mon, old_goal, targpos))
+            {
+                mon->travel_path.push_back(old_goal);
+                path_valid = true;
+            }
+        }
+
+        if (path_valid)
+        {
+            // The path's end can see the foe's current position, so
+            // remember that position for future splicing.
+            mon->props["pathfind_goal"].get_coord() = targpos;
+
             // Did we reach the target?
             if (mon->pos() == mon->travel_path[0])
             {
@@ -220,6 +248,20 @@ bool try_pathfind(monster* mon)
          mon->name(DESC_PLAIN).c_str(), mon->pos().x, mon->pos().y,
          targpos.x, targpos.y, range);
 #endif
+    // A pack heading for the player can share one flow field instead
+    // of each monster running its own A*.
+    if (targpos == you.pos() && mons_flow_field_eligible(mon))
+    {
+        mon->travel_path = mons_flow_field_path(mon, range);
+        if (!mon->travel_path.empty())
+        {
+            mon->props["pathfind_goal"].get_coord() = targpos;
+            mon->target = mon->travel_path[0];
+            mon->travel_target = MTRAV_FOE;
+            return true;
+        }
+    }
+
     monster_pathfind mp;
     if (range > 0)
         mp.set_range(range);
@@ -230,6 +272,7 @@ bool try_pathfind(monster* mon)
         if (!mon->travel_path.empty())
         {
             // Okay then, we found a path. Let's use it!
+            mon->props["pathfind_goal"].get_coord() = targpos;
             mon->target = mon->travel_path[0];
             mon->travel_target = MTRAV_FOE;
             return true;
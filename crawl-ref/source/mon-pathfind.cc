@@ -2,6 +2,7 @@
 
 #include "mon-pathfind.h"
 
+#include "coordit.h"
 #include "directn.h"
 #include "env.h"
 #include "los.h"
@@ -12,6 +13,160 @@
 #include "terrain.h"
 #include "traps.h"
 
+/////////////////////////////////////////////////////////////////////////////
+// Shared flow field
+//
+// When a pack of melee-seeking monsters all head for the player on the
+// same turn, each used to run an independent A*. For ordinary land
+// walkers the distance field away from the player is identical, so
+// compute it once per turn with Dijkstra and hand out per-monster
+// paths by descending the field. Monsters with unusual traversal
+// (flyers, clingers, stationaries, ...) and any cell the individual
+// monster can't actually enter make the caller fall back to
+// monster_pathfind.
+
+static FixedArray<int, GXM, GYM> _flow_dist;
+static coord_def _flow_src(-1, -1);
+static int _flow_time = -1;
+
+// Traversability for the shared field: the common denominator of
+// ordinary land walkers. Per-monster differences are caught when the
+// extracted path is validated below.
+static bool _flow_traversable(const coord_def& p)
+{
+    const dungeon_feature_type f = grd(p);
+    if (f == DNGN_UNSEEN)
+        return false;
+    if (feat_is_closed_door(f))
+        return true;
+    if (!feat_has_solid_floor(f))
+        return false;
+    // Stationary monsters block the shared field just as they block
+    // individual pathfinding.
+    const monster* m = monster_at(p);
+    return !(m && m->is_stationary());
+}
+
+static int _flow_cost(const coord_def& p)
+{
+    const dungeon_feature_type f = grd(p);
+    if (feat_is_closed_door(f) || f == DNGN_SHALLOW_WATER)
+        return 2;
+    return 1;
+}
+
+static void _update_flow_field()
+{
+    if (_flow_src == you.pos() && _flow_time == you.elapsed_time)
+        return;
+    _flow_src  = you.pos();
+    _flow_time = you.elapsed_time;
+
+    _flow_dist.init(INFINITE_DISTANCE);
+
+    // Costs are 1 or 2, so a bucket queue makes this a plain sweep.
+    // The buckets are reused across updates to keep their capacity.
+    const int cap = GXM + GYM;
+    static vector<vector<coord_def> > buckets(cap + 3);
+    for (vector<coord_def> &bucket : buckets)
+        bucket.clear();
+    _flow_dist(you.pos()) = 0;
+    buckets[0].push_back(you.pos());
+
+    for (int d = 0; d <= cap; ++d)
+        for (unsigned int i = 0; i < buckets[d].size(); ++i)
+        {
+            const coord_def c = buckets[d][i];
+            if (_flow_dist(c) != d)
+                continue; // superseded by a shorter route
+
+            for (adjacent_iterator ai(c); ai; ++ai)
+            {
+                if (!in_bounds(*ai) || !_flow_traversable(*ai))
+                    continue;
+                const int nd = d + _flow_cost(*ai);
+                if (nd <= cap && nd < _flow_dist(*ai))
+                {
+                    _flow_dist(*ai) = nd;
+                    buckets[nd].push_back(*ai);
+                }
+            }
+        }
+}
+
+// Monsters whose traversal matches the shared field closely enough
+// that descending it is worth attempting.
+bool mons_flow_field_eligible(const monster* mon)
+{
+    return mon
+           && mons_habitat(*mon) == HT_LAND
+           && !mon->airborne()
+           && !mon->can_cling_to_walls()
+           && !mon->is_stationary();
+}
+
+// Extract a path for mon to the player by descending the shared flow
+// field, validating each cell against the monster's own traversal.
+// Returns an empty path if the field doesn't work out for this
+// monster; the caller should then fall back to monster_pathfind.
+vector<coord_def> mons_flow_field_path(const monster* mon, int range)
+{
+    vector<coord_def> path;
+    if (!mons_flow_field_eligible(mon))
+        return path;
+
+    _update_flow_field();
+
+    const int d0 = _flow_dist(mon->pos());
+    if (d0 == INFINITE_DISTANCE || range > 0 && d0 > range)
+        return path;
+
+    coord_def c = mon->pos();
+    path.push_back(c);
+    while (c != you.pos())
+    {
+        coord_def best;
+        int best_dist = _flow_dist(c);
+        for (adjacent_iterator ai(c); ai; ++ai)
+        {
+            if (!in_bounds(*ai))
+                continue;
+            if (_flow_dist(*ai) >= best_dist)
+                continue;
+            if (*ai != you.pos() && !mons_can_traverse(*mon, *ai))
+                continue;
+            best = *ai;
+            best_dist = _flow_dist(*ai);
+        }
+        if (best.origin())
+        {
+            // The monster can't actually walk the field here.
+            path.clear();
+            return path;
+        }
+        c = best;
+        path.push_back(c);
+    }
+
+    // Reduce the path to waypoints the same way calc_waypoints() does.
+    vector<coord_def> waypoints;
+    coord_def wpos = path[0];
+    for (unsigned int i = 1; i < path.size(); i++)
+    {
+        if (can_go_straight(mon, wpos, path[i])
+            && mons_can_traverse(*mon, path[i]))
+        {
+            continue;
+        }
+        wpos = path[i - 1];
+        waypoints.push_back(wpos);
+    }
+    if (wpos != path[path.size() - 1])
+        waypoints.push_back(path[path.size() - 1]);
+
+    return waypoints;
+}
+
 /////////////////////////////////////////////////////////////////////////////
 // monster_pathfind
 
@@ -64,11 +219,22 @@ int mons_tracking_range(const monster* mon)
     return range;
 }
 
+// The open list, keyed by total estimated path length. It is only live
+// inside start_pathfind(), which never starts a nested search, so one
+// static copy serves every monster_pathfind instance. Reusing the
+// buckets across searches keeps their allocated capacity, so repeated
+// searches do no heap allocation once warmed up. The touched bucket
+// range of the last search is remembered so the next one only has to
+// clear those.
+static FixedVector<vector<coord_def>, GXM * GYM> _open_list;
+static int _open_list_lo = 0;
+static int _open_list_hi = -1;
+
 //#define DEBUG_PATHFIND
 monster_pathfind::monster_pathfind()
     : mons(nullptr), start(), target(), pos(), allow_diagonals(true),
-      traverse_unmapped(false), range(0), min_length(0), max_length(0),
-      dist(), prev(), hash()
+      jump_mode(false), traverse_unmapped(false), range(0), min_length(0),
+      max_length(0), dist(), prev()
 {
 }
 
@@ -139,11 +305,23 @@ bool monster_pathfind::start_pathfind(bool msg)
     //       surrounded by shallow water or floor, or if a foe is hiding in
     //       a wall.
 
+    // Jumping exploits uniform-cost open regions and needs the full
+    // 8-ary expansion to stay optimal.
+    jump_mode = allow_diagonals;
+
     max_length = min_length = grid_distance(pos, target);
     for (int i = 0; i < GXM; i++)
         for (int j = 0; j < GYM; j++)
             dist[i][j] = INFINITE_DISTANCE;
 
+    // Clear out whatever the previous search left in the open list.
+    // Totals never drop below the initial estimate, so tracking starts
+    // at min_length.
+    for (int i = _open_list_lo; i <= _open_list_hi; i++)
+        _open_list[i].clear();
+    _open_list_lo = min_length;
+    _open_list_hi = min_length - 1;
+
     dist[pos.x][pos.y] = 0;
 
     bool success = false;
@@ -217,6 +395,37 @@ bool monster_pathfind::calc_path_to_neighbours()
         distance = dist[pos.x][pos.y] + travel_cost(npos);
         old_dist = dist[npos.x][npos.y];
 
+        // Jump point scan: in open regions of uniform cost there are
+        // no forced turns, so extend the step along dir as far as the
+        // region stays open. The cells jumped over get their distance
+        // and backtracking info settled but are never pushed on the
+        // open list, which is where the savings come from; they can
+        // still be improved later like any other cell. We stop short
+        // of the target so the terminal handling below is unchanged.
+        if (jump_mode && npos != target && old_dist == INFINITE_DISTANCE)
+        {
+            while (grid_distance(npos, target) > 1
+                   && cell_open_uniform(npos))
+            {
+                const coord_def next = npos + Compass[dir];
+                if (next == target
+                    || dist[next.x][next.y] <= distance + 1
+                    || range && estimated_cost(next) > range
+                    || !cell_open_uniform(next))
+                {
+                    break;
+                }
+
+                // Settle the cell we jump over.
+                dist[npos.x][npos.y] = distance;
+                prev[npos.x][npos.y] = (dir + 4) % 8;
+
+                npos = next;
+                distance++;
+            }
+            old_dist = dist[npos.x][npos.y];
+        }
+
         // Also bail out if this would make the path longer than twice the
         // allowed distance from the target. (This factor may need tuning.)
         //
@@ -287,12 +496,12 @@ bool monster_pathfind::get_best_position()
 {
     for (int i = min_length; i <= max_length; i++)
     {
-        if (!hash[i].empty())
+        if (!_open_list[i].empty())
         {
             if (i > min_length)
                 min_length = i;
 
-            vector<coord_def> &vec = hash[i];
+            vector<coord_def> &vec = _open_list[i];
             // Pick the last position pushed into the vector as it's most
             // likely to be close to the target.
             pos = vec[vec.size()-1];
@@ -393,6 +602,31 @@ vector<coord_def> monster_pathfind::calc_waypoints()
     return waypoints;
 }
 
+// Whether p sits in a locally open region of uniform cost: p and all
+// its neighbours are traversable at cost 1, with nothing (doors, deep
+// water, known traps) that would make an expansion here turn or pay
+// extra. Only such cells may be jumped over.
+bool monster_pathfind::cell_open_uniform(const coord_def& p)
+{
+    for (int dx = -1; dx <= 1; dx++)
+        for (int dy = -1; dy <= 1; dy++)
+        {
+            const coord_def c(p.x + dx, p.y + dy);
+            if (!in_bounds(c))
+                return false;
+            if (!traversable(c))
+                return false;
+            if (feat_is_closed_door(grd(c)))
+                return false;
+            if (mons && mons->floundering_at(c))
+                return false;
+            if (const trap_def* ptrap = trap_at(c))
+                if (ptrap->is_known(mons))
+                    return false;
+        }
+    return true;
+}
+
 bool monster_pathfind::traversable(const coord_def& p)
 {
     if (!traverse_unmapped && grd(p) == DNGN_UNSEEN)
@@ -497,7 +731,9 @@ int monster_pathfind::estimated_cost(coord_def p)
 
 void monster_pathfind::add_new_pos(coord_def npos, int total)
 {
-    hash[total].push_back(npos);
+    _open_list[total].push_back(npos);
+    if (total > _open_list_hi)
+        _open_list_hi = total;
 }
 
 void monster_pathfind::update_pos(coord_def npos, int total)
@@ -506,7 +742,7 @@ void monster_pathfind::update_pos(coord_def npos, int total)
     // then call_add_new_pos.
     int old_total = dist[npos.x][npos.y] + estimated_cost(npos);
 
-    vector<coord_def> &vec = hash[old_total];
+    vector<coord_def> &vec = _open_list[old_total];
     for (unsigned int i = 0; i < vec.size(); i++)
     {
         if (vec[i] == npos)
@@ -4,6 +4,9 @@ class monster;
 
 int mons_tracking_range(const monster* mon);
 
+bool mons_flow_field_eligible(const monster* mon);
+vector<coord_def> mons_flow_field_path(const monster* mon, int range);
+
 class monster_pathfind
 {
 public:
@@ -25,6 +28,7 @@ public:
 protected:
     // protected methods
     bool calc_path_to_neighbours();
+    bool cell_open_uniform(const coord_def& p);
     bool traversable(const coord_def& p);
     int  travel_cost(coord_def npos);
     bool mons_traversable(const coord_def& p);
@@ -43,6 +47,10 @@ protected:
     // If false, do not move diagonally along the path.
     bool allow_diagonals;
 
+    // If true, expansions may jump along straight lines through open
+    // regions of uniform cost instead of settling cells one at a time.
+    bool jump_mode;
+
     // If true, unmapped terrain is treated as traversable no matter the
     // monster involved.
     // (Used for player estimates of whether a monster can travel somewhere.)
@@ -63,6 +71,4 @@ protected:
     int dist[GXM][GYM];
     // An array to store where we came from on a given shortest path.
     int prev[GXM][GYM];
-
-    FixedVector<vector<coord_def>, GXM * GYM> hash;
 };
@@ -8,6 +8,8 @@
 #include "mon-pick.h"
 #include "mon-pick-data.h"
 
+#include <map>
+
 #include "branch.h"
 #include "coord.h"
 #include "env.h"
@@ -81,11 +83,109 @@ monster_type pick_monster_from(const pop_entry *fpop, int depth,
     return picker.pick_with_veto(fpop, depth, MONS_0, veto);
 }
 
+// Alias table for the weighted pick over one population table at one
+// depth: sampling is one bucket roll and one threshold roll, instead of
+// scanning the whole table and summing depth-adjusted rarities.
+struct mon_alias_table
+{
+    int total;                    // sum of all depth-adjusted rarities
+    vector<monster_type> primary;
+    vector<monster_type> alias;
+    vector<int> threshold;        // primary below, alias at or above
+
+    bool empty() const { return primary.empty(); }
+
+    monster_type sample() const
+    {
+        const int i = random2(primary.size());
+        return random2(total) < threshold[i] ? primary[i] : alias[i];
+    }
+};
+
+// Session cache of alias tables, keyed by (population table, depth).
+// The population tables are static data, so pointer identity works and
+// also covers the fish/zombie/vault tables passed to pick_monster_from.
+static map<pair<const pop_entry *, int>, mon_alias_table> _alias_tables;
+
+const mon_alias_table &monster_picker::_alias_table_for(
+    const pop_entry *weights, int level)
+{
+    auto insert = _alias_tables.emplace(make_pair(weights, level),
+                                        mon_alias_table());
+    mon_alias_table &table = insert.first->second;
+    if (!insert.second)
+        return table;
+
+    vector<int> scaled;
+    table.total = 0;
+    for (const pop_entry *pop = weights; pop->rarity; pop++)
+    {
+        if (level < pop->minr || level > pop->maxr)
+            continue;
+
+        int rar = rarity_at(pop, level);
+        ASSERTM(rar > 0, "Rarity %d: %d at level %d", rar, pop->value, level);
+
+        table.primary.push_back(pop->value);
+        scaled.push_back(rar);
+        table.total += rar;
+    }
+
+    // Standard alias table construction: scale each weight by the
+    // number of buckets, then top up underfull buckets from overfull
+    // ones; every bucket ends up holding exactly `total`.
+    const int n = table.primary.size();
+    table.alias = table.primary;
+    table.threshold.resize(n);
+    vector<int> small, large;
+    for (int i = 0; i < n; i++)
+    {
+        scaled[i] *= n;
+        (scaled[i] < table.total ? small : large).push_back(i);
+    }
+    while (!small.empty() && !large.empty())
+    {
+        const int s = small.back(), l = large.back();
+        small.pop_back();
+        table.threshold[s] = scaled[s];
+        table.alias[s] = table.primary[l];
+        scaled[l] -= table.total - scaled[s];
+        if (scaled[l] < table.total)
+        {
+            large.pop_back();
+            small.push_back(l);
+        }
+    }
+    // Whatever remains holds exactly one bucket's worth.
+    for (int i : small)
+        table.threshold[i] = table.total;
+    for (int i : large)
+        table.threshold[i] = table.total;
+
+    return table;
+}
+
 monster_type monster_picker::pick_with_veto(const pop_entry *weights,
                                             int level, monster_type none,
                                             mon_pick_vetoer vetoer)
 {
     _veto = vetoer;
+
+    // Fast path: sample from the cached alias table and re-roll vetoed
+    // results, which leaves the distribution over surviving monsters
+    // unchanged. If the vetoes are too dense, fall through to the exact
+    // scan, which also handles the empty-table case.
+    const mon_alias_table &table = _alias_table_for(weights, level);
+    if (!table.empty())
+    {
+        for (int tries = 0; tries < 10; tries++)
+        {
+            const monster_type mon = table.sample();
+            if (!veto(mon))
+                return mon;
+        }
+    }
+
     return pick(weights, level, none);
 }
 
@@ -32,6 +32,8 @@ void debug_monpick();
 // The main reason for this is that passing delegates into template functions
 // is fraught with peril when the delegate's arguments use T, until 0x at least.
 // There is supposedly a nasty workaround but this wouldn't even compile for me.
+struct mon_alias_table;
+
 class monster_picker : public random_picker<monster_type, NUM_MONSTERS>
 {
 public:
@@ -44,6 +46,9 @@ public:
     virtual bool veto(monster_type mon) override;
 
 private:
+    const mon_alias_table &_alias_table_for(const pop_entry *weights,
+                                            int level);
+
     mon_pick_vetoer _veto;
 };
 
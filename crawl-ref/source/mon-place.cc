@@ -836,11 +836,14 @@ monster* place_monster(mgen_data mg, bool force_pos, bool dont_place)
 
 monster* get_free_monster()
 {
-    for (auto &mons : menv_real)
-        if (mons.type == MONS_NO_MONSTER)
+    for (int i = 0; i < MAX_MONSTERS; ++i)
+        if (menv[i].type == MONS_NO_MONSTER)
         {
-            mons.reset();
-            return &mons;
+            menv[i].reset();
+            env.mons_occupied.set(i);
+            if (i >= env.mons_slot_watermark)
+                env.mons_slot_watermark = i + 1;
+            return &menv[i];
         }
 
     return nullptr;
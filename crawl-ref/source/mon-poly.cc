@@ -28,6 +28,7 @@
 #include "mon-tentacle.h"
 #include "notes.h"
 #include "religion.h"
+#include "show.h"
 #include "state.h"
 #include "stringutil.h"
 #include "terrain.h"
@@ -201,6 +202,7 @@ static bool _jiyva_slime_target(monster_type targetc)
 void change_monster_type(monster* mons, monster_type targetc)
 {
     ASSERT(mons); // XXX: change to monster &mons
+    show_mark_dirty(mons->pos());
     bool could_see     = you.can_see(*mons);
     bool slimified = _jiyva_slime_target(targetc);
 
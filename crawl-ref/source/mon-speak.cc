@@ -332,6 +332,51 @@ static string _get_speak_string(const vector<string> &prefixes,
     return msg;
 }
 
+// Cached per-type answer to "could any speech database key apply to
+// this monster type?" Every key probed by mons_speaks() for a monster
+// without a custom name ends in one of a handful of names derived from
+// the type — exact name, genus name, glyph, body shape — so if none of
+// them appears anywhere in the speech database's keys, the entire
+// prefix cascade is guaranteed to miss. -1 = not yet resolved.
+static FixedVector<int8_t, NUM_MONSTERS> _speech_avail(-1);
+
+static bool _type_has_speech(monster_type type)
+{
+    int8_t &avail = _speech_avail[type];
+    if (avail != -1)
+        return avail;
+
+    bool found = speakKeyExists(mons_type_name(type, DESC_PLAIN));
+
+    if (!found && mons_genus(type) != type)
+        found = speakKeyExists(mons_type_name(mons_genus(type), DESC_PLAIN));
+
+    if (!found)
+    {
+        string key = "'";
+        if (isaupper(mons_base_char(type)))
+            key += "cap-";
+        key += mons_base_char(type);
+        key += "'";
+        found = speakKeyExists(key);
+    }
+
+    if (!found)
+    {
+        const mon_body_shape shape = get_mon_shape(type);
+        // All the partial-humanoid shape names, which mons_speaks()
+        // falls back through, end in "humanoid", so one probe covers
+        // the lot.
+        if (mon_shape_is_humanoid(shape))
+            found = speakKeyExists(get_mon_shape_str(MON_SHAPE_HUMANOID));
+        else
+            found = speakKeyExists(get_mon_shape_str(shape));
+    }
+
+    avail = found;
+    return found;
+}
+
 /**
  * Rolls a chance for a monster to speak, and calls mons_speaks as necessary.
  *
@@ -449,6 +494,24 @@ bool mons_speaks(monster* mons)
             return false;
     }
 
+    // A type with no speech database entries can't produce a message no
+    // matter which prefixes apply, so skip the key cascade entirely.
+    // Only type-derived keys are covered by the cache; monsters that
+    // carry their own keys — renames, vault "dbname" props, ghosts,
+    // pandemonium lords, anything whose name varies per instance —
+    // fall through to the full lookup. (Chaos spawn shapes are rolled
+    // randomly, so they can't be resolved per type either.)
+    if (mons->mname.empty()
+        && !mons->props.exists("dbname")
+        && mons->type != MONS_PLAYER_GHOST
+        && mons->type != MONS_PANDEMONIUM_LORD
+        && mons->type != MONS_CHAOS_SPAWN
+        && mons->base_name(DESC_PLAIN) == mons_type_name(mons->type, DESC_PLAIN)
+        && !_type_has_speech(mons->type))
+    {
+        return false;
+    }
+
     vector<string> prefixes;
     if (mons->neutral())
     {
@@ -70,7 +70,10 @@
 #include "unwind.h"
 #include "view.h"
 
-static FixedVector < int, NUM_MONSTERS > mon_entry;
+// Maps monster_type directly to its mondata[] entry, so the hot
+// accessors below are a single table load instead of an index
+// indirection. Dummy types alias the MONS_PROGRAM_BUG entry.
+static monsterentry *mon_entry[NUM_MONSTERS];
 
 struct mon_display
 {
@@ -243,15 +246,16 @@ monster_type get_monster_by_name(string name, bool substring)
 void init_monsters()
 {
     // First, fill static array with dummy values. {dlb}
-    mon_entry.init(-1);
+    for (monsterentry *&entry : mon_entry)
+        entry = nullptr;
 
-    // Next, fill static array with location of entry in mondata[]. {dlb}:
+    // Next, fill static array with pointers into mondata[]. {dlb}:
     for (unsigned int i = 0; i < MONDATASIZE; ++i)
-        mon_entry[mondata[i].mc] = i;
+        mon_entry[mondata[i].mc] = &mondata[i];
 
     // Finally, monsters yet with dummy entries point to TTTSNB(tm). {dlb}:
-    for (int &entry : mon_entry)
-        if (entry == -1)
+    for (monsterentry *&entry : mon_entry)
+        if (!entry)
             entry = mon_entry[MONS_PROGRAM_BUG];
 
     init_monster_symbols();
@@ -2642,11 +2646,7 @@ unique_books get_unique_spells(const monster_info &mi,
     for (size_t i = 0; i < num_books; ++i)
     {
         const mon_spellbook_type book = books[i];
-        // TODO: should we build an index to speed this reverse lookup?
-        unsigned int msidx;
-        for (msidx = 0; msidx < ARRAYSZ(mspell_list); ++msidx)
-            if (mspell_list[msidx].type == book)
-                break;
+        const monster_spells *book_spells = _spellbook_spells(book);
 
         vector<mon_spell_slot> slots;
 
@@ -2668,10 +2668,10 @@ unique_books get_unique_spells(const monster_info &mi,
         }
 
         if (book != MST_GHOST)
-            ASSERT(msidx < ARRAYSZ(mspell_list));
+            ASSERT(book_spells);
         for (const mon_spell_slot &slot : (book == MST_GHOST
                                            ? mi.spells
-                                           : mspell_list[msidx].spells))
+                                           : *book_spells))
         {
             if (flags != MON_SPELL_NO_FLAGS && !(slot.flags & flags))
                 continue;
@@ -2721,6 +2721,19 @@ mon_spell_slot drac_breath(monster_type drac_type)
     return slot;
 }
 
+// Look up the shared, immutable spell list for a preset spellbook.
+// Returns nullptr for MST_GHOST (ghosts carry their own spells).
+static const monster_spells *_spellbook_spells(mon_spellbook_type book)
+{
+    static map<mon_spellbook_type, const monster_spells *> book_index;
+    if (book_index.empty())
+        for (const mon_spellbook &spbook : mspell_list)
+            book_index[spbook.type] = &spbook.spells;
+
+    const monster_spells **entry = map_find(book_index, book);
+    return entry ? *entry : nullptr;
+}
+
 void mons_load_spells(monster& mon)
 {
     vector<mon_spellbook_type> books = _mons_spellbook_list(mon.type);
@@ -2743,12 +2756,8 @@ void mons_load_spells(monster& mon)
     dprf(DIAG_MONPLACE, "%s: loading spellbook #%d",
          mon.name(DESC_PLAIN, true).c_str(), static_cast<int>(book));
 
-    for (const mon_spellbook &spbook : mspell_list)
-        if (spbook.type == book)
-        {
-            mon.spells = spbook.spells;
-            break;
-        }
+    if (const monster_spells *spells = _spellbook_spells(book))
+        mon.spells = *spells;
 }
 
 // Never hand out DARKGREY as a monster colour, even if it is randomly
@@ -3110,9 +3119,22 @@ monster_type demonspawn_base_by_name(const string &name)
     return MONS_PROGRAM_BUG;
 }
 
-string mons_type_name(monster_type mc, description_level_type desc)
+// Interned type-name strings. The vocabulary is fixed -- monster type
+// crossed with description level -- but this is called from describe,
+// message formatting and webtiles serialization, so building a fresh
+// string per call produced constant small-string heap traffic in
+// message-heavy turns. Entries are built once on first use; map nodes
+// are stable, so handed-out references stay valid.
+static map<int, string> _mons_type_name_cache;
+
+const string &mons_type_name(monster_type mc, description_level_type desc)
 {
-    string result;
+    const int key = int(mc) * (DESC_NONE + 1) + int(desc);
+    auto cached = _mons_type_name_cache.find(key);
+    if (cached != _mons_type_name_cache.end())
+        return cached->second;
+
+    string &result = _mons_type_name_cache[key];
 
     if (!mons_is_unique(mc))
     {
@@ -3222,7 +3244,7 @@ bool give_monster_proper_name(monster& mon, bool orcs_only)
 monsterentry *get_monster_data(monster_type mc)
 {
     if (mc >= 0 && mc < NUM_MONSTERS)
-        return &mondata[mon_entry[mc]];
+        return mon_entry[mc];
     else
         return nullptr;
 }
@@ -5175,6 +5197,8 @@ void reset_all_monsters()
         mons.reset();
     }
 
+    env.mons_slot_watermark = 0;
+    env.mons_occupied.reset();
     env.mid_cache.clear();
 }
 
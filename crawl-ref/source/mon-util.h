@@ -200,10 +200,13 @@ const bool monster_resists_this_poison(const monster& mons, bool force = false);
 void init_monsters();
 void init_monster_symbols();
 
-monster *monster_at(const coord_def &pos);
+monster *monster_at(const coord_def &pos) PURE;
 
 // this is the old moname()
-string mons_type_name(monster_type type, description_level_type desc);
+// Returns a reference into an interned name cache; valid for the
+// lifetime of the process.
+const string &mons_type_name(monster_type type,
+                             description_level_type desc);
 
 bool give_monster_proper_name(monster& mon, bool orcs_only = true);
 
@@ -53,6 +53,7 @@
 #include "mon-transit.h"
 #include "religion.h"
 #include "rot.h"
+#include "show.h"
 #include "spl-monench.h"
 #include "spl-summoning.h"
 #include "spl-util.h"
@@ -142,6 +143,12 @@ void monster::reset()
     went_unseen_this_turn = false;
     unseen_pos = coord_def(0, 0);
 
+    // Keep the occupancy bitmap in step; monsters outside menv (stack
+    // temporaries, the anon slots) have no bit to clear.
+    const int idx = mindex();
+    if (idx >= 0 && idx < MAX_MONSTERS)
+        env.mons_occupied.set(idx, false);
+
     mons_remove_from_grid(*this);
     target.reset();
     position.reset();
@@ -149,7 +156,7 @@ void monster::reset()
     patrol_point.reset();
     travel_target = MTRAV_NONE;
     travel_path.clear();
-    ghost.reset(nullptr);
+    ghost.reset();
     seen_context = SC_NONE;
     props.clear();
     clear_constricted();
@@ -201,10 +208,8 @@ void monster::init_with(const monster& mon)
     damage_total      = mon.damage_total;
     xp_tracking       = mon.xp_tracking;
 
-    if (mon.ghost.get())
-        ghost.reset(new ghost_demon(*mon.ghost));
-    else
-        ghost.reset(nullptr);
+    // Share the payload; writable_ghost() unshares on mutation.
+    ghost = mon.ghost;
 }
 
 uint32_t monster::last_client_id = 0;
@@ -912,6 +917,8 @@ void monster::equip_jewellery(item_def &item, bool msg)
 
 void monster::equip(item_def &item, bool msg)
 {
+    // Held weapons are part of the monster's display.
+    show_mark_dirty(pos());
     switch (item.base_type)
     {
     case OBJ_WEAPONS:
@@ -1021,6 +1028,8 @@ bool monster::unequip(item_def &item, bool msg, bool force)
     if (!force && item.cursed())
         return false;
 
+    show_mark_dirty(pos());
+
     if (!force && you.can_see(*this))
         set_ident_flags(item, ISFLAG_KNOW_CURSE);
 
@@ -3472,6 +3481,10 @@ int monster::evasion(ev_ignore_type evit, const actor* /*act*/) const
 
 bool monster::heal(int amount)
 {
+    invalidate_tension_cache();
+    // Hit points feed the displayed health bar.
+    show_mark_dirty(pos());
+
     if (mons_is_statue(type))
         return false;
 
@@ -4378,6 +4391,9 @@ int monster::hurt(const actor *agent, int amount, beam_type flavour,
         return 0;
     }
 
+    invalidate_tension_cache();
+    show_mark_dirty(pos());
+
     if (alive())
     {
         if (amount != INSTANT_DEATH
@@ -4551,6 +4567,16 @@ void monster::set_ghost(const ghost_demon &g)
         mname = ghost->name;
 }
 
+// Returns mutable ghost data, cloning it first if the payload is
+// shared with another monster.
+ghost_demon &monster::writable_ghost()
+{
+    ASSERT(ghost.get());
+    if (ghost.use_count() > 1)
+        ghost.reset(new ghost_demon(*ghost));
+    return *ghost;
+}
+
 void monster::set_new_monster_id()
 {
     mid = ++you.last_mid;
@@ -4624,7 +4650,8 @@ void monster::ghost_demon_init()
 
 void monster::uglything_mutate(colour_t force_colour)
 {
-    ghost->init_ugly_thing(type == MONS_VERY_UGLY_THING, true, force_colour);
+    writable_ghost().init_ugly_thing(type == MONS_VERY_UGLY_THING, true,
+                                     force_colour);
     uglything_init(true);
 }
 
@@ -98,7 +98,10 @@ public:
     god_type god;                      // What god the monster worships, if
                                        // any.
 
-    unique_ptr<ghost_demon> ghost;     // Ghost information.
+    // Ghost information. Shared between monsters copied from one
+    // another (and with nothing else); mutate it only through
+    // writable_ghost(), which unshares the payload first.
+    shared_ptr<ghost_demon> ghost;
 
     seen_context_type seen_context;    // Non-standard context for
                                        // AI_SEE_MONSTER
@@ -234,6 +237,7 @@ public:
     void set_originating_map(const string &);
 
     void set_ghost(const ghost_demon &ghost);
+    ghost_demon &writable_ghost();
     void ghost_init(bool need_pos = true);
     void ghost_demon_init();
     void uglything_init(bool only_mutate = false);
@@ -38,11 +38,13 @@
 #include "player-equip.h" // lose_permafly_source
 #include "player-stats.h"
 #include "religion.h"
+#include "show.h"
 #include "skills.h"
 #include "state.h"
 #include "stringutil.h"
 #include "transform.h"
 #include "unicode.h"
+#include "view.h"
 #include "viewchar.h"
 #include "xom.h"
 
@@ -298,7 +300,7 @@ bool is_body_facet(mutation_type mut)
  *          mutation_activity_type::PARTIAL: partially suppressed.
  *          mutation_activity_type::INACTIVE: completely suppressed.
  */
-mutation_activity_type mutation_activity_level(mutation_type mut)
+static mutation_activity_type _mutation_activity_level(mutation_type mut)
 {
     // First make sure the player's form permits the mutation.
     if (!form_keeps_mutations())
@@ -389,6 +391,56 @@ mutation_activity_type mutation_activity_level(mutation_type mut)
     return mutation_activity_type::FULL;
 }
 
+// Activity levels get asked for on almost every mutation query, and
+// the rule cascade above reruns form and suppression logic each time.
+// The rules read only a handful of player fields, so rather than
+// funnel invalidations through the many places mutations and forms
+// change, pack those fields into a key and rebuild the cache whenever
+// the key no longer matches. Mutation *levels* are deliberately not
+// cached — they're plain array reads — so direct writes to
+// you.mutation can't go stale here; the only levels the rules
+// themselves consume (scale thresholds in statue form, MUT_NO_LOVE)
+// are part of the key.
+static int _activity_key()
+{
+    int key = (static_cast<int>(you.form) + 1) << 8;
+    int bit = 1;
+    for (mutation_type mut : { MUT_YELLOW_SCALES, MUT_ICY_BLUE_SCALES,
+                               MUT_MOLTEN_SCALES, MUT_SLIMY_GREEN_SCALES,
+                               MUT_THIN_METALLIC_SCALES })
+    {
+        if (you.get_base_mutation_level(mut) > 2)
+            key |= bit;
+        bit <<= 1;
+    }
+    if (you.get_base_mutation_level(MUT_NO_LOVE))
+        key |= bit;
+    bit <<= 1;
+#if TAG_MAJOR_VERSION == 34
+    if (you_worship(GOD_PAKELLAS) || player_under_penance(GOD_PAKELLAS))
+        key |= bit;
+#endif
+    return key;
+}
+
+mutation_activity_type mutation_activity_level(mutation_type mut)
+{
+    static FixedVector<int8_t, NUM_MUTATIONS> cache(-1);
+    static int cache_key = 0; // never a valid _activity_key()
+
+    const int key = _activity_key();
+    if (key != cache_key)
+    {
+        cache.init(-1);
+        cache_key = key;
+    }
+
+    int8_t &cached = cache[mut];
+    if (cached == -1)
+        cached = static_cast<int8_t>(_mutation_activity_level(mut));
+    return static_cast<mutation_activity_type>(cached);
+}
+
 // Counts of various statuses/types of mutations from the current/most
 // recent call to describe_mutations. TODO: eliminate
 static int _num_full_suppressed = 0;
@@ -1676,6 +1728,8 @@ bool mutate(mutation_type which_mutation, const string &reason, bool failMsg,
         case MUT_ACUTE_VISION:
             // We might have to turn autopickup back on again.
             autotoggle_autopickup(false);
+            // Invisible monsters may have just become drawable.
+            show_mark_all_dirty();
             break;
 
         case MUT_NIGHTSTALKER:
@@ -2749,6 +2803,8 @@ void check_monster_detect()
             }
         }
     }
+
+    view_invalidate_scroll();
 }
 
 int augmentation_amount()
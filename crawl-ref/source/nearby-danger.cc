@@ -25,6 +25,7 @@
 #include "mon-pathfind.h"
 #include "mon-place.h"
 #include "mon-tentacle.h"
+#include "mon-util.h"
 #include "player.h"
 #include "player-stats.h"
 #include "stringutil.h"
@@ -169,6 +170,78 @@ bool mons_is_safe(const monster* mon, const bool want_move,
     return is_safe;
 }
 
+// How many monsters the player could currently see that might attack,
+// per the last update_monsters_in_view() census; -1 when something has
+// changed since and the census can't be trusted. When this is zero the
+// dangerous-monster sweep below cannot find anything -- every monster
+// it would keep is visible and not always-safe -- so the safety checks
+// that run on every travel and rest step reduce to one comparison.
+// Invalidation rides the show_mark_dirty() funnels, which already fire
+// on actor movement, enchantment, attitude and LOS changes.
+static int _visible_threats = -1;
+
+// Mids of the hostile monsters the same census saw, so per-keypress
+// consumers (autofight's Lua target scan above all) can enumerate them
+// in one call instead of probing every cell in sight range. Entries are
+// revalidated on use, so a stale mid costs a lookup, never a wrong
+// answer; the flag only says whether the list may be trusted to be
+// complete.
+static vector<mid_t> _visible_hostiles;
+static bool _visible_hostiles_valid = false;
+
+void note_visible_threat_summary(int count)
+{
+    _visible_threats = count;
+}
+
+void note_visible_hostiles(vector<mid_t> &&mids)
+{
+    _visible_hostiles = move(mids);
+    _visible_hostiles_valid = true;
+}
+
+void invalidate_visible_threat_summary()
+{
+    _visible_threats = -1;
+    _visible_hostiles_valid = false;
+}
+
+// All hostile monsters the player can currently see: from the cached
+// census when it can be trusted, otherwise by the same kind of sweep
+// get_nearby_monsters() does.
+vector<monster* > get_visible_hostiles()
+{
+    vector<monster* > mons;
+
+    if (_visible_hostiles_valid)
+    {
+        for (mid_t mid : _visible_hostiles)
+        {
+            monster* mon = monster_by_mid(mid);
+            if (mon && mon->alive() && mon->attitude == ATT_HOSTILE
+                && !mon->submerged() && you.see_cell(mon->pos())
+                && mon->visible_to(&you))
+            {
+                mons.push_back(mon);
+            }
+        }
+        return mons;
+    }
+
+    for (radius_iterator ri(you.pos(), you.current_vision, C_SQUARE,
+                            you.xray_vision ? LOS_NONE : LOS_DEFAULT);
+         ri; ++ri)
+    {
+        monster* mon = monster_at(*ri);
+        if (mon && mon->alive() && mon->attitude == ATT_HOSTILE
+            && !mon->submerged() && mon->visible_to(&you))
+        {
+            mons.push_back(mon);
+        }
+    }
+    return mons;
+}
+
 // Return all nearby monsters in range (default: LOS) that the player
 // is able to recognise as being monsters (i.e. no submerged creatures.)
 //
@@ -193,6 +266,9 @@ vector<monster* > get_nearby_monsters(bool want_move,
 
     vector<monster* > mons;
 
+    if (dangerous_only && require_visible && _visible_threats == 0)
+        return mons;
+
     // Sweep every visible square within range.
     for (radius_iterator ri(you.pos(), range, C_SQUARE, you.xray_vision ? LOS_NONE : LOS_DEFAULT); ri; ++ri)
     {
@@ -34,6 +34,12 @@ bool there_are_monsters_nearby(bool dangerous_only = false,
                                bool require_visible = true,
                                bool consider_user_options = false);
 
+void note_visible_threat_summary(int count);
+void note_visible_hostiles(vector<mid_t> &&mids);
+void invalidate_visible_threat_summary();
+
+vector<monster* > get_visible_hostiles();
+
 
 bool player_in_a_dangerous_place(bool *invis = nullptr);
 void bring_to_safety();
@@ -365,6 +365,7 @@ static void _give_basic_knowledge()
 
     // Recognisable by appearance.
     you.type_ids[OBJ_POTIONS][POT_BLOOD] = true;
+    reset_ident_bitsets();
 
     // Removed item types are handled in _set_removed_types_as_identified.
 }
@@ -565,6 +566,7 @@ static void _setup_generic(const newgame_def& ng)
     init_companions();
 
     // Create the save file.
+    reset_level_cache();
     if (Options.no_save)
         you.save = new package();
     else
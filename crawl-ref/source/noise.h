@@ -138,4 +138,14 @@ private:
     FixedArray<noise_cell, GXM, GYM> cells;
     vector<noise_t> noises;
     int affected_actor_count;
+
+    // Cells touched by the current propagation, so cleanup after a
+    // flood is proportional to the area covered instead of the level.
+    vector<coord_def> dirty_cells;
+
+    // Noises raised while propagate_noise() is running (monsters waking
+    // up and shouting back); they are re-registered for the next turn
+    // once the in-progress flood has finished with the grid.
+    vector<noise_t> deferred_noises;
+    bool propagating;
 };
@@ -271,6 +271,8 @@ public:
                                   // creating macros
     int         autofight_warning;      // Amount of real time required between
                                         // two autofight commands
+    int         slow_turn_capture_ms;   // Dump diagnostics when a turn takes
+                                        // longer than this (0 = disabled).
     bool        cloud_status;     // Whether to show a cloud status light
 
     bool        wall_jump_prompt; // Whether to ask for confirmation before jumps.
@@ -382,6 +384,10 @@ public:
     // Wait for rest wait percent HP and MP before exploring.
     bool        explore_auto_rest;
 
+    // Memory budget (in megabytes) for keeping recently visited levels'
+    // serialized state in memory across level changes; 0 disables.
+    int         level_cache_size;
+
     bool        travel_key_stop;   // Travel stops on keypress.
 
     vector<sound_mapping> sound_mappings;
@@ -571,6 +577,9 @@ public:
     bool        tile_level_map_hide_messages;
     bool        tile_level_map_hide_sidebar;
     bool        tile_web_mouse_control;
+    // Seconds without input before an idle process sheds rebuildable
+    // memory; 0 disables.
+    int         tile_web_idle_trim_delay;
 #endif
 #endif // USE_TILE
 
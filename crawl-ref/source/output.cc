@@ -40,6 +40,7 @@
 #include "player-stats.h"
 #include "prompt.h"
 #include "religion.h"
+#include "show.h"
 #include "showsymb.h"
 #include "skills.h"
 #include "state.h"
@@ -1371,7 +1372,28 @@ void print_stats()
         if (Options.equip_bar)
             _print_stats_equip(1, 8+yhack);
         else
-            _print_stats_noise(1, 8+yhack);
+        {
+            // This line used to repaint unconditionally every turn; only
+            // do so when what it displays has actually changed.
+            static bool last_silence = false;
+            static int last_level = -1, last_raw = -1;
+            const bool silence = silenced(you.pos());
+            const int level = silence ? 0 : you.get_noise_perception(true);
+            const int raw = you.wizard && !silence
+                            ? you.get_noise_perception(false) : -1;
+            if (you.redraw_noise
+                || silence != last_silence
+                || level != last_level
+                || raw != last_raw
+                || Noise_Bar.wants_redraw())
+            {
+                _print_stats_noise(1, 8+yhack);
+                last_silence = silence;
+                last_level = level;
+                last_raw = raw;
+                you.redraw_noise = false;
+            }
+        }
     }
 
     if (you.wield_change)
@@ -1488,6 +1510,9 @@ void redraw_screen(bool show_updates)
         return;
     }
 
+    // A forced redraw should rebuild everything from scratch.
+    show_mark_all_dirty();
+
 #ifdef USE_TILE_WEB
     tiles.close_all_menus();
 #endif
@@ -1503,6 +1528,7 @@ void redraw_screen(bool show_updates)
     you.redraw_experience    = true;
     you.wield_change         = true;
     you.redraw_quiver        = true;
+    you.redraw_noise         = true;
     you.redraw_status_lights = true;
 
     print_stats();
@@ -376,10 +376,43 @@ void package::free_chunk(const string &name)
     dirty = true;
 }
 
+// 64-bit FNV-1a; together with the length check this makes an accidental
+// match between different chunk contents all but impossible.
+static uint64_t _chunk_fingerprint(const void *data, plen_t len)
+{
+    const uint8_t *p = static_cast<const uint8_t*>(data);
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (plen_t i = 0; i < len; i++)
+    {
+        h ^= p[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+// Returns true if the chunk was last written (through this function, in
+// this session) with exactly this content, in which case the caller may
+// skip rewriting it. Otherwise records the new content's fingerprint and
+// returns false. Callers that use this must route every write of the
+// chunk through it, or the recorded fingerprint goes stale; deleting the
+// chunk clears the record.
+bool package::chunk_up_to_date(const string &name, const void *data,
+                               plen_t len)
+{
+    ASSERT(rw);
+    const uint64_t fp = _chunk_fingerprint(data, len);
+    if (pair<plen_t, uint64_t> *old = map_find(chunk_fingerprints, name))
+        if (directory.count(name) && old->first == len && old->second == fp)
+            return true;
+    chunk_fingerprints[name] = make_pair(len, fp);
+    return false;
+}
+
 void package::delete_chunk(const string &name)
 {
     free_chunk(name);
     directory.erase(name);
+    chunk_fingerprints.erase(name);
 }
 
 plen_t package::write_directory()
@@ -910,17 +943,31 @@ plen_t chunk_reader::read(void *data, plen_t len)
     if (eof)
         return 0;
 
+    // Read the whole compressed chain up front; this costs one read
+    // per on-disk block rather than one per 32K of refill, and lets
+    // inflate run over a single contiguous input buffer.
+    if (z_inbuf.empty() && !zs.avail_in)
+    {
+        const plen_t block = 256 * 1024;
+        plen_t got;
+        do
+        {
+            const size_t at = z_inbuf.size();
+            z_inbuf.resize(at + block);
+            got = raw_read(&z_inbuf[at], block);
+            z_inbuf.resize(at + got);
+        } while (got == block);
+
+        zs.next_in  = z_inbuf.empty() ? Z_NULL : &z_inbuf[0];
+        zs.avail_in = z_inbuf.size();
+    }
+
     zs.next_out  = (Bytef*)data;
     zs.avail_out = len;
     while (zs.avail_out)
     {
         if (!zs.avail_in)
-        {
-            zs.next_in  = z_buffer;
-            zs.avail_in = raw_read(z_buffer, sizeof(z_buffer));
-            if (!zs.avail_in)
-                corrupted("save file corrupted -- block truncated");
-        }
+            corrupted("save file corrupted -- block truncated");
         int res = inflate(&zs, Z_NO_FLUSH);
         if (res == Z_STREAM_END)
         {
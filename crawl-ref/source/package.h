@@ -51,7 +51,9 @@ private:
 #ifdef USE_ZLIB
     bool eof;
     z_stream zs;
-    Bytef z_buffer[32768];
+    // The chunk's whole compressed chain, slurped on first read();
+    // inflate consumes it straight from this buffer.
+    vector<Bytef> z_inbuf;
 #endif
     plen_t raw_read(void *data, plen_t len);
 public:
@@ -71,6 +73,7 @@ public:
     chunk_writer* writer(const string &name);
     chunk_reader* reader(const string &name);
     void commit();
+    bool chunk_up_to_date(const string &name, const void *data, plen_t len);
     void delete_chunk(const string &name);
     bool has_chunk(const string &name);
     vector<string> list_chunks();
@@ -99,6 +102,9 @@ private:
     map<plen_t, pair<plen_t, plen_t> > block_map;
     set<plen_t> new_chunks;
     map<plen_t, uint32_t> reader_count;
+    // Length and hash of the last content passed to chunk_up_to_date(),
+    // per chunk, used to skip rewriting unchanged chunks.
+    map<string, pair<plen_t, uint64_t> > chunk_fingerprints;
     plen_t extend_block(plen_t at, plen_t size, plen_t by);
     plen_t alloc_block(plen_t &size);
     void finish_chunk(const string &name, plen_t at);
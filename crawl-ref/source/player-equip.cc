@@ -31,6 +31,7 @@
 #include "player-stats.h"
 #include "religion.h"
 #include "shopping.h"
+#include "show.h"
 #include "spl-miscast.h"
 #include "spl-summoning.h"
 #include "spl-wpnench.h"
@@ -58,6 +59,10 @@ void equip_item(equipment_type slot, int item_slot, bool msg)
     ASSERT(!you.melded[slot]);
 
     you.equip[slot] = item_slot;
+    invalidate_equip_property_cache();
+    // Equipment can grant see invisible, changing which monsters the
+    // show layer draws without any monster-side event.
+    show_mark_all_dirty();
 
     equip_effect(slot, item_slot, false, msg);
     ash_check_bondage();
@@ -77,6 +82,8 @@ bool unequip_item(equipment_type slot, bool msg)
     else
     {
         you.equip[slot] = -1;
+        invalidate_equip_property_cache();
+        show_mark_all_dirty();
 
         if (!you.melded[slot])
             unequip_effect(slot, item_slot, false, msg);
@@ -98,6 +105,7 @@ bool meld_slot(equipment_type slot, bool msg)
     if (you.equip[slot] != -1 && !you.melded[slot])
     {
         you.melded.set(slot);
+        invalidate_equip_property_cache();
         return true;
     }
     return false;
@@ -113,6 +121,7 @@ bool unmeld_slot(equipment_type slot, bool msg)
     if (you.equip[slot] != -1 && you.melded[slot])
     {
         you.melded.set(slot, false);
+        invalidate_equip_property_cache();
         return true;
     }
     return false;
@@ -843,9 +843,11 @@ static void _decrement_durations()
     }
 
     // these should be after decr_ambrosia, transforms, liquefying, etc.
-    for (int i = 0; i < NUM_DURATIONS; ++i)
-        if (duration_decrements_normally((duration_type) i))
-            _decrement_simple_duration((duration_type) i, delay);
+    // Only active durations need any work; checking you.duration[] up
+    // front keeps the common all-zero case to one array read each.
+    for (duration_type dur : simple_decrementing_durations())
+        if (you.duration[dur])
+            _decrement_simple_duration(dur, delay);
 }
 
 /**
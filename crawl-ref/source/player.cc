@@ -41,6 +41,7 @@
 #include "hints.h"
 #include "hiscores.h"
 #include "invent.h"
+#include "item-name.h"
 #include "item-prop.h"
 #include "items.h"
 #include "item-use.h"
@@ -61,6 +62,7 @@
 #include "prompt.h"
 #include "religion.h"
 #include "shout.h"
+#include "show.h"
 #include "skills.h"
 #include "spl-damage.h"
 #include "spl-transloc.h"
@@ -633,6 +635,8 @@ void update_vision_range()
     you.current_vision = (you.normal_vision * nom + denom / 2) / denom;
     ASSERT(you.current_vision > 0);
     set_los_radius(you.current_vision);
+    // A new vision range means a new LOS footprint for the show layer.
+    show_mark_all_dirty();
 }
 
 /**
@@ -1307,40 +1311,101 @@ bool player_likes_chunks(bool permanently)
 }
 
 // If temp is set to false, temporary sources or resistance won't be counted.
+// Equipment contributions to the player's resistances, indexed by
+// whether unidentified properties count. beam.cc asks for resistances
+// per cell hit and the UI per redraw, and each ask used to walk the
+// equipment slots several times over. The sums only change when
+// equipment or its identification state does, so they ride the same
+// invalidation as the artefact property sums. Mutation, form and
+// duration contributions stay live reads — they're plain array
+// accesses, and durations change in too many places to funnel.
+struct equip_resists
+{
+    int fire, cold, elec, pois, life, mr;
+    int steam_body; // ARMF_RES_STEAM on body armour, before doubling
+    bool dragonskin, olgreb;
+};
+static equip_resists _equip_res[2];
+static bool _equip_res_valid = false;
+
+static const equip_resists &_equip_resist_block(bool calc_unid)
+{
+    if (!_equip_res_valid)
+    {
+        for (int u = 0; u < 2; u++)
+        {
+            equip_resists &er = _equip_res[u];
+            const bool unid = u;
+
+            er.fire = you.wearing(EQ_RINGS, RING_PROTECTION_FROM_FIRE, unid)
+                      + you.wearing(EQ_RINGS, RING_FIRE, unid)
+                      - you.wearing(EQ_RINGS, RING_ICE, unid)
+                      + you.wearing(EQ_STAFF, STAFF_FIRE, unid)
+                      + you.wearing_ego(EQ_ALL_ARMOUR, SPARM_FIRE_RESISTANCE)
+                      + you.wearing_ego(EQ_ALL_ARMOUR, SPARM_RESISTANCE)
+                      + you.scan_artefacts(ARTP_FIRE, unid);
+
+            er.cold = you.wearing(EQ_RINGS, RING_PROTECTION_FROM_COLD, unid)
+                      + you.wearing(EQ_RINGS, RING_ICE, unid)
+                      - you.wearing(EQ_RINGS, RING_FIRE, unid)
+                      + you.wearing(EQ_STAFF, STAFF_COLD, unid)
+                      + you.wearing_ego(EQ_ALL_ARMOUR, SPARM_COLD_RESISTANCE)
+                      + you.wearing_ego(EQ_ALL_ARMOUR, SPARM_RESISTANCE)
+                      + you.scan_artefacts(ARTP_COLD, unid);
+
+            er.elec = you.wearing(EQ_STAFF, STAFF_AIR, unid)
+                      + you.scan_artefacts(ARTP_ELECTRICITY, unid);
+
+            er.pois = you.wearing(EQ_RINGS, RING_POISON_RESISTANCE, unid)
+                      + you.wearing(EQ_STAFF, STAFF_POISON, unid)
+                      + you.wearing_ego(EQ_ALL_ARMOUR, SPARM_POISON_RESISTANCE)
+                      + you.scan_artefacts(ARTP_POISON, unid);
+
+            er.life = you.wearing(EQ_RINGS, RING_LIFE_PROTECTION, unid)
+                      + you.wearing_ego(EQ_ALL_ARMOUR, SPARM_POSITIVE_ENERGY)
+                      + you.scan_artefacts(ARTP_NEGATIVE_ENERGY, unid)
+                      + you.wearing(EQ_STAFF, STAFF_DEATH, unid);
+
+            // In MR pips; multiplied out by player_res_magic().
+            er.mr = you.scan_artefacts(ARTP_MAGIC_RESISTANCE, unid)
+                    + you.wearing_ego(EQ_ALL_ARMOUR, SPARM_MAGIC_RESISTANCE,
+                                      unid)
+                    + you.wearing(EQ_RINGS, RING_PROTECTION_FROM_MAGIC, unid);
+
+            er.steam_body = 0;
+            const item_def *body_armour = you.slot_item(EQ_BODY_ARMOUR);
+            if (body_armour)
+            {
+                const int type = body_armour->sub_type;
+                er.fire += armour_type_prop(type, ARMF_RES_FIRE);
+                er.cold += armour_type_prop(type, ARMF_RES_COLD);
+                er.elec += armour_type_prop(type, ARMF_RES_ELEC);
+                er.pois += armour_type_prop(type, ARMF_RES_POISON);
+                er.life += armour_type_prop(type, ARMF_RES_NEG);
+                er.mr   += armour_type_prop(type, ARMF_RES_MAGIC);
+                er.steam_body = armour_type_prop(type, ARMF_RES_STEAM);
+            }
+
+            er.dragonskin = player_equip_unrand(UNRAND_DRAGONSKIN);
+            er.olgreb     = player_equip_unrand(UNRAND_OLGREB);
+        }
+        _equip_res_valid = true;
+    }
+    return _equip_res[calc_unid];
+}
+
 int player_res_fire(bool calc_unid, bool temp, bool items)
 {
     int rf = 0;
 
     if (items)
     {
-        // rings of fire resistance/fire
-        rf += you.wearing(EQ_RINGS, RING_PROTECTION_FROM_FIRE, calc_unid);
-        rf += you.wearing(EQ_RINGS, RING_FIRE, calc_unid);
-
-        // rings of ice
-        rf -= you.wearing(EQ_RINGS, RING_ICE, calc_unid);
-
-        // Staves
-        rf += you.wearing(EQ_STAFF, STAFF_FIRE, calc_unid);
-
-        // body armour:
-        const item_def *body_armour = you.slot_item(EQ_BODY_ARMOUR);
-        if (body_armour)
-            rf += armour_type_prop(body_armour->sub_type, ARMF_RES_FIRE);
-
-        // ego armours
-        rf += you.wearing_ego(EQ_ALL_ARMOUR, SPARM_FIRE_RESISTANCE);
-        rf += you.wearing_ego(EQ_ALL_ARMOUR, SPARM_RESISTANCE);
-
-        // randart weapons:
-        rf += you.scan_artefacts(ARTP_FIRE, calc_unid);
+        const equip_resists &er = _equip_resist_block(calc_unid);
+        rf += er.fire;
 
         // dragonskin cloak: 0.5 to draconic resistances
-        if (calc_unid && player_equip_unrand(UNRAND_DRAGONSKIN)
-            && coinflip())
-        {
+        if (calc_unid && er.dragonskin && coinflip())
             rf++;
-        }
     }
 
     // species:
@@ -1387,11 +1452,7 @@ int player_res_steam(bool calc_unid, bool temp, bool items)
         res += 2;
 
     if (items)
-    {
-        const item_def *body_armour = you.slot_item(EQ_BODY_ARMOUR);
-        if (body_armour)
-            res += armour_type_prop(body_armour->sub_type, ARMF_RES_STEAM) * 2;
-    }
+        res += _equip_resist_block(calc_unid).steam_body * 2;
 
     res += rf * 2;
 
@@ -1429,30 +1490,11 @@ int player_res_cold(bool calc_unid, bool temp, bool items)
 
     if (items)
     {
-        // rings of cold resistance/ice
-        rc += you.wearing(EQ_RINGS, RING_PROTECTION_FROM_COLD, calc_unid);
-        rc += you.wearing(EQ_RINGS, RING_ICE, calc_unid);
-
-        // rings of fire
-        rc -= you.wearing(EQ_RINGS, RING_FIRE, calc_unid);
-
-        // Staves
-        rc += you.wearing(EQ_STAFF, STAFF_COLD, calc_unid);
-
-        // body armour:
-        const item_def *body_armour = you.slot_item(EQ_BODY_ARMOUR);
-        if (body_armour)
-            rc += armour_type_prop(body_armour->sub_type, ARMF_RES_COLD);
-
-        // ego armours
-        rc += you.wearing_ego(EQ_ALL_ARMOUR, SPARM_COLD_RESISTANCE);
-        rc += you.wearing_ego(EQ_ALL_ARMOUR, SPARM_RESISTANCE);
-
-        // randart weapons:
-        rc += you.scan_artefacts(ARTP_COLD, calc_unid);
+        const equip_resists &er = _equip_resist_block(calc_unid);
+        rc += er.cold;
 
         // dragonskin cloak: 0.5 to draconic resistances
-        if (calc_unid && player_equip_unrand(UNRAND_DRAGONSKIN) && coinflip())
+        if (calc_unid && er.dragonskin && coinflip())
             rc++;
     }
 
@@ -1509,19 +1551,11 @@ int player_res_electricity(bool calc_unid, bool temp, bool items)
 
     if (items)
     {
-        // staff
-        re += you.wearing(EQ_STAFF, STAFF_AIR, calc_unid);
-
-        // body armour:
-        const item_def *body_armour = you.slot_item(EQ_BODY_ARMOUR);
-        if (body_armour)
-            re += armour_type_prop(body_armour->sub_type, ARMF_RES_ELEC);
-
-        // randart weapons:
-        re += you.scan_artefacts(ARTP_ELECTRICITY, calc_unid);
+        const equip_resists &er = _equip_resist_block(calc_unid);
+        re += er.elec;
 
         // dragonskin cloak: 0.5 to draconic resistances
-        if (calc_unid && player_equip_unrand(UNRAND_DRAGONSKIN) && coinflip())
+        if (calc_unid && er.dragonskin && coinflip())
             re++;
     }
 
@@ -1603,7 +1637,7 @@ int player_res_poison(bool calc_unid, bool temp, bool items)
 
     if (you.is_nonliving(temp)
         || temp && get_form()->res_pois() == 3
-        || items && player_equip_unrand(UNRAND_OLGREB)
+        || items && _equip_resist_block(calc_unid).olgreb
         || temp && you.duration[DUR_DIVINE_STAMINA])
     {
         return 3;
@@ -1613,25 +1647,11 @@ int player_res_poison(bool calc_unid, bool temp, bool items)
 
     if (items)
     {
-        // rings of poison resistance
-        rp += you.wearing(EQ_RINGS, RING_POISON_RESISTANCE, calc_unid);
-
-        // Staves
-        rp += you.wearing(EQ_STAFF, STAFF_POISON, calc_unid);
-
-        // ego armour:
-        rp += you.wearing_ego(EQ_ALL_ARMOUR, SPARM_POISON_RESISTANCE);
-
-        // body armour:
-        const item_def *body_armour = you.slot_item(EQ_BODY_ARMOUR);
-        if (body_armour)
-            rp += armour_type_prop(body_armour->sub_type, ARMF_RES_POISON);
-
-        // rPois+ artefacts
-        rp += you.scan_artefacts(ARTP_POISON, calc_unid);
+        const equip_resists &er = _equip_resist_block(calc_unid);
+        rp += er.pois;
 
         // dragonskin cloak: 0.5 to draconic resistances
-        if (calc_unid && player_equip_unrand(UNRAND_DRAGONSKIN) && coinflip())
+        if (calc_unid && er.dragonskin && coinflip())
             rp++;
     }
 
@@ -1679,7 +1699,7 @@ int player_res_sticky_flame(bool calc_unid, bool temp, bool items)
 
     // dragonskin cloak: 0.5 to draconic resistances
     if (items && calc_unid
-        && player_equip_unrand(UNRAND_DRAGONSKIN) && coinflip())
+        && _equip_resist_block(calc_unid).dragonskin && coinflip())
     {
         rsf++;
     }
@@ -1866,25 +1886,12 @@ int player_prot_life(bool calc_unid, bool temp, bool items)
 
     if (items)
     {
-        // rings
-        pl += you.wearing(EQ_RINGS, RING_LIFE_PROTECTION, calc_unid);
-
-        // armour (checks body armour only)
-        pl += you.wearing_ego(EQ_ALL_ARMOUR, SPARM_POSITIVE_ENERGY);
-
-        // pearl dragon counts
-        const item_def *body_armour = you.slot_item(EQ_BODY_ARMOUR);
-        if (body_armour)
-            pl += armour_type_prop(body_armour->sub_type, ARMF_RES_NEG);
-
-        // randart wpns
-        pl += you.scan_artefacts(ARTP_NEGATIVE_ENERGY, calc_unid);
+        const equip_resists &er = _equip_resist_block(calc_unid);
+        pl += er.life;
 
         // dragonskin cloak: 0.5 to draconic resistances
-        if (calc_unid && player_equip_unrand(UNRAND_DRAGONSKIN) && coinflip())
+        if (calc_unid && er.dragonskin && coinflip())
             pl++;
-
-        pl += you.wearing(EQ_STAFF, STAFF_DEATH, calc_unid);
     }
 
     // undead/demonic power
@@ -2705,11 +2712,60 @@ static void _gain_and_note_hp_mp()
     take_note(Note(NOTE_XP_LEVEL_CHANGE, you.experience_level, 0, buf));
 }
 
+// Melding or unmelding a set of equipment on a form change recomputes
+// max HP and MP once per item through the entry points below. A
+// recalc_batch records that a recompute is owed and performs each kind
+// once when the outermost batch closes: proportional rescales compose,
+// so one rescale from the original maximum to the final one gives the
+// same answer as the per-item cascade.
+static int _recalc_batch_depth = 0;
+static bool _recalc_hp_pending = false;
+static bool _recalc_hp_scale_pending = false;
+static bool _recalc_mp_pending = false;
+
+recalc_batch::recalc_batch()
+{
+    _recalc_batch_depth++;
+}
+
+recalc_batch::~recalc_batch()
+{
+    ASSERT(_recalc_batch_depth > 0);
+    if (--_recalc_batch_depth)
+        return;
+
+    if (_recalc_hp_scale_pending)
+    {
+        _recalc_hp_scale_pending = false;
+        _recalc_hp_pending = false;
+        recalc_and_scale_hp();
+        if (you.hp_max <= 0) // as in _calc_hp_artefact()
+            ouch(0, KILLED_BY_DRAINING);
+    }
+    else if (_recalc_hp_pending)
+    {
+        _recalc_hp_pending = false;
+        calc_hp();
+    }
+
+    if (_recalc_mp_pending)
+    {
+        _recalc_mp_pending = false;
+        calc_mp();
+    }
+}
+
 /**
  * Calculate max HP changes and scale current HP accordingly.
  */
 void recalc_and_scale_hp()
 {
+    if (_recalc_batch_depth)
+    {
+        _recalc_hp_scale_pending = true;
+        return;
+    }
+
     // Rounding must be down or Deep Dwarves would abuse certain values.
     // We can reduce errors by a factor of 100 by using partial hp we have.
     int old_max = you.hp_max;
@@ -3577,41 +3633,103 @@ int slaying_bonus(bool ranged)
 // a given property. Slow if any randarts are worn, so avoid where
 // possible. If `matches' is non-nullptr, items with nonzero property are
 // pushed onto *matches.
+// Aggregated property sums over equipped artefacts, indexed by whether
+// unidentified properties count. Stat recalculation queries these
+// several times per turn (more during travel); the sums only change
+// when equipment or its identification state does, so they are rebuilt
+// lazily after invalidate_equip_property_cache().
+static FixedVector<int, ART_PROPERTIES> _equip_artp_sum[2];
+static bool _equip_artp_sum_valid = false;
+
+void invalidate_equip_property_cache()
+{
+    _equip_artp_sum_valid = false;
+    _equip_res_valid = false;
+    // Equipment can change what the player sees (see invisible), which
+    // both the tension formula and the cached monster_info list read.
+    invalidate_tension_cache();
+}
+
 int player::scan_artefacts(artefact_prop_type which_property,
                            bool calc_unid,
                            vector<item_def> *matches) const
 {
-    int retval = 0;
-
-    for (int i = EQ_FIRST_EQUIP; i < NUM_EQUIP; ++i)
+    // Callers asking for the matching items need the per-item walk.
+    if (matches)
     {
-        if (melded[i] || equip[i] == -1)
-            continue;
+        int retval = 0;
+        for (int i = EQ_FIRST_EQUIP; i < NUM_EQUIP; ++i)
+        {
+            if (melded[i] || equip[i] == -1)
+                continue;
 
-        const int eq = equip[i];
+            const int eq = equip[i];
 
-        // Only weapons give their effects when in our hands.
-        if (i == EQ_WEAPON && inv[ eq ].base_type != OBJ_WEAPONS)
-            continue;
+            // Only weapons give their effects when in our hands.
+            if (i == EQ_WEAPON && inv[ eq ].base_type != OBJ_WEAPONS)
+                continue;
 
-        if (!is_artefact(inv[ eq ]))
-            continue;
+            if (!is_artefact(inv[ eq ]))
+                continue;
+
+            bool known;
+            int val = artefact_property(inv[eq], which_property, known);
+            if (calc_unid || known)
+            {
+                retval += val;
+                if (val)
+                    matches->push_back(inv[eq]);
+            }
+        }
+        return retval;
+    }
+
+    if (!_equip_artp_sum_valid)
+    {
+        for (int u = 0; u < 2; u++)
+            _equip_artp_sum[u].init(0);
 
-        bool known;
-        int val = artefact_property(inv[eq], which_property, known);
-        if (calc_unid || known)
+        for (int i = EQ_FIRST_EQUIP; i < NUM_EQUIP; ++i)
         {
-            retval += val;
-            if (matches && val)
-                matches->push_back(inv[eq]);
+            if (melded[i] || equip[i] == -1)
+                continue;
+
+            const int eq = equip[i];
+
+            // Only weapons give their effects when in our hands.
+            if (i == EQ_WEAPON && inv[ eq ].base_type != OBJ_WEAPONS)
+                continue;
+
+            if (!is_artefact(inv[ eq ]))
+                continue;
+
+            artefact_properties_t  proprt;
+            artefact_known_props_t known;
+            proprt.init(0);
+            known.init(0);
+            artefact_properties(inv[eq], proprt, known);
+
+            for (int prop = 0; prop < ART_PROPERTIES; prop++)
+            {
+                _equip_artp_sum[1][prop] += proprt[prop];
+                if (known[prop])
+                    _equip_artp_sum[0][prop] += proprt[prop];
+            }
         }
+        _equip_artp_sum_valid = true;
     }
 
-    return retval;
+    return _equip_artp_sum[calc_unid ? 1 : 0][which_property];
 }
 
 void calc_hp()
 {
+    if (_recalc_batch_depth)
+    {
+        _recalc_hp_pending = true;
+        return;
+    }
+
     int oldhp = you.hp, oldmax = you.hp_max;
     you.hp_max = get_real_hp(true, false);
     deflate_hp(you.hp_max, false);
@@ -3646,6 +3764,12 @@ void dec_hp(int hp_loss, bool fatal, const char *aux)
 
 void calc_mp()
 {
+    if (_recalc_batch_depth)
+    {
+        _recalc_mp_pending = true;
+        return;
+    }
+
     you.max_magic_points = get_real_mp(true);
     you.magic_points = min(you.magic_points, you.max_magic_points);
     you.redraw_magic_points = true;
@@ -5190,6 +5314,7 @@ player::player()
     dactions.clear();
     level_stack.clear();
     type_ids.init(false);
+    reset_ident_bitsets();
 
     banished_by.clear();
     banished_power = 0;
@@ -5227,6 +5352,7 @@ player::player()
 
     wield_change         = false;
     redraw_quiver        = false;
+    redraw_noise         = true;
     redraw_status_lights = false;
     redraw_hit_points    = false;
     redraw_magic_points  = false;
@@ -6273,20 +6399,8 @@ int player_res_magic(bool calc_unid, bool temp)
 
     int rm = you.experience_level * species_mr_modifier(you.species);
 
-    // randarts
-    rm += MR_PIP * you.scan_artefacts(ARTP_MAGIC_RESISTANCE, calc_unid);
-
-    // body armour
-    const item_def *body_armour = you.slot_item(EQ_BODY_ARMOUR);
-    if (body_armour)
-        rm += armour_type_prop(body_armour->sub_type, ARMF_RES_MAGIC) * MR_PIP;
-
-    // ego armours
-    rm += MR_PIP * you.wearing_ego(EQ_ALL_ARMOUR, SPARM_MAGIC_RESISTANCE,
-                                   calc_unid);
-
-    // rings of magic resistance
-    rm += MR_PIP * you.wearing(EQ_RINGS, RING_PROTECTION_FROM_MAGIC, calc_unid);
+    // randarts, body armour, ego armours, rings of magic resistance
+    rm += MR_PIP * _equip_resist_block(calc_unid).mr;
 
     // Mutations
     rm += MR_PIP * you.get_mutation_level(MUT_MAGIC_RESISTANCE);
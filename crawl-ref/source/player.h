@@ -381,7 +381,7 @@ public:
 
     // This should really be unique_ptr, but that causes issues since files.cc
     // uses the default constructor of `player`.
-    vector<shared_ptr<Delay>> delay_queue; // pending actions
+    deque<shared_ptr<Delay>> delay_queue; // pending actions
 
     chrono::time_point<chrono::system_clock> last_keypress_time;
 
@@ -408,6 +408,7 @@ public:
 
     bool wield_change;          // redraw weapon
     bool redraw_quiver;         // redraw quiver
+    bool redraw_noise;          // force a repaint of the noise bar
 
     bool redraw_title;
     bool redraw_hit_points;
@@ -1014,6 +1015,8 @@ int player_total_spell_levels();
 
 int player_teleport(bool calc_unid = true);
 
+void invalidate_equip_property_cache();
+
 int player_monster_detect_radius();
 
 int slaying_bonus(bool ranged = false);
@@ -1049,6 +1052,18 @@ void calc_hp();
 void calc_mp();
 void recalc_and_scale_hp();
 
+// While one of these is in scope, calc_hp(), calc_mp() and
+// recalc_and_scale_hp() only note that a recompute is owed; each owed
+// kind runs once when the outermost batch closes. Used around the
+// equipment meld/unmeld sets of a form change, where every item would
+// otherwise trigger its own full recalculation.
+class recalc_batch
+{
+public:
+    recalc_batch();
+    ~recalc_batch();
+};
+
 void dec_hp(int hp_loss, bool fatal, const char *aux = nullptr);
 void dec_mp(int mp_loss, bool silent = false);
 
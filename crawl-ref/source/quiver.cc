@@ -301,10 +301,12 @@ void player_quiver::on_inv_quantity_changed(int slot, int amt)
     }
     else
     {
-        // We might need to update the quiver...
-        int qv_slot = get_fire_item();
-        if (qv_slot == slot)
-            you.redraw_quiver = true;
+        // Just flag the quiver line for redraw. Rebuilding the fire
+        // order here to see whether this slot is the quivered one made
+        // every stack quantity change -- each pickup during autoexplore
+        // -- pay for a full inventory scan; the display code recomputes
+        // the quiver contents when it actually redraws.
+        you.redraw_quiver = true;
     }
 }
 
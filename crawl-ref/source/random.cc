@@ -14,6 +14,20 @@
 
 static FixedVector<PcgRNG, NUM_RNGS> rngs;
 
+// The stream the default random2/coinflip family currently draws from;
+// switched by rng_stream below.
+static int _current_rng = RNG_GAMEPLAY;
+
+rng_stream::rng_stream(rng_type rng) : previous(_current_rng)
+{
+    _current_rng = rng;
+}
+
+rng_stream::~rng_stream()
+{
+    _current_rng = previous;
+}
+
 uint32_t get_uint32(int generator)
 {
     return rngs[generator].get_uint32();
@@ -85,7 +99,7 @@ static int _random2(int max, int rng)
 // [0, max)
 int random2(int max)
 {
-    return _random2(max, RNG_GAMEPLAY);
+    return _random2(max, _current_rng);
 }
 
 // [0, max), separate RNG state
@@ -276,7 +290,7 @@ double random_real()
 {
     static const uint64_t UPPER_BITS = 0x3FF0000000000000ULL;
     static const uint64_t LOWER_MASK = 0x000FFFFFFFFFFFFFULL;
-    const uint64_t value = UPPER_BITS | (get_uint64() & LOWER_MASK);
+    const uint64_t value = UPPER_BITS | (get_uint64(_current_rng) & LOWER_MASK);
     double result;
     // Portable memory transmutation. The union trick almost always
     // works, but this is safer.
@@ -336,7 +350,7 @@ bool defer_rand::x_chance_in_y_contd(int x, int y, int index)
     do
     {
         if (index == int(bits.size()))
-            bits.push_back(get_uint32());
+            bits.push_back(get_uint32(_current_rng));
 
         uint64_t expn_rand_1 = uint64_t(bits[index++]) * y;
         uint64_t expn_rand_2 = expn_rand_1 + y;
@@ -359,7 +373,7 @@ int defer_rand::random2(int maxp1)
         return 0;
 
     if (bits.empty())
-        bits.push_back(get_uint32());
+        bits.push_back(get_uint32(_current_rng));
 
     uint64_t expn_rand_1 = uint64_t(bits[0]) * maxp1;
     uint64_t expn_rand_2 = expn_rand_1 + maxp1;
@@ -12,6 +12,19 @@ void seed_rng();
 void seed_rng(uint32_t seed);
 void seed_rng(uint64_t[], int);
 
+// Scoped substream switch: while one of these is in scope, the
+// random2/coinflip family draws from the given stream. Keeping level
+// and item generation on their own substreams means incidental
+// gameplay rolls can't desync them from their seeds (and vice versa).
+class rng_stream
+{
+public:
+    explicit rng_stream(rng_type rng);
+    ~rng_stream();
+private:
+    int previous;
+};
+
 uint32_t get_uint32(int generator = RNG_GAMEPLAY);
 uint64_t get_uint64(int generator = RNG_GAMEPLAY);
 bool coinflip();
@@ -275,13 +275,19 @@ bool ranged_attack::handle_phase_hit()
     if (projectile->is_type(OBJ_MISSILES, MI_NEEDLE))
     {
         damage_done = blowgun_duration_roll(get_ammo_brand(*projectile));
-        set_attack_verb(0);
-        announce_hit();
+        if (needs_message)
+        {
+            set_attack_verb(0);
+            announce_hit();
+        }
     }
     else if (projectile->is_type(OBJ_MISSILES, MI_THROWING_NET))
     {
-        set_attack_verb(0);
-        announce_hit();
+        if (needs_message)
+        {
+            set_attack_verb(0);
+            announce_hit();
+        }
         if (defender->is_player())
             player_caught_in_net();
         else
@@ -16,6 +16,7 @@
 #include "ray.h"
 
 #include <cmath>
+#include <map>
 
 #include "los.h"
 
@@ -480,6 +481,46 @@ void ray_def::nudge_inside()
     ASSERT(in_diamond_int(r.start));
 }
 
+// Bouncy beams present the same relative geometry over and over: a
+// lightning bolt rattling down a corridor hits identical (cell-relative
+// ray, wall configuration) pairs at every bounce, and again each time
+// it is refired. Since bounce() translates the ray to cell (0,0) before
+// reflecting, the outcome depends only on that pair, so resolved
+// reflections are kept in a table filled by the geometry code below --
+// a miss just runs the full computation and records the result.
+struct bounce_key
+{
+    double sx, sy;      // translated ray start
+    double dx, dy;      // ray direction
+    unsigned int walls; // 3x3 reflect_grid, packed
+
+    bool operator<(const bounce_key &k) const
+    {
+        if (sx != k.sx)
+            return sx < k.sx;
+        if (sy != k.sy)
+            return sy < k.sy;
+        if (dx != k.dx)
+            return dx < k.dx;
+        if (dy != k.dy)
+            return dy < k.dy;
+        return walls < k.walls;
+    }
+};
+
+static map<bounce_key, geom::ray> _bounce_memo;
+
+static unsigned int _pack_reflect_grid(const reflect_grid &rg)
+{
+    unsigned int mask = 0;
+    unsigned int bit = 0;
+    for (int y = -1; y <= 1; y++)
+        for (int x = -1; x <= 1; x++, bit++)
+            if (rg(coord_def(x, y)))
+                mask |= 1U << bit;
+    return mask;
+}
+
 void ray_def::bounce(const reflect_grid &rg)
 {
     ASSERT(_valid());
@@ -498,6 +539,22 @@ void ray_def::bounce(const reflect_grid &rg)
     rtrans.start = r.start - p;
     rtrans.dir = r.dir;
 
+    // Everything below is a pure function of the translated ray and the
+    // wall configuration, so check the reflection table first.
+    const bounce_key key = { rtrans.start.x, rtrans.start.y,
+                             rtrans.dir.x, rtrans.dir.y,
+                             _pack_reflect_grid(rg) };
+    const auto memo = _bounce_memo.find(key);
+    if (memo != _bounce_memo.end())
+    {
+        r.start = memo->second.start + p;
+        r.dir = memo->second.dir;
+        on_corner = is_corner(r.start);
+        ASSERT(_valid());
+        ASSERT(!rg(pos() - old_pos));
+        return;
+    }
+
     // Move to the diamond edge to determine the side.
     coord_def side;
     bool corner = _to_grid(&rtrans, false);
@@ -521,6 +578,12 @@ void ray_def::bounce(const reflect_grid &rg)
     else
         rtrans = _bounce_noncorner(rtrans, side, rg);
 
+    // Remember the resolved reflection; cap the table so pathological
+    // maps can't grow it without bound.
+    if (_bounce_memo.size() >= 4096)
+        _bounce_memo.clear();
+    _bounce_memo[key] = rtrans;
+
     // Translate back.
     r.start = rtrans.start + p;
     r.dir = rtrans.dir;
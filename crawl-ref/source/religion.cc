@@ -4368,7 +4368,50 @@ int get_monster_tension(const monster& mons, god_type god)
     return exper;
 }
 
-int get_tension(god_type god)
+// Tension cache. Xom, penance checks and god mood all want the tension
+// value during the same turn, and each computation walks every visible
+// monster. The value is cached against the exact state it was computed
+// from and dropped whenever anything tension reads changes: any actor
+// moving, monster damage/healing, enchantment changes, attitude flips
+// and deaths all call invalidate_tension_cache(), and the player-side
+// inputs (hp, position, turn) are part of the cache key directly. The
+// tension-delta probes in mon-cast.cc keep working because placing or
+// removing their test monster invalidates the cache.
+static int _tension_epoch = 0;
+static int _cached_tension = 0;
+static god_type _cached_tension_god = GOD_NO_GOD;
+static int _cached_tension_turn = -1;
+static int _cached_tension_epoch = -1;
+static int _cached_tension_hp = -1;
+static int _cached_tension_status = -1;
+static coord_def _cached_tension_pos;
+
+void invalidate_tension_cache()
+{
+    _tension_epoch++;
+}
+
+// The epoch doubles as a generic "the monster situation changed" stamp:
+// it ticks on actor movement, damage, enchantment, attitude and death
+// events, so callers scanning the monsters in view can key their own
+// caches on it (Xom's candidate feasibility checks do).
+int tension_epoch()
+{
+    return _tension_epoch;
+}
+
+// The player statuses the tension formula tests; only their presence
+// matters, so a bitmask suffices as a cache key.
+static int _tension_status_key()
+{
+    return (you.cannot_act() ? 1 : 0)
+           | (you.confused() ? 2 : 0)
+           | (you.caught() ? 4 : 0)
+           | (you.duration[DUR_SLOW] ? 8 : 0)
+           | (you.duration[DUR_HASTE] ? 16 : 0);
+}
+
+static int _calc_tension(god_type god)
 {
     int total = 0;
 
@@ -4449,6 +4492,31 @@ int get_tension(god_type god)
     return max(0, tension);
 }
 
+int get_tension(god_type god)
+{
+    if (_cached_tension_turn == you.num_turns
+        && _cached_tension_epoch == _tension_epoch
+        && _cached_tension_god == god
+        && _cached_tension_hp == you.hp
+        && _cached_tension_status == _tension_status_key()
+        && _cached_tension_pos == you.pos())
+    {
+        return _cached_tension;
+    }
+
+    const int tension = _calc_tension(god);
+
+    _cached_tension        = tension;
+    _cached_tension_god    = god;
+    _cached_tension_turn   = you.num_turns;
+    _cached_tension_epoch  = _tension_epoch;
+    _cached_tension_hp     = you.hp;
+    _cached_tension_status = _tension_status_key();
+    _cached_tension_pos    = you.pos();
+
+    return tension;
+}
+
 int get_fuzzied_monster_difficulty(const monster& mons)
 {
     double factor = sqrt(exp_needed(you.experience_level) / 30.0);
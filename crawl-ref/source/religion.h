@@ -140,6 +140,10 @@ void religion_turn_start();
 void religion_turn_end();
 
 int get_tension(god_type god = you.religion);
+// Drop the cached tension value; called whenever the monster-side
+// inputs change (movement, damage, enchantments, attitude, death).
+void invalidate_tension_cache();
+int tension_epoch();
 int get_monster_tension(const monster& mons, god_type god = you.religion);
 int get_fuzzied_monster_difficulty(const monster& mons);
 
@@ -10,6 +10,53 @@
 
 using namespace std;
 
+// Generated outputs are written to a temporary file first and only moved
+// over the real one when the content actually changed. Untouched outputs
+// keep their timestamps, so editing one tile source doesn't recompile
+// every (large) generated tiledef or re-crush unchanged pages.
+static FILE *_fopen_temp(const char *filename)
+{
+    char temp[1024];
+    sprintf(temp, "%s.tmp", filename);
+    FILE *fp = fopen(temp, "w");
+    if (!fp)
+        fprintf(stderr, "Error: couldn't open '%s' for write.\n", temp);
+    return fp;
+}
+
+static bool _identical_files(const char *a, const char *b)
+{
+    ifstream fa(a, ios::binary);
+    ifstream fb(b, ios::binary);
+    if (!fa || !fb)
+        return false;
+
+    string ca((istreambuf_iterator<char>(fa)), istreambuf_iterator<char>());
+    string cb((istreambuf_iterator<char>(fb)), istreambuf_iterator<char>());
+    return ca == cb;
+}
+
+static bool _commit_output(const char *filename)
+{
+    char temp[1024];
+    sprintf(temp, "%s.tmp", filename);
+
+    if (_identical_files(temp, filename))
+    {
+        remove(temp);
+        return true;
+    }
+
+    // rename() can't replace an existing file on Windows.
+    remove(filename);
+    if (rename(temp, filename))
+    {
+        fprintf(stderr, "Error: couldn't write '%s'.\n", filename);
+        return false;
+    }
+    return true;
+}
+
 tile_list_processor::tile_list_processor() :
     m_last_enum(0),
     m_rim(false),
@@ -915,7 +962,11 @@ bool tile_list_processor::write_data(bool image, bool code)
             sprintf(filename, "%s.png", lcname.c_str());
             if (m_abstract.empty())
             {
-                if (!m_page.write_image(filename))
+                char temp[1024];
+                sprintf(temp, "%s.tmp", filename);
+                if (!m_page.write_image(temp))
+                    return false;
+                if (!_commit_output(filename))
                     return false;
             }
             else
@@ -923,14 +974,12 @@ bool tile_list_processor::write_data(bool image, bool code)
                 // Write an empty file.
                 char filename[1024];
                 sprintf(filename, "%s.png", lcname.c_str());
-                FILE *fp = fopen(filename, "w");
+                FILE *fp = _fopen_temp(filename);
                 if (!fp)
-                {
-                    fprintf(stderr, "Error: couldn't open '%s' for write.\n",
-                            filename);
                     return false;
-                }
                 fclose(fp);
+                if (!_commit_output(filename))
+                    return false;
             }
         }
     }
@@ -944,13 +993,10 @@ bool tile_list_processor::write_data(bool image, bool code)
     {
         char filename[1024];
         sprintf(filename, "tiledef-%s.h", lcname.c_str());
-        FILE *fp = fopen(filename, "w");
+        FILE *fp = _fopen_temp(filename);
 
         if (!fp)
-        {
-            fprintf(stderr, "Error: couldn't open '%s' for write.\n", filename);
             return false;
-        }
 
         if (!m_categories.empty())
         {
@@ -1094,6 +1140,8 @@ bool tile_list_processor::write_data(bool image, bool code)
         }
 
         fclose(fp);
+        if (!_commit_output(filename))
+            return false;
     }
 
     // write "tiledef-%name.cc"
@@ -1101,13 +1149,10 @@ bool tile_list_processor::write_data(bool image, bool code)
     {
         char filename[1024];
         sprintf(filename, "tiledef-%s.cc", lcname.c_str());
-        FILE *fp = fopen(filename, "w");
+        FILE *fp = _fopen_temp(filename);
 
         if (!fp)
-        {
-            fprintf(stderr, "Error: couldn't open '%s' for write.\n", filename);
             return false;
-        }
 
         fprintf(fp, "// This file has been automatically generated.\n\n");
         fprintf(fp, "#include \"AppHdr.h\"\n");
@@ -1336,6 +1381,8 @@ bool tile_list_processor::write_data(bool image, bool code)
             lcname.c_str(), lcname.c_str(), lcname.c_str(), lcname.c_str());
 
         fclose(fp);
+        if (!_commit_output(filename))
+            return false;
     }
     else
     {
@@ -1347,13 +1394,10 @@ bool tile_list_processor::write_data(bool image, bool code)
 
         char filename[1024];
         sprintf(filename, "tiledef-%s.cc", lcname.c_str());
-        FILE *fp = fopen(filename, "w");
+        FILE *fp = _fopen_temp(filename);
 
         if (!fp)
-        {
-            fprintf(stderr, "Error: couldn't open '%s' for write.\n", filename);
             return false;
-        }
 
         fprintf(fp, "// This file has been automatically generated.\n\n");
         fprintf(fp, "#include \"AppHdr.h\"\n");
@@ -1429,6 +1473,8 @@ bool tile_list_processor::write_data(bool image, bool code)
         fprintf(fp, "}\n\n");
 
         fclose(fp);
+        if (!_commit_output(filename))
+            return false;
     }
 
     // write "tile-%name.html"
@@ -1436,13 +1482,10 @@ bool tile_list_processor::write_data(bool image, bool code)
     {
         char filename[1024];
         sprintf(filename, "tile-%s.html", lcname.c_str());
-        FILE *fp = fopen(filename, "w");
+        FILE *fp = _fopen_temp(filename);
 
         if (!fp)
-        {
-            fprintf(stderr, "Error: couldn't open '%s' for write.\n", filename);
             return false;
-        }
 
         fprintf(fp, "<html><table>\n");
 
@@ -1507,6 +1550,8 @@ bool tile_list_processor::write_data(bool image, bool code)
         fprintf(fp, "</table></html>\n");
 
         fclose(fp);
+        if (!_commit_output(filename))
+            return false;
     }
 
     delete[] part_min;
@@ -1516,13 +1561,10 @@ bool tile_list_processor::write_data(bool image, bool code)
     {
         char filename[1024];
         sprintf(filename, "%s.d", lcname.c_str());
-        FILE *fp = fopen(filename, "w");
+        FILE *fp = _fopen_temp(filename);
 
         if (!fp)
-        {
-            fprintf(stderr, "Error: couldn't open '%s' for write.\n", filename);
             return false;
-        }
 
         if (!m_page.m_tiles.empty())
             fprintf(fp, "%s.png: \\\n", lcname.c_str());
@@ -1539,19 +1581,18 @@ bool tile_list_processor::write_data(bool image, bool code)
              fprintf(fp, "%s:\n", str.c_str());
 
         fclose(fp);
+        if (!_commit_output(filename))
+            return false;
     }
 
     // write "tileinfo-%name.js"
     {
         char filename[1024];
         sprintf(filename, "tileinfo-%s.js", lcname.c_str());
-        FILE *fp = fopen(filename, "w");
+        FILE *fp = _fopen_temp(filename);
 
         if (!fp)
-        {
-            fprintf(stderr, "Error: couldn't open '%s' for write.\n", filename);
             return false;
-        }
 
         if (m_abstract.size() == 0)
         {
@@ -1747,6 +1788,8 @@ bool tile_list_processor::write_data(bool image, bool code)
         fprintf(fp, "return exports;\n});\n");
 
         fclose(fp);
+        if (!_commit_output(filename))
+            return false;
     }
 
     return true;
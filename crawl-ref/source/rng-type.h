@@ -2,6 +2,8 @@
 
 enum rng_type {
     RNG_GAMEPLAY,
+    RNG_LEVELGEN,
+    RNG_ITEMGEN,
     RNG_UI,
     NUM_RNGS,
 };
@@ -187,7 +187,34 @@ int artefact_value(const item_def &item)
     return (ret > 0) ? ret : 0;
 }
 
-unsigned int item_value(item_def item, bool ident)
+// Appraised values keyed on the item fields the appraisal reads, so
+// browsing a shop or scrolling the shopping list redoes the full
+// property inspection only for items the cache hasn't seen. Cleared
+// whenever dungeon-wide item knowledge changes (set_ident_type), since
+// values depend on what the player can identify.
+static map<uint64_t, unsigned int> _item_value_cache;
+
+void invalidate_shop_price_cache()
+{
+    _item_value_cache.clear();
+}
+
+static uint64_t _item_value_cache_key(const item_def &item, bool ident)
+{
+    uint64_t key = ident ? 2 : 1;
+    const uint64_t key_parts[] =
+    {
+        (uint64_t)item.base_type, (uint64_t)item.sub_type,
+        (uint64_t)(uint16_t)item.plus, (uint64_t)(uint16_t)item.plus2,
+        (uint64_t)(uint32_t)item.special, (uint64_t)(uint16_t)item.quantity,
+        (uint64_t)item.flags,
+    };
+    for (uint64_t part : key_parts)
+        key = key * 0x9E3779B97F4A7C15ULL + part + 1;
+    return key;
+}
+
+static unsigned int _item_value(item_def item, bool ident)
 {
     // Note that we pass item in by value, since we want a local
     // copy to mangle as necessary.
@@ -815,6 +842,23 @@ unsigned int item_value(item_def item, bool ident)
     return item.quantity * valued;
 }
 
+unsigned int item_value(item_def item, bool ident)
+{
+    const uint64_t cache_key = _item_value_cache_key(item, ident);
+    const auto cached = _item_value_cache.find(cache_key);
+    if (cached != _item_value_cache.end())
+        return cached->second;
+
+    const unsigned int valued = _item_value(item, ident);
+
+    // Bound the footprint: long games churn through many distinct
+    // stack states, and stale keys are never looked up again.
+    if (_item_value_cache.size() > 500)
+        _item_value_cache.clear();
+    _item_value_cache[cache_key] = valued;
+    return valued;
+}
+
 bool is_worthless_consumable(const item_def &item)
 {
     switch (item.base_type)
@@ -1011,7 +1055,8 @@ class ShopEntry : public InvEntry
                                                   YELLOW;
         const string keystr = colour_to_str(keycol);
         const string itemstr =
-            colour_to_str(menu_colour(text, item_prefix(*item), tag));
+            colour_to_str(menu_colour(get_fullname(), item_prefix(*item),
+                                      tag));
         return make_stringf(" <%s>%c%c%c%c</%s><%s>%4d gold   %s%s</%s>",
                             keystr.c_str(),
                             hotkeys[0],
@@ -1021,7 +1066,7 @@ class ShopEntry : public InvEntry
                             keystr.c_str(),
                             itemstr.c_str(),
                             cost,
-                            text.c_str(),
+                            get_fullname().c_str(),
                             shop_item_unknown(*item) ? " (unknown)" : "",
                             itemstr.c_str());
     }
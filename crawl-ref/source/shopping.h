@@ -10,6 +10,7 @@ int artefact_value(const item_def &item);
 // ident == true overrides the item ident level and gives the price
 // as if the item was fully id'd
 unsigned int item_value(item_def item, bool ident = false);
+void invalidate_shop_price_cache();
 // price of an item if it were being sold in a given shop
 int item_price(const item_def& item, const shop_struct& shop);
 // Return true if an item is classified as a worthless consumable.
@@ -764,17 +764,13 @@ void yell(const actor* mon)
 
 void apply_noises()
 {
-    // [ds] This copying isn't awesome, but we cannot otherwise handle
-    // the case where one set of noises wakes up monsters who then let
-    // out yips of their own, modifying _noise_grid while it is in the
-    // middle of propagate_noise().
+    // Noises raised while the flood runs (monsters waking up and
+    // letting out yips of their own) are queued inside the grid and
+    // re-registered for the next turn, so propagation can work on
+    // _noise_grid in place instead of taking a defensive copy of the
+    // whole cell array every noisy turn.
     if (_noise_grid.dirty())
-    {
-        noise_grid copy = _noise_grid;
-        // Reset the main grid.
-        _noise_grid.reset();
-        copy.propagate_noise();
-    }
+        _noise_grid.propagate_noise();
 }
 
 // noisy() has a messaging service for giving messages to the player
@@ -985,7 +981,7 @@ int noise_cell::turn_angle(const coord_def &next_delta) const
 }
 
 noise_grid::noise_grid()
-    : cells(), noises(), affected_actor_count(0)
+    : cells(), noises(), affected_actor_count(0), propagating(false)
 {
 }
 
@@ -994,13 +990,27 @@ void noise_grid::reset()
     cells.init(noise_cell());
     noises.clear();
     affected_actor_count = 0;
+    dirty_cells.clear();
+    deferred_noises.clear();
+    propagating = false;
 }
 
 void noise_grid::register_noise(const noise_t &noise)
 {
+    // Noises raised mid-propagation (monsters waking and letting out
+    // yips of their own) cannot touch the grid while the flood is
+    // reading it; queue them for the next turn instead.
+    if (propagating)
+    {
+        deferred_noises.push_back(noise);
+        return;
+    }
+
     noise_cell &target_cell(cells(noise.noise_source));
     if (target_cell.can_apply_noise(noise.noise_intensity_millis))
     {
+        if (target_cell.noise_id == -1)
+            dirty_cells.push_back(noise.noise_source);
         const int noise_index = noises.size();
         noises.push_back(noise);
         noises[noise_index].noise_id = noise_index;
@@ -1020,6 +1030,16 @@ void noise_grid::propagate_noise()
     dprf(DIAG_NOISE, "noise_grid: %u noises to apply",
          (unsigned int)noises.size());
 #endif
+    propagating = true;
+
+    // Noise only has an effect where someone is standing to hear it, so
+    // once nobody is within hearing range of the frontier the rest of
+    // the flood is pure bookkeeping and can be skipped.
+    vector<coord_def> listeners;
+    listeners.push_back(you.pos());
+    for (monster_iterator mi; mi; ++mi)
+        listeners.push_back(mi->pos());
+
     vector<coord_def> noise_perimeter[2];
     int circ_index = 0;
 
@@ -1078,6 +1098,41 @@ void noise_grid::propagate_noise()
 
         noise_perimeter[circ_index].clear();
         circ_index = !circ_index;
+
+        // Early out: find how far the loudest frontier cell could still
+        // be heard (open floor costs BASE_NOISE_ATTENUATION_MILLIS per
+        // step, everything else more), and stop if no listener is that
+        // close to the frontier's bounding box. Distances are chebyshev
+        // like the flood itself, so this never cuts a flood short that
+        // could still reach someone.
+        vector<coord_def> &frontier(noise_perimeter[circ_index]);
+        if (!frontier.empty())
+        {
+            int max_intensity = 0;
+            coord_def bmin = frontier[0], bmax = frontier[0];
+            for (const coord_def p : frontier)
+            {
+                max_intensity = max(max_intensity,
+                                    cells(p).noise_intensity_millis);
+                bmin.x = min(bmin.x, p.x); bmin.y = min(bmin.y, p.y);
+                bmax.x = max(bmax.x, p.x); bmax.y = max(bmax.y, p.y);
+            }
+            const int reach =
+                (max_intensity - LOWEST_AUDIBLE_NOISE_INTENSITY_MILLIS)
+                / BASE_NOISE_ATTENUATION_MILLIS + 1;
+            bool in_reach = false;
+            for (const coord_def l : listeners)
+            {
+                if (l.x >= bmin.x - reach && l.x <= bmax.x + reach
+                    && l.y >= bmin.y - reach && l.y <= bmax.y + reach)
+                {
+                    in_reach = true;
+                    break;
+                }
+            }
+            if (!in_reach)
+                break;
+        }
     }
 
 #ifdef DEBUG_NOISE_PROPAGATION
@@ -1088,6 +1143,20 @@ void noise_grid::propagate_noise()
         dump_noise_grid("noise-grid.html");
     }
 #endif
+
+    // Clean up only the cells this flood touched, then re-register any
+    // noises that were raised while it ran so they go off next turn.
+    for (const coord_def p : dirty_cells)
+        cells(p) = noise_cell();
+    dirty_cells.clear();
+    noises.clear();
+    affected_actor_count = 0;
+    propagating = false;
+
+    const vector<noise_t> replay(move(deferred_noises));
+    deferred_noises.clear();
+    for (const noise_t &noise : replay)
+        register_noise(noise);
 }
 
 bool noise_grid::propagate_noise_to_neighbour(int base_attenuation,
@@ -1103,6 +1172,9 @@ bool noise_grid::propagate_noise_to_neighbour(int base_attenuation,
         return false;
     }
 
+    if (neighbour.noise_id == -1)
+        dirty_cells.push_back(next_pos);
+
     const int noise_turn_angle = cell.turn_angle(next_pos - current_pos);
     const int turn_attenuation =
         noise_turn_angle? (base_attenuation * (100 + noise_turn_angle * 25)
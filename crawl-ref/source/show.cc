@@ -19,6 +19,7 @@
 #include "libutil.h"
 #include "map-knowledge.h"
 #include "mon-place.h"
+#include "nearby-danger.h"
 #include "options.h"
 #include "state.h"
 #include "terrain.h"
@@ -29,9 +30,59 @@
 #include "tiles-build-specific.h"
 #include "traps.h"
 #include "travel.h"
+#include "view.h"
 #include "viewgeom.h"
 #include "viewmap.h"
 
+// Dirty-cell tracking for show_init(). Change funnels (actor movement,
+// cloud updates, floor item changes, ...) mark the cells they touch;
+// LOS shape changes mark everything. When nothing forced a full
+// refresh, show_init() patches only the marked cells.
+static bool _show_dirty_all = true;
+static FixedArray<bool, GXM, GYM> _show_dirty_grid;
+static vector<coord_def> _show_dirty_cells;
+// The LOS centre env.show was last derived around; a different centre
+// means the show-space mapping shifted and everything must be redone.
+static coord_def _show_center(-1, -1);
+
+// More marks than this and patching approaches the cost of the full
+// LOS pass anyway.
+static const unsigned int SHOW_DIRTY_CELL_MAX = 128;
+
+void show_mark_all_dirty()
+{
+    _show_dirty_all = true;
+    view_invalidate_scroll();
+    invalidate_visible_threat_summary();
+}
+
+void show_mark_dirty(const coord_def &gc)
+{
+    // Even a redundant mark means something changed since the last
+    // monster census.
+    invalidate_visible_threat_summary();
+
+    if (_show_dirty_all || !map_bounds(gc) || _show_dirty_grid(gc))
+        return;
+
+    if (_show_dirty_cells.size() >= SHOW_DIRTY_CELL_MAX)
+    {
+        show_mark_all_dirty();
+        return;
+    }
+
+    _show_dirty_grid(gc) = true;
+    _show_dirty_cells.push_back(gc);
+}
+
+static void _show_dirty_reset()
+{
+    for (const coord_def &gc : _show_dirty_cells)
+        _show_dirty_grid(gc) = false;
+    _show_dirty_cells.clear();
+    _show_dirty_all = false;
+}
+
 show_type::show_type()
     : cls(SH_NOTHING),
       feat(DNGN_UNSEEN),
@@ -499,6 +550,10 @@ void show_update_at(const coord_def &gp, layers_type layers)
         return;
     else
         env.map_knowledge(gp).clear_monster();
+
+    // env.show is changing under the last frame viewwindow() derived.
+    view_invalidate_frame();
+
     // The sequence is grid, items, clouds, monsters.
     _update_feat_at(gp);
 
@@ -533,18 +588,63 @@ void show_update_at(const coord_def &gp, layers_type layers)
 
 void show_init(layers_type layers)
 {
-    clear_terrain_visibility();
+    // A full LOS update touches each cell's neighbourhood through
+    // set_terrain_seen(); batch so each minimap square is flushed once.
+    map_update_batch batch;
+
     if (crawl_state.game_is_arena())
     {
+        clear_terrain_visibility();
         for (rectangle_iterator ri(crawl_view.vgrdc, LOS_MAX_RANGE); ri; ++ri)
         {
             show_update_at(*ri, layers);
             // Invis indicators and update flags not used in Arena.
             env.map_knowledge(*ri).flags &= ~MAP_INVISIBLE_UPDATE;
         }
+        _show_dirty_reset();
+        _show_center = crawl_view.vgrdc;
         return;
     }
 
+    // Patch only the cells change funnels marked since the last pass.
+    // This is only sound when the previous pass filled env.show
+    // completely (LAYERS_ALL both times) around the same centre, and
+    // nothing forced a full refresh (LOS shape change, level load).
+    static layers_type last_layers = LAYERS_NONE;
+    static bool last_xray = false;
+    const bool patch = !_show_dirty_all
+                       && layers == LAYERS_ALL
+                       && last_layers == LAYERS_ALL
+                       && you.xray_vision == last_xray
+                       && you.pos() == _show_center;
+    last_layers = layers;
+    last_xray = you.xray_vision;
+
+    if (patch)
+    {
+        for (const coord_def &gc : _show_dirty_cells)
+            if (you.see_cell(gc))
+                show_update_at(gc, layers);
+        for (const coord_def &gc : _show_dirty_cells)
+            if (you.see_cell(gc))
+                env.map_knowledge(gc).flags &= ~MAP_INVISIBLE_UPDATE;
+#ifdef USE_TILE
+        // tile_draw_floor() cleared the foreground buffers for the
+        // whole show area before we were called; unchanged cells just
+        // redraw from their still-current map knowledge.
+        for (radius_iterator ri(you.pos(),
+                                you.xray_vision ? LOS_NONE : LOS_DEFAULT);
+             ri; ++ri)
+        {
+            if (!_show_dirty_grid(*ri))
+                tile_draw_map_cell(*ri, true);
+        }
+#endif
+        _show_dirty_reset();
+        return;
+    }
+
+    clear_terrain_visibility();
     vector <coord_def> update_locs;
     for (radius_iterator ri(you.pos(), you.xray_vision ? LOS_NONE : LOS_DEFAULT); ri; ++ri)
     {
@@ -555,6 +655,9 @@ void show_init(layers_type layers)
     // Need to clear these update flags now so they don't persist.
     for (coord_def loc : update_locs)
         env.map_knowledge(loc).flags &= ~MAP_INVISIBLE_UPDATE;
+
+    _show_dirty_reset();
+    _show_center = you.pos();
 }
 
 // Emphasis may change while off-level. This catches up.
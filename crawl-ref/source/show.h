@@ -86,6 +86,12 @@ constexpr layers_type LAYERS_ALL = LAYER_MONSTERS | LAYER_PLAYER
                                  | LAYER_ITEMS | LAYER_CLOUDS;
 
 void show_init(layers_type layers = LAYERS_ALL);
+
+// Tell show_init() a cell's contents changed so it can be patched
+// without re-deriving the whole LOS, or that everything did (LOS shape
+// changes, level loads).
+void show_mark_dirty(const coord_def &gc);
+void show_mark_all_dirty();
 void update_item_at(const coord_def &gp, bool detected = false, bool wizard = false);
 void show_update_at(const coord_def &gp, layers_type layers = LAYERS_ALL);
 void show_update_emphasis();
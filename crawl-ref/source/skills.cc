@@ -1892,9 +1892,25 @@ float apt_to_factor(int apt)
     return 1 / exp(log(2) * apt / APT_DOUBLE);
 }
 
+// Memoized apt_to_factor: exp() per lookup adds up when XP from a big
+// kill batch walks every skill. Aptitudes live in a narrow band
+// (UNUSABLE_SKILL - 3 through small positives), so a flat table covers
+// every value we ever see; factors are strictly positive, so zero
+// marks an empty slot.
+static float _apt_factor(int apt)
+{
+    static float factors[256];
+    const int idx = apt + 128;
+    if (idx < 0 || idx >= 256)
+        return apt_to_factor(apt);
+    if (factors[idx] == 0)
+        factors[idx] = apt_to_factor(apt);
+    return factors[idx];
+}
+
 unsigned int skill_exp_needed(int lev, skill_type sk, species_type sp)
 {
-    const int exp[28] =
+    static const int exp[28] =
           { 0, 50, 150, 300, 500, 750,          // 0-5
             1050, 1400, 1800, 2250, 2800,       // 6-10
             3450, 4200, 5050, 6000, 7050,       // 11-15
@@ -1930,7 +1946,31 @@ int species_apt(skill_type skill, species_type species)
 
 float species_apt_factor(skill_type sk, species_type sp)
 {
-    return apt_to_factor(species_apt(sk, sp));
+    // Cache the player's effective factor vector so train_skills'
+    // inner loop is a single array read. The key covers everything
+    // species_apt folds in: species itself (draconian colouring is a
+    // species change) and the MUT_UNSKILLED penalty.
+    static float you_factors[NUM_SKILLS];
+    static species_type cached_species = NUM_SPECIES;
+    static int cached_unskilled = -1;
+
+    if (sp == you.species)
+    {
+        const int unskilled = you.get_mutation_level(MUT_UNSKILLED);
+        if (cached_species != sp || cached_unskilled != unskilled)
+        {
+            for (int i = 0; i < NUM_SKILLS; ++i)
+            {
+                you_factors[i] =
+                    _apt_factor(species_apt(static_cast<skill_type>(i), sp));
+            }
+            cached_species = sp;
+            cached_unskilled = unskilled;
+        }
+        return you_factors[sk];
+    }
+
+    return _apt_factor(species_apt(sk, sp));
 }
 
 vector<skill_type> get_crosstrain_skills(skill_type sk)
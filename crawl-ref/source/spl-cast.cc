@@ -314,7 +314,7 @@ static int _apply_spellcasting_success_boosts(spell_type spell, int chance)
  * @return          A failure rate. This is *not* a percentage - for a human-
  *                  readable version, call _get_true_fail_rate().
  */
-int raw_spell_fail(spell_type spell)
+static int _raw_spell_fail(spell_type spell)
 {
     int chance = 60;
 
@@ -420,8 +420,8 @@ int stepdown_spellpower(int power, int scale)
  *
  * @return the resulting spell power.
  */
-int calc_spell_power(spell_type spell, bool apply_intel, bool fail_rate_check,
-                     bool cap_power, int scale)
+static int _calc_spell_power(spell_type spell, bool apply_intel,
+                             bool fail_rate_check, bool cap_power, int scale)
 {
     int power = 0;
 
@@ -486,6 +486,68 @@ int calc_spell_power(spell_type spell, bool apply_intel, bool fail_rate_check,
     return power;
 }
 
+// The spell menu, the tiles spell region and the dump code recompute
+// every spell's failure rate and power per redraw, and each
+// recomputation walks equipment, skills and mutations. Those inputs
+// only move as turns pass, so per-spell results are remembered until
+// the state below changes; the skill-point total catches wizard-mode
+// skill edits, and hp/int catch mid-turn swings that feed the
+// augmentation and intelligence scaling.
+static FixedVector<int8_t, NUM_SPELLS> _spell_fail_cache(-1);
+static FixedVector<int, NUM_SPELLS> _spell_power_cache(-1);
+
+static void _refresh_spellcalc_caches()
+{
+    static int turn = -1, hp = -1, intel = -1, points = -1;
+
+    int pts = 0;
+    for (int sk = SK_FIRST_SKILL; sk < NUM_SKILLS; ++sk)
+        pts += you.skill_points[sk];
+    const int in = you.intel();
+
+    if (you.num_turns == turn && you.hp == hp && in == intel && pts == points)
+        return;
+
+    turn = you.num_turns;
+    hp = you.hp;
+    intel = in;
+    points = pts;
+    _spell_fail_cache.init(-1);
+    _spell_power_cache.init(-1);
+}
+
+int raw_spell_fail(spell_type spell)
+{
+    _refresh_spellcalc_caches();
+
+    int8_t &fail = _spell_fail_cache[spell];
+    if (fail == -1)
+        fail = static_cast<int8_t>(_raw_spell_fail(spell));
+    return fail;
+}
+
+int calc_spell_power(spell_type spell, bool apply_intel, bool fail_rate_check,
+                     bool cap_power, int scale)
+{
+    // Only the full-power unit-scale signature that the display and
+    // casting paths share is worth remembering; the cap is per-spell
+    // constant, so it's applied on the way out of the cache.
+    if (!apply_intel || fail_rate_check || scale != 1)
+        return _calc_spell_power(spell, apply_intel, fail_rate_check,
+                                 cap_power, scale);
+
+    _refresh_spellcalc_caches();
+
+    int &power = _spell_power_cache[spell];
+    if (power == -1)
+        power = _calc_spell_power(spell, true, false, false, 1);
+
+    const int cap = spell_power_cap(spell);
+    if (cap > 0 && cap_power)
+        return min(power, cap);
+    return power;
+}
+
 static int _spell_enhancement(spell_type spell)
 {
     const spschools_type typeflags = get_spell_disciplines(spell);
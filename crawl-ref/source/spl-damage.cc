@@ -178,6 +178,15 @@ spret_type cast_chain_spell(spell_type spell_cast, int pow,
     bool first = true;
     coord_def source, target;
 
+    // Every arc target must be in the caster's line of sight, so gather
+    // the candidates once up front instead of walking the whole monster
+    // list again for each arc. (Anything that appears mid-cast can't be
+    // arced to, which just grounds the chain out marginally earlier.)
+    vector<monster *> candidates;
+    for (monster_near_iterator mi(caster->pos(), LOS_SOLID_SEE); mi; ++mi)
+        if (!invalid_monster(*mi))
+            candidates.push_back(*mi);
+
     for (source = caster->pos(); pow > 0;
          pow -= 8 + random2(13), source = target)
     {
@@ -192,16 +201,16 @@ spret_type cast_chain_spell(spell_type spell_cast, int pow,
         target.x = -1;
         target.y = -1;
 
-        for (monster_iterator mi; mi; ++mi)
+        for (monster *mon : candidates)
         {
-            if (invalid_monster(*mi))
+            if (invalid_monster(mon) || !mon->alive())
                 continue;
 
             // Don't arc to things we cannot hit.
-            if (beam.ignores_monster(*mi))
+            if (beam.ignores_monster(mon))
                 continue;
 
-            dist = grid_distance(source, mi->pos());
+            dist = grid_distance(source, mon->pos());
 
             // check for the source of this arc
             if (!dist)
@@ -214,8 +223,10 @@ spret_type cast_chain_spell(spell_type spell_cast, int pow,
             if (dist > min_dist)
                 continue;
 
-            if (!cell_see_cell(source, mi->pos(), LOS_SOLID)
-                || !cell_see_cell(caster->pos(), mi->pos(), LOS_SOLID_SEE))
+            // Recheck the caster's view too: a chaos arc can have
+            // teleported an earlier candidate out of it.
+            if (!cell_see_cell(source, mon->pos(), LOS_SOLID)
+                || !cell_see_cell(caster->pos(), mon->pos(), LOS_SOLID_SEE))
             {
                 continue;
             }
@@ -228,7 +239,7 @@ spret_type cast_chain_spell(spell_type spell_cast, int pow,
                 if (!one_chance_in(10))
                 {
                     min_dist = dist;
-                    target = mi->pos();
+                    target = mon->pos();
                     count = 0;
                 }
             }
@@ -236,7 +247,7 @@ spret_type cast_chain_spell(spell_type spell_cast, int pow,
             {
                 // either first target, or new selected target at
                 // min_dist == dist.
-                target = mi->pos();
+                target = mon->pos();
             }
         }
 
@@ -1164,6 +1175,7 @@ spret_type cast_shatter(int pow, bool fail)
     run_animation(ANIMATION_SHAKE_VIEWPORT, UA_PLAYER);
 
     int dest = 0;
+    const terrain_change_batch batch;
     for (distance_iterator di(you.pos(), true, true, LOS_RADIUS); di; ++di)
     {
         // goes from the center out, so newly dug walls recurse
@@ -1225,6 +1237,7 @@ bool mons_shatter(monster* caster, bool actual)
     int pow = 5 + div_rand_round(caster->get_hit_dice() * 9, 2);
 
     int dest = 0;
+    const terrain_change_batch batch;
     for (distance_iterator di(caster->pos(), true, true, LOS_RADIUS); di; ++di)
     {
         // goes from the center out, so newly dug walls recurse
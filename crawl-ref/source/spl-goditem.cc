@@ -523,6 +523,9 @@ int detect_items(int pow)
         }
     }
 
+    if (items_found)
+        view_invalidate_scroll();
+
     return items_found;
 }
 
@@ -595,6 +598,9 @@ int detect_creatures(int pow, bool telepathic)
         }
     }
 
+    if (creatures_found)
+        view_invalidate_scroll();
+
     return creatures_found;
 }
 
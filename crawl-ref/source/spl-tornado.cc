@@ -19,6 +19,7 @@
 #include "message.h"
 #include "misc.h"
 #include "mon-behv.h"
+#include "mon-death.h"
 #include "mon-tentacle.h"
 #include "ouch.h"
 #include "prompt.h"
@@ -284,6 +285,10 @@ void tornado_damage(actor *caster, int dur, bool is_vortex)
     int cnt_open = 0;
     int cnt_all  = 0;
 
+    // The storm can kill at every cell it sweeps; batch the deaths so
+    // the forced redraw happens once at the end of the turn's damage.
+    const death_batch batch;
+
     distance_iterator count_i(org, false);
     distance_iterator dam_i(org, true);
     for (int r = 1; r <= max_radius; r++)
@@ -407,7 +412,8 @@ void tornado_damage(actor *caster, int dur, bool is_vortex)
             if (cell_is_solid(*dam_i))
                 continue;
 
-            if ((!cloud_at(*dam_i) || cloud_at(*dam_i)->type == CLOUD_TORNADO)
+            const cloud_struct *cl = cloud_at(*dam_i);
+            if ((!cl || cl->type == CLOUD_TORNADO)
                 && x_chance_in_y(rpow, 20))
             {
                 place_cloud(CLOUD_TORNADO, *dam_i, 2 + random2(2), caster);
@@ -78,9 +78,13 @@ struct spell_desc
 
 #include "spl-data.h"
 
-static int spell_list[NUM_SPELLS];
+// Direct spell_type-indexed pointers into spelldata (nullptr for holes
+// left by removed spells), so the per-cast flag/level/title queries are
+// a single array load rather than an index table plus a second load.
+static const spell_desc *spell_list[NUM_SPELLS];
 
 #define SPELLDATASIZE ARRAYSZ(spelldata)
+COMPILE_CHECK(SPELLDATASIZE <= NUM_SPELLS);
 
 static const struct spell_desc *_seekspell(spell_type spellid);
 
@@ -92,7 +96,7 @@ static const struct spell_desc *_seekspell(spell_type spellid);
 void init_spell_descs()
 {
     for (int i = 0; i < NUM_SPELLS; i++)
-        spell_list[i] = -1;
+        spell_list[i] = nullptr;
 
     for (unsigned int i = 0; i < SPELLDATASIZE; i++)
     {
@@ -117,7 +121,7 @@ void init_spell_descs()
         ASSERTM(!(data.flags & SPFLAG_MONSTER && is_player_spell(data.id)),
                 "spell '%s' is declared as a monster spell but is a player spell", data.title);
 
-        spell_list[data.id] = i;
+        spell_list[data.id] = &data;
     }
 }
 
@@ -901,16 +905,15 @@ spschool_flag_type skill2spell_type(skill_type spell_skill)
 static const spell_desc *_seekspell(spell_type spell)
 {
     ASSERT_RANGE(spell, 0, NUM_SPELLS);
-    const int index = spell_list[spell];
-    ASSERT(index != -1);
+    ASSERT(spell_list[spell]);
 
-    return &spelldata[index];
+    return spell_list[spell];
 }
 
 bool is_valid_spell(spell_type spell)
 {
     return spell > SPELL_NO_SPELL && spell < NUM_SPELLS
-           && spell_list[spell] != -1;
+           && spell_list[spell] != nullptr;
 }
 
 static bool _spell_range_varies(spell_type spell)
@@ -89,6 +89,29 @@ static pair<spell_type, zap_type> _spl_zaps[] =
     { SPELL_BORGNJORS_VILE_CLUTCH, ZAP_VILE_CLUTCH},
 };
 
+// Indexed lookups over the table above, as zap_index in beam.cc does
+// for zap_data; both directions run on every cast. Some spells and
+// zaps appear more than once, so only the first match is recorded,
+// preserving the behaviour of the old linear scans.
+static zap_type _spell_zap_index[NUM_SPELLS];
+static spell_type _zap_spell_index[NUM_ZAPS];
+
+void init_spell_zap_index()
+{
+    for (int i = 0; i < NUM_SPELLS; ++i)
+        _spell_zap_index[i] = NUM_ZAPS;
+    for (int i = 0; i < NUM_ZAPS; ++i)
+        _zap_spell_index[i] = SPELL_NO_SPELL;
+
+    for (const auto &spzap : _spl_zaps)
+    {
+        if (_spell_zap_index[spzap.first] == NUM_ZAPS)
+            _spell_zap_index[spzap.first] = spzap.second;
+        if (_zap_spell_index[spzap.second] == SPELL_NO_SPELL)
+            _zap_spell_index[spzap.second] = spzap.first;
+    }
+}
+
 zap_type spell_to_zap(spell_type spell)
 {
     // This is to make sure that spl-cast.cc doesn't just zap dazzling
@@ -96,20 +119,14 @@ zap_type spell_to_zap(spell_type spell)
     if (spell == SPELL_DAZZLING_SPRAY)
         return NUM_ZAPS;
 
-    for (const auto &spzap : _spl_zaps)
-        if (spzap.first == spell)
-            return spzap.second;
-
-    return NUM_ZAPS;
+    ASSERT_RANGE(spell, 0, NUM_SPELLS);
+    return _spell_zap_index[spell];
 }
 
 spell_type zap_to_spell(zap_type zap)
 {
-    for (const auto &spzap : _spl_zaps)
-        if (spzap.second == zap)
-            return spzap.first;
-
-    return SPELL_NO_SPELL;
+    ASSERT_RANGE(zap, 0, NUM_ZAPS);
+    return _zap_spell_index[zap];
 }
 
 int spell_zap_power(spell_type spell, int pow)
@@ -2,6 +2,8 @@
 
 #include "zap-type.h"
 
+void init_spell_zap_index();
+
 zap_type spell_to_zap(spell_type spell);
 spell_type zap_to_spell(zap_type zap);
 
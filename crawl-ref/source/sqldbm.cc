@@ -122,6 +122,27 @@ From SQLite's documentation:
         return errc;
     }
 
+    if (readonly)
+    {
+        // Map the database instead of reading it through a private page
+        // cache, so concurrent crawl processes on a server share one
+        // copy of the (read-only) description DBs in the OS page cache.
+        // SQLite versions without mmap support ignore the pragma.
+        sqlite3_exec(db, "PRAGMA mmap_size=33554432;",
+                     nullptr, nullptr, nullptr);
+    }
+    else
+    {
+        // The DBs are throwaway build products, regenerated from the
+        // dat/ text files whenever they're stale, so a crash mid-build
+        // loses nothing; skip the fsyncs and the rollback journal while
+        // (re)building.
+        sqlite3_exec(db, "PRAGMA synchronous=OFF;",
+                     nullptr, nullptr, nullptr);
+        sqlite3_exec(db, "PRAGMA journal_mode=MEMORY;",
+                     nullptr, nullptr, nullptr);
+    }
+
     init_schema();
     return errc;
 }
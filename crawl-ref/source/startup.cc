@@ -47,6 +47,7 @@
 #include "skills.h"
 #include "spl-book.h"
 #include "spl-util.h"
+#include "spl-zap.h"
 #include "stairs.h"
 #include "state.h"
 #include "status.h"
@@ -67,6 +68,42 @@
 
 static void _cio_init();
 
+#ifdef DEBUG_DIAGNOSTICS
+// Wall-clock phase timing for process startup, in the same format as
+// the level builder's dgn-phase-times: _startup_phase(name) closes the
+// running phase and opens the named one, and the totals come out as a
+// single greppable "startup-phase-times:" line so the per-release
+// startup budget can be tracked.
+static const char *_startup_cur_phase = nullptr;
+static chrono::steady_clock::time_point _startup_phase_start;
+static string _startup_phase_report;
+
+static void _startup_phase(const char *name)
+{
+    const auto now = chrono::steady_clock::now();
+    if (_startup_cur_phase)
+    {
+        const int ms = chrono::duration_cast<chrono::milliseconds>(
+                           now - _startup_phase_start).count();
+        _startup_phase_report += make_stringf(" %s=%d", _startup_cur_phase,
+                                              ms);
+    }
+    _startup_cur_phase = name;
+    _startup_phase_start = now;
+}
+
+static void _startup_report_phase_times()
+{
+    _startup_phase(nullptr);
+    if (!_startup_phase_report.empty())
+        dprf("startup-phase-times:%s", _startup_phase_report.c_str());
+    _startup_phase_report.clear();
+}
+#else
+static inline void _startup_phase(const char *) { }
+static inline void _startup_report_phase_times() { }
+#endif
+
 // Initialise a whole lot of stuff...
 static void _initialize()
 {
@@ -76,11 +113,13 @@ static void _initialize()
 
     seed_rng();
 
+    _startup_phase("tables");
     init_char_table(Options.char_set);
     init_show_table();
     init_monster_symbols();
     init_spell_descs();        // This needs to be way up top. {dlb}
     init_zap_index();
+    init_spell_zap_index();
     init_mut_index();
     init_sac_index();
     init_duration_index();
@@ -94,6 +133,7 @@ static void _initialize()
 
     msg::initialise_mpr_streams();
 
+    _startup_phase("world");
     // Init item array.
     for (int i = 0; i < MAX_ITEMS; ++i)
         init_item(i);
@@ -109,6 +149,7 @@ static void _initialize()
     you.unique_creatures.reset();
     you.unique_items.init(UNIQ_NOT_EXISTS);
 
+    _startup_phase("lua");
     // Set up the Lua interpreter for the dungeon builder.
     init_dungeon_lua();
 
@@ -123,28 +164,44 @@ static void _initialize()
     }
 #endif
 
-    // Initialise internal databases.
+    _startup_phase("databases");
+    // Initialise internal databases. With -builddb this regenerates
+    // everything now; otherwise each database opens lazily on its
+    // first lookup (see database.cc).
     databaseSystemInit();
 #ifdef USE_TILE_LOCAL
     if (!crawl_state.tiles_disabled && crawl_state.title_screen)
         tiles.update_title_msg("Loading spells and features...");
 #endif
 
+    _startup_phase("caches");
     init_feat_desc_cache();
     init_spell_name_cache();
     init_spell_rarities();
+
+    _startup_phase("maps");
+    // Read special levels and vaults. Only -builddb and the debug
+    // harnesses need the map cache this early; a normal game defers
+    // it to the first map lookup (ensure_maps_loaded()), so an idle
+    // startup menu doesn't pay for parsing the .des cache.
+    bool need_maps_now = crawl_state.build_db || crawl_state.test;
+#ifdef DEBUG_STATISTICS
+    need_maps_now |= crawl_state.map_stat_gen || crawl_state.obj_stat_gen;
+#endif
+    if (need_maps_now)
+    {
 #ifdef USE_TILE_LOCAL
-    if (!crawl_state.tiles_disabled && crawl_state.title_screen)
-        tiles.update_title_msg("Loading maps...");
+        if (!crawl_state.tiles_disabled && crawl_state.title_screen)
+            tiles.update_title_msg("Loading maps...");
 #endif
-
-    // Read special levels and vaults.
-    read_maps();
-    run_map_global_preludes();
+        ensure_maps_loaded();
+    }
 
     if (crawl_state.build_db)
         end(0);
 
+    _startup_report_phase_times();
+
 #ifdef USE_TILE_LOCAL
     if (!crawl_state.tiles_disabled
         && crawl_state.title_screen)
@@ -155,13 +212,35 @@ static void _initialize()
     }
 #endif
 
+    // Load any keylog before seeding: its header can supply the seed.
+    if (!crawl_state.keylog_replay_file.empty()
+        && !keylog_start_replay(crawl_state.keylog_replay_file))
+    {
+        end(1, false, "Couldn't read keylog '%s'",
+            crawl_state.keylog_replay_file.c_str());
+    }
+
     if (Options.seed)
         seed_rng(Options.seed);
 
+    if (!crawl_state.keylog_record_file.empty())
+    {
+        // A recording is only reproducible with a known seed, so pick
+        // one now if the command line didn't provide any.
+        if (!Options.seed)
+        {
+            Options.seed = static_cast<uint32_t>(time(nullptr));
+            seed_rng(Options.seed);
+        }
+        keylog_start_record(crawl_state.keylog_record_file);
+    }
+
 #ifdef DEBUG_STATISTICS
     if (crawl_state.map_stat_gen)
     {
         release_cli_signals();
+        if (crawl_state.gen_bench)
+            end(mapstat_run_genbench() ? 0 : 1, false);
         mapstat_generate_stats();
         end(0, false);
     }
@@ -17,6 +17,7 @@
 #include "cluautil.h"
 #include "command.h"
 #include "coordit.h"
+#include "dbg-prof.h"
 #include "describe.h"
 #include "describe-spells.h"
 #include "directn.h"
@@ -40,6 +41,7 @@
 #include "state.h"
 #include "stringutil.h"
 #include "syscalls.h"
+#include "tag-version.h"
 #include "terrain.h"
 #include "traps.h"
 #include "travel.h"
@@ -53,6 +55,15 @@
 // Global
 StashTracker StashTrack;
 
+// Bumped whenever item type knowledge changes: the cached search text
+// below embeds item names, which such a change can rewrite wholesale.
+static int _stash_search_index_gen = 0;
+
+void invalidate_stash_search_index()
+{
+    _stash_search_index_gen++;
+}
+
 string userdef_annotate_item(const char *s, const item_def *item,
                              bool exclusive)
 {
@@ -170,7 +181,7 @@ static void _fully_identify_item(item_def *item)
 // Stash
 // ----------------------------------------------------------------------
 
-Stash::Stash(coord_def pos_) : items()
+Stash::Stash(coord_def pos_) : items(), search_cache(), search_cache_gen(-1)
 {
     // First, fix what square we're interested in
     if (pos_.origin())
@@ -249,11 +260,14 @@ bool Stash::unmark_trapping_nets()
     for (auto &item : items)
         if (item_is_stationary_net(item))
             item.net_placed = false, changed = true;
+    if (changed)
+        _invalidate_search_cache();
     return changed;
 }
 
 void Stash::update()
 {
+    _invalidate_search_cache();
     feat = grd(pos);
     trap = NUM_TRAPS;
 
@@ -445,6 +459,35 @@ string Stash::feature_description() const
     return feat_desc;
 }
 
+void Stash::_invalidate_search_cache()
+{
+    search_cache_gen = -1;
+}
+
+bool Stash::_search_cache_valid() const
+{
+    return search_cache_gen == _stash_search_index_gen
+           && search_cache.size() == items.size();
+}
+
+void Stash::_rebuild_search_cache() const
+{
+    search_cache.clear();
+    search_cache.reserve(items.size());
+    for (const item_def &item : items)
+    {
+        stash_search_text text;
+        text.name = stash_item_name(item);
+        text.haystack = stash_annotate_item(STASH_LUA_SEARCH_ANNOTATE, &item)
+                        + " " + text.name;
+        text.dumpable = is_dumpable_artefact(item);
+        if (text.dumpable)
+            text.dump = chardump_desc(item);
+        search_cache.push_back(text);
+    }
+    search_cache_gen = _stash_search_index_gen;
+}
+
 vector<stash_search_result> Stash::matches_search(
     const string &prefix, const base_pattern &search) const
 {
@@ -452,15 +495,18 @@ vector<stash_search_result> Stash::matches_search(
     if (empty())
         return results;
 
-    for (const item_def &item : items)
+    if (!_search_cache_valid())
+        _rebuild_search_cache();
+
+    for (unsigned int i = 0; i < items.size(); ++i)
     {
-        const string s   = stash_item_name(item);
-        const string ann = stash_annotate_item(STASH_LUA_SEARCH_ANNOTATE, &item);
-        if (search.matches(prefix + " " + ann + " " + s)
-            || is_dumpable_artefact(item) && search.matches(chardump_desc(item)))
+        const item_def &item = items[i];
+        const stash_search_text &text = search_cache[i];
+        if (search.matches(prefix + " " + text.haystack)
+            || text.dumpable && search.matches(text.dump))
         {
             stash_search_result res;
-            res.match = s;
+            res.match = text.name;
             res.primary_sort = item.name(DESC_QUALNAME);
             res.item = item;
             results.push_back(res);
@@ -488,6 +534,7 @@ vector<stash_search_result> Stash::matches_search(
 /// Fedhas: rot away all corpses.
 void Stash::rot_all_corpses()
 {
+    _invalidate_search_cache();
     for (int i = items.size() - 1; i >= 0; i--)
     {
         item_def &item = items[i];
@@ -498,6 +545,7 @@ void Stash::rot_all_corpses()
 
 void Stash::_update_corpses(int rot_time)
 {
+    _invalidate_search_cache();
     for (int i = items.size() - 1; i >= 0; i--)
     {
         item_def &item = items[i];
@@ -518,6 +566,7 @@ void Stash::_update_corpses(int rot_time)
 
 void Stash::_update_identification()
 {
+    _invalidate_search_cache();
     for (int i = items.size() - 1; i >= 0; i--)
     {
         god_id_item(items[i]);
@@ -527,6 +576,7 @@ void Stash::_update_identification()
 
 void Stash::add_item(const item_def &item, bool add_to_front)
 {
+    _invalidate_search_cache();
     if (_is_rottable(item))
         StashTrack.update_corpses();
 
@@ -619,6 +669,22 @@ void Stash::save(writer& outf) const
     // not interested in (and don't anticipate being interested in).
     for (const item_def &item : items)
         marshallItem(outf, item, true);
+
+    // Persist the cached search text if it is current, so the first
+    // search after a load doesn't rebuild it for the whole dungeon.
+    // Item knowledge is saved alongside, so the text stays accurate.
+    marshallByte(outf, _search_cache_valid() ? 1 : 0);
+    if (_search_cache_valid())
+    {
+        for (const stash_search_text &text : search_cache)
+        {
+            marshallString(outf, text.name);
+            marshallString(outf, text.haystack);
+            marshallByte(outf, text.dumpable ? 1 : 0);
+            if (text.dumpable)
+                marshallString(outf, text.dump);
+        }
+    }
 }
 
 void Stash::load(reader& inf)
@@ -646,10 +712,32 @@ void Stash::load(reader& inf)
 
         items.push_back(item);
     }
+
+    search_cache.clear();
+    search_cache_gen = -1;
+#if TAG_MAJOR_VERSION == 34
+    if (inf.getMinorVersion() < TAG_MINOR_STASH_SEARCH_CACHE)
+        return;
+#endif
+    if (unmarshallByte(inf))
+    {
+        search_cache.reserve(items.size());
+        for (int i = 0; i < count; ++i)
+        {
+            stash_search_text text;
+            text.name = unmarshallString(inf);
+            text.haystack = unmarshallString(inf);
+            text.dumpable = unmarshallByte(inf);
+            if (text.dumpable)
+                text.dump = unmarshallString(inf);
+            search_cache.push_back(text);
+        }
+        search_cache_gen = _stash_search_index_gen;
+    }
 }
 
 ShopInfo::ShopInfo(const shop_struct& shop_)
-    : shop(shop_)
+    : shop(shop_), search_cache_gen(-1)
 {
 }
 
@@ -694,6 +782,25 @@ void ShopInfo::show_menu(const level_pos& pos) const
     ::shop(const_cast<shop_struct&>(shop), pos);
 }
 
+void ShopInfo::_rebuild_search_cache() const
+{
+    shoptitle_cache = shop_name(shop) + (shop.stock.empty() ? "*" : "");
+
+    stock_search_cache.clear();
+    stock_search_cache.reserve(shop.stock.size());
+    for (const item_def &item : shop.stock)
+    {
+        stash_search_text text;
+        text.name = shop_item_name(item);
+        text.haystack = stash_annotate_item(STASH_LUA_SEARCH_ANNOTATE,
+                                            &item, true)
+                        + " " + text.name;
+        text.dump = shop_item_desc(item);
+        stock_search_cache.push_back(text);
+    }
+    search_cache_gen = _stash_search_index_gen;
+}
+
 vector<stash_search_result> ShopInfo::matches_search(
     const string &prefix, const base_pattern &search) const
 {
@@ -702,12 +809,19 @@ vector<stash_search_result> ShopInfo::matches_search(
     no_notes nx;
     bool shop_matches = false;
 
-    const string shoptitle = shop_name(shop) + (shop.stock.empty() ? "*" : "");
-    if (search.matches(shoptitle + " " + prefix + " {shop}"))
+    // Stock only changes through purchases, which shrink it, so the
+    // size check catches those along with any knowledge change.
+    if (search_cache_gen != _stash_search_index_gen
+        || stock_search_cache.size() != shop.stock.size())
+    {
+        _rebuild_search_cache();
+    }
+
+    if (search.matches(shoptitle_cache + " " + prefix + " {shop}"))
     {
         stash_search_result res;
-        res.match = shoptitle;
-        res.primary_sort = shoptitle;
+        res.match = shoptitle_cache;
+        res.primary_sort = shoptitle_cache;
         res.shop = this;
         res.pos.pos = shop.pos;
         results.push_back(res);
@@ -720,18 +834,17 @@ vector<stash_search_result> ShopInfo::matches_search(
         shop_matches = true;
     }
 
-    for (const item_def &item : shop.stock)
+    for (unsigned int i = 0; i < shop.stock.size(); ++i)
     {
-        const string sname = shop_item_name(item);
-        const string ann   = stash_annotate_item(STASH_LUA_SEARCH_ANNOTATE,
-                                                 &item, true);
+        const item_def &item = shop.stock[i];
+        const stash_search_text &text = stock_search_cache[i];
 
         if (shop_matches
-            || search.matches(prefix + " " + ann + " " + sname)
-            || search.matches(shop_item_desc(item)))
+            || search.matches(prefix + " " + text.haystack)
+            || search.matches(text.dump))
         {
             stash_search_result res;
-            res.match = sname;
+            res.match = text.name;
             res.primary_sort = item.name(DESC_QUALNAME);
             res.item = item;
             res.pos.pos = shop.pos;
@@ -1057,12 +1170,26 @@ void LevelStashes::remove_shop(const coord_def& c)
 
 LevelStashes &StashTracker::get_current_level()
 {
-    return levels[level_id::current()];
+    const level_id li = level_id::current();
+    if (last_level && last_level_seen == li)
+        return *last_level;
+    LevelStashes &ls = levels[li];
+    last_level_seen = li;
+    last_level = &ls;
+    return ls;
 }
 
 LevelStashes *StashTracker::find_level(const level_id &id)
 {
-    return map_find(levels, id);
+    if (last_level && last_level_seen == id)
+        return last_level;
+    LevelStashes *ls = map_find(levels, id);
+    if (ls)
+    {
+        last_level_seen = id;
+        last_level = ls;
+    }
+    return ls;
 }
 
 LevelStashes *StashTracker::find_current_level()
@@ -1099,6 +1226,7 @@ bool StashTracker::unmark_trapping_nets(const coord_def &c)
 
 void StashTracker::remove_level(const level_id &place)
 {
+    last_level = nullptr;
     levels.erase(place);
 }
 
@@ -1153,6 +1281,7 @@ void StashTracker::load(reader& inf)
 
     int count = unmarshallShort(inf);
 
+    last_level = nullptr;
     levels.clear();
     for (int i = 0; i < count; ++i)
     {
@@ -1165,10 +1294,32 @@ void StashTracker::load(reader& inf)
 
 void StashTracker::update_visible_stashes()
 {
+    PROF_ZONE("stash_tracking");
+
+    // Generation stamps recorded (plus one, so zero means "never looked")
+    // the last time each cell of the current level was scanned; cells
+    // whose pile and feature haven't changed since then would produce an
+    // identical stash record and can be skipped.
+    static FixedArray<uint32_t, GXM, GYM> seen_gen;
+    static level_id seen_level;
+    if (seen_level != level_id::current())
+    {
+        seen_gen.init(0);
+        seen_level = level_id::current();
+    }
+
     LevelStashes *lev = find_current_level();
     for (radius_iterator ri(you.pos(),
                             you.xray_vision ? LOS_NONE : LOS_DEFAULT); ri; ++ri)
     {
+        // The player's own square always gets a full update: standing on
+        // a stash verifies it (and god-identifies it) in ways a scan from
+        // afar does not, whether or not the pile changed.
+        const uint32_t gen = item_grid_generation(*ri);
+        if (*ri != you.pos() && seen_gen(*ri) == gen + 1)
+            continue;
+        seen_gen(*ri) = gen + 1;
+
         const dungeon_feature_type feat = grd(*ri);
 
         if ((!lev || !lev->update_stash(*ri))
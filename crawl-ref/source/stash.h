@@ -18,6 +18,24 @@ class writer;
 class StashMenu;
 
 struct stash_search_result;
+
+// Cached searchable text for one stashed or stocked item, so that
+// stash search doesn't have to regenerate item names and annotations
+// for every item in the dungeon on every search.
+struct stash_search_text
+{
+    stash_search_text() : dumpable(false) { }
+
+    string name;     // the item name shown for a match
+    string haystack; // annotations + name; what patterns match against
+    string dump;     // chardump description, for dumpable artefacts
+    bool dumpable;
+};
+
+// Invalidate all cached stash search text; called when item type
+// knowledge changes, since that can rename items wholesale.
+void invalidate_stash_search_index();
+
 class Stash
 {
 public:
@@ -68,6 +86,10 @@ private:
     void _update_identification();
     void add_item(const item_def &item, bool add_to_front = false);
 
+    void _invalidate_search_cache();
+    bool _search_cache_valid() const;
+    void _rebuild_search_cache() const;
+
 private:
     bool verified;      // Is this correct to the best of our knowledge?
     coord_def pos;
@@ -77,6 +99,10 @@ private:
 
     vector<item_def> items;
 
+    // One entry per item, rebuilt lazily when stale.
+    mutable vector<stash_search_text> search_cache;
+    mutable int search_cache_gen;
+
     static bool are_items_same(const item_def &, const item_def &,
                                bool exact = false);
 
@@ -107,6 +133,14 @@ private:
     string shop_item_name(const item_def &it) const;
     string shop_item_desc(const item_def &it) const;
 
+    void _rebuild_search_cache() const;
+
+    // One entry per stock item, plus the shop title, rebuilt lazily
+    // when stale. Shops are few enough that this is not persisted.
+    mutable vector<stash_search_text> stock_search_cache;
+    mutable string shoptitle_cache;
+    mutable int search_cache_gen;
+
     friend class ST_ItemIterator;
 };
 
@@ -275,6 +309,11 @@ private:
     typedef map<level_id, LevelStashes> stash_levels_t;
     stash_levels_t levels;
 
+    // One-entry memo mirroring TravelCache: stash queries hit the
+    // current level once per cell during travel and stash search.
+    level_id last_level_seen;
+    LevelStashes *last_level = nullptr;
+
     int last_corpse_update;
 
     friend class ST_ItemIterator;
@@ -57,6 +57,9 @@ struct game_state
     bool map_stat_dump_disconnect; // Set if we dump disconnected maps and exit
                                    // under mapstat.
     bool obj_stat_gen;      // Set if we're generating object stats.
+    bool gen_bench;         // Set if we're benchmarking level generation.
+    int genbench_p95_ms;    // -genbench gate: max p95 build time per branch.
+    int genbench_veto_percent; // -genbench gate: max veto rate per branch.
 
     string force_map;       // Set if we're forcing a specific map to generate.
 
@@ -73,6 +76,10 @@ struct game_state
     bool test_list;         // Show available tests and exit.
     bool script;            // Set if we want to run a Lua script and exit.
     bool build_db;          // Set if we want to rebuild the db and exit.
+    // With -builddb-des: compile only these .des files' caches (paths
+    // as listed in loadmaps.lua, e.g. "des/branches/dis.des"), so a
+    // packaging step can farm the corpus out to parallel workers.
+    vector<string> build_db_only;
     vector<string> tests_selected; // Tests to be run.
     vector<string> script_args;    // Arguments to scripts.
 
@@ -83,6 +90,9 @@ struct game_state
 
     string sprint_map;      // Sprint map set on command line, if any.
 
+    string keylog_record_file; // -record-keys: log keystrokes to this file.
+    string keylog_replay_file; // -replay-keys: feed keystrokes from this file.
+
     string map;             // Map selected in the newgame menu
 
     void (*terminal_resize_handler)();
@@ -33,6 +33,10 @@
 
 static int duration_index[NUM_DURATIONS];
 
+// Durations that tick down simply over time, in enum order. The set is
+// fixed at compile time, so it only needs building once.
+static vector<duration_type> _simple_durations;
+
 void init_duration_index()
 {
     COMPILE_CHECK(ARRAYSZ(duration_data) == NUM_DURATIONS);
@@ -47,6 +51,18 @@ void init_duration_index()
         ASSERT(duration_index[dur] == -1);
         duration_index[dur] = i;
     }
+
+    _simple_durations.clear();
+    for (int i = 0; i < NUM_DURATIONS; ++i)
+    {
+        if (duration_decrements_normally(static_cast<duration_type>(i)))
+            _simple_durations.push_back(static_cast<duration_type>(i));
+    }
+}
+
+const vector<duration_type> &simple_decrementing_durations()
+{
+    return _simple_durations;
 }
 
 static const duration_def* _lookup_duration(duration_type dur)
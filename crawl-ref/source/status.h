@@ -78,6 +78,9 @@ bool duration_dispellable(duration_type dur);
 void init_duration_index();
 
 bool duration_decrements_normally(duration_type dur);
+// All durations for which duration_decrements_normally() holds, in enum
+// order; lets per-turn processing skip the rest of the table.
+const vector<duration_type> &simple_decrementing_durations();
 const char *duration_end_message(duration_type dur);
 void duration_end_effect(duration_type dur);
 const char *duration_mid_message(duration_type dur);
@@ -221,6 +221,8 @@ enum tag_minor_version
     TAG_MINOR_XP_SCALING,          // scale exp_available and total_experience
     TAG_MINOR_NO_ACTOR_HELD,       // Remove actor.held.
     TAG_MINOR_GOLDIFY_BOOKS,       // Spellbooks disintegrate when picked up, like gold/runes/orbs
+    TAG_MINOR_STASH_SEARCH_CACHE,  // Stashes save their cached search text.
+    TAG_MINOR_FLAT_LEVEL_GRIDS,    // Terrain and grid properties as flat blocks.
 #endif
     NUM_TAG_MINORS,
     TAG_MINOR_VERSION = NUM_TAG_MINORS - 1
@@ -40,6 +40,7 @@
 #endif
 #include "colour.h"
 #include "coordit.h"
+#include "dbg-prof.h"
 #include "dbg-scan.h"
 #include "dbg-util.h"
 #include "describe.h"
@@ -104,7 +105,7 @@ extern set<pair<string, level_id> > auto_unique_annotations;
 extern abyss_state abyssal_state;
 
 reader::reader(const string &_read_filename, int minorVersion)
-    : _filename(_read_filename), _chunk(0), _pbuf(nullptr), _read_offset(0),
+    : _filename(_read_filename), _pbuf(nullptr), _read_offset(0),
       _minorVersion(minorVersion), _safe_read(false)
 {
     _file       = fopen_u(_filename.c_str(), "rb");
@@ -112,17 +113,38 @@ reader::reader(const string &_read_filename, int minorVersion)
 }
 
 reader::reader(package *save, const string &chunkname, int minorVersion)
-    : _file(0), _chunk(0), opened_file(false), _pbuf(0), _read_offset(0),
+    : _file(0), opened_file(false), _pbuf(0), _read_offset(0),
      _minorVersion(minorVersion), _safe_read(false)
 {
     ASSERT(save);
-    _chunk = new chunk_reader(save, chunkname);
+    // Decompress the whole chunk up front and serve reads from memory.
+    // Unmarshalling otherwise issues one zlib inflate call per field,
+    // which dominates load time; reading from a buffer also lets
+    // advance() skip data instead of inflating it.
+    chunk_reader *chunk = new chunk_reader(save, chunkname);
+    try
+    {
+        const size_t block = 64 * 1024;
+        size_t s;
+        do
+        {
+            const size_t at = _chunk_buf.size();
+            _chunk_buf.resize(at + block);
+            s = chunk->read(&_chunk_buf[at], block);
+            _chunk_buf.resize(at + s);
+        } while (s == block);
+    }
+    catch (...)
+    {
+        delete chunk;
+        throw;
+    }
+    delete chunk;
+    _pbuf = &_chunk_buf;
 }
 
 reader::~reader()
 {
-    if (_chunk)
-        delete _chunk;
     close();
 }
 
@@ -135,14 +157,11 @@ void reader::close()
 
 void reader::advance(size_t offset)
 {
-    char junk[128];
-
-    while (offset)
-    {
-        const size_t junklen = min(sizeof(junk), offset);
-        offset -= junklen;
-        read(junk, junklen);
-    }
+    // Files seek and buffers bump their offset; no need to read the
+    // skipped bytes. The map cache relies on this to jump straight to a
+    // map's cache_offset in the .dsc instead of reading everything
+    // before it.
+    read(nullptr, offset);
 }
 
 bool reader::valid() const
@@ -170,13 +189,6 @@ unsigned char reader::readByte()
             _short_read(_safe_read);
         return b;
     }
-    else if (_chunk)
-    {
-        unsigned char buf;
-        if (_chunk->read(&buf, 1) != 1)
-            _short_read(_safe_read);
-        return buf;
-    }
     else
     {
         if (_read_offset >= _pbuf->size())
@@ -197,11 +209,6 @@ void reader::read(void *data, size_t size)
         else
             fseek(_file, (long)size, SEEK_CUR);
     }
-    else if (_chunk)
-    {
-        if (_chunk->read(data, size) != size)
-            _short_read(_safe_read);
-    }
     else
     {
         if (_read_offset+size > _pbuf->size())
@@ -226,13 +233,8 @@ void reader::setMinorVersion(int minorVersion)
 
 void reader::fail_if_not_eof(const string &name)
 {
-    char dummy;
-    if (_chunk ? _chunk->read(&dummy, 1) :
-        _file ? (fgetc(_file) != EOF) :
-        _read_offset >= _pbuf->size())
-    {
+    if (_file ? (fgetc(_file) != EOF) : _read_offset < _pbuf->size())
         fail("Incomplete read of \"%s\" - aborting.", name.c_str());
-    }
 }
 
 void writer::check_ok(bool ok)
@@ -245,13 +247,41 @@ void writer::check_ok(bool ok)
     }
 }
 
+// Serialization produces millions of one- to four-byte writes; calling
+// into zlib's deflate for each of them dominates save time. Chunk
+// output is therefore staged in _cbuf and passed to the chunk_writer
+// (and thus the compressor) in large blocks.
+static const size_t CHUNK_WRITE_BUFFER_SIZE = 64 * 1024;
+
+void writer::flush_chunk()
+{
+    if (!_cbuf.empty())
+    {
+        _chunk->write(&_cbuf[0], _cbuf.size());
+        _cbuf.clear();
+    }
+}
+
+writer::~writer()
+{
+    if (_chunk)
+    {
+        flush_chunk();
+        delete _chunk;
+    }
+}
+
 void writer::writeByte(unsigned char ch)
 {
     if (failed)
         return;
 
     if (_chunk)
-        _chunk->write(&ch, 1);
+    {
+        _cbuf.push_back(ch);
+        if (_cbuf.size() >= CHUNK_WRITE_BUFFER_SIZE)
+            flush_chunk();
+    }
     else if (_file)
         check_ok(fputc(ch, _file) != EOF);
     else
@@ -264,7 +294,12 @@ void writer::write(const void *data, size_t size)
         return;
 
     if (_chunk)
-        _chunk->write(data, size);
+    {
+        const unsigned char* cdata = static_cast<const unsigned char*>(data);
+        _cbuf.insert(_cbuf.end(), cdata, cdata + size);
+        if (_cbuf.size() >= CHUNK_WRITE_BUFFER_SIZE)
+            flush_chunk();
+    }
     else if (_file)
         check_ok(fwrite(data, 1, size, _file) == size);
     else
@@ -1142,6 +1177,8 @@ static void _add_missing_branches()
 // tagId specifies what to write.
 void tag_write(tag_type tagID, writer &outf)
 {
+    PROF_ZONE("tag_write");
+
     vector<unsigned char> buf;
     writer th(&buf);
     switch (tagID)
@@ -1222,6 +1259,8 @@ static void _shunt_monsters_out_of_walls()
 // minorVersion is available for any sub-readers that need it
 void tag_read(reader &inf, tag_type tag_id)
 {
+    PROF_ZONE("tag_read");
+
     // Read header info and data
     vector<unsigned char> buf;
     const int data_size = unmarshallInt(inf);
@@ -1922,6 +1961,7 @@ static void unmarshall_level_map_masks(reader &th)
         env.level_map_mask(*ri) = unmarshallInt(th);
         env.level_map_ids(*ri)  = unmarshallInt(th);
     }
+    abyss_invalidate_turned_to_floor();
 }
 
 static void marshall_level_map_unique_ids(writer &th)
@@ -2365,6 +2405,7 @@ static void tag_read_you(reader &th)
         you.melded.set(i, unmarshallBoolean(th));
     for (int i = count; i < NUM_EQUIP; ++i)
         you.melded.set(i, false);
+    invalidate_equip_property_cache();
 
     you.magic_points              = unmarshallUByte(th);
     you.max_magic_points          = unmarshallByte(th);
@@ -3798,6 +3839,7 @@ static void tag_read_you_items(reader &th)
         for (int j = count2; j < MAX_SUBTYPES; ++j)
             you.type_ids[i][j] = false;
     }
+    reset_ident_bitsets();
 
 #if TAG_MAJOR_VERSION == 34
     if (th.getMinorVersion() < TAG_MINOR_ID_STATES)
@@ -4207,15 +4249,6 @@ static void tag_read_companions(reader &th)
                   unmarshall_companion);
 }
 
-template <typename Z>
-static int _last_used_index(const Z &thinglist, int max_things)
-{
-    for (int i = max_things - 1; i >= 0; --i)
-        if (thinglist[i].defined())
-            return i + 1;
-    return 0;
-}
-
 // ------------------------------- level tags ---------------------------- //
 
 static void tag_construct_level(writer &th)
@@ -4236,13 +4269,39 @@ static void tag_construct_level(writer &th)
 
     CANARY;
 
+    // The terrain grid, map knowledge and grid properties used to be
+    // interleaved cell by cell. They're written as three flat blocks
+    // now, so the terrain bytes and the property flags go out with one
+    // write each, with endianness handled per block instead of per
+    // field. Map knowledge keeps field marshalling: its cells carry
+    // item, monster and cloud info of varying shape.
+    {
+        uint8_t feats[GXM * GYM];
+        for (int x = 0; x < GXM; x++)
+            for (int y = 0; y < GYM; y++)
+                feats[x * GYM + y] = static_cast<uint8_t>(grd[x][y]);
+        th.write(feats, sizeof(feats));
+    }
+
     for (int count_x = 0; count_x < GXM; count_x++)
         for (int count_y = 0; count_y < GYM; count_y++)
-        {
-            marshallByte(th, grd[count_x][count_y]);
             marshallMapCell(th, env.map_knowledge[count_x][count_y]);
-            marshallInt(th, env.pgrid[count_x][count_y].flags);
-        }
+
+    {
+        uint8_t props[GXM * GYM * 4];
+        uint8_t *out = props;
+        for (int x = 0; x < GXM; x++)
+            for (int y = 0; y < GYM; y++)
+            {
+                // Network order, matching marshallInt.
+                const uint32_t fl = env.pgrid[x][y].flags;
+                *out++ = (fl >> 24) & 0xff;
+                *out++ = (fl >> 16) & 0xff;
+                *out++ = (fl >> 8) & 0xff;
+                *out++ = fl & 0xff;
+            }
+        th.write(props, sizeof(props));
+    }
 
     marshallBoolean(th, !!env.map_forgotten.get());
     if (env.map_forgotten.get())
@@ -5068,6 +5127,33 @@ void unmarshallMapCell(reader &th, map_cell& cell)
     cell.flags = cell_flags;
 }
 
+// Level saves renumber live items and monsters densely, dropping the
+// dead slots that accumulate over a level's life. The renumbering maps
+// are shared between the item and monster writers because each array
+// stores indices into the other: an item held by a monster keeps its
+// holder's index in its link field, and monster inventories hold mitm
+// indices. Everything else either uses mids or is rebuilt on load
+// (mgrd from monster positions, igrd and floor stack links by
+// link_items()), so the renumbering never touches the live arrays --
+// the affected fields are rewritten on copies as they are marshalled.
+static vector<int> _mitm_compact;
+static vector<int> _menv_compact;
+
+static void _build_level_compaction_maps()
+{
+    _mitm_compact.assign(MAX_ITEMS, NON_ITEM);
+    int n = 0;
+    for (int i = 0; i < MAX_ITEMS; ++i)
+        if (mitm[i].defined())
+            _mitm_compact[i] = n++;
+
+    _menv_compact.assign(MAX_MONSTERS, NON_MONSTER);
+    n = 0;
+    for (int i = 0; i < MAX_MONSTERS; ++i)
+        if (menv[i].alive())
+            _menv_compact[i] = n++;
+}
+
 static void tag_construct_level_items(writer &th)
 {
     // how many traps?
@@ -5081,11 +5167,32 @@ static void tag_construct_level_items(writer &th)
         marshallUByte(th, trap.skill_rnd);
     }
 
-    // how many items?
-    const int ni = _last_used_index(mitm, MAX_ITEMS);
+    _build_level_compaction_maps();
+
+    // how many items? Live ones only; the holes between them aren't
+    // written at all.
+    int ni = 0;
+    for (int i = 0; i < MAX_ITEMS; ++i)
+        if (mitm[i].defined())
+            ni++;
     marshallShort(th, ni);
-    for (int i = 0; i < ni; ++i)
-        marshallItem(th, mitm[i]);
+    for (int i = 0; i < MAX_ITEMS; ++i)
+    {
+        if (!mitm[i].defined())
+            continue;
+        if (mitm[i].held_by_monster())
+        {
+            // The link field holds the index of the holding monster,
+            // which the monster writer below is about to renumber.
+            item_def item = mitm[i];
+            const int holder = _menv_compact[item.link - NON_ITEM - 1];
+            item.link = holder == NON_MONSTER ? NON_ITEM
+                                              : NON_ITEM + 1 + holder;
+            marshallItem(th, item);
+        }
+        else
+            marshallItem(th, mitm[i]);
+    }
 }
 
 static void marshall_mon_enchant(writer &th, const mon_enchant &me)
@@ -5579,33 +5686,51 @@ static void tag_construct_level_monsters(writer &th)
     for (int i = 0; i < nm; ++i)
         marshallShort(th, env.mons_alloc[i]);
 
-    // how many monsters?
-    nm = _last_used_index(menv, MAX_MONSTERS);
+    // how many monsters? Live ones only; the dead slots between them
+    // aren't written at all.
+    nm = 0;
+    for (int i = 0; i < MAX_MONSTERS; ++i)
+        if (menv[i].alive())
+            nm++;
     marshallShort(th, nm);
 
-    for (int i = 0; i < nm; i++)
+    for (int i = 0; i < MAX_MONSTERS; i++)
     {
-        monster& m(menv[i]);
+        if (!menv[i].alive())
+            continue;
+
+        // The two kinds of raw slot index a monster carries -- its
+        // inventory's mitm indices and its foe -- are rewritten on a
+        // copy to match the dense renumbering.
+        monster m(menv[i]);
+        for (int j = 0; j < NUM_MONSTER_SLOTS; ++j)
+            if (m.inv[j] != NON_ITEM)
+                m.inv[j] = _mitm_compact[m.inv[j]];
+        if (m.foe < MAX_MONSTERS)
+        {
+            const int foe = _menv_compact[m.foe];
+            m.foe = foe == NON_MONSTER ? MHITNOT : foe;
+        }
 
 #if defined(DEBUG) || defined(DEBUG_MONS_SCAN)
-        if (m.type != MONS_NO_MONSTER)
+        if (invalid_monster_type(m.type))
         {
-            if (invalid_monster_type(m.type))
-            {
-                mprf(MSGCH_ERROR, "Marshalled monster #%d %s",
-                     i, m.name(DESC_PLAIN, true).c_str());
-            }
-            if (!in_bounds(m.pos()))
-            {
-                mprf(MSGCH_ERROR,
-                     "Marshalled monster #%d %s out of bounds at (%d, %d)",
-                     i, m.name(DESC_PLAIN, true).c_str(),
-                     m.pos().x, m.pos().y);
-            }
+            mprf(MSGCH_ERROR, "Marshalled monster #%d %s",
+                 i, m.name(DESC_PLAIN, true).c_str());
+        }
+        if (!in_bounds(m.pos()))
+        {
+            mprf(MSGCH_ERROR,
+                 "Marshalled monster #%d %s out of bounds at (%d, %d)",
+                 i, m.name(DESC_PLAIN, true).c_str(),
+                 m.pos().x, m.pos().y);
         }
 #endif
         marshallMonster(th, m);
     }
+
+    _mitm_compact.clear();
+    _menv_compact.clear();
 }
 
 void tag_construct_level_tiles(writer &th)
@@ -5678,33 +5803,80 @@ static void tag_read_level(reader &th)
     env.map_seen.reset();
 #if TAG_MAJOR_VERSION == 34
     vector<coord_def> transporters;
+    if (th.getMinorVersion() < TAG_MINOR_FLAT_LEVEL_GRIDS)
+    {
+        for (int i = 0; i < gx; i++)
+            for (int j = 0; j < gy; j++)
+            {
+                dungeon_feature_type feat = unmarshallFeatureType(th);
+                grd[i][j] = feat;
+                ASSERT(feat < NUM_FEATURES);
+
+                // Save these for potential destination clean up.
+                if (grd[i][j] == DNGN_TRANSPORTER)
+                    transporters.push_back(coord_def(i, j));
+                unmarshallMapCell(th, env.map_knowledge[i][j]);
+                // Fixup positions
+                if (env.map_knowledge[i][j].monsterinfo())
+                    env.map_knowledge[i][j].monsterinfo()->pos = coord_def(i, j);
+                if (env.map_knowledge[i][j].cloudinfo())
+                    env.map_knowledge[i][j].cloudinfo()->pos = coord_def(i, j);
+
+                env.map_knowledge[i][j].flags &= ~MAP_VISIBLE_FLAG;
+                if (env.map_knowledge[i][j].seen())
+                    env.map_seen.set(i, j);
+                env.pgrid[i][j].flags = unmarshallInt(th);
+
+                mgrd[i][j] = NON_MONSTER;
+            }
+    }
+    else
 #endif
-    for (int i = 0; i < gx; i++)
-        for (int j = 0; j < gy; j++)
-        {
-            dungeon_feature_type feat = unmarshallFeatureType(th);
-            grd[i][j] = feat;
-            ASSERT(feat < NUM_FEATURES);
-
-#if TAG_MAJOR_VERSION == 34
-            // Save these for potential destination clean up.
-            if (grd[i][j] == DNGN_TRANSPORTER)
-                transporters.push_back(coord_def(i, j));
-#endif
-            unmarshallMapCell(th, env.map_knowledge[i][j]);
-            // Fixup positions
-            if (env.map_knowledge[i][j].monsterinfo())
-                env.map_knowledge[i][j].monsterinfo()->pos = coord_def(i, j);
-            if (env.map_knowledge[i][j].cloudinfo())
-                env.map_knowledge[i][j].cloudinfo()->pos = coord_def(i, j);
+    {
+        // Flat-block layout: terrain bytes, then map knowledge, then
+        // grid property flags. The feature conversions handled by
+        // unmarshallFeatureType all predate this layout.
+        uint8_t feats[GXM * GYM];
+        th.read(feats, sizeof(feats));
+        for (int i = 0; i < gx; i++)
+            for (int j = 0; j < gy; j++)
+            {
+                const dungeon_feature_type feat =
+                    static_cast<dungeon_feature_type>(feats[i * GYM + j]);
+                ASSERT(feat < NUM_FEATURES);
+                grd[i][j] = feat;
+            }
 
-            env.map_knowledge[i][j].flags &= ~MAP_VISIBLE_FLAG;
-            if (env.map_knowledge[i][j].seen())
-                env.map_seen.set(i, j);
-            env.pgrid[i][j].flags = unmarshallInt(th);
+        for (int i = 0; i < gx; i++)
+            for (int j = 0; j < gy; j++)
+            {
+                unmarshallMapCell(th, env.map_knowledge[i][j]);
+                // Fixup positions
+                if (env.map_knowledge[i][j].monsterinfo())
+                    env.map_knowledge[i][j].monsterinfo()->pos = coord_def(i, j);
+                if (env.map_knowledge[i][j].cloudinfo())
+                    env.map_knowledge[i][j].cloudinfo()->pos = coord_def(i, j);
+
+                env.map_knowledge[i][j].flags &= ~MAP_VISIBLE_FLAG;
+                if (env.map_knowledge[i][j].seen())
+                    env.map_seen.set(i, j);
+
+                mgrd[i][j] = NON_MONSTER;
+            }
 
-            mgrd[i][j] = NON_MONSTER;
-        }
+        uint8_t props[GXM * GYM * 4];
+        th.read(props, sizeof(props));
+        const uint8_t *in = props;
+        for (int i = 0; i < gx; i++)
+            for (int j = 0; j < gy; j++)
+            {
+                env.pgrid[i][j].flags = (uint32_t(in[0]) << 24)
+                                      | (uint32_t(in[1]) << 16)
+                                      | (uint32_t(in[2]) << 8)
+                                      |  uint32_t(in[3]);
+                in += 4;
+            }
+    }
 
 #if TAG_MAJOR_VERSION == 34
     if (th.getMinorVersion() < TAG_MINOR_FORGOTTEN_MAP)
@@ -5766,6 +5938,7 @@ static void tag_read_level(reader &th)
 #endif
             env.cloud[cloud.pos] = cloud;
     }
+    reload_cloud_grid();
 
     EAT_CANARY;
 
@@ -6413,11 +6586,17 @@ static void tag_read_level_monsters(reader &th)
     count = unmarshallShort(th);
     ASSERT_RANGE(count, 0, MAX_MONSTERS + 1);
 
+    // These slots are written directly, without get_free_monster().
+    env.mons_slot_watermark = count;
+
     for (int i = 0; i < count; i++)
     {
         monster& m = menv[i];
         unmarshallMonster(th, m);
 
+        if (m.type != MONS_NO_MONSTER)
+            env.mons_occupied.set(i);
+
         // place monster
         if (!m.alive())
             continue;
@@ -52,7 +52,7 @@ public:
         _chunk = save->writer(chunkname);
     }
 
-    ~writer() { if (_chunk) delete _chunk; }
+    ~writer();
 
     void writeByte(unsigned char byte);
     void write(const void *data, size_t size);
@@ -62,6 +62,7 @@ public:
 
 private:
     void check_ok(bool ok);
+    void flush_chunk();
 
 private:
     string _filename;
@@ -70,6 +71,9 @@ private:
     bool _ignore_errors;
 
     vector<unsigned char>* _pbuf;
+    // Pending output for _chunk, handed to the compressor in large
+    // blocks rather than one marshalled field at a time.
+    vector<unsigned char> _cbuf;
 
     bool failed;
 };
@@ -98,11 +102,11 @@ class reader
 public:
     reader(const string &filename, int minorVersion = TAG_MINOR_INVALID);
     reader(FILE* input, int minorVersion = TAG_MINOR_INVALID)
-        : _file(input), _chunk(0), opened_file(false), _pbuf(0),
+        : _file(input), opened_file(false), _pbuf(0),
           _read_offset(0), _minorVersion(minorVersion), _safe_read(false) {}
     reader(const vector<unsigned char>& input,
            int minorVersion = TAG_MINOR_INVALID)
-        : _file(0), _chunk(0), opened_file(false), _pbuf(&input),
+        : _file(0), opened_file(false), _pbuf(&input),
           _read_offset(0), _minorVersion(minorVersion), _safe_read(false) {}
     reader(package *save, const string &chunkname,
            int minorVersion = TAG_MINOR_INVALID);
@@ -124,9 +128,11 @@ public:
 private:
     string _filename;
     FILE* _file;
-    chunk_reader *_chunk;
     bool  opened_file;
     const vector<unsigned char>* _pbuf;
+    // Owns the decompressed content of a package chunk; _pbuf points
+    // here for chunk-backed readers.
+    vector<unsigned char> _chunk_buf;
     unsigned int _read_offset;
     int _minorVersion;
     // always throw an exception rather than dying when reading past EOF
@@ -97,12 +97,25 @@ bool targeter_beam::set_aim(coord_def a)
     if (!targeter::set_aim(a))
         return false;
 
-    bolt tempbeam = beam;
+    // The targeting UI re-aims on every cursor key, and the map can't
+    // change while it's up, so a cell's tracer path is good for the
+    // life of the targeter; cursoring back and forth across a fight
+    // only fires the tracer for cells not yet probed. The explosion
+    // maps are rebuilt from the path either way — they're derived
+    // deterministically from it and much cheaper than the tracer.
+    auto cached = path_cache.find(aim);
+    if (cached != path_cache.end())
+        path_taken = cached->second;
+    else
+    {
+        bolt tempbeam = beam;
 
-    tempbeam.target = aim;
-    tempbeam.path_taken.clear();
-    tempbeam.fire();
-    path_taken = tempbeam.path_taken;
+        tempbeam.target = aim;
+        tempbeam.path_taken.clear();
+        tempbeam.fire();
+        path_taken = tempbeam.path_taken;
+        path_cache[aim] = path_taken;
+    }
 
     if (max_expl_rad > 0)
         set_explosion_aim(beam);
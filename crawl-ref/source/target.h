@@ -59,6 +59,7 @@ private:
     bool penetrates_targets;
     int range;
     explosion_map exp_map_min, exp_map_max;
+    map<coord_def, vector<coord_def>> path_cache;
 };
 
 class targeter_unravelling : public targeter_beam
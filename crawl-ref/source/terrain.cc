@@ -11,6 +11,7 @@
 #include <functional>
 #include <sstream>
 
+#include "abyss.h"
 #include "areas.h"
 #include "branch.h"
 #include "cloud.h"
@@ -21,6 +22,7 @@
 #include "directn.h"
 #include "dungeon.h"
 #include "env.h"
+#include "exclude.h"
 #include "fight.h"
 #include "feature.h"
 #include "fprop.h"
@@ -59,7 +61,15 @@ actor* actor_at(const coord_def& c)
         return nullptr;
     if (c == you.pos())
         return &you;
-    return monster_at(c);
+
+    // Probe the monster grid directly rather than through
+    // monster_at(), which re-checks the bounds we just checked; beam
+    // traversal and cloud application call this per cell.
+    const int mindex = mgrd(c);
+    if (mindex == NON_MONSTER)
+        return nullptr;
+    ASSERT(mindex <= MAX_MONSTERS);
+    return &menv[mindex];
 }
 
 /** Can a malign gateway be placed on this feature?
@@ -69,11 +79,76 @@ bool feat_is_malign_gateway_suitable(dungeon_feature_type feat)
     return feat == DNGN_FLOOR || feat == DNGN_SHALLOW_WATER;
 }
 
+// Packed per-feature category bits. The broad category predicates
+// below are called per cell in grid-scale passes (travel's floodfill,
+// LOS recomputation, minimap classification), and each call re-walks
+// the feature table through get_feature_def() or a chain of compares;
+// the bits turn those into one load from a cache-resident table. Built
+// lazily on the first query, after the feature table is initialised.
+enum feat_category_flag
+{
+    FCAT_WALL   = 1 << 0,
+    FCAT_SOLID  = 1 << 1,
+    FCAT_OPAQUE = 1 << 2,
+    FCAT_WATER  = 1 << 3,
+    FCAT_LAVA   = 1 << 4,
+    FCAT_STAIR  = 1 << 5,
+};
+
+static uint8_t _feat_categories[NUM_FEATURES];
+static bool _feat_categories_built = false;
+
+static void _build_feat_categories()
+{
+    for (int i = 0; i < NUM_FEATURES; i++)
+    {
+        const dungeon_feature_type feat =
+            static_cast<dungeon_feature_type>(i);
+        uint8_t bits = 0;
+        if (is_valid_feature_type(feat))
+        {
+            const feature_def &fdef = get_feature_def(feat);
+            if (fdef.flags & FFT_WALL)
+                bits |= FCAT_WALL;
+            if (fdef.flags & FFT_SOLID)
+                bits |= FCAT_SOLID;
+            if (fdef.flags & FFT_OPAQUE)
+                bits |= FCAT_OPAQUE;
+        }
+        if (feat == DNGN_SHALLOW_WATER || feat == DNGN_DEEP_WATER
+            || feat == DNGN_OPEN_SEA)
+        {
+            bits |= FCAT_WATER;
+        }
+        if (feat == DNGN_LAVA || feat == DNGN_LAVA_SEA)
+            bits |= FCAT_LAVA;
+        if (feat_is_travelable_stair(feat) || feat_is_gate(feat))
+            bits |= FCAT_STAIR;
+        _feat_categories[i] = bits;
+    }
+    _feat_categories_built = true;
+}
+
+static inline bool _feat_category(dungeon_feature_type feat,
+                                  feat_category_flag flag)
+{
+    if (!_feat_categories_built)
+        _build_feat_categories();
+    return _feat_categories[feat] & flag;
+}
+
+// Invalidate the category bits; called whenever init_show_table()
+// (re)builds the feature table the bits are derived from.
+void reset_feat_category_cache()
+{
+    _feat_categories_built = false;
+}
+
 /** Is this feature a type of wall?
  */
 bool feat_is_wall(dungeon_feature_type feat)
 {
-    return get_feature_def(feat).flags & FFT_WALL;
+    return _feat_category(feat, FCAT_WALL);
 }
 
 /** Is this feature one of the main stone downstairs of a level?
@@ -241,7 +316,7 @@ bool feat_is_portal(dungeon_feature_type feat)
  */
 bool feat_is_stair(dungeon_feature_type gridc)
 {
-    return feat_is_travelable_stair(gridc) || feat_is_gate(gridc);
+    return _feat_category(gridc, FCAT_STAIR);
 }
 
 /** Is this feature a level exit stair with a consistent endpoint?
@@ -358,14 +433,14 @@ command_type feat_stair_direction(dungeon_feature_type feat)
  */
 bool feat_is_opaque(dungeon_feature_type feat)
 {
-    return get_feature_def(feat).flags & FFT_OPAQUE;
+    return _feat_category(feat, FCAT_OPAQUE);
 }
 
 /** Can you move into this feature in normal play?
  */
 bool feat_is_solid(dungeon_feature_type feat)
 {
-    return get_feature_def(feat).flags & FFT_SOLID;
+    return _feat_category(feat, FCAT_SOLID);
 }
 
 /** Can you wall jump against this feature? (Wu Jian)?
@@ -475,9 +550,7 @@ bool feat_is_trap(dungeon_feature_type feat, bool undiscovered_too)
  */
 bool feat_is_water(dungeon_feature_type feat)
 {
-    return feat == DNGN_SHALLOW_WATER
-           || feat == DNGN_DEEP_WATER
-           || feat == DNGN_OPEN_SEA;
+    return _feat_category(feat, FCAT_WATER);
 }
 
 /** Does this feature have enough water to keep water-only monsters alive in it?
@@ -491,7 +564,7 @@ bool feat_is_watery(dungeon_feature_type feat)
  */
 bool feat_is_lava(dungeon_feature_type feat)
 {
-    return feat == DNGN_LAVA || feat == DNGN_LAVA_SEA;
+    return _feat_category(feat, FCAT_LAVA);
 }
 
 static const pair<god_type, dungeon_feature_type> _god_altars[] =
@@ -1189,6 +1262,27 @@ static void _dgn_check_terrain_player(const coord_def pos)
  *                          & shouldn't check whether the player can actually
  *                          exist in the new feature.
  */
+// See terrain_change_batch in terrain.h: bulk terrain changers open a
+// batch so the coalescable downstream updates run once per batch
+// rather than once per cell. LOS proper already defers its own
+// updates, and dungeon_events listeners still see every cell.
+static int _terrain_batch_depth = 0;
+static vector<coord_def> _terrain_batch_cells;
+
+terrain_change_batch::terrain_change_batch()
+{
+    _terrain_batch_depth++;
+}
+
+terrain_change_batch::~terrain_change_batch()
+{
+    if (--_terrain_batch_depth == 0 && !_terrain_batch_cells.empty())
+    {
+        update_exclusion_los(_terrain_batch_cells);
+        _terrain_batch_cells.clear();
+    }
+}
+
 void dungeon_terrain_changed(const coord_def &pos,
                              dungeon_feature_type nfeat,
                              bool preserve_features,
@@ -1199,6 +1293,10 @@ void dungeon_terrain_changed(const coord_def &pos,
     if (grd(pos) == nfeat)
         return;
 
+    // Stash records include the feature, so a feature change must force
+    // the stash tracker to revisit this cell.
+    note_item_grid_change(pos);
+
     _dgn_check_terrain_covering(pos, grd(pos), nfeat);
 
     if (nfeat != DNGN_UNSEEN)
@@ -1231,6 +1329,15 @@ void dungeon_terrain_changed(const coord_def &pos,
 
     set_terrain_changed(pos);
 
+    // Exclusion LOS can depend on this cell's opacity even before the
+    // player sees the change; repair just the circles it intersects.
+    // Inside a batch, queue the cell so all intersected circles are
+    // repaired in one pass when the batch closes.
+    if (_terrain_batch_depth)
+        _terrain_batch_cells.push_back(pos);
+    else
+        update_exclusion_los({pos});
+
     // Deal with doors being created by changing features.
     tile_init_flavour(pos);
 }
@@ -1820,6 +1927,7 @@ void destroy_wall(const coord_def& p)
     remove_mold(p);
 
     _revert_terrain_to_floor(p);
+    abyss_note_turned_to_floor(p);
     env.level_map_mask(p) |= MMT_TURNED_TO_FLOOR;
 }
 
@@ -1953,6 +2061,7 @@ void set_terrain_changed(const coord_def p)
     dungeon_events.fire_position_event(DET_FEAT_CHANGE, p);
 
     los_terrain_changed(p);
+    travel_safety_changed(p);
 
     for (orth_adjacent_iterator ai(p); ai; ++ai)
         if (actor *act = actor_at(*ai))
@@ -28,7 +28,22 @@ private:
     bool did_compute_mask;
 };
 
-actor* actor_at(const coord_def& c);
+// While one of these is live, dungeon_terrain_changed() collects the
+// changed cells and delivers the derived-structure updates that can be
+// coalesced (currently exclusion LOS repair) in a single pass when the
+// outermost batch closes, instead of once per cell. Use around bulk
+// terrain changes such as Shatter, tides and abyss morphing; nesting
+// is fine.
+class terrain_change_batch
+{
+public:
+    terrain_change_batch();
+    ~terrain_change_batch();
+};
+
+// Pure: reads only the actor grids, so repeated lookups of the same
+// cell between actor movements can be folded by the compiler.
+actor* actor_at(const coord_def& c) PURE;
 
 bool cell_is_solid(const coord_def &c);
 
@@ -128,6 +143,7 @@ bool slide_feature_over(const coord_def &src,
 
 void fall_into_a_pool(dungeon_feature_type terrain);
 
+void                 reset_feat_category_cache();
 void                 init_feat_desc_cache();
 dungeon_feature_type feat_by_desc(string desc);
 const char* feat_type_name(dungeon_feature_type feat);
@@ -0,0 +1,16 @@
+-- Autoexplore throughput benchmark: explores a few fresh Dungeon levels
+-- to completion through the real explore loop. Step counts and
+-- steps/second land in the message log; DEBUG_PROF builds also report
+-- cumulative time in travel_pathfind, losight and stash_tracking, which
+-- is what makes travel-cache changes verifiable.
+local nlevels = 3
+
+for depth = 1, nlevels do
+  local place = "D:" .. depth
+  crawl.message("Explore benchmark on " .. place)
+  crawl.delay(0)
+  debug.goto_place(place)
+  debug.flush_map_memory()
+  debug.generate_level()
+  debug.test_explore()
+end
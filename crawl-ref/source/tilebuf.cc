@@ -299,6 +299,11 @@ void ShapeBuffer::add(float pos_sx, float pos_sy, float pos_ex, float pos_ey,
     add_primitive(rect);
 }
 
+void ShapeBuffer::set_colour(int index, const VColour &col)
+{
+    m_vert_buf->set_rect_colour(index, col);
+}
+
 /////////////////////////////////////////////////////////////////////////////
 // LineBuffer
 
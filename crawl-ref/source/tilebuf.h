@@ -108,6 +108,8 @@ class ShapeBuffer : public VertBuffer
 public:
     ShapeBuffer();
     void add(float sx, float sy, float ex, float ey, const VColour &c);
+    // Recolour the index-th rectangle added since the last clear().
+    void set_colour(int index, const VColour &c);
 };
 
 class LineBuffer : public VertBuffer
@@ -478,7 +478,38 @@ bool is_door_tile(tileidx_t tile)
         tile < TILE_DNGN_STONE_ARCH;
 }
 
-tileidx_t tileidx_feature(const coord_def &gc)
+// Per-level memo for tileidx_feature. Resolving a feature tile chases a
+// long chain of branches over inputs that rarely change, and it runs for
+// every cell on every map update, so remember the last result per cell
+// together with the state it was derived from. A key mismatch simply
+// recomputes; per-level state (branch, env.floor_colour) is handled by
+// clearing the table from tile_new_level.
+struct _feat_tile_memo
+{
+    uint64_t key;
+    tileidx_t tile;
+};
+static _feat_tile_memo _feat_memo[GXM][GYM];
+
+static uint64_t _feat_memo_key(const coord_def &gc)
+{
+    const map_cell &cell = env.map_knowledge(gc);
+    // Bit 63 is always set so an empty (zeroed) slot can never match.
+    return (uint64_t)cell.feat()
+           | (uint64_t)cell.feat_colour() << 8
+           | (uint64_t)(uint8_t)cell.trap() << 20
+           | (cell.invisible_monster() ? (uint64_t)1 << 28 : 0)
+           | (uint64_t)env.tile_flv(gc).feat << 29
+           | (uint64_t)1 << 63;
+}
+
+void tile_invalidate_feature_memo()
+{
+    memset(_feat_memo, 0, sizeof(_feat_memo));
+}
+
+static tileidx_t _tileidx_feature_uncached(const coord_def &gc,
+                                           bool &cacheable)
 {
     dungeon_feature_type feat = env.map_knowledge(gc).feat();
 
@@ -500,6 +531,8 @@ tileidx_t tileidx_feature(const coord_def &gc)
             || player_in_branch(BRANCH_TEMPLE)
             || player_in_branch(BRANCH_LAIR))
         {
+            // Depends on neighbouring cells the memo key doesn't cover.
+            cacheable = false;
             bool slimy = false;
             for (adjacent_iterator ai(gc); ai; ++ai)
             {
@@ -528,6 +561,8 @@ tileidx_t tileidx_feature(const coord_def &gc)
         }
         if (colour >= ETC_FIRST)
         {
+            // Elemental colours are resolved per redraw.
+            cacheable = false;
             tileidx_t idx = (feat == DNGN_FLOOR) ? env.tile_flv(gc).floor :
                 (feat == DNGN_ROCK_WALL) ? env.tile_flv(gc).wall
                 : tileidx_feature_base(feat);
@@ -556,6 +591,9 @@ tileidx_t tileidx_feature(const coord_def &gc)
         // There's room here to have different types of webs (acid? fire? ice? different strengths?)
         if (this_trap_type==TRAP_WEB) {*/
 
+        // Depends on neighbouring cells the memo key doesn't cover.
+        cacheable = false;
+
         // Determine web connectivity on all sides
         const coord_def neigh[4] =
         {
@@ -612,6 +650,23 @@ tileidx_t tileidx_feature(const coord_def &gc)
     }
 }
 
+tileidx_t tileidx_feature(const coord_def &gc)
+{
+    const uint64_t key = _feat_memo_key(gc);
+    _feat_tile_memo &memo = _feat_memo[gc.x][gc.y];
+    if (memo.key == key)
+        return memo.tile;
+
+    bool cacheable = true;
+    const tileidx_t tile = _tileidx_feature_uncached(gc, cacheable);
+    if (cacheable)
+    {
+        memo.key  = key;
+        memo.tile = tile;
+    }
+    return tile;
+}
+
 static tileidx_t _mon_random(tileidx_t tile)
 {
     int count = tile_player_count(tile);
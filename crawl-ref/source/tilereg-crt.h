@@ -24,6 +24,7 @@ public:
     virtual ~CRTRegion();
 
     virtual void render() override;
+    virtual const char *profile_name() const override { return "crt"; }
     virtual void clear() override;
 
     virtual int handle_mouse(MouseEvent& event) override;
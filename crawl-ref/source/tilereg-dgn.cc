@@ -39,6 +39,7 @@
 #include "tilefont.h"
 #include "tilepick.h"
 #include "tiles-build-specific.h"
+#include "tileview.h"
 #include "traps.h"
 #include "travel.h"
 #include "viewgeom.h"
@@ -67,6 +68,7 @@ DungeonRegion::DungeonRegion(const TileRegionInit &init) :
     TileRegion(init),
     m_cx_to_gx(0),
     m_cy_to_gy(0),
+    m_has_animations(false),
     m_last_clicked_grid(coord_def()),
     m_buf_dngn(init.im)
 {
@@ -81,6 +83,15 @@ DungeonRegion::~DungeonRegion()
 void DungeonRegion::load_dungeon(const crawl_view_buffer &vbuf,
                                  const coord_def &gc)
 {
+    // If the newly derived view matches what is already packed into the
+    // tile buffers, keep them: render() can then redraw the frame
+    // without rebuilding and re-uploading every quad in the viewport.
+    if (!m_dirty && gc.x - mx / 2 == m_cx_to_gx && gc.y - my / 2 == m_cy_to_gy
+        && vbuf == m_vbuf)
+    {
+        return;
+    }
+
     m_dirty = true;
 
     m_cx_to_gx = gc.x - mx / 2;
@@ -88,6 +99,15 @@ void DungeonRegion::load_dungeon(const crawl_view_buffer &vbuf,
 
     m_vbuf = vbuf;
 
+    m_has_animations = false;
+    const screen_cell_t *cell = m_vbuf;
+    for (int i = m_vbuf.size().x * m_vbuf.size().y; i > 0; i--, cell++)
+        if (tile_cell_animated(cell->tile.bg))
+        {
+            m_has_animations = true;
+            break;
+        }
+
     place_cursor(CURSOR_TUTORIAL, m_cursor[CURSOR_TUTORIAL]);
 }
 
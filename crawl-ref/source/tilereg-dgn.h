@@ -27,6 +27,7 @@ public:
     virtual ~DungeonRegion();
 
     virtual void render() override;
+    virtual const char *profile_name() const override { return "dungeon"; }
     virtual void clear() override;
     virtual int handle_mouse(MouseEvent &event) override;
     virtual bool update_tip_text(string &tip) override;
@@ -48,6 +49,9 @@ public:
     void clear_overlays();
     void zoom(bool in);
 
+    // Does the loaded view contain any cells with animated flavours?
+    bool has_animations() const { return m_has_animations; }
+
     int tile_iw, tile_ih;
 
 protected:
@@ -60,6 +64,7 @@ protected:
     void to_screen_coords(const coord_def &gc, coord_def *pc) const;
 
     crawl_view_buffer m_vbuf;
+    bool m_has_animations;
     int m_cx_to_gx;
     int m_cy_to_gy;
     coord_def m_cursor[CURSOR_MAX];
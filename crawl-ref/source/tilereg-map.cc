@@ -18,6 +18,7 @@
 MapRegion::MapRegion(int pixsz) :
     m_buf(nullptr),
     m_dirty(true),
+    m_dirty_window(true),
     m_far_view(false)
 {
     ASSERT(pixsz > 0);
@@ -35,6 +36,7 @@ void MapRegion::on_resize()
     int size = mx * my;
     m_buf    = new unsigned char[size];
     memset(m_buf, 0, sizeof(unsigned char) * size);
+    m_dirty  = true;
 }
 
 void MapRegion::init_colours()
@@ -78,7 +80,6 @@ MapRegion::~MapRegion()
 void MapRegion::pack_buffers()
 {
     m_buf_map.clear();
-    m_buf_lines.clear();
 
     for (int x = m_min_gx; x <= m_max_gx; x++)
         for (int y = m_min_gy; y <= m_max_gy; y++)
@@ -90,6 +91,13 @@ void MapRegion::pack_buffers()
             m_buf_map.add(pos_x, pos_y, pos_x + 1, pos_y + 1, m_colours[f]);
         }
 
+    pack_window_buffer();
+}
+
+void MapRegion::pack_window_buffer()
+{
+    m_buf_lines.clear();
+
     // Draw window box.
     if (m_win_start.x == -1 && m_win_end.x == -1)
         return;
@@ -115,6 +123,12 @@ void MapRegion::render()
     {
         pack_buffers();
         m_dirty = false;
+        m_dirty_window = false;
+    }
+    else if (m_dirty_window)
+    {
+        pack_window_buffer();
+        m_dirty_window = false;
     }
 
     set_transform();
@@ -136,6 +150,19 @@ void MapRegion::set(const coord_def &gc, map_feature f)
     ASSERT((unsigned int)f <= (unsigned char)~0);
     m_buf[gc.x + gc.y * mx] = f;
 
+    // A cell inside the packed extents maps onto an existing quad, so
+    // recolour it in place instead of rebuilding the whole buffer; the
+    // pack order below is x-major.
+    if (!m_dirty
+        && gc.x >= m_min_gx && gc.x <= m_max_gx
+        && gc.y >= m_min_gy && gc.y <= m_max_gy)
+    {
+        const int stride = m_max_gy - m_min_gy + 1;
+        m_buf_map.set_colour((gc.x - m_min_gx) * stride + (gc.y - m_min_gy),
+                             m_colours[f]);
+        return;
+    }
+
     if (f == MF_UNSEEN)
         return;
 
@@ -146,6 +173,7 @@ void MapRegion::set(const coord_def &gc, map_feature f)
     m_max_gy = max(m_max_gy, gc.y);
 
     recenter();
+    m_dirty = true;
 }
 
 void MapRegion::update_bounds()
@@ -174,6 +202,7 @@ void MapRegion::update_bounds()
         }
 
     recenter();
+    m_dirty = true;
 }
 
 void MapRegion::set_window(const coord_def &start, const coord_def &end)
@@ -181,7 +210,7 @@ void MapRegion::set_window(const coord_def &start, const coord_def &end)
     m_win_start = start;
     m_win_end   = end;
 
-    m_dirty = true;
+    m_dirty_window = true;
 }
 
 void MapRegion::clear()
@@ -203,6 +232,7 @@ void MapRegion::clear()
 
     m_buf_map.clear();
     m_buf_lines.clear();
+    m_dirty = true;
 }
 
 int MapRegion::handle_mouse(MouseEvent &event)
@@ -12,6 +12,7 @@ public:
     ~MapRegion();
 
     virtual void render() override;
+    virtual const char *profile_name() const override { return "map"; }
     virtual void clear() override;
     virtual int handle_mouse(MouseEvent &event) override;
     virtual bool update_tip_text(string &tip) override;
@@ -25,6 +26,7 @@ protected:
     virtual void on_resize() override;
     void recenter();
     void pack_buffers();
+    void pack_window_buffer();
 
     VColour m_colours[MF_MAX];
     int m_min_gx, m_max_gx, m_min_gy, m_max_gy;
@@ -35,6 +37,7 @@ protected:
     ShapeBuffer m_buf_map;
     LineBuffer m_buf_lines;
     bool m_dirty;
+    bool m_dirty_window;
     bool m_far_view;
 };
 
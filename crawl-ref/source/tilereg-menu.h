@@ -16,6 +16,7 @@ public:
 
     virtual int handle_mouse(MouseEvent &event) override;
     virtual void render() override;
+    virtual const char *profile_name() const override { return "menu"; }
     virtual void clear() override;
 
     void set_entry(int index, const string &s, int colour, const MenuEntry *me,
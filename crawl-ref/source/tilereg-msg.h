@@ -12,6 +12,7 @@ public:
 
     virtual int handle_mouse(MouseEvent &event) override;
     virtual void render() override;
+    virtual const char *profile_name() const override { return "msg"; }
     virtual bool update_tip_text(string &tip) override;
 
     string &alt_text() { return m_alt_text; }
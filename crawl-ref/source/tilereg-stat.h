@@ -13,6 +13,7 @@ public:
     virtual bool update_tip_text(string &tip) override;
 
     virtual void render() override;
+    virtual const char *profile_name() const override { return "stat"; }
     virtual void clear() override;
 
 protected:
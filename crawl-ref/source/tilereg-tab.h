@@ -38,6 +38,7 @@ public:
     virtual void update() override;
     virtual void clear() override;
     virtual void render() override;
+    virtual const char *profile_name() const override { return "tab"; }
     virtual void on_resize() override;
     virtual int handle_mouse(MouseEvent &event) override;
     virtual bool update_tip_text(string &tip) override;
@@ -28,6 +28,9 @@ public:
     virtual void render() = 0;
     virtual void clear() = 0;
 
+    // Short identifier for the frame profiler overlay.
+    virtual const char *profile_name() const { return "other"; }
+
     const virtual int grid_width_to_pixels(int x) const;
     const virtual int grid_height_to_pixels(int y) const;
 
@@ -20,6 +20,8 @@
 #include "options.h"
 #include "player.h"
 #include "state.h"
+#include "stringutil.h"
+#include "syscalls.h"
 #include "tiledef-dngn.h"
 #include "tiledef-gui.h"
 #include "tiledef-main.h"
@@ -169,7 +171,9 @@ TilesFramework::TilesFramework() :
     m_key_mod(0),
     m_mouse(-1, -1),
     m_last_tick_moved(0),
-    m_last_tick_redraw(0)
+    m_last_tick_redraw(0),
+    m_profile_frames(false),
+    m_profile_pos(0)
 {
 }
 
@@ -934,8 +938,12 @@ int TilesFramework::getch_ck()
                 m_tooltip.clear();
             }
 
+            // The periodic redraw only exists to advance animated
+            // flavours, so a frame with nothing animated on it stays put
+            // until real input or a game-state change dirties it.
             if (need_redraw()
-                || ticks > m_last_tick_redraw
+                || m_region_tile->has_animations()
+                   && ticks > m_last_tick_redraw
                    && ticks - m_last_tick_redraw > ticks_per_screen_redraw)
             {
                 last_redraw_loc = m_cur_loc;
@@ -1519,8 +1527,21 @@ void TilesFramework::redraw()
 
     glmanager->reset_view_for_redraw(m_viewsc.x, m_viewsc.y);
 
+    const unsigned int frame_start = m_profile_frames ? wm->get_ticks() : 0;
+    unsigned int last_tick = frame_start;
+    string breakdown;
+
     for (Region *region : m_layers[m_active_layer].m_regions)
+    {
         region->render();
+        if (m_profile_frames)
+        {
+            const unsigned int now = wm->get_ticks();
+            breakdown += make_stringf(" %s:%u", region->profile_name(),
+                                      now - last_tick);
+            last_tick = now;
+        }
+    }
 
     // Draw tooltip
     if (Options.tile_tooltip_ms > 0 && !m_tooltip.empty())
@@ -1532,6 +1553,16 @@ void TilesFramework::redraw()
                             min_pos, m_windowsz, WHITE, false, 220, BLUE, 5,
                             true);
     }
+
+    // Overlay last frame's timings while profiling.
+    if (m_profile_frames && !m_profile_last.empty())
+    {
+        const coord_def min_pos(0, 0);
+        FontWrapper *font = m_fonts[m_tip_font].font;
+        font->render_string(0, 0, m_profile_last.c_str(), min_pos,
+                            m_windowsz, WHITE, false, 220, BLUE, 5, true);
+    }
+
     wm->swap_buffers();
 
 #ifdef __ANDROID__
@@ -1539,6 +1570,52 @@ void TilesFramework::redraw()
 #endif
 
     m_last_tick_redraw = wm->get_ticks();
+
+    if (m_profile_frames)
+    {
+        breakdown += make_stringf(" swap:%u", m_last_tick_redraw - last_tick);
+        m_profile_last = make_stringf("frame %ums:%s",
+                                      m_last_tick_redraw - frame_start,
+                                      breakdown.c_str());
+        // Bounded ring of recent frames for the toggle-off dump.
+        if (m_profile_ring.size() < 256)
+            m_profile_ring.push_back(m_profile_last);
+        else
+        {
+            m_profile_ring[m_profile_pos] = m_profile_last;
+            m_profile_pos = (m_profile_pos + 1) % m_profile_ring.size();
+        }
+    }
+}
+
+void TilesFramework::toggle_frame_profile()
+{
+    m_profile_frames = !m_profile_frames;
+    if (m_profile_frames)
+    {
+        m_profile_ring.clear();
+        m_profile_pos = 0;
+        m_profile_last.clear();
+        mpr("Tile frame profiling on.");
+        set_need_redraw();
+        return;
+    }
+
+    const string fname = Options.morgue_dir + "tile_frames.txt";
+    if (FILE *file = fopen_u(fname.c_str(), "w"))
+    {
+        // Oldest entries start at m_profile_pos once the ring has wrapped.
+        for (size_t i = 0; i < m_profile_ring.size(); ++i)
+        {
+            const size_t at = (m_profile_pos + i) % m_profile_ring.size();
+            fprintf(file, "%s\n", m_profile_ring[at].c_str());
+        }
+        fclose(file);
+        mprf("Wrote %d frame timings to %s.", (int)m_profile_ring.size(),
+             fname.c_str());
+    }
+    else
+        mprf(MSGCH_ERROR, "Can't write %s.", fname.c_str());
 }
 
 void TilesFramework::update_minimap(const coord_def& gc)
@@ -156,6 +156,7 @@ public:
     void set_need_redraw(unsigned int min_tick_delay = 0);
     bool need_redraw() const;
     void redraw();
+    void toggle_frame_profile();
     bool update_dpi();
 
     void place_cursor(cursor_type type, const coord_def &gc);
@@ -292,6 +293,14 @@ protected:
 
     string m_tooltip;
 
+    // Frame profiling (wizard Ctrl-N): per-frame region render and
+    // buffer swap timings, kept in a bounded ring and written to the
+    // morgue directory when profiling is toggled off.
+    bool m_profile_frames;
+    vector<string> m_profile_ring;
+    size_t m_profile_pos;
+    string m_profile_last;
+
     int m_screen_width;
     int m_screen_height;
 
@@ -33,43 +33,65 @@
 
 void tile_new_level(bool first_time, bool init_unseen)
 {
+    // Branch and level colours feed into feature tile resolution.
+    tile_invalidate_feature_memo();
+
     if (first_time)
         tile_init_flavour();
 
 #ifdef USE_TILE
-    if (init_unseen)
+    // The minimap can only show something at cells the player knows
+    // about, plus the explore-horizon fringe of unknown cells right
+    // next to them; everything else stays blank after the clear below,
+    // so there's no point running it through update_minimap. One grid
+    // pass handles the back-buffer reset, the stair-flag fixup and the
+    // candidate scan together; on arrival this used to be four.
+    static FixedArray<bool, GXM, GYM> shown;
+    shown.init(false);
+
+    for (rectangle_iterator ri(0); ri; ++ri)
     {
-        for (unsigned int x = 0; x < GXM; x++)
-            for (unsigned int y = 0; y < GYM; y++)
-            {
-                env.tile_bk_fg[x][y] = 0;
-                env.tile_bk_bg[x][y] = TILE_DNGN_UNSEEN;
-                env.tile_bk_cloud[x][y] = 0;
-            }
-    }
+        const coord_def gc = *ri;
 
-    // Fix up stair markers. The travel information isn't hooked up
-    // until after we change levels. So, look through all of the stairs
-    // on this level and check if they still need the stair flag.
-    for (unsigned int x = 0; x < GXM; x++)
-        for (unsigned int y = 0; y < GYM; y++)
+        if (init_unseen)
         {
-            unsigned int tile = env.tile_bk_bg[x][y];
-            if ((tile & TILE_FLAG_NEW_STAIR)
-                && !is_unknown_stair(coord_def(x,y)))
+            env.tile_bk_fg(gc) = 0;
+            env.tile_bk_bg(gc) = TILE_DNGN_UNSEEN;
+            env.tile_bk_cloud(gc) = 0;
+        }
+        else
+        {
+            // Fix up stair markers. The travel information isn't
+            // hooked up until after we change levels, so look through
+            // all of the stairs on this level and check if they still
+            // need the stair flag.
+            const unsigned int tile = env.tile_bk_bg(gc);
+            if ((tile & TILE_FLAG_NEW_STAIR) && !is_unknown_stair(gc))
+                env.tile_bk_bg(gc) &= ~TILE_FLAG_NEW_STAIR;
+            else if ((tile & TILE_FLAG_NEW_TRANSPORTER)
+                     && !is_unknown_transporter(gc))
             {
-                env.tile_bk_bg[x][y] &= ~TILE_FLAG_NEW_STAIR;
+                env.tile_bk_bg(gc) &= ~TILE_FLAG_NEW_TRANSPORTER;
             }
-            else if ((tile & TILE_FLAG_NEW_TRANSPORTER)
-                     && !is_unknown_transporter(coord_def(x,y)))
-                env.tile_bk_bg[x][y] &= ~TILE_FLAG_NEW_TRANSPORTER;
         }
 
+        if (env.map_knowledge(gc).known())
+        {
+            for (int dy = -1; dy <= 1; ++dy)
+                for (int dx = -1; dx <= 1; ++dx)
+                {
+                    const coord_def n(gc.x + dx, gc.y + dy);
+                    if (map_bounds(n))
+                        shown(n) = true;
+                }
+        }
+    }
+
     tiles.clear_minimap();
 
-    for (unsigned int x = 0; x < GXM; x++)
-        for (unsigned int y = 0; y < GYM; y++)
-            tiles.update_minimap(coord_def(x, y));
+    for (rectangle_iterator ri(0); ri; ++ri)
+        if (shown(*ri))
+            tiles.update_minimap(*ri);
 #endif
 }
 
@@ -1156,6 +1178,27 @@ void tile_apply_animations(tileidx_t bg, tile_flavour *flv)
 #endif
 }
 
+// Mirrors tile_apply_animations: would an animation update re-roll the
+// flavour of a cell with this background tile? Lets the renderer tell
+// whether a frame contains anything that animates at all.
+bool tile_cell_animated(tileidx_t bg)
+{
+#ifndef USE_TILE_WEB
+    const tileidx_t bg_idx = bg & TILE_FLAG_MASK;
+    if (bg_idx >= TILE_DNGN_LAVA && bg_idx < TILE_FLOOR_MAX)
+        return Options.tile_water_anim;
+    if (bg_idx == TILE_DNGN_PORTAL_WIZARD_LAB
+        || bg_idx == TILE_WALL_NORMAL
+        || bg_idx >= TILE_DNGN_ENTER_ZOT_CLOSED && bg_idx < TILE_BLOOD)
+    {
+        return Options.tile_misc_anim;
+    }
+#else
+    UNUSED(bg);
+#endif
+    return false;
+}
+
 static bool _suppress_blood(const map_cell& mc)
 {
     const dungeon_feature_type feat = mc.feat();
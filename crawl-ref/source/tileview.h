@@ -53,6 +53,7 @@ void tile_draw_map_cell(const coord_def &gc, bool foreground_only = false);
 void tile_wizmap_terrain(const coord_def &gc);
 
 void tile_apply_animations(tileidx_t bg, tile_flavour *flv);
+bool tile_cell_animated(tileidx_t bg);
 void tile_apply_properties(const coord_def &gc, packed_cell &cell);
 void apply_variations(const tile_flavour &flv, tileidx_t *bg,
                       const coord_def &gc);
@@ -6,6 +6,9 @@
 
 #include <cerrno>
 #include <cstdarg>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
 #include <sys/socket.h>
 #include <sys/time.h>
 #include <sys/types.h>
@@ -80,12 +83,16 @@ TilesFramework::TilesFramework()
       m_need_full_map(true),
       m_text_crt("crt"),
       m_text_menu("menu_txt"),
+      m_everything_cache_valid(false),
+      m_capturing_everything(false),
       m_print_fg(15)
 {
     screen_cell_t default_cell;
     default_cell.tile.bg = TILE_FLAG_UNSEEN;
     m_next_view.init(default_cell);
     m_current_view.init(default_cell);
+
+    m_msg_start = 0;
 }
 
 TilesFramework::~TilesFramework()
@@ -97,6 +104,7 @@ void TilesFramework::shutdown()
     if (m_sock_name.empty())
         return;
 
+    flush_messages();
     close(m_sock);
     remove(m_sock_name.c_str());
 }
@@ -152,7 +160,7 @@ bool TilesFramework::initialise()
 
 string TilesFramework::get_message()
 {
-    return m_msg_buf;
+    return m_msg_buf.substr(m_msg_start);
 }
 
 void TilesFramework::write_message(const char *format, ...)
@@ -173,18 +181,46 @@ void TilesFramework::write_message(const char *format, ...)
 
 void TilesFramework::finish_message()
 {
-    if (m_msg_buf.size() == 0)
+    if (m_msg_buf.size() == m_msg_start)
         return;
 
     if (m_sock_name.empty())
     {
-        m_msg_buf.clear();
+        m_msg_buf.resize(m_msg_start);
         return;
     }
 
     m_msg_buf.append("\n");
-    const char* fragment_start = m_msg_buf.data();
-    const char* data_end = m_msg_buf.data() + m_msg_buf.size();
+
+    if (m_capturing_everything)
+        m_everything_cache.append(m_msg_buf, m_msg_start, string::npos);
+    else
+    {
+        // Whatever this message carries, the serialized spectator
+        // snapshot no longer reflects the full client state.
+        m_everything_cache_valid = false;
+    }
+
+    // Finished messages stay in m_msg_buf until the next
+    // flush_messages(), so a turn's worth of stats/messages/map updates
+    // goes out as one contiguous write without being copied into a
+    // second buffer first. Overly long stretches without a flush (rest,
+    // autoexplore) are pushed out early so the buffer stays bounded.
+    m_msg_start = m_msg_buf.size();
+    m_need_flush = true;
+
+    if (m_msg_buf.size() >= 1 << 16)
+    {
+        _send_bytes(m_msg_buf.data(), m_msg_buf.size());
+        m_msg_buf.clear();
+        m_msg_start = 0;
+    }
+}
+
+void TilesFramework::_send_bytes(const char *data, size_t size)
+{
+    const char* fragment_start = data;
+    const char* data_end = data + size;
     while (fragment_start < data_end)
     {
         int fragment_size = data_end - fragment_start;
@@ -231,8 +267,6 @@ void TilesFramework::finish_message()
 
         fragment_start += fragment_size;
     }
-    m_msg_buf.clear();
-    m_need_flush = true;
 }
 
 void TilesFramework::send_message(const char *format, ...)
@@ -264,6 +298,15 @@ void TilesFramework::flush_messages()
         send_message("*{\"msg\":\"flush_messages\"}");
         m_need_flush = false;
     }
+
+    if (m_msg_start > 0)
+    {
+        // Send only completed messages; an in-progress one stays in the
+        // buffer tail.
+        _send_bytes(m_msg_buf.data(), m_msg_start);
+        m_msg_buf.erase(0, m_msg_start);
+        m_msg_start = 0;
+    }
 }
 
 void TilesFramework::_await_connection()
@@ -334,8 +377,23 @@ wint_t TilesFramework::_handle_control_message(sockaddr_un addr, string data)
     else if (msgtype == "spectator_joined")
     {
         flush_messages();
-        _send_everything();
-        flush_messages();
+        if (m_everything_cache_valid)
+        {
+            // Nothing has gone out since the snapshot was captured, so
+            // several spectators joining in a burst (or on a static
+            // screen) all get the same serialized bytes.
+            _send_bytes(m_everything_cache.data(),
+                        m_everything_cache.size());
+        }
+        else
+        {
+            m_everything_cache.clear();
+            m_capturing_everything = true;
+            _send_everything();
+            flush_messages();
+            m_capturing_everything = false;
+            m_everything_cache_valid = true;
+        }
     }
     else if (msgtype == "menu_scroll")
     {
@@ -389,11 +447,32 @@ wint_t TilesFramework::_handle_control_message(sockaddr_un addr, string data)
     return c;
 }
 
+// Give back memory that only exists to make the active game fast; it is
+// all rebuilt on demand. Long-idle processes are the norm on public
+// servers, and their residency is what bounds how many games a host can
+// carry.
+void TilesFramework::_trim_idle_memory()
+{
+    string().swap(m_everything_cache);
+    m_everything_cache_valid = false;
+
+    // Flushed, so only capacity is left here.
+    string().swap(m_msg_buf);
+    m_msg_start = 0;
+
+#ifdef __GLIBC__
+    // Hand freed heap pages back to the kernel; they otherwise stay
+    // resident in the allocator's arenas for the rest of the session.
+    malloc_trim(0);
+#endif
+}
+
 bool TilesFramework::await_input(wint_t& c, bool block)
 {
     int result;
     fd_set fds;
     int maxfd = m_sock_name.empty() ? STDIN_FILENO : m_sock;
+    bool idle_trimmed = false;
 
     while (true)
     {
@@ -407,7 +486,17 @@ bool TilesFramework::await_input(wint_t& c, bool block)
             if (block)
             {
                 tiles.flush_messages();
-                result = select(maxfd + 1, &fds, nullptr, nullptr, nullptr);
+                if (Options.tile_web_idle_trim_delay > 0 && !idle_trimmed)
+                {
+                    timeval timeout;
+                    timeout.tv_sec = Options.tile_web_idle_trim_delay;
+                    timeout.tv_usec = 0;
+
+                    result = select(maxfd + 1, &fds, nullptr, nullptr,
+                                    &timeout);
+                }
+                else
+                    result = select(maxfd + 1, &fds, nullptr, nullptr, nullptr);
             }
             else
             {
@@ -421,7 +510,15 @@ bool TilesFramework::await_input(wint_t& c, bool block)
         while (result == -1 && errno == EINTR);
 
         if (result == 0)
-            return false;
+        {
+            if (!block)
+                return false;
+
+            // The idle window elapsed with no input: shed memory once,
+            // then go back to sleeping indefinitely.
+            _trim_idle_memory();
+            idle_trimmed = true;
+        }
         else if (result > 0)
         {
             if (!m_sock_name.empty() && FD_ISSET(m_sock, &fds))
@@ -1096,7 +1193,7 @@ static inline void _write_tileidx(tileidx_t t)
     const int lo = t & 0xFFFFFFFF;
     const int hi = t >> 32;
     if (hi == 0)
-        tiles.write_message("%d", lo);
+        tiles.json_write_int(lo);
     else
         tiles.write_message("[%d,%d]", lo, hi);
 }
@@ -1423,6 +1520,16 @@ void TilesFramework::_send_map(bool force_full)
 
             mark_clean(gc);
 
+            // An unexplored cell diffs to nothing against the default
+            // cell; don't walk every field and build and erase a JSON
+            // object per cell to find that out. Pan and Abyss maps are
+            // mostly this case on a full resync.
+            if (force_full && !env.map_knowledge(gc).known()
+                && m_next_view(gc) == default_cell)
+            {
+                continue;
+            }
+
             if (m_origin.equals(-1, -1))
                 m_origin = gc;
 
@@ -2060,28 +2167,33 @@ void TilesFramework::json_close_array(bool erase_if_empty)
     json_close(erase_if_empty, ']');
 }
 
+// The json_write_* functions below append to m_msg_buf directly rather
+// than going through write_message(): they run for every field of every
+// changed cell, and routing single characters through vsnprintf shows up
+// prominently in server profiles.
 void TilesFramework::json_write_comma()
 {
-    if (m_msg_buf.empty()) return;
+    if (m_msg_buf.size() == m_msg_start) return;
     char last = m_msg_buf[m_msg_buf.size() - 1];
     if (last == '{' || last == '[' || last == ',' || last == ':') return;
-    write_message(",");
+    m_msg_buf.append(1, ',');
 }
 
 void TilesFramework::json_write_name(const string& name)
 {
     json_write_comma();
 
-    write_message("\"");
+    m_msg_buf.append(1, '"');
     write_message_escaped(name);
-    write_message("\":");
+    m_msg_buf.append("\":", 2);
 }
 
 void TilesFramework::json_write_int(int value)
 {
     json_write_comma();
 
-    write_message("%d", value);
+    char buf[12];
+    m_msg_buf.append(buf, snprintf(buf, sizeof(buf), "%d", value));
 }
 
 void TilesFramework::json_write_int(const string& name, int value)
@@ -2097,9 +2209,9 @@ void TilesFramework::json_write_bool(bool value)
     json_write_comma();
 
     if (value)
-        write_message("true");
+        m_msg_buf.append("true", 4);
     else
-        write_message("false");
+        m_msg_buf.append("false", 5);
 }
 
 void TilesFramework::json_write_bool(const string& name, bool value)
@@ -2114,7 +2226,7 @@ void TilesFramework::json_write_null()
 {
     json_write_comma();
 
-    write_message("null");
+    m_msg_buf.append("null", 4);
 }
 
 void TilesFramework::json_write_null(const string& name)
@@ -2129,9 +2241,9 @@ void TilesFramework::json_write_string(const string& value)
 {
     json_write_comma();
 
-    write_message("\"");
+    m_msg_buf.append(1, '"');
     write_message_escaped(value);
-    write_message("\"");
+    m_msg_buf.append(1, '"');
 }
 
 void TilesFramework::json_write_string(const string& name, const string& value)
@@ -212,12 +212,23 @@ public:
 protected:
     int m_sock;
     int m_max_msg_size;
+    // In-progress message plus any finished messages awaiting the next
+    // flush_messages(); m_msg_start is where the in-progress one begins.
     string m_msg_buf;
+    size_t m_msg_start;
     vector<sockaddr_un> m_dest_addrs;
 
     bool m_controlled_from_web;
     bool m_need_flush;
 
+    // Serialized copy of the last _send_everything(), replayed verbatim
+    // for spectators who join before any further output invalidates it.
+    string m_everything_cache;
+    bool m_everything_cache_valid;
+    bool m_capturing_everything;
+
+    void _send_bytes(const char *data, size_t size);
+    void _trim_idle_memory();
     void _await_connection();
     wint_t _handle_control_message(sockaddr_un addr, string data);
     wint_t _receive_control_message();
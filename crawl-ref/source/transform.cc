@@ -28,10 +28,12 @@
 #include "mon-death.h"
 #include "mutation.h"
 #include "output.h"
+#include "player.h"
 #include "player-equip.h"
 #include "player-stats.h"
 #include "prompt.h"
 #include "religion.h"
+#include "show.h"
 #include "spl-cast.h"
 #include "state.h"
 #include "stringutil.h"
@@ -1733,8 +1735,15 @@ bool transform(int pow, transformation which_trans, bool involuntary,
     you.form = which_trans;
     you.set_duration(DUR_TRANSFORMATION, _transform_duration(which_trans, pow));
     update_player_symbol();
+    // Forms can change what the player can see (e.g. see invisible).
+    show_mark_all_dirty();
 
-    _remove_equipment(rem_stuff);
+    {
+        // Each melded item reapplies its effects and rescales max HP
+        // and MP on its own; batch the set so each recompute runs once.
+        const recalc_batch recalc;
+        _remove_equipment(rem_stuff);
+    }
 
     you.props[TRANSFORM_POW_KEY] = pow;
 
@@ -1921,6 +1930,7 @@ void untransform(bool skip_move)
     you.form = transformation::none;
     you.duration[DUR_TRANSFORMATION] = 0;
     update_player_symbol();
+    show_mark_all_dirty();
 
     if (old_form == transformation::appendage)
     {
@@ -1959,7 +1969,12 @@ void untransform(bool skip_move)
     if (dex_mod)
         notify_stat_change(STAT_DEX, -dex_mod, true);
 
-    _unmeld_equipment(melded);
+    {
+        // As in transform(): one max HP/MP recompute for the whole set
+        // of unmelding equipment rather than one per item.
+        const recalc_batch recalc;
+        _unmeld_equipment(melded);
+    }
 
     if (!skip_move)
     {
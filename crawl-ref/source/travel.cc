@@ -15,6 +15,7 @@
 #include <cstdarg>
 #include <cstdio>
 #include <memory>
+#include <queue>
 #include <set>
 #include <sstream>
 
@@ -24,6 +25,7 @@
 #include "command.h"
 #include "coordit.h"
 #include "daction-type.h"
+#include "dbg-prof.h"
 #include "dactions.h"
 #include "directn.h"
 #include "delay.h"
@@ -409,22 +411,13 @@ bool is_stair_exclusion(const coord_def &p)
     return get_exclusion_radius(p) == 1;
 }
 
-// Returns true if the square at (x,y) is okay to travel over. If ignore_hostile
-// is true, returns true even for dungeon features the character can normally
-// not cross safely (deep water, lava, traps).
-static bool _is_travelsafe_square(const coord_def& c, bool ignore_hostile,
-                                  bool ignore_danger, bool try_fallback)
+// Classifies the square from scratch; see _is_travelsafe_square for the
+// cached entry points.
+static bool _is_travelsafe_square_uncached(const coord_def& c,
+                                           bool ignore_hostile,
+                                           bool ignore_danger,
+                                           bool try_fallback)
 {
-    if (!in_bounds(c))
-        return false;
-
-    if (_travel_safe_grid.get())
-    {
-        const cell_travel_safety &cell((*_travel_safe_grid)(c));
-        return ignore_hostile? cell.safe_if_ignoring_hostile_terrain
-               : cell.safe;
-    }
-
     if (!env.map_knowledge(c).known())
         return false;
 
@@ -482,6 +475,109 @@ static bool _is_travelsafe_square(const coord_def& c, bool ignore_hostile,
     return feat_is_traversable_now(grid, try_fallback);
 }
 
+// Persistent travel safety cache. Unlike _travel_safe_grid above, which
+// is recomputed wholesale for the duration of a stair distance update,
+// this cache survives between travel_pathfind invocations, so the flood
+// run by each autoexplore or travel step only reclassifies cells whose
+// map knowledge may have changed since the previous step. Cells the
+// player can currently see are always classified afresh (their contents
+// — monsters, clouds — change every turn), and cached entries are
+// dropped whenever map knowledge changes out of sight: terrain changes,
+// magic mapping, exclusion updates and map forgetting all funnel
+// through travel_safety_changed(), travel_safety_exclude_changed() or
+// travel_safety_reset().
+//
+// Each cell's classification is fused into one byte so the floodfill
+// inner loop does a single array read: a zero byte means "reclassify".
+static const uint8_t TSAFE_VALID          = 1 << 0;
+static const uint8_t TSAFE_SAFE           = 1 << 1;
+static const uint8_t TSAFE_IGNORE_HOSTILE = 1 << 2;
+
+static FixedArray<uint8_t, GXM, GYM> _travel_safe_cache(0);
+static bool _travel_safe_cache_live = false;
+static bool _travel_safe_cache_slime = false;
+
+void travel_safety_changed(const coord_def &p)
+{
+    if (!_travel_safe_cache_live)
+        return;
+
+    // Safety checks look at adjacent squares (slime walls), so take the
+    // neighbours down as well.
+    for (adjacent_iterator ai(p, false); ai; ++ai)
+        if (in_bounds(*ai))
+            _travel_safe_cache(*ai) = 0;
+}
+
+// An exclusion placed, removed or resized at p changes the safety of the
+// whole circle it can cover; reclassify that rather than dropping the
+// entire cache.
+void travel_safety_exclude_changed(const coord_def &p)
+{
+    if (!_travel_safe_cache_live)
+        return;
+
+    for (radius_iterator ri(p, LOS_RADIUS, C_SQUARE, false); ri; ++ri)
+        if (in_bounds(*ri))
+            _travel_safe_cache(*ri) = 0;
+}
+
+void travel_safety_reset()
+{
+    _travel_safe_cache_live = false;
+}
+
+// Returns true if the square at (x,y) is okay to travel over. If ignore_hostile
+// is true, returns true even for dungeon features the character can normally
+// not cross safely (deep water, lava, traps).
+static bool _is_travelsafe_square(const coord_def& c, bool ignore_hostile,
+                                  bool ignore_danger, bool try_fallback)
+{
+    if (!in_bounds(c))
+        return false;
+
+    if (_travel_safe_grid.get())
+    {
+        const cell_travel_safety &cell((*_travel_safe_grid)(c));
+        return ignore_hostile? cell.safe_if_ignoring_hostile_terrain
+               : cell.safe;
+    }
+
+    // The persistent cache only covers the default danger handling; the
+    // rarer flavours fall through to a direct classification.
+    if (ignore_danger || try_fallback)
+        return _is_travelsafe_square_uncached(c, ignore_hostile,
+                                              ignore_danger, try_fallback);
+
+    if (you.see_cell(c))
+    {
+        // Anything cached here predates whatever we're looking at now.
+        if (_travel_safe_cache_live)
+            _travel_safe_cache(c) = 0;
+        return _is_travelsafe_square_uncached(c, ignore_hostile,
+                                              false, false);
+    }
+
+    if (!_travel_safe_cache_live
+        || _travel_safe_cache_slime != g_Slime_Wall_Check)
+    {
+        _travel_safe_cache.init(0);
+        _travel_safe_cache_live = true;
+        _travel_safe_cache_slime = g_Slime_Wall_Check;
+    }
+
+    uint8_t &cell(_travel_safe_cache(c));
+    if (!(cell & TSAFE_VALID))
+    {
+        cell = TSAFE_VALID
+               | (_is_travelsafe_square_uncached(c, false, false, false)
+                      ? TSAFE_SAFE : 0)
+               | (_is_travelsafe_square_uncached(c, true, false, false)
+                      ? TSAFE_IGNORE_HOSTILE : 0);
+    }
+    return cell & (ignore_hostile ? TSAFE_IGNORE_HOSTILE : TSAFE_SAFE);
+}
+
 // Returns true if the location at (x,y) is monster-free and contains
 // no clouds. Travel uses this to check if the square the player is
 // about to move to is safe.
@@ -513,6 +609,7 @@ static bool _is_safe_move(const coord_def& c)
 void travel_init_load_level()
 {
     curr_excludes.clear();
+    travel_safety_reset();
     travel_cache.set_level_excludes();
     travel_cache.update_waypoints();
 }
@@ -1160,6 +1257,8 @@ const coord_def travel_pathfind::unexplored_square() const
 // Allison - used with his permission.
 coord_def travel_pathfind::pathfind(run_mode_type rmode, bool fallback_explore)
 {
+    PROF_ZONE("travel_pathfind");
+
     unwind_bool saved_ipt(ignore_player_traversability);
 
     if (rmode == RMODE_INTERLEVEL)
@@ -2589,16 +2688,49 @@ static int _target_distance_from(const coord_def &pos)
     return -1;
 }
 
+// A node in the interlevel route search: we have arrived at pos on lid
+// having travelled dist squares (stair costs included), entering the
+// route via first_stair on the player's level. first_stair is (-1, -1)
+// for the seed node, i.e. the player's own position.
+struct transtravel_node
+{
+    int dist;
+    level_id lid;
+    coord_def pos;
+    coord_def first_stair;
+};
+
+// Orders the search frontier nearest node first, with ties broken on
+// the level and position so that route planning (and thus the stair
+// travel picks) is deterministic regardless of insertion order.
+struct transtravel_farther
+{
+    bool operator () (const transtravel_node &a,
+                      const transtravel_node &b) const
+    {
+        if (a.dist != b.dist)
+            return a.dist > b.dist;
+        if (a.lid < b.lid || b.lid < a.lid)
+            return b.lid < a.lid;
+        if (a.pos != b.pos)
+            return b.pos < a.pos;
+        return b.first_stair < a.first_stair;
+    }
+};
+
 /*
  * Sets best_stair to the coordinates of the best stair on the player's current
- * level to take to get to the 'target' level. Should be called with 'distance'
- * set to 0, 'stair' set to (you.x_pos, you.y_pos) and 'best_distance' set to
- * -1. 'cur' should be the player's current level.
+ * level to take to get to the 'target' level.
  *
  * If best_stair remains unchanged when this function returns, there is no
  * travel-safe path between the player's current level and the target level OR
  * the player's current level *is* the target level.
  *
+ * The search is a best-first expansion over the stair-to-stair distance
+ * matrices precomputed into each LevelInfo, so every stair is expanded
+ * at most once per improvement of its distance label rather than once
+ * per route that reaches it.
+ *
  * This function relies on the travel_point_distance array being correctly
  * populated with a floodout call to find_travel_pos starting from the player's
  * location.
@@ -2606,196 +2738,225 @@ static int _target_distance_from(const coord_def &pos)
  * This function has undefined behavior when the target position is not
  * traversable.
  */
-static int _find_transtravel_stair(const level_id &cur,
-                                    const level_pos &target,
-                                    int distance,
-                                    // This is actually the current position
-                                    // on cur, not necessarily a stair.
-                                    const coord_def &stair,
+static void _find_transtravel_stair(const level_pos &target,
                                     level_id &closest_level,
                                     int &best_level_distance,
                                     coord_def &best_stair)
 {
-    int local_distance = -1;
-    level_id player_level = level_id::current();
+    const level_id player_level = level_id::current();
+
+    // Total distance of the best route found so far, and the first
+    // stair it takes; used both to prune the search and to report the
+    // result.
+    int best_total = -1;
+    coord_def best_first_stair(-1, -1);
 
-    LevelInfo &li = travel_cache.get_level_info(cur);
+    priority_queue<transtravel_node, vector<transtravel_node>,
+                   transtravel_farther> frontier;
+    frontier.push(transtravel_node{0, player_level, you.pos(),
+                                   coord_def(-1, -1)});
 
-    // Have we reached the target level?
-    if (cur == target.id)
+    while (!frontier.empty())
     {
-        // Are we in an exclude? If so, bail out. Unless it is just a stair exclusion.
-        if (is_excluded(stair, li.get_excludes()) && !is_stair_exclusion(stair))
-            return -1;
+        const transtravel_node node = frontier.top();
+        frontier.pop();
 
-        // If there's no target position on the target level, or we're on the
-        // target, we're home.
-        if (target.pos.x == -1 || target.pos == stair)
-            return distance;
+        const level_id cur = node.lid;
+        const coord_def stair = node.pos;
+        const int distance = node.dist;
 
-        // If there *is* a target position, we need to work out our distance
-        // from it.
-        int deltadist = _target_distance_from(stair);
+        // A cheaper complete route makes this node useless.
+        if (best_total != -1 && distance >= best_total)
+            continue;
 
-        if (deltadist == -1 && cur == player_level)
-        {
-            // Okay, we don't seem to have a distance available to us, which
-            // means we're either (a) not standing on stairs or (b) whoever
-            // initiated interlevel travel didn't call
-            // _populate_stair_distances. Assuming we're not on stairs, that
-            // situation can arise only if interlevel travel has been triggered
-            // for a location on the same level. If that's the case, we can get
-            // the distance off the travel_point_distance matrix.
-            deltadist = travel_point_distance[target.pos.x][target.pos.y];
-            if (!deltadist && stair != target.pos)
-                deltadist = -1;
-        }
+        LevelInfo &li = travel_cache.get_level_info(cur);
 
-        if (deltadist != -1)
+        // Have we reached the target level?
+        if (cur == target.id)
         {
-            local_distance = distance + deltadist;
-
-            // See if this is a degenerate case of interlevel travel:
-            // A degenerate case of interlevel travel decays to normal travel;
-            // we identify this by checking if:
-            // a. The current level is the target level.
-            // b. The target square is reachable from the 'current' square.
-            // c. The current square is where the player is.
-            //
-            // Note that even if this *is* degenerate, interlevel travel may
-            // still be able to find a shorter route, since it can consider
-            // routes that leave and reenter the current level.
-            if (player_level == target.id && stair == you.pos())
-                best_stair = target.pos;
-
-            // The local_distance is already set, but there may actually be
-            // stairs we can take that'll get us to the target faster than the
-            // direct route, so we also try the stairs.
-        }
-    }
+            // Are we in an exclude? If so, bail out. Unless it is just a
+            // stair exclusion.
+            if (is_excluded(stair, li.get_excludes())
+                && !is_stair_exclusion(stair))
+            {
+                continue;
+            }
 
-    vector<stair_info> &stairs = li.get_stairs();
+            int total = -1;
+            // If there's no target position on the target level, or we're
+            // on the target, we're home.
+            if (target.pos.x == -1 || target.pos == stair)
+                total = distance;
+            else
+            {
+                // If there *is* a target position, we need to work out our
+                // distance from it.
+                int deltadist = _target_distance_from(stair);
 
-    // this_stair being nullptr is perfectly acceptable, since we start with
-    // coords as the player coords, and the player need not be standing on
-    // stairs.
-    stair_info *this_stair = li.get_stair(stair);
+                if (deltadist == -1 && cur == player_level)
+                {
+                    // Okay, we don't seem to have a distance available to
+                    // us, which means we're either (a) not standing on
+                    // stairs or (b) whoever initiated interlevel travel
+                    // didn't call _populate_stair_distances. Assuming we're
+                    // not on stairs, that situation can arise only if
+                    // interlevel travel has been triggered for a location on
+                    // the same level. If that's the case, we can get the
+                    // distance off the travel_point_distance matrix.
+                    deltadist =
+                        travel_point_distance[target.pos.x][target.pos.y];
+                    if (!deltadist && stair != target.pos)
+                        deltadist = -1;
+                }
 
-    if (!this_stair && cur != player_level)
-    {
-        // Whoops, there's no stair in the travel cache for the current
-        // position, and we're not on the player's current level (i.e., there
-        // certainly *should* be a stair here). Since we can't proceed in any
-        // reasonable way, bail out.
-        return local_distance;
-    }
+                if (deltadist != -1)
+                    total = distance + deltadist;
+            }
 
-    for (stair_info &si : stairs)
-    {
-        if (stairs_destination_is_excluded(si))
-            continue;
+            if (total != -1 && (best_total == -1 || total < best_total))
+            {
+                best_total = total;
+                // A route with no first stair is the degenerate case of
+                // interlevel travel: the target square is reachable by
+                // ordinary travel from the player's position. Even then,
+                // stairs may still offer a shorter route that leaves and
+                // reenters the current level, so keep searching.
+                best_first_stair = node.first_stair.x == -1
+                                   ? target.pos : node.first_stair;
+            }
+        }
 
-        // Skip placeholders and excluded stairs.
-        if (!si.can_travel() || is_excluded(si.position, li.get_excludes()))
-            continue;
+        vector<stair_info> &stairs = li.get_stairs();
 
-        int deltadist = li.distance_between(this_stair, &si);
+        // this_stair being nullptr is perfectly acceptable for the seed
+        // node, since the player need not be standing on stairs.
+        stair_info *this_stair = li.get_stair(stair);
 
-        if (!this_stair)
+        if (!this_stair && cur != player_level)
         {
-            deltadist = travel_point_distance[si.position.x][si.position.y];
-            if (!deltadist && you.pos() != si.position)
-                deltadist = -1;
+            // Whoops, there's no stair in the travel cache for the current
+            // position, and we're not on the player's current level (i.e.,
+            // there certainly *should* be a stair here). Since we can't
+            // proceed in any reasonable way, bail out.
+            continue;
         }
 
-        // deltadist == 0 is legal (if this_stair is nullptr), since the player
-        // may be standing on the stairs. If two stairs are disconnected,
-        // deltadist has to be negative.
-        if (deltadist < 0)
+        // A cheaper arrival at this stair has already been expanded.
+        if (this_stair && this_stair->distance != -1
+            && this_stair->distance < distance)
+        {
             continue;
+        }
 
-        int dist2stair = distance + deltadist;
-        if (si.distance == -1 || si.distance > dist2stair)
+        for (stair_info &si : stairs)
         {
-            si.distance = dist2stair;
-
-            // Account for the cost of taking the stairs
-            dist2stair += 500; // XXX: this seems large?
+            if (stairs_destination_is_excluded(si))
+                continue;
 
-            // Already too expensive? Short-circuit.
-            if (local_distance != -1 && dist2stair >= local_distance)
+            // Skip placeholders and excluded stairs.
+            if (!si.can_travel()
+                || is_excluded(si.position, li.get_excludes()))
+            {
                 continue;
+            }
 
-            const level_pos &dest = si.destination;
+            int deltadist = li.distance_between(this_stair, &si);
 
-            // Never use escape hatches as the last leg of the trip, since
-            // that will leave the player unable to retrace their path.
-            // This does not apply if we have a destination with a specific
-            // position on the target level travel wants to get to.
-            if (feat_is_escape_hatch(si.grid)
-                && target.pos.x == -1
-                && dest.id == target.id)
+            if (!this_stair)
             {
-                continue;
+                deltadist = travel_point_distance[si.position.x][si.position.y];
+                if (!deltadist && you.pos() != si.position)
+                    deltadist = -1;
             }
 
-            // We can only short-circuit the stair-following process if we
-            // have no exact target location. If there *is* an exact target
-            // location, we can't follow stairs for which we have incomplete
-            // information.
-            if (target.pos.x == -1
-                && dest.id == target.id)
+            // deltadist == 0 is legal (if this_stair is nullptr), since the
+            // player may be standing on the stairs. If two stairs are
+            // disconnected, deltadist has to be negative.
+            if (deltadist < 0)
+                continue;
+
+            int dist2stair = distance + deltadist;
+            if (si.distance == -1 || si.distance > dist2stair)
             {
-                if (local_distance == -1 || local_distance > dist2stair)
+                si.distance = dist2stair;
+
+                // Account for the cost of taking the stairs
+                dist2stair += 500; // XXX: this seems large?
+
+                // Already too expensive? Short-circuit.
+                if (best_total != -1 && dist2stair >= best_total)
+                    continue;
+
+                const level_pos &dest = si.destination;
+
+                // Never use escape hatches as the last leg of the trip,
+                // since that will leave the player unable to retrace their
+                // path. This does not apply if we have a destination with a
+                // specific position on the target level travel wants to get
+                // to.
+                if (feat_is_escape_hatch(si.grid)
+                    && target.pos.x == -1
+                    && dest.id == target.id)
                 {
-                    local_distance = dist2stair;
-                    if (cur == player_level && you.pos() == stair)
-                        best_stair = si.position;
+                    continue;
                 }
-                continue;
-            }
 
-            if (dest.id.depth > -1) // We have a valid level descriptor.
-            {
-                int dist = level_distance(dest.id, target.id);
-                if (dist != -1 && (dist < best_level_distance
-                                   || best_level_distance == -1))
+                // The first stair of the route is fixed once we leave the
+                // player's level.
+                const coord_def first_stair = node.first_stair.x == -1
+                                              ? si.position : node.first_stair;
+
+                // We can only short-circuit the stair-following process if
+                // we have no exact target location. If there *is* an exact
+                // target location, we can't follow stairs for which we have
+                // incomplete information.
+                if (target.pos.x == -1
+                    && dest.id == target.id)
+                {
+                    if (best_total == -1 || dist2stair < best_total)
+                    {
+                        best_total = dist2stair;
+                        best_first_stair = first_stair;
+                    }
+                    continue;
+                }
+
+                if (dest.id.depth > -1) // We have a valid level descriptor.
                 {
-                    best_level_distance = dist;
-                    closest_level       = dest.id;
+                    int dist = level_distance(dest.id, target.id);
+                    if (dist != -1 && (dist < best_level_distance
+                                       || best_level_distance == -1))
+                    {
+                        best_level_distance = dist;
+                        closest_level       = dest.id;
+                    }
                 }
-            }
 
-            // If we don't know where these stairs go, we can't take them.
-            if (!dest.is_valid())
-                continue;
+                // If we don't know where these stairs go, we can't take
+                // them.
+                if (!dest.is_valid())
+                    continue;
 
-            // We need to get the stairs at the new location and set the
-            // distance on them as well.
-            LevelInfo &lo = travel_cache.get_level_info(dest.id);
-            if (stair_info *so = lo.get_stair(dest.pos))
-            {
-                if (so->distance == -1 || so->distance > dist2stair)
-                    so->distance = dist2stair;
-                else
-                    continue;   // We've already been here.
-            }
+                // We need to get the stairs at the new location and set the
+                // distance on them as well.
+                LevelInfo &lo = travel_cache.get_level_info(dest.id);
+                if (stair_info *so = lo.get_stair(dest.pos))
+                {
+                    if (so->distance == -1 || so->distance > dist2stair)
+                        so->distance = dist2stair;
+                    else
+                        continue;   // We've already been here.
+                }
 
-            // Okay, take these stairs and keep going.
-            const int newdist =
-                _find_transtravel_stair(dest.id, target,
-                                        dist2stair, dest.pos, closest_level,
-                                        best_level_distance, best_stair);
-            if (newdist != -1
-                && (local_distance == -1 || local_distance > newdist))
-            {
-                local_distance = newdist;
-                if (cur == player_level && you.pos() == stair)
-                    best_stair = si.position;
+                // Okay, take these stairs and keep going.
+                frontier.push(transtravel_node{dist2stair, dest.id, dest.pos,
+                                               first_stair});
             }
         }
     }
-    return local_distance;
+
+    if (best_first_stair.x != -1)
+        best_stair = best_first_stair;
 }
 
 static bool _loadlev_populate_stair_distances(const level_pos &target)
@@ -2830,7 +2991,6 @@ static bool _find_transtravel_square(const level_pos &target, bool verbose)
     level_id current = level_id::current();
 
     coord_def best_stair(-1, -1);
-    coord_def cur_stair(you.pos());
 
     level_id closest_level;
     int best_level_distance = -1;
@@ -2847,8 +3007,7 @@ static bool _find_transtravel_square(const level_pos &target, bool verbose)
 
     if (maybe_traversable)
     {
-        _find_transtravel_stair(current, target,
-                                0, cur_stair, closest_level,
+        _find_transtravel_stair(target, closest_level,
                                 best_level_distance, best_stair);
     }
     // even without _find_transtravel_stair called, the values are initalized
@@ -3047,11 +3206,18 @@ string level_id::describe(bool long_name, bool with_number) const
     {
         if (long_name)
         {
-            // decapitalise 'the'
-            if (starts_with(result, "The"))
-                result[0] = 't';
+            // decapitalise 'the' (precomputed: travel prompts, notes
+            // and the overview screen all format level names)
+            static vector<string> decap(NUM_BRANCHES);
+            string &base = decap[branch];
+            if (base.empty())
+            {
+                base = branches[branch].longname;
+                if (starts_with(base, "The"))
+                    base[0] = 't';
+            }
             result = make_stringf("Level %d of %s",
-                      depth, result.c_str());
+                      depth, base.c_str());
         }
         else if (depth)
             result = make_stringf("%s:%d", result.c_str(), depth);
@@ -3970,6 +4136,7 @@ void TravelCache::save(writer& outf) const
 
 void TravelCache::load(reader& inf, int minorVersion)
 {
+    last_level_info = nullptr;
     levels.clear();
 
     // Check version. If not compatible, we just ignore the file altogether.
@@ -4771,6 +4938,7 @@ void clear_travel_trail()
         tiles.update_minimap(c);
 #endif
     env.travel_trail.clear();
+    view_invalidate_scroll();
 }
 
 int travel_trail_index(const coord_def& gc)
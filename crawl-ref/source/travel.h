@@ -58,6 +58,10 @@ void stop_running(bool clear_delays = true);
 void travel_init_load_level();
 void travel_init_new_level();
 
+void travel_safety_changed(const coord_def &p);
+void travel_safety_exclude_changed(const coord_def &p);
+void travel_safety_reset();
+
 uint8_t is_waypoint(const coord_def &p);
 command_type direction_to_command(int x, int y);
 bool is_resting();
@@ -415,19 +419,30 @@ public:
 
     LevelInfo& get_level_info(const level_id &lev)
     {
+        if (last_level_info && last_level_seen == lev)
+            return *last_level_info;
         LevelInfo &li = levels[lev];
         li.id = lev;
+        last_level_seen = lev;
+        last_level_info = &li;
         return li;
     }
 
     LevelInfo *find_level_info(const level_id &lev)
     {
+        if (last_level_info && last_level_seen == lev)
+            return last_level_info;
         map<level_id, LevelInfo>::iterator i = levels.find(lev);
-        return i != levels.end()? &i->second : nullptr;
+        if (i == levels.end())
+            return nullptr;
+        last_level_seen = lev;
+        last_level_info = &i->second;
+        return last_level_info;
     }
 
     void erase_level_info(const level_id& lev)
     {
+        last_level_info = nullptr;
         levels.erase(lev);
     }
 
@@ -476,6 +491,13 @@ private:
     typedef map<level_id, LevelInfo> travel_levels_map;
     travel_levels_map levels;
     level_pos waypoints[TRAVEL_WAYPOINT_COUNT];
+
+    // One-entry memo for the level most recently asked about — in
+    // practice almost always the current level, probed once per
+    // travel step. Map nodes are stable, so the pointer survives
+    // insertions of other levels; erasure and reload drop it.
+    level_id last_level_seen;
+    LevelInfo *last_level_info = nullptr;
 };
 
 // Handles travel and explore floodfill pathfinding. Does not do interlevel
@@ -23,6 +23,7 @@
 #include "coord.h"
 #include "coordit.h"
 #include "database.h"
+#include "dbg-prof.h"
 #include "delay.h"
 #include "dgn-overview.h"
 #include "directn.h"
@@ -75,6 +76,7 @@
 #include "traps.h"
 #include "travel.h"
 #include "unicode.h"
+#include "unwind.h"
 #include "viewchar.h"
 #include "viewmap.h"
 #include "xom.h"
@@ -84,8 +86,32 @@
 static layers_type _layers = LAYERS_ALL;
 static layers_type _layers_saved = LAYERS_NONE;
 
+// Whether crawl_view.vbuf still holds exactly the frame an overlay-free
+// viewwindow() pass would derive from the current env.show.
+static bool _vbuf_frame_current = false;
+
+// Scroll fast path state: the view centre the buffer was last drawn
+// around, and which view cells were drawn as visible. When the centre
+// moves a single step, unchanged out-of-LOS cells can be shifted over
+// instead of re-derived -- their rendering depends only on map memory.
+// _vbuf_scrollable goes false whenever map memory changes outside the
+// normal LOS flow (detection effects, exclusions, trail clears).
+static bool _vbuf_scrollable = false;
+static coord_def _vbuf_center(-1, -1);
+static vector<uint8_t> _vbuf_seen;
+
 crawl_view_geometry crawl_view;
 
+void view_invalidate_frame()
+{
+    _vbuf_frame_current = false;
+}
+
+void view_invalidate_scroll()
+{
+    _vbuf_scrollable = false;
+}
+
 bool handle_seen_interrupt(monster* mons, vector<string>* msgs_buf)
 {
     activity_interrupt_data aid(mons);
@@ -466,8 +492,10 @@ static void _maybe_gozag_incite(vector<monster*> monsters)
 void update_monsters_in_view()
 {
     int num_hostile = 0;
+    int num_threats = 0;
     vector<string> msgs;
     vector<monster*> monsters;
+    vector<mid_t> hostile_mids;
 
     for (monster_iterator mi; mi; ++mi)
     {
@@ -478,6 +506,18 @@ void update_monsters_in_view()
 
             if (mi->visible_to(&you))
             {
+                if (mi->attitude == ATT_HOSTILE)
+                    hostile_mids.push_back(mi->mid);
+
+                // Census of potential threats for the fast safety check;
+                // mirrors the short-circuits in mons_is_safe().
+                if (!mi->wont_attack()
+                    && (!mons_is_firewood(**mi)
+                        || mi->type == MONS_BALLISTOMYCETE))
+                {
+                    num_threats++;
+                }
+
                 if (handle_seen_interrupt(*mi, &msgs))
                     monsters.push_back(*mi);
                 seen_monster(*mi);
@@ -524,6 +564,9 @@ void update_monsters_in_view()
         you.attribute[ATTR_ABYSS_ENTOURAGE] = num_hostile;
         xom_is_stimulated(12 * num_hostile);
     }
+
+    note_visible_threat_summary(num_threats);
+    note_visible_hostiles(move(hostile_mids));
 }
 
 void mark_mon_equipment_seen(const monster *mons)
@@ -619,6 +662,10 @@ bool magic_mapping(int map_radius, int proportion, bool suppress_msg,
     int  num_altars        = 0;
     int  num_shops_portals = 0;
 
+    // Coalesce the per-cell minimap touches into one flush for the
+    // whole mapped area.
+    map_update_batch batch;
+
     const FixedArray<uint8_t, GXM, GYM>& difficulty =
         _tile_difficulties(!deterministic);
 
@@ -755,6 +802,9 @@ bool magic_mapping(int map_radius, int proportion, bool suppress_msg,
             mpr_comma_separated_list("You sensed ", sensed);
     }
 
+    if (did_map)
+        view_invalidate_scroll();
+
     return did_map;
 }
 
@@ -778,6 +828,7 @@ void fully_map_level()
             env.map_knowledge(*ri).set_detected_item();
         env.pgrid(*ri) |= FPROP_SEEN_OR_NOEXP;
     }
+    view_invalidate_scroll();
 }
 
 bool mon_enemies_around(const monster* mons)
@@ -1350,6 +1401,39 @@ void run_animation(animation_type anim, use_animation_type type, bool cleanup)
     }
 }
 
+// Redraw batching: while a redraw_batch is in scope, ordinary
+// viewwindow() refreshes just mark the view dirty and the outermost
+// batch close issues the one final draw. Animation frames opt out and
+// draw immediately (flushing any pending refresh first, so the frame
+// lands on a current base).
+static int _redraw_batch_depth = 0;
+static bool _redraw_batch_pending = false;
+static bool _redraw_batch_updates = false;
+
+static void _redraw_batch_flush()
+{
+    if (!_redraw_batch_pending)
+        return;
+    _redraw_batch_pending = false;
+    const bool updates = _redraw_batch_updates;
+    _redraw_batch_updates = false;
+    // Let the draw through even if a batch is still open.
+    unwind_var<int> no_batch(_redraw_batch_depth, 0);
+    viewwindow(updates);
+}
+
+redraw_batch::redraw_batch()
+{
+    _redraw_batch_depth++;
+}
+
+redraw_batch::~redraw_batch()
+{
+    ASSERT(_redraw_batch_depth > 0);
+    if (--_redraw_batch_depth == 0)
+        _redraw_batch_flush();
+}
+
 /**
  * Draws the main window using the character set returned
  * by get_show_glyph().
@@ -1368,6 +1452,19 @@ void viewwindow(bool show_updates, bool tiles_only, animation *a)
     if (you.duration[DUR_TIME_STEP] || you.pos().origin())
         return;
 
+    if (_redraw_batch_depth)
+    {
+        if (!a)
+        {
+            _redraw_batch_pending = true;
+            _redraw_batch_updates |= show_updates;
+            return;
+        }
+        _redraw_batch_flush();
+    }
+
+    PROF_ZONE("viewwindow");
+
     screen_cell_t *cell(crawl_view.vbuf);
 
     // The buffer is not initialised when run from 'monster'; abort early.
@@ -1420,21 +1517,95 @@ void viewwindow(bool show_updates, bool tiles_only, animation *a)
     if (flash_colour == BLACK)
         flash_colour = viewmap_flash_colour();
 
+    // A draw that updates neither env.show nor the cell animations and
+    // has no overlay to apply would derive exactly the frame already in
+    // the view buffer, so skip the per-cell rebuild and go straight to
+    // repainting it. This covers the restore draws after targeting beams
+    // and view flashes. (Elemental colours keep their previous phase on
+    // such a repaint, but the view only repaints on input anyway.)
+    const bool overlay_free = !a
+                              && _layers == LAYERS_ALL
+                              && flash_colour == BLACK
+                              && !you.flash_where
+                              && !crawl_state.darken_range
+                              && !crawl_state.flash_monsters;
+
     const coord_def tl = coord_def(1, 1);
     const coord_def br = crawl_view.viewsz;
-    for (rectangle_iterator ri(tl, br); ri; ++ri)
+    if (show_updates || anim_updates || !overlay_free || !_vbuf_frame_current)
     {
-        // in grid coords
-        const coord_def gc = a
-            ? a->cell_cb(view2grid(*ri), flash_colour)
-            : view2grid(*ri);
+        const int vw = crawl_view.viewsz.x;
+        const int vh = crawl_view.viewsz.y;
+        // View-space displacement since the last frame. For a single
+        // step, cells whose rendering can't have changed -- out of LOS
+        // both then and now -- are shifted over from the old buffer;
+        // only visible cells and the uncovered edge are re-derived.
+        // (draw_cell renders out-of-LOS cells purely from map memory,
+        // with no animation or player-position dependence.)
+        const coord_def delta = crawl_view.vgrdc - _vbuf_center;
+        const bool scroll = _vbuf_scrollable
+                            && overlay_free
+                            && !crawl_state.game_is_arena()
+                            && you.on_current_level
+                            && delta.rdist() <= 1
+                            && (int) _vbuf_seen.size() == vw * vh;
+
+        if ((int) _vbuf_seen.size() != vw * vh)
+            _vbuf_seen.assign(vw * vh, 0);
+
+        if (scroll)
+        {
+            static vector<screen_cell_t> old_vbuf;
+            old_vbuf.assign(cell, cell + vw * vh);
+            const vector<uint8_t> old_seen = _vbuf_seen;
 
-        if (you.flash_where && you.flash_where->is_affected(gc) <= 0)
-            draw_cell(cell, gc, anim_updates, 0);
+            for (int vy = 1; vy <= vh; ++vy)
+                for (int vx = 1; vx <= vw; ++vx)
+                {
+                    const coord_def vc(vx, vy);
+                    const coord_def gc = view2grid(vc);
+                    const coord_def src = vc + delta;
+                    const int idx = (vy - 1) * vw + (vx - 1);
+                    const bool have_src = src.x >= 1 && src.x <= vw
+                                          && src.y >= 1 && src.y <= vh;
+                    const int src_idx = have_src
+                        ? (src.y - 1) * vw + (src.x - 1) : -1;
+                    const bool vis = map_bounds(gc)
+                                     && (gc == you.pos() || you.see_cell(gc));
+
+                    if (!have_src || vis || old_seen[src_idx])
+                        draw_cell(&cell[idx], gc, anim_updates, 0);
+                    else
+                        cell[idx] = old_vbuf[src_idx];
+                    _vbuf_seen[idx] = vis;
+                }
+        }
         else
-            draw_cell(cell, gc, anim_updates, flash_colour);
+        {
+            int idx = 0;
+            for (rectangle_iterator ri(tl, br); ri; ++ri)
+            {
+                // in grid coords
+                const coord_def gc = a
+                    ? a->cell_cb(view2grid(*ri), flash_colour)
+                    : view2grid(*ri);
+
+                if (you.flash_where && you.flash_where->is_affected(gc) <= 0)
+                    draw_cell(cell, gc, anim_updates, 0);
+                else
+                    draw_cell(cell, gc, anim_updates, flash_colour);
+
+                _vbuf_seen[idx++] = map_bounds(gc)
+                                    && (gc == you.pos() || you.see_cell(gc));
+                cell++;
+            }
+        }
 
-        cell++;
+        _vbuf_frame_current = overlay_free;
+        // Frames drawn with an overlay (flash colours, animation
+        // remapping) can't seed a future shift.
+        _vbuf_scrollable = overlay_free;
+        _vbuf_center = crawl_view.vgrdc;
     }
 
     you.last_view_update = you.num_turns;
@@ -23,6 +23,8 @@ string screenshot();
 int viewmap_flash_colour();
 bool view_update();
 void view_update_at(const coord_def &pos);
+void view_invalidate_frame();
+void view_invalidate_scroll();
 class targeter;
 
 static inline void scaled_delay(unsigned int ms)
@@ -69,6 +71,19 @@ void run_animation(animation_type anim, use_animation_type type,
                    bool cleanup = true);
 void viewwindow(bool show_updates = true, bool tiles_only = false,
                 animation *a = nullptr);
+
+/**
+ * Coalesces viewwindow() refreshes for as long as it is in scope:
+ * intermediate requests only mark the view dirty, and closing the
+ * outermost batch issues the single final draw. Draws carrying an
+ * animation frame bypass the batch. Nests safely.
+ */
+class redraw_batch
+{
+public:
+    redraw_batch();
+    ~redraw_batch();
+};
 void draw_cell(screen_cell_t *cell, const coord_def &gc,
                bool anim_updates, int flash_colour);
 
@@ -253,6 +253,16 @@ bool crawl_view_buffer::empty() const
     return m_size.x * m_size.y <= 0;
 }
 
+bool crawl_view_buffer::operator == (const crawl_view_buffer &rhs) const
+{
+    if (m_size != rhs.m_size)
+        return false;
+    for (int i = 0; i < m_size.x * m_size.y; ++i)
+        if (m_buffer[i] != rhs.m_buffer[i])
+            return false;
+    return true;
+}
+
 const crawl_view_buffer &crawl_view_buffer::operator = (const crawl_view_buffer &rhs)
 {
     resize(rhs.m_size);
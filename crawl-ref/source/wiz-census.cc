@@ -0,0 +1,63 @@
+/**
+ * @file
+ * @brief In-game census of engine data structures.
+**/
+
+#include "AppHdr.h"
+
+#include "wiz-census.h"
+
+#ifdef WIZARD
+
+#include "env.h"
+#include "message.h"
+#include "mon-util.h"
+#include "player.h"
+#include "state.h"
+
+/**
+ * Dumps a cheap O(n) occupancy census of the main engine containers to
+ * the message log, one "census:" line per subsystem. The fixed
+ * key=value format is scraped by ops tooling, so extend it rather than
+ * reformatting it.
+ */
+void wizard_dump_census()
+{
+    int mon_used = 0, mon_active = 0;
+    for (int i = 0; i < MAX_MONSTERS; ++i)
+    {
+        if (menv[i].type == MONS_NO_MONSTER)
+            continue;
+        mon_used++;
+        if (menv[i].alive())
+            mon_active++;
+    }
+    mprf("census: monster_slots=%d/%d active=%d",
+         mon_used, MAX_MONSTERS, mon_active);
+
+    int item_used = 0, item_props_items = 0, item_props_keys = 0;
+    for (int i = 0; i < MAX_ITEMS; ++i)
+    {
+        if (!mitm[i].defined())
+            continue;
+        item_used++;
+        if (mitm[i].props.size())
+        {
+            item_props_items++;
+            item_props_keys += mitm[i].props.size();
+        }
+    }
+    mprf("census: item_slots=%d/%d props_items=%d props_keys=%d",
+         item_used, MAX_ITEMS, item_props_items, item_props_keys);
+
+    mprf("census: clouds=%d markers=%d",
+         (int) env.cloud.size(), (int) env.markers.get_all().size());
+
+    mprf("census: you_props=%d level_props=%d",
+         (int) you.props.size(), (int) env.properties.size());
+
+    mprf("census: messages_bytes=%d",
+         (int) get_last_messages(NUM_STORED_MESSAGES, true).size());
+}
+
+#endif
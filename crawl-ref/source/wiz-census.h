@@ -0,0 +1,10 @@
+/**
+ * @file
+ * @brief In-game census of engine data structures.
+**/
+
+#pragma once
+
+#ifdef WIZARD
+void wizard_dump_census();
+#endif
@@ -7,10 +7,13 @@
 
 #include "wiz-dgn.h"
 
+#include <chrono>
+
 #include "act-iter.h"
 #include "branch.h"
 #include "coordit.h"
 #include "dactions.h"
+#include "dbg-prof.h"
 #include "delay.h"
 #include "describe.h"
 #include "dgn-overview.h"
@@ -651,6 +654,9 @@ static int _debug_time_explore()
 
     unwind_var<int> es(Options.explore_stop, 0);
 
+    prof_reset_totals();
+    const auto wall_start = chrono::steady_clock::now();
+
     const int start = you.num_turns;
     while (you_are_delayed())
     {
@@ -659,6 +665,18 @@ static int _debug_time_explore()
         you.num_turns++;
     }
 
+    const double wall_ms = chrono::duration_cast<chrono::microseconds>(
+        chrono::steady_clock::now() - wall_start).count() / 1000.0;
+    const int steps = you.num_turns - start;
+    mprf("Explored %d steps in %.1f ms (%.0f steps/sec).",
+         steps, wall_ms, wall_ms > 0 ? steps * 1000.0 / wall_ms : 0.0);
+
+    // With DEBUG_PROF, break the total down by subsystem zone
+    // (travel_pathfind, losight, stash_tracking, ...).
+    const string zones = prof_report_totals();
+    if (!zones.empty())
+        mprf(MSGCH_DIAGNOSTICS, "%s", zones.c_str());
+
     // Elapsed time might not match up if explore had to go through
     // shallow water.
     PlaceInfo& pi = you.get_place_info();
@@ -8,6 +8,8 @@
 #include "wiz-fsim.h"
 
 #include <cerrno>
+#include <chrono>
+#include <cmath>
 
 #include "beam.h"
 #include "bitary.h"
@@ -33,6 +35,7 @@
 #include "output.h"
 #include "player-equip.h"
 #include "player.h"
+#include "random.h"
 #include "ranged-attack.h"
 #include "skills.h"
 #include "species.h"
@@ -509,6 +512,68 @@ void wizard_quick_fsim()
     return;
 }
 
+// Deterministic cost benchmark for the to-hit and damage path. This
+// reruns the quick-sim attack loop under a fixed RNG seed and reports
+// wall-clock ns per attack with a spread estimate, so a formula change
+// that slows down calc_to_hit or calc_damage shows up as a number
+// instead of a feeling. The damage output is deliberately ignored.
+void wizard_fsim_bench()
+{
+    monster *mon = _init_fsim();
+    if (!mon)
+        return;
+
+    // A handful of timed batches gives a spread estimate without making
+    // the command annoyingly slow at the default fsim_rounds.
+    const int batches = 10;
+    const int rounds = max(100, Options.fsim_rounds / batches);
+
+    // The fixed seed makes every batch (and every run on the same
+    // character) do identical work; 0x6673696d is "fsim".
+    const uint32_t bench_seed = 0x6673696d;
+
+    // One untimed batch to warm up caches and any lazy init.
+    seed_rng(bench_seed);
+    _get_fight_data(*mon, rounds, false);
+
+    double ns_per_attack[batches];
+    for (int i = 0; i < batches; i++)
+    {
+        seed_rng(bench_seed);
+        const auto start = chrono::steady_clock::now();
+        _get_fight_data(*mon, rounds, false);
+        const auto stop = chrono::steady_clock::now();
+        const auto elapsed =
+            chrono::duration_cast<chrono::nanoseconds>(stop - start);
+        ns_per_attack[i] = (double)elapsed.count() / rounds;
+    }
+
+    double mean = 0.0;
+    for (int i = 0; i < batches; i++)
+        mean += ns_per_attack[i];
+    mean /= batches;
+
+    double var = 0.0;
+    for (int i = 0; i < batches; i++)
+    {
+        const double dev = ns_per_attack[i] - mean;
+        var += dev * dev;
+    }
+    var /= batches - 1;
+
+    // 95% confidence half-width; 2.262 is t(0.975) at 9 degrees of
+    // freedom.
+    const double ci = 2.262 * sqrt(var / batches);
+
+    mprf("%d batches of %d attacks: %.0f +/- %.0f ns/attack.",
+         batches, rounds, mean, ci);
+
+    // Don't leave the game on the benchmark's predictable seed.
+    seed_rng();
+
+    _uninit_fsim(mon);
+}
+
 static string _init_scale(skill_map &scale, bool &xl_mode)
 {
     string ret;
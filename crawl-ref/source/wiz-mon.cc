@@ -586,6 +586,7 @@ void wizard_detect_creatures()
 #endif
         count++;
     }
+    view_invalidate_scroll();
     mprf("Detected %i monster%s.", count, count == 1 ? "" : "s");
 }
 
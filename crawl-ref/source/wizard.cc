@@ -12,6 +12,7 @@
 #include "cio.h" // cursor_control
 #include "clua.h"
 #include "command.h" // show_keyhelp_menu
+#include "dbg-prof.h"
 #include "dbg-util.h"
 #include "dgn-shoals.h" // wizard_mod_tide
 #include "files.h" // save_game
@@ -32,8 +33,10 @@
 #include "spl-transloc.h" // wizard_blink
 #include "stairs.h" // down_stairs
 #include "state.h"
+#include "tiles-build-specific.h"
 #include "timed-effects.h" // change_labyrinth
 #include "wizard-option-type.h"
+#include "wiz-census.h"
 #include "wiz-dgn.h"
 #include "wiz-dump.h"
 #include "wiz-fsim.h"
@@ -103,7 +106,7 @@ static void _do_wizard_command(int wiz_command)
     case 'I': wizard_unidentify_pack(); break;
     case CONTROL('I'): debug_item_statistics(); break;
 
-    // case 'j': break;
+    case 'j': wizard_fsim_bench(); break;
     case 'J':
         mpr("Running Jiyva off-level sacrifice.");
         jiyva_eat_offlevel_items();
@@ -129,11 +132,15 @@ static void _do_wizard_command(int wiz_command)
 
     // case 'n': break;
     // case 'N': break;
+#ifdef USE_TILE_LOCAL
+    case CONTROL('N'): tiles.toggle_frame_profile(); break;
+#else
     // case CONTROL('N'): break;
+#endif
 
     case 'o': wizard_create_spec_object(); break;
     case 'O': debug_test_explore(); break;
-    // case CONTROL('O'): break;
+    case CONTROL('O'): wizard_dump_census(); break;
 
     case 'p': wizard_transform(); break;
     case 'P': debug_place_map(true); break;
@@ -179,7 +186,9 @@ static void _do_wizard_command(int wiz_command)
     case CONTROL('Y'): wizard_suppress(); break;
 
     case 'z': wizard_cast_spec_spell(); break;
-    // case 'Z': break;
+#ifdef DEBUG_ALLOC
+    case 'Z': debug_dump_alloc_stats(); break;
+#endif
     // case CONTROL('Z'): break;
 
     case '!': wizard_memorise_spec_spell(); break;
@@ -497,13 +506,21 @@ int list_wizard_commands(bool do_redraw_screen)
                        "<w>f</w>      quick fight simulation\n"
                        "<w>F</w>      single scale fsim\n"
                        "<w>Ctrl-F</w> double scale fsim\n"
+                       "<w>j</w>      fsim timing benchmark\n"
                        "<w>Ctrl-I</w> item generation stats\n"
                        "<w>O</w>      measure exploration time\n"
                        "<w>Ctrl-T</w> dungeon (D)Lua interpreter\n"
                        "<w>Ctrl-U</w> client (C)Lua interpreter\n"
                        "<w>Ctrl-X</w> Xom effect stats\n"
+                       "<w>Ctrl-O</w> engine data structure census\n"
+#ifdef DEBUG_ALLOC
+                       "<w>Z</w>      allocation stats for last turn\n"
+#endif
 #ifdef DEBUG_DIAGNOSTICS
                        "<w>Ctrl-Q</w> make some debug messages quiet\n"
+#endif
+#ifdef USE_TILE_LOCAL
+                       "<w>Ctrl-N</w> toggle tiles frame profiling\n"
 #endif
                        "<w>Ctrl-Y</w> temporarily suppress wizmode\n"
                        "<w>Ctrl-C</w> force a crash\n"
@@ -412,6 +412,48 @@ void xom_tick()
     }
 }
 
+// Xom's choosers re-scan the monsters in view once per candidate
+// category every time he stirs. The verdicts depend only on the
+// visible monster set and where the player stands, so each category's
+// last answer is remembered against the monster-event epoch the
+// tension cache maintains (plus turn and player position) and reused
+// until one of those changes.
+enum xom_feasibility
+{
+    XOM_FEAS_HOSTILE,
+    XOM_FEAS_ENCHANTABLE,
+    XOM_FEAS_SNAKES,
+    XOM_FEAS_ANIMATEABLE_WEAPON,
+    XOM_FEAS_POLY_TARGET,
+    XOM_FEAS_BLINK_VICTIM,
+    XOM_FEAS_SWAPPABLE,
+    XOM_FEAS_CHAOS_UPGRADE,
+    NUM_XOM_FEASIBILITIES,
+};
+
+struct feasibility_verdict
+{
+    int epoch = -1;
+    int turn = -1;
+    coord_def pos;
+    bool feasible = false;
+};
+static feasibility_verdict _feasibility_cache[NUM_XOM_FEASIBILITIES];
+
+static bool _xom_feasible(xom_feasibility which, const function<bool()> &scan)
+{
+    feasibility_verdict &v = _feasibility_cache[which];
+    if (v.epoch != tension_epoch() || v.turn != you.num_turns
+        || v.pos != you.pos())
+    {
+        v.feasible = scan();
+        v.epoch = tension_epoch();
+        v.turn  = you.num_turns;
+        v.pos   = you.pos();
+    }
+    return v.feasible;
+}
+
 static bool mon_nearby(function<bool(monster&)> filter)
 {
     for (monster_near_iterator mi(you.pos(), LOS_NO_TRANS); mi; ++mi)
@@ -426,6 +468,21 @@ static bool mon_nearby(function<bool(monster&)> filter)
 // estimated percentage value of exploration.
 static int _exploration_estimate(bool seen_only = false)
 {
+    // One stirring can want the estimate twice (divinations and
+    // teleport both consult it), and wrath can stir Xom several times
+    // in a turn, so memoise the sampled value for the rest of the turn.
+    // It's a 100-grid random sample to begin with; at worst a map
+    // change later in the same turn skews one reroll.
+    static int est[2] = { -1, -1 };
+    static int est_turn = -1;
+    if (est_turn != you.num_turns)
+    {
+        est[0] = est[1] = -1;
+        est_turn = you.num_turns;
+    }
+    if (est[seen_only] != -1)
+        return est[seen_only];
+
     int seen  = 0;
     int total = 0;
     int tries = 0;
@@ -465,11 +522,11 @@ static int _exploration_estimate(bool seen_only = false)
     // If we didn't get any qualifying grids, there are probably so few
     // of them you've already seen them all.
     if (total == 0)
-        return 100;
-
-    if (total < 100)
+        seen = 100;
+    else if (total < 100)
         seen *= 100 / total;
 
+    est[seen_only] = seen;
     return seen;
 }
 
@@ -2953,13 +3010,15 @@ static xom_event_type _xom_choose_good_action(int sever, int tension)
     }
 
     if (tension > 0 && x_chance_in_y(5, sever)
-        && mon_nearby([](monster& mon){ return !mon.wont_attack(); }))
+        && _xom_feasible(XOM_FEAS_HOSTILE, []()
+           { return mon_nearby([](monster& mon){ return !mon.wont_attack(); }); }))
     {
         return XOM_GOOD_CONFUSION;
     }
 
     if (tension > 0 && x_chance_in_y(6, sever)
-        && mon_nearby(_choose_enchantable_monster))
+        && _xom_feasible(XOM_FEAS_ENCHANTABLE, []()
+           { return mon_nearby(_choose_enchantable_monster); }))
     {
         return XOM_GOOD_ENCHANT_MONSTER;
     }
@@ -2975,8 +3034,12 @@ static xom_event_type _xom_choose_good_action(int sever, int tension)
         return XOM_GOOD_SCENERY;
     }
 
-    if (x_chance_in_y(9, sever) && mon_nearby(_hostile_snake))
+    if (x_chance_in_y(9, sever)
+        && _xom_feasible(XOM_FEAS_SNAKES, []()
+           { return mon_nearby(_hostile_snake); }))
+    {
         return XOM_GOOD_SNAKES;
+    }
 
     if (tension > random2(10) && x_chance_in_y(10, sever)
         && !you.get_mutation_level(MUT_NO_LOVE))
@@ -2984,14 +3047,19 @@ static xom_event_type _xom_choose_good_action(int sever, int tension)
         return XOM_GOOD_ALLIES;
     }
     if (tension > random2(8) && x_chance_in_y(11, sever)
-        && _find_monster_with_animateable_weapon()
+        && _xom_feasible(XOM_FEAS_ANIMATEABLE_WEAPON, []()
+           { return _find_monster_with_animateable_weapon() != nullptr; })
         && !you.get_mutation_level(MUT_NO_LOVE))
     {
         return XOM_GOOD_ANIMATE_MON_WPN;
     }
 
-    if (x_chance_in_y(12, sever) && _xom_mons_poly_target() != nullptr)
+    if (x_chance_in_y(12, sever)
+        && _xom_feasible(XOM_FEAS_POLY_TARGET, []()
+           { return _xom_mons_poly_target() != nullptr; }))
+    {
         return XOM_GOOD_POLYMORPH;
+    }
 
     if (tension > 0 && x_chance_in_y(13, sever))
     {
@@ -3090,7 +3158,8 @@ static xom_event_type _xom_choose_bad_action(int sever, int tension)
         return XOM_BAD_ENCHANT_MONSTER;
 
     if (tension > 0 && x_chance_in_y(8, sever)
-        && mon_nearby(_mon_valid_blink_victim))
+        && _xom_feasible(XOM_FEAS_BLINK_VICTIM, []()
+           { return mon_nearby(_mon_valid_blink_victim); }))
     {
         return XOM_BAD_BLINK_MONSTERS;
     }
@@ -3100,15 +3169,20 @@ static xom_event_type _xom_choose_bad_action(int sever, int tension)
         return XOM_BAD_CONFUSION;
 
     if (tension > 0 && x_chance_in_y(10, sever)
-        && _rearrangeable_pieces().size())
+        && _xom_feasible(XOM_FEAS_SWAPPABLE, []()
+           { return !_rearrangeable_pieces().empty(); }))
     {
         return XOM_BAD_SWAP_MONSTERS;
     }
 
     if (x_chance_in_y(12, sever))
         return XOM_BAD_MISCAST_MAJOR;
-    if (x_chance_in_y(14, sever) && mon_nearby(_choose_chaos_upgrade))
+    if (x_chance_in_y(14, sever)
+        && _xom_feasible(XOM_FEAS_CHAOS_UPGRADE, []()
+           { return mon_nearby(_choose_chaos_upgrade); }))
+    {
         return XOM_BAD_CHAOS_UPGRADE;
+    }
     if (x_chance_in_y(15, sever) && !player_in_branch(BRANCH_ABYSS)
         && _teleportation_check())
     {